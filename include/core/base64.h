@@ -59,10 +59,13 @@ namespace Base64 { /********************************** Core::Base64 Namespace */
 	 * Deallocation will be automatic by the double buffered
 	 * allocator. (not yet implemented)
 	 *
+	 * Malformed input (bad length, characters outside the alphabet or
+	 * misplaced padding) is rejected, *out is set to null.
+	 *
 	 * @param in In buffer
 	 * @param in_size In buffer size
 	 * @param out Out buffer pointer
-	 * @return Out buffer size
+	 * @return Out buffer size (includes null-term), zero on error
 	 */
 	MARSHMALLOW_CORE_EXPORT
 	size_t Decode(const char *in, size_t in_size, char **out);
@@ -77,11 +80,46 @@ namespace Base64 { /********************************** Core::Base64 Namespace */
 	 * @param in In buffer
 	 * @param in_size In buffer size
 	 * @param out Out buffer pointer
-	 * @return Out buffer size
+	 * @return Out buffer size (excludes null-term)
 	 */
 	MARSHMALLOW_CORE_EXPORT
 	size_t Encode(const char *in, size_t in_size, char **out);
 
+	/*!
+	 * @return Decoded size of a Base64 buffer, zero if the length or
+	 *         padding is malformed
+	 */
+	MARSHMALLOW_CORE_EXPORT
+	size_t DecodedSize(const char *in, size_t in_size);
+
+	/*!
+	 * @return Encoded size of a buffer, without null-term
+	 */
+	MARSHMALLOW_CORE_EXPORT
+	size_t EncodedSize(size_t in_size);
+
+	/*!
+	 * Decode a Base64 buffer into caller provided memory.
+	 *
+	 * @param in In buffer
+	 * @param in_size In buffer size
+	 * @param out Out buffer, at least DecodedSize() bytes
+	 * @return true if input was well-formed
+	 */
+	MARSHMALLOW_CORE_EXPORT
+	bool DecodeTo(const char *in, size_t in_size, char *out);
+
+	/*!
+	 * Encode a buffer as Base64 into caller provided memory, no
+	 * null-term is written.
+	 *
+	 * @param in In buffer
+	 * @param in_size In buffer size
+	 * @param out Out buffer, at least EncodedSize() bytes
+	 */
+	MARSHMALLOW_CORE_EXPORT
+	void EncodeTo(const char *in, size_t in_size, char *out);
+
 } /*************************************************** Core::Base64 Namespace */
 } /*********************************************************** Core Namespace */
 MARSHMALLOW_NAMESPACE_END
@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2013, Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ * All rights reserved.
+ *
+ * This file is part of Marshmallow Game Engine.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE CONTRIBUTORS ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are
+ * those of the authors and should not be interpreted as representing official
+ * policies, either expressed or implied, of the project as a whole.
+ */
+
+#pragma once
+
+/*!
+ * @file
+ *
+ * @author Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ */
+
+#ifndef MARSHMALLOW_CORE_BASE64IO_H
+#define MARSHMALLOW_CORE_BASE64IO_H 1
+
+#include <core/idataio.h>
+
+#include <core/global.h>
+
+MARSHMALLOW_NAMESPACE_BEGIN
+namespace Core { /******************************************** Core Namespace */
+
+	template <class T> class Shared;
+	template <class T> class Weak;
+
+	/*!
+	 * @brief A read-only IDataIO decorator that decodes a Base64 stream
+	 * as it is read
+	 *
+	 * Encoded data is pulled from the source through a fixed-size
+	 * window. Input is validated strictly, the stream ends at the first
+	 * malformed block. Seeking backward restarts from the beginning of
+	 * the stream.
+	 */
+	class MARSHMALLOW_CORE_EXPORT
+	Base64IO : public IDataIO
+	{
+		struct Private;
+		Private *m_p;
+
+		NO_ASSIGN_COPY(Base64IO);
+	public:
+
+		/*!
+		 * Decorator is opened automatically, encoded data starts at
+		 * the current source position.
+		 *
+		 * @param source Base64 encoded DataIO
+		 * @param window Encoded read window size, rounded down to a
+		 *        multiple of four
+		 */
+		Base64IO(const SharedDataIO &source, size_t window = 4096);
+		virtual ~Base64IO(void);
+
+		/*!
+		 * @return true if the stream ended on malformed input
+		 */
+		bool failed(void) const;
+
+	public: /* virtual */
+
+		/*!
+		 * @param mode Open mode, only DIOReadOnly is supported
+		 * @return true on success
+		 */
+		VIRTUAL bool open(DIOMode mode = DIOReadOnly);
+		VIRTUAL void close(void);
+
+		VIRTUAL DIOMode mode(void) const;
+		VIRTUAL bool isOpen(void) const;
+		VIRTUAL bool atEOF(void) const;
+
+		VIRTUAL size_t read(void *buffer, size_t bsize);
+		VIRTUAL size_t write(const void *buffer, size_t bsize);
+
+		VIRTUAL bool seek(long offset, DIOSeek origin);
+		VIRTUAL long tell(void) const;
+	};
+	typedef Shared<Base64IO> SharedBase64IO;
+	typedef Weak<Base64IO> WeakBase64IO;
+
+} /*********************************************************** Core Namespace */
+MARSHMALLOW_NAMESPACE_END
+
+#endif
@@ -121,6 +121,8 @@ namespace Core { /******************************************** Core Namespace */
 
 		VIRTUAL bool seek(long offset, DIOSeek origin);
 		VIRTUAL long tell(void) const;
+
+		VIRTUAL const void * view(size_t offset, size_t length) const;
 	};
 	typedef Shared<BufferIO> SharedBufferIO;
 	typedef Weak<BufferIO> WeakBufferIO;
@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2013, Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ * All rights reserved.
+ *
+ * This file is part of Marshmallow Game Engine.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE CONTRIBUTORS ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are
+ * those of the authors and should not be interpreted as representing official
+ * policies, either expressed or implied, of the project as a whole.
+ */
+
+#pragma once
+
+/*!
+ * @file
+ *
+ * @author Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ */
+
+#ifndef MARSHMALLOW_CORE_DEFLATEIO_H
+#define MARSHMALLOW_CORE_DEFLATEIO_H 1
+
+#include <core/idataio.h>
+
+#include <core/global.h>
+#include <core/zlib.h>
+
+MARSHMALLOW_NAMESPACE_BEGIN
+namespace Core { /******************************************** Core Namespace */
+
+	template <class T> class Shared;
+	template <class T> class Weak;
+
+	/*!
+	 * @brief A write-only IDataIO decorator that deflates everything
+	 * written to it into a sink
+	 *
+	 * Compressed output is handed to the sink one window at a time, the
+	 * stream is finalized when the decorator is closed.
+	 */
+	class MARSHMALLOW_CORE_EXPORT
+	DeflateIO : public IDataIO
+	{
+		struct Private;
+		Private *m_p;
+
+		NO_ASSIGN_COPY(DeflateIO);
+	public:
+
+		enum Format
+		{
+			ZlibFormat,
+			GzipFormat
+		};
+
+		/*!
+		 * Decorator is opened automatically, compressed data is written
+		 * at the current sink position.
+		 *
+		 * @param sink Compressed DataIO
+		 * @param format Stream header format
+		 * @param level Compression level
+		 * @param window Compressed write window size
+		 */
+		DeflateIO(const SharedDataIO &sink, Format format = ZlibFormat,
+		    int level = Zlib::DefaultCompression, size_t window = 16384);
+		virtual ~DeflateIO(void);
+
+		/*!
+		 * Push all pending output to the sink without ending the
+		 * stream, at a small cost in compression ratio.
+		 *
+		 * @return true on success
+		 */
+		bool flush(void);
+
+	public: /* virtual */
+
+		/*!
+		 * @param mode Open mode, only DIOWriteOnly is supported
+		 * @return true on success
+		 */
+		VIRTUAL bool open(DIOMode mode = DIOWriteOnly);
+
+		/*!
+		 * Finish the compressed stream
+		 */
+		VIRTUAL void close(void);
+
+		VIRTUAL DIOMode mode(void) const;
+		VIRTUAL bool isOpen(void) const;
+		VIRTUAL bool atEOF(void) const;
+
+		VIRTUAL size_t read(void *buffer, size_t bsize);
+		VIRTUAL size_t write(const void *buffer, size_t bsize);
+
+		VIRTUAL bool seek(long offset, DIOSeek origin);
+		VIRTUAL long tell(void) const;
+	};
+	typedef Shared<DeflateIO> SharedDeflateIO;
+	typedef Weak<DeflateIO> WeakDeflateIO;
+
+} /*********************************************************** Core Namespace */
+MARSHMALLOW_NAMESPACE_END
+
+#endif
@@ -51,6 +51,7 @@ namespace Core { /******************************************** Core Namespace */
 
 	template <class T> class Shared;
 	template <class T> class Weak;
+	template <class T> class Ref;
 } /*********************************************************** Core Namespace */
 MARSHMALLOW_NAMESPACE_END
 
@@ -55,6 +55,9 @@ namespace Core { /******************************************** Core Namespace */
 
 	/*!
 	 * @brief An IDataIO implementation of a file buffer device
+	 *
+	 * Paths using the "pack://" scheme are served read-only from mounted
+	 * asset packs, see PackIO.
 	 */
 	class MARSHMALLOW_CORE_EXPORT
 	FileIO : public IDataIO
@@ -109,6 +112,8 @@ namespace Core { /******************************************** Core Namespace */
 		VIRTUAL bool seek(long offset, DIOSeek origin);
 		VIRTUAL long tell(void) const;
 
+		VIRTUAL const void * view(size_t offset, size_t length) const;
+
 		VIRTUAL size_t size(void) const;
 	};
 	typedef Shared<FileIO> SharedFileIO;
@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) 2011-2013, Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ * All rights reserved.
+ *
+ * This file is part of Marshmallow Game Engine.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE CONTRIBUTORS ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are
+ * those of the authors and should not be interpreted as representing official
+ * policies, either expressed or implied, of the project as a whole.
+ */
+
+#pragma once
+
+/*!
+ * @file
+ *
+ * @author Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ */
+
+#ifndef MARSHMALLOW_CORE_FRAMEARENA_H
+#define MARSHMALLOW_CORE_FRAMEARENA_H 1
+
+#include <core/environment.h>
+#include <core/global.h>
+#include <core/namespace.h>
+
+#include <cstddef>
+#include <new>
+
+MARSHMALLOW_NAMESPACE_BEGIN
+namespace Core { /******************************************** Core Namespace */
+
+/*!
+ * @brief Per-frame transient memory
+ *
+ * A double-buffered bump allocator, EngineBase calls Swap() at the end
+ * of every frame. Memory allocated during a frame stays valid until the
+ * end of the following frame and is never freed individually.
+ *
+ * Allocations that don't fit spill onto the heap, the buffer grows to
+ * fit them the next time it's reset so a steady-state frame doesn't
+ * touch the heap. Allocate() is thread-safe, Swap() must not race it.
+ *
+ * Objects placed in the arena don't get their destructors called.
+ */
+namespace FrameArena { /************************** Core::FrameArena Namespace */
+
+	enum { Alignment = 16, DefaultCapacity = 256 * 1024 };
+
+	/*!
+	 * @return Alignment aligned memory valid until the end of the next
+	 *         frame
+	 */
+	MARSHMALLOW_CORE_EXPORT
+	void * Allocate(size_t size);
+
+	/*!
+	 * @return Uninitialized array of count elements
+	 */
+	template <class T>
+	inline T * Allocate(size_t count)
+	    { return(static_cast<T *>(Allocate(count * sizeof(T)))); }
+
+	/*!
+	 * Mark the end of a frame, memory of the frame before the last is
+	 * reclaimed.
+	 */
+	MARSHMALLOW_CORE_EXPORT
+	void Swap(void);
+
+	/*!
+	 * Grow both buffers to at least capacity bytes, takes effect
+	 * immediately on the current one
+	 */
+	MARSHMALLOW_CORE_EXPORT
+	void Reserve(size_t capacity);
+
+	/*!
+	 * Free all memory, nothing allocated from the arena may be in use
+	 */
+	MARSHMALLOW_CORE_EXPORT
+	void Release(void);
+
+	/*!
+	 * @return Bytes allocated during the current frame
+	 */
+	MARSHMALLOW_CORE_EXPORT
+	size_t Used(void);
+
+	/*!
+	 * @return Bytes available to the current frame before spilling
+	 */
+	MARSHMALLOW_CORE_EXPORT
+	size_t Capacity(void);
+
+	/*!
+	 * @return Number of allocations that spilled onto the heap
+	 */
+	MARSHMALLOW_CORE_EXPORT
+	unsigned long Spilled(void);
+
+} /*********************************************** Core::FrameArena Namespace */
+
+	/*!
+	 * @brief STL allocator adapter for the frame arena
+	 *
+	 * Containers using it must not outlive the next frame, deallocation
+	 * is a no-op.
+	 */
+	template <class T>
+	class FrameAllocator
+	{
+	public:
+
+		typedef T         value_type;
+		typedef T *       pointer;
+		typedef const T * const_pointer;
+		typedef T &       reference;
+		typedef const T & const_reference;
+		typedef size_t    size_type;
+		typedef ptrdiff_t difference_type;
+
+		template <class U>
+		struct rebind { typedef FrameAllocator<U> other; };
+
+		FrameAllocator(void) {}
+
+		template <class U>
+		FrameAllocator(const FrameAllocator<U> &) {}
+
+		pointer address(reference value) const
+		    { return(&value); }
+		const_pointer address(const_reference value) const
+		    { return(&value); }
+
+		pointer allocate(size_type count, const void * = 0)
+		    { return(FrameArena::Allocate<T>(count)); }
+		void deallocate(pointer, size_type) {}
+
+		size_type max_size(void) const
+		    { return(static_cast<size_type>(-1) / sizeof(T)); }
+
+		void construct(pointer p, const T &value)
+		    { new (p) T(value); }
+		void destroy(pointer p)
+		    { p->~T(); }
+	};
+
+	template <class T, class U>
+	inline bool operator==(const FrameAllocator<T> &, const FrameAllocator<U> &)
+	    { return(true); }
+
+	template <class T, class U>
+	inline bool operator!=(const FrameAllocator<T> &, const FrameAllocator<U> &)
+	    { return(false); }
+
+} /*********************************************************** Core Namespace */
+MARSHMALLOW_NAMESPACE_END
+
+#endif
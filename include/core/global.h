@@ -51,6 +51,12 @@
 #define MARSHMALLOW_VERSION_BUILD    0x00
 #define MARSHMALLOW_VERSION_REVISION 0x0a
 
+#if __cplusplus >= 201103L || (defined(_MSC_VER) && _MSC_VER >= 1800)
+#   define MARSHMALLOW_CXX11 1
+#else
+#   define MARSHMALLOW_CXX11 0
+#endif
+
 #define VIRTUAL
 #define NO_ASSIGN_COPY(x) NO_ASSIGN(x); NO_COPY(x)
 #define NO_COPY(x) x(const x&)
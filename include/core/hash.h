@@ -42,8 +42,11 @@
 #define MARSHMALLOW_CORE_HASH_H 1
 
 #include <core/environment.h>
+#include <core/global.h>
 #include <core/namespace.h>
 
+#include <cstddef>
+
 MARSHMALLOW_NAMESPACE_BEGIN
 namespace Core { /******************************************** Core Namespace */
 
@@ -55,12 +58,12 @@ namespace Core { /******************************************** Core Namespace */
 	class MARSHMALLOW_CORE_EXPORT
 	Hash
 	{
-		struct Private;
-		Private *m_p;
+		MMUID m_result;
 
 	public:
 
-		Hash(void);
+		Hash(void)
+		    : m_result(0) {}
 
 		/*!
 		 * Hash Contructor
@@ -69,45 +72,129 @@ namespace Core { /******************************************** Core Namespace */
 		 * @param length Data length
 		 * @param mask UID mask
 		 */
-		Hash(const char *d, size_t length, MMUID mask);
+		Hash(const char *d, size_t length, MMUID mask)
+		    : m_result(Algorithm(d, length, mask)) {}
 
 		/*!
 		 * Hash Copy Contructor
 		 *
 		 * @param copy Hash
 		 */
-		Hash(const Hash &copy);
+		Hash(const Hash &copy)
+		    : m_result(copy.m_result) {}
 		virtual ~Hash(void);
 
 		/*!
 		 * @brief Datum
 		 */
-		MMUID result(void) const;
+		MMUID result(void) const
+		    { return(m_result); }
 
 	public: /* operator */
 
-		operator MMUID() const;
+		operator MMUID() const
+		    { return(m_result); }
 
-		Hash & operator=(const Hash &rhs);
+		Hash & operator=(const Hash &rhs)
+		    { m_result = rhs.m_result;
+		      return(*this); }
 
-		bool operator==(const Hash &rhs) const;
-		bool operator!=(const Hash &rhs) const;
-		bool operator<(const Hash &rhs) const;
+		bool operator==(const Hash &rhs) const
+		    { return(m_result == rhs.m_result); }
+		bool operator!=(const Hash &rhs) const
+		    { return(m_result != rhs.m_result); }
+		bool operator<(const Hash &rhs) const
+		    { return(m_result < rhs.m_result); }
 
 	public: /* static */
 
 		/*!
 		 * @brief Hash algorithm
 		 *
-		 * One-at-a-time hash is used.
+		 * CRC-32C (Castagnoli) finished with a murmur3 mix. The SSE4.2
+		 * crc32 instruction is used when the CPU has it, otherwise a
+		 * portable slicing-by-8 table; both produce the same result.
+		 * Building with MARSHMALLOW_LEGACY_HASH selects LegacyAlgorithm()
+		 * instead, for data saved with older UIDs.
 		 */
 		static MMUID Algorithm(const char *data, size_t length, MMUID mask);
 
+		/*!
+		 * @brief Legacy hash algorithm
+		 *
+		 * One-at-a-time hash, as used by earlier releases.
+		 */
+		static MMUID LegacyAlgorithm(const char *data, size_t length, MMUID mask);
+
+#if MARSHMALLOW_CXX11
+		/*!
+		 * @brief Compile-time Hash algorithm
+		 *
+		 * Same result as Algorithm(), usable in constant expressions.
+		 */
+		static constexpr MMUID
+		Literal(const char *data, size_t length, MMUID mask = ~MMUID(0))
+#if MARSHMALLOW_LEGACY_HASH
+		    { return(Final(Step(data, length, 0)) & mask); }
+#else
+		    { return(Final(~Step(data, length, ~MMUID(0))) & mask); }
+#endif
+#endif
+
 	protected:
 
-		void rehash(const char *d, size_t length, MMUID mask);
+		void rehash(const char *d, size_t length, MMUID mask)
+		    { m_result = Algorithm(d, length, mask); }
+
+		void rehash(MMUID result)
+		    { m_result = result; }
+
+#if MARSHMALLOW_CXX11
+	private:
+
+#if MARSHMALLOW_LEGACY_HASH
+		static constexpr MMUID Mix(MMUID h)
+		    { return(h ^ (h >> 0x06)); }
+		static constexpr MMUID Step(const char *d, size_t n, MMUID h)
+		    { return(n == 0 ? h : Step(d + 1, n - 1,
+		        Mix((h + static_cast<MMUID>(*d)) + ((h + static_cast<MMUID>(*d)) << 0x0A)))); }
+		static constexpr MMUID Final2(MMUID h)
+		    { return(h + (h << 0x0F)); }
+		static constexpr MMUID Final1(MMUID h)
+		    { return(Final2(h ^ (h >> 0x0B))); }
+		static constexpr MMUID Final(MMUID h)
+		    { return(Final1(h + (h << 0x03))); }
+#else
+		static constexpr MMUID Bits(MMUID c, int k)
+		    { return(k == 0 ? c : Bits((c >> 1) ^ (0x82F63B78 & (0u - (c & 1))), k - 1)); }
+		static constexpr MMUID Step(const char *d, size_t n, MMUID c)
+		    { return(n == 0 ? c : Step(d + 1, n - 1,
+		        Bits(c ^ static_cast<unsigned char>(*d), 8))); }
+		static constexpr MMUID Final3(MMUID h)
+		    { return(h ^ (h >> 0x10)); }
+		static constexpr MMUID Final2(MMUID h)
+		    { return(Final3((h ^ (h >> 0x0D)) * 0xC2B2AE35)); }
+		static constexpr MMUID Final(MMUID h)
+		    { return(Final2((h ^ (h >> 0x10)) * 0x85EBCA6B)); }
+#endif
+#endif
 	};
 
+#if MARSHMALLOW_CXX11
+	template <MMUID V>
+	struct HashConstant { static const MMUID value = V; };
+
+	/*!
+	 * @brief Hash of a string literal, computed at compile time when possible
+	 */
+#   define MMHASH(x) \
+    MARSHMALLOW_NAMESPACE::Core::HashConstant< \
+        MARSHMALLOW_NAMESPACE::Core::Hash::Literal(x, sizeof(x) - 1)>::value
+#else
+#   define MMHASH(x) \
+    MARSHMALLOW_NAMESPACE::Core::Hash::Algorithm(x, sizeof(x) - 1, ~static_cast<MMUID>(0))
+#endif
+
 } /*********************************************************** Core Namespace */
 MARSHMALLOW_NAMESPACE_END
 
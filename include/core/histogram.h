@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2011-2013, Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ * All rights reserved.
+ *
+ * This file is part of Marshmallow Game Engine.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE CONTRIBUTORS ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are
+ * those of the authors and should not be interpreted as representing official
+ * policies, either expressed or implied, of the project as a whole.
+ */
+
+#pragma once
+
+/*!
+ * @file
+ *
+ * @author Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ */
+
+#ifndef MARSHMALLOW_CORE_HISTOGRAM_H
+#define MARSHMALLOW_CORE_HISTOGRAM_H 1
+
+#include <core/environment.h>
+#include <core/global.h>
+#include <core/namespace.h>
+
+MARSHMALLOW_NAMESPACE_BEGIN
+namespace Core { /******************************************** Core Namespace */
+
+	/*!
+	 * @brief High dynamic range histogram of non-negative integers
+	 *
+	 * Values are counted in log-linear buckets: each power of two is
+	 * split into SubBuckets linear buckets, so every recorded value is
+	 * kept to within 1/SubBuckets (about 0.4%) of its magnitude while
+	 * memory stays proportional to the logarithm of the range. Values
+	 * below 2 * SubBuckets are kept exactly.
+	 *
+	 * Recording and removing are constant time, queries walk the
+	 * buckets. Results are the highest value equivalent to the bucket
+	 * they fall in, bounded by the exact extremes recorded since the
+	 * last reset.
+	 */
+	class MARSHMALLOW_CORE_EXPORT
+	Histogram
+	{
+		struct Private;
+		Private *m_p;
+
+		NO_ASSIGN_COPY(Histogram);
+	public:
+
+		enum { SubBucketBits = 8, SubBuckets = 1 << SubBucketBits };
+
+		/*!
+		 * @param highest Highest trackable value, larger values are
+		 *        clamped to it
+		 */
+		explicit Histogram(int64_t highest = MMTICK_MAX);
+		~Histogram(void);
+
+		/*!
+		 * Count value, negative values are counted as zero
+		 */
+		void record(int64_t value, uint32_t count = 1);
+
+		/*!
+		 * Uncount a previously recorded value
+		 */
+		void remove(int64_t value, uint32_t count = 1);
+
+		void reset(void);
+
+		/*!
+		 * Add all counts of another histogram
+		 */
+		void merge(const Histogram &other);
+
+		int64_t highest(void) const;
+
+		/*!
+		 * @return Number of values counted
+		 */
+		uint64_t count(void) const;
+
+		/*!
+		 * @return Exact mean of values counted (clamped values
+		 *         included as clamped)
+		 */
+		double mean(void) const;
+
+		int64_t minimum(void) const;
+		int64_t maximum(void) const;
+
+		/*!
+		 * @param percent Percentile in the range [0, 100]
+		 * @return Value at or below which percent of the counted
+		 *         values fall, zero if empty
+		 */
+		int64_t percentile(double percent) const;
+
+		/*!
+		 * @return Number of values counted above value (to bucket
+		 *         precision)
+		 */
+		uint64_t countAbove(int64_t value) const;
+
+	public: /* static */
+
+		/*!
+		 * @return Index of the bucket counting value
+		 */
+		static size_t BucketOf(int64_t value);
+
+		/*!
+		 * @return Lowest value counted by bucket
+		 */
+		static int64_t BucketLowest(size_t bucket);
+
+		/*!
+		 * @return Highest value counted by bucket
+		 */
+		static int64_t BucketHighest(size_t bucket);
+	};
+
+} /*********************************************************** Core Namespace */
+MARSHMALLOW_NAMESPACE_END
+
+#endif
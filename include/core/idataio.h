@@ -115,6 +115,21 @@ namespace Core { /******************************************** Core Namespace */
 
 		virtual bool seek(long offset, DIOSeek origin) = 0;
 		virtual long tell(void) const = 0;
+
+		/*!
+		 * Zero-copy access to device data, the cursor is not moved.
+		 *
+		 * Devices that don't expose their storage keep the default
+		 * implementation, which provides no view.
+		 *
+		 * @param offset Offset from start of device
+		 * @param length Number of bytes requested
+		 * @return Pointer valid while DIO stays open, null if the range is
+		 *         out of bounds or the device doesn't expose its storage
+		 */
+		virtual const void * view(size_t /* offset */,
+		    size_t /* length */) const
+		    { return(0); }
 	};
 	typedef Shared<IDataIO> SharedDataIO;
 	typedef Weak<IDataIO> WeakDataIO;
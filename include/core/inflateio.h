@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2013, Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ * All rights reserved.
+ *
+ * This file is part of Marshmallow Game Engine.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE CONTRIBUTORS ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are
+ * those of the authors and should not be interpreted as representing official
+ * policies, either expressed or implied, of the project as a whole.
+ */
+
+#pragma once
+
+/*!
+ * @file
+ *
+ * @author Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ */
+
+#ifndef MARSHMALLOW_CORE_INFLATEIO_H
+#define MARSHMALLOW_CORE_INFLATEIO_H 1
+
+#include <core/idataio.h>
+
+#include <core/global.h>
+
+MARSHMALLOW_NAMESPACE_BEGIN
+namespace Core { /******************************************** Core Namespace */
+
+	template <class T> class Shared;
+	template <class T> class Weak;
+
+	/*!
+	 * @brief A read-only IDataIO decorator that inflates a zlib or gzip
+	 * stream as it is read
+	 *
+	 * Compressed data is pulled from the source through a fixed-size
+	 * window, so memory use doesn't depend on the size of the stream.
+	 * Seeking forward decompresses and discards, seeking backward
+	 * restarts from the beginning of the stream.
+	 */
+	class MARSHMALLOW_CORE_EXPORT
+	InflateIO : public IDataIO
+	{
+		struct Private;
+		Private *m_p;
+
+		NO_ASSIGN_COPY(InflateIO);
+	public:
+
+		/*!
+		 * Decorator is opened automatically, compressed data starts at
+		 * the current source position.
+		 *
+		 * @param source Compressed DataIO
+		 * @param window Compressed read window size
+		 */
+		InflateIO(const SharedDataIO &source, size_t window = 16384);
+		virtual ~InflateIO(void);
+
+		/*!
+		 * Uncompressed size, the whole stream is inflated the first time
+		 * it's requested.
+		 *
+		 * @return uncompressed size, zero on error
+		 */
+		size_t size(void);
+
+	public: /* virtual */
+
+		/*!
+		 * @param mode Open mode, only DIOReadOnly is supported
+		 * @return true on success
+		 */
+		VIRTUAL bool open(DIOMode mode = DIOReadOnly);
+		VIRTUAL void close(void);
+
+		VIRTUAL DIOMode mode(void) const;
+		VIRTUAL bool isOpen(void) const;
+		VIRTUAL bool atEOF(void) const;
+
+		VIRTUAL size_t read(void *buffer, size_t bsize);
+		VIRTUAL size_t write(const void *buffer, size_t bsize);
+
+		VIRTUAL bool seek(long offset, DIOSeek origin);
+		VIRTUAL long tell(void) const;
+	};
+	typedef Shared<InflateIO> SharedInflateIO;
+	typedef Weak<InflateIO> WeakInflateIO;
+
+} /*********************************************************** Core Namespace */
+MARSHMALLOW_NAMESPACE_END
+
+#endif
@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2011-2013, Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ * All rights reserved.
+ *
+ * This file is part of Marshmallow Game Engine.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE CONTRIBUTORS ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are
+ * those of the authors and should not be interpreted as representing official
+ * policies, either expressed or implied, of the project as a whole.
+ */
+
+#pragma once
+
+/*!
+ * @file
+ *
+ * @author Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ */
+
+#ifndef MARSHMALLOW_CORE_JOBSYSTEM_H
+#define MARSHMALLOW_CORE_JOBSYSTEM_H 1
+
+#include <core/environment.h>
+#include <core/global.h>
+#include <core/namespace.h>
+
+MARSHMALLOW_NAMESPACE_BEGIN
+namespace Core { /******************************************** Core Namespace */
+
+/*!
+ * @brief Work-stealing job system
+ *
+ * A fixed pool of worker threads, each owning a deque of jobs; idle
+ * workers steal from the others. The thread that calls Initialize()
+ * (the main thread) takes part as well, while waiting for jobs it runs
+ * pending ones.
+ *
+ * A job is finished once it and all of its children have run, which
+ * gives fork-join through Wait():
+ *
+ * @code
+ * Job *l_root = JobSystem::Create(0, 0);
+ * for (...) JobSystem::Run(JobSystem::Create(Work, &data[i], l_root));
+ * JobSystem::Run(l_root);
+ * JobSystem::Wait(l_root);
+ * @endcode
+ *
+ * Jobs are allocated from a per-thread ring and recycled, a job pointer
+ * is only valid until it has finished and been waited on. Jobs run
+ * from threads other than the worker threads and the main thread, or
+ * while the system is not initialized, execute immediately on the
+ * calling thread.
+ */
+namespace JobSystem { /**************************** Core::JobSystem Namespace */
+
+	struct Job;
+
+	typedef void (*Function)(void *context);
+	typedef void (*RangeFunction)(void *context, size_t begin, size_t end);
+
+	/*!
+	 * Start worker threads
+	 *
+	 * @param workers Number of worker threads, negative for one per
+	 *        hardware thread minus the calling one
+	 */
+	MARSHMALLOW_CORE_EXPORT
+	bool Initialize(int workers = -1);
+
+	/*!
+	 * Stop worker threads, jobs still queued are dropped
+	 */
+	MARSHMALLOW_CORE_EXPORT
+	void Finalize(void);
+
+	MARSHMALLOW_CORE_EXPORT
+	bool Active(void);
+
+	/*!
+	 * @return Threads running jobs, the main thread included
+	 */
+	MARSHMALLOW_CORE_EXPORT
+	int Threads(void);
+
+	/*!
+	 * Create a job, parent won't finish before it does
+	 *
+	 * @param function Job function, may be null (a pure join point)
+	 * @param context Passed to function
+	 * @param parent Parent job, must not have finished yet
+	 */
+	MARSHMALLOW_CORE_EXPORT
+	Job * Create(Function function, void *context, Job *parent = 0);
+
+	/*!
+	 * Queue job for execution
+	 */
+	MARSHMALLOW_CORE_EXPORT
+	void Run(Job *job);
+
+	/*!
+	 * Run other jobs until job has finished
+	 */
+	MARSHMALLOW_CORE_EXPORT
+	void Wait(const Job *job);
+
+	MARSHMALLOW_CORE_EXPORT
+	bool Finished(const Job *job);
+
+	/*!
+	 * Call function over [0, count) split into ranges, returns when
+	 * all ranges are done.
+	 *
+	 * @param grain Minimum range size, zero picks one from the thread
+	 *        count
+	 */
+	MARSHMALLOW_CORE_EXPORT
+	void ParallelFor(size_t count, RangeFunction function, void *context,
+	                 size_t grain = 0);
+
+} /************************************************ Core::JobSystem Namespace */
+} /*********************************************************** Core Namespace */
+MARSHMALLOW_NAMESPACE_END
+
+#endif
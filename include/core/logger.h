@@ -43,12 +43,241 @@
 
 #include <core/config.h>
 #include <core/environment.h>
+#include <core/global.h>
+#include <core/namespace.h>
 
 #include <cstdlib>
-#include <iostream>
+#include <cstring>
+#include <sstream>
+#include <string>
 
-#define MMLOG(type, x) std::cerr << __FILE__ << ":" << __LINE__ << " ["type"]" << std::endl \
-                                 << "\t" << MMFUNCTION << ": " << x << std::endl
+MARSHMALLOW_NAMESPACE_BEGIN
+namespace Core { /******************************************** Core Namespace */
+
+/*!
+ * @brief Asynchronous log backend behind the MM* logging macros
+ *
+ * Messages are formatted on the calling thread into a fixed-size record
+ * and pushed into a lock-free ring buffer owned by that thread. A
+ * background writer drains all rings and does the actual output, so
+ * logging rarely blocks on I/O. A full ring is drained by the caller
+ * if the writer is idle, otherwise the message is dropped and counted,
+ * see Dropped().
+ *
+ * Messages from one thread keep their order, messages from different
+ * threads are only ordered by timestamp.
+ */
+namespace Logger { /********************************** Core::Logger Namespace */
+
+	enum Level
+	{
+		VerboseLevel,
+		InfoLevel,
+		DebugLevel,
+		WarningLevel,
+		ErrorLevel,
+		FatalLevel
+	};
+
+	/*!
+	 * Map a MMLOG() type tag ("ERROR", "WARN", ...) to a level
+	 */
+	inline Level
+	TagLevel(const char *tag)
+	{
+		switch (tag[0]) {
+		case 'F': return(FatalLevel);
+		case 'E': return(ErrorLevel);
+		case 'W': return(WarningLevel);
+		case 'D': return(DebugLevel);
+		case 'I': return(InfoLevel);
+		default:  return(VerboseLevel);
+		}
+	}
+
+	/*!
+	 * @brief A single log message, built by the logging macros
+	 *
+	 * Common types are formatted in place, anything else goes through
+	 * its std::ostream operator. Messages longer than Capacity are
+	 * truncated.
+	 */
+	class MARSHMALLOW_CORE_EXPORT
+	Record
+	{
+		NO_ASSIGN_COPY(Record);
+	public:
+
+		enum { Capacity = 480 };
+
+		Record(Level level, const char *file, int line, const char *function)
+		    : m_file(file)
+		    , m_function(function)
+		    , m_level(level)
+		    , m_line(line)
+		    , m_length(0)
+		    , m_truncated(false)
+		{}
+
+		Level level(void) const
+		    { return(m_level); }
+		const char * file(void) const
+		    { return(m_file); }
+		int line(void) const
+		    { return(m_line); }
+		const char * function(void) const
+		    { return(m_function); }
+		const char * text(void) const
+		    { return(m_text); }
+		size_t length(void) const
+		    { return(m_length); }
+		bool truncated(void) const
+		    { return(m_truncated); }
+
+	public: /* operator */
+
+		Record & operator<<(const char *s)
+		    { if (s) append(s, strlen(s)); else append("(null)", 6);
+		      return(*this); }
+		Record & operator<<(const std::string &s)
+		    { append(s.data(), s.size());
+		      return(*this); }
+		Record & operator<<(char c)
+		    { append(&c, 1);
+		      return(*this); }
+
+		Record & operator<<(bool v)
+		    { return(format("%d", int(v))); }
+		Record & operator<<(int v)
+		    { return(format("%d", v)); }
+		Record & operator<<(unsigned int v)
+		    { return(format("%u", v)); }
+		Record & operator<<(long v)
+		    { return(format("%ld", v)); }
+		Record & operator<<(unsigned long v)
+		    { return(format("%lu", v)); }
+		Record & operator<<(double v)
+		    { return(format("%g", v)); }
+		Record & operator<<(float v)
+		    { return(format("%g", double(v))); }
+		Record & operator<<(const void *v)
+		    { return(format("%p", v)); }
+
+		template <class T>
+		Record & operator<<(const T &v)
+		    { std::ostringstream l_stream;
+		      l_stream << v;
+		      return(*this << l_stream.str()); }
+
+		Record & operator<<(std::ostream & (*manipulator)(std::ostream &))
+		    { std::ostringstream l_stream;
+		      l_stream << manipulator;
+		      return(*this << l_stream.str()); }
+
+	private:
+
+		void append(const char *data, size_t length)
+		{
+			size_t l_count = Capacity - m_length;
+			if (length > l_count)
+				m_truncated = true;
+			else
+				l_count = length;
+
+			memcpy(m_text + m_length, data, l_count);
+			m_length += l_count;
+		}
+
+		Record & format(const char *format, ...);
+
+	private:
+
+		const char *m_file;
+		const char *m_function;
+		Level       m_level;
+		int         m_line;
+		size_t      m_length;
+		bool        m_truncated;
+		char        m_text[Capacity];
+	};
+
+	/*!
+	 * Output callback, receives formatted text of one or more messages
+	 */
+	typedef void (*Sink)(const char *text, size_t length);
+
+	/*!
+	 * Runtime filter, used by the logging macros before formatting
+	 *
+	 * @return true if messages at level from file should be logged
+	 */
+	MARSHMALLOW_CORE_EXPORT
+	bool Enabled(Level level, const char *file);
+
+	/*!
+	 * Queue a message for the writer, fatal messages are flushed
+	 * before returning.
+	 */
+	MARSHMALLOW_CORE_EXPORT
+	void Submit(const Record &record);
+
+	/*!
+	 * Write out every queued message before returning
+	 */
+	MARSHMALLOW_CORE_EXPORT
+	void Flush(void);
+
+	/*!
+	 * Drop messages below level (default VerboseLevel). Levels already
+	 * compiled out by MARSHMALLOW_DEBUG_VERBOSITY can't be enabled.
+	 */
+	MARSHMALLOW_CORE_EXPORT
+	void SetThreshold(Level level);
+
+	MARSHMALLOW_CORE_EXPORT
+	Level Threshold(void);
+
+	/*!
+	 * Enable or disable a subsystem, the source directory below src/
+	 * or include/ ("core", "graphics", "audio", ...).
+	 *
+	 * Filters should be set up before other threads start logging.
+	 */
+	MARSHMALLOW_CORE_EXPORT
+	void SetSubsystem(const char *subsystem, bool enabled);
+
+	/*!
+	 * Replace the output callback (stderr by default), null restores
+	 * the default.
+	 */
+	MARSHMALLOW_CORE_EXPORT
+	void SetSink(Sink sink);
+
+	/*!
+	 * Synchronous mode writes every message before Submit() returns
+	 */
+	MARSHMALLOW_CORE_EXPORT
+	void SetAsynchronous(bool asynchronous);
+
+	/*!
+	 * @return Number of messages dropped because a ring was full
+	 */
+	MARSHMALLOW_CORE_EXPORT
+	unsigned long Dropped(void);
+
+} /*************************************************** Core::Logger Namespace */
+} /*********************************************************** Core Namespace */
+MARSHMALLOW_NAMESPACE_END
+
+#define MMLOG_RECORD(level, x) \
+    (MARSHMALLOW_NAMESPACE::Core::Logger::Enabled(level, __FILE__) \
+        ? MARSHMALLOW_NAMESPACE::Core::Logger::Submit( \
+              MARSHMALLOW_NAMESPACE::Core::Logger::Record \
+                  (level, __FILE__, __LINE__, MMFUNCTION) << x) \
+        : (void)0)
+
+#define MMLOG(type, x) \
+    MMLOG_RECORD(MARSHMALLOW_NAMESPACE::Core::Logger::TagLevel(type), x)
 
 #define MMFATAL(x) MMLOG("FATAL", x), exit(-1)
 #define MMERROR(x) MMLOG("ERROR", x)
@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) 2013, Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ * All rights reserved.
+ *
+ * This file is part of Marshmallow Game Engine.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE CONTRIBUTORS ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are
+ * those of the authors and should not be interpreted as representing official
+ * policies, either expressed or implied, of the project as a whole.
+ */
+
+#pragma once
+
+/*!
+ * @file
+ *
+ * @author Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ */
+
+#ifndef MARSHMALLOW_CORE_MAPPEDFILEIO_H
+#define MARSHMALLOW_CORE_MAPPEDFILEIO_H 1
+
+#include <core/idataio.h>
+
+#include <core/global.h>
+
+MARSHMALLOW_NAMESPACE_BEGIN
+namespace Core { /******************************************** Core Namespace */
+
+	template <class T> class Shared;
+	template <class T> class Weak;
+
+	/*!
+	 * @brief Expected access pattern of a mapped range
+	 */
+	enum DIOAdvice
+	{
+		DIOAdviceNormal,
+		DIOAdviceSequential,
+		DIOAdviceRandom,
+		DIOAdviceWillNeed,
+		DIOAdviceDontNeed
+	};
+
+	/*!
+	 * @brief A read-only IDataIO implementation backed by a memory-mapped
+	 * file
+	 *
+	 * Pages are loaded on demand by the operating system and shared with
+	 * the page cache, view() hands out pointers straight into the mapping.
+	 * Paths using the "pack://" scheme are served from mounted asset
+	 * packs, see PackIO.
+	 */
+	class MARSHMALLOW_CORE_EXPORT
+	MappedFileIO : public IDataIO
+	{
+		struct Private;
+		Private *m_p;
+
+		NO_ASSIGN_COPY(MappedFileIO);
+	public:
+
+		MappedFileIO(void);
+
+		/*!
+		 * @brief Construct and attempt to map file
+		 * @param filename Path of file to be mapped
+		 * @param mode Open mode, only DIOReadOnly is supported
+		 */
+		MappedFileIO(const Identifier &filename, DIOMode mode = DIOReadOnly);
+		virtual ~MappedFileIO(void);
+
+		/*!
+		 * Path of file to be mapped
+		 * @return Path of file
+		 */
+		const Identifier & fileName(void) const;
+
+		/*!
+		 * Set path of file to be mapped
+		 */
+		void setFileName(const Identifier &filename);
+
+		/*!
+		 * Size of mapped file
+		 */
+		size_t size(void) const;
+
+		/*!
+		 * Hint the expected access pattern of a range to the kernel
+		 *
+		 * @param advice Access pattern
+		 * @param offset Offset from start of file
+		 * @param length Range length, zero means up to end of file
+		 * @return true if the hint was accepted
+		 */
+		bool advise(DIOAdvice advice, size_t offset = 0, size_t length = 0);
+
+	public: /* virtual */
+
+		/*!
+		 * Map file
+		 *
+		 * Requires a valid filename
+		 *
+		 * @param mode Open mode, only DIOReadOnly is supported
+		 * @return true on success
+		 */
+		VIRTUAL bool open(DIOMode mode = DIOReadOnly);
+		VIRTUAL void close(void);
+
+		VIRTUAL DIOMode mode(void) const;
+		VIRTUAL bool isOpen(void) const;
+		VIRTUAL bool atEOF(void) const;
+
+		VIRTUAL size_t read(void *buffer, size_t bsize);
+		VIRTUAL size_t write(const void *buffer, size_t bsize);
+
+		VIRTUAL bool seek(long offset, DIOSeek origin);
+		VIRTUAL long tell(void) const;
+
+		VIRTUAL const void * view(size_t offset, size_t length) const;
+	};
+	typedef Shared<MappedFileIO> SharedMappedFileIO;
+	typedef Weak<MappedFileIO> WeakMappedFileIO;
+
+} /*********************************************************** Core Namespace */
+MARSHMALLOW_NAMESPACE_END
+
+#endif
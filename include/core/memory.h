@@ -0,0 +1,188 @@
+/*
+ * Copyright (c) 2011-2013, Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ * All rights reserved.
+ *
+ * This file is part of Marshmallow Game Engine.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE CONTRIBUTORS ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are
+ * those of the authors and should not be interpreted as representing official
+ * policies, either expressed or implied, of the project as a whole.
+ */
+
+#pragma once
+
+/*!
+ * @file
+ *
+ * @author Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ */
+
+#ifndef MARSHMALLOW_CORE_MEMORY_H
+#define MARSHMALLOW_CORE_MEMORY_H 1
+
+#include <core/config.h>
+#include <core/environment.h>
+#include <core/global.h>
+#include <core/namespace.h>
+
+#include <cstddef>
+
+MARSHMALLOW_NAMESPACE_BEGIN
+namespace Core { /******************************************** Core Namespace */
+
+/*!
+ * @brief Per-subsystem memory accounting
+ *
+ * With MARSHMALLOW_MEMORY_TRACKING enabled, global new and delete carry a
+ * small header and every allocation is charged to the tag of the
+ * innermost MMMEMORY_SCOPE() on the allocating thread. A block is
+ * credited back to the same tag when released, wherever that happens.
+ *
+ * GPU side memory can't be observed, backends report estimates for
+ * texture, vertex and texture coordinate data with MMMEMORY_TRACK() and
+ * MMMEMORY_UNTRACK().
+ *
+ * Disabled builds keep the query API (reporting zeros) while the macros
+ * compile to nothing and new/delete are left untouched.
+ *
+ * Tracking builds own the global new/delete, programs must not replace
+ * them (static builds fail to link), count allocations through Stats()
+ * instead.
+ */
+namespace Memory { /********************************** Core::Memory Namespace */
+
+	enum Tag
+	{
+		UntaggedMemory,
+		CoreMemory,
+		EventMemory,
+		GraphicsMemory,
+		AudioMemory,
+		GameMemory,
+		InputMemory,
+		Tags
+	};
+
+	enum Resource
+	{
+		TextureMemory,
+		VertexMemory,
+		TextureCoordinateMemory,
+		Resources
+	};
+
+	/*! @brief Tag or resource usage */
+	struct Statistics
+	{
+		long          live;        /*!< Bytes currently allocated */
+		long          peak;        /*!< Highest live bytes */
+		unsigned long allocations; /*!< Lifetime allocations */
+		unsigned long frame;       /*!< Allocations during the last frame */
+	};
+
+	/*!
+	 * @brief Charges allocations made during its lifetime to a tag
+	 */
+	class MARSHMALLOW_CORE_EXPORT
+	Scope
+	{
+		NO_ASSIGN_COPY(Scope);
+	public:
+
+		explicit Scope(Tag tag);
+		~Scope(void);
+
+	private:
+
+		Tag m_previous;
+	};
+
+	/*!
+	 * @return true if compiled with MARSHMALLOW_MEMORY_TRACKING
+	 */
+	MARSHMALLOW_CORE_EXPORT
+	bool Enabled(void);
+
+	/*!
+	 * @return Tag allocations on the calling thread are charged to
+	 */
+	MARSHMALLOW_CORE_EXPORT
+	Tag Current(void);
+
+	/*!
+	 * Report GPU side bytes reserved for a resource
+	 */
+	MARSHMALLOW_CORE_EXPORT
+	void Track(Resource resource, size_t bytes);
+
+	MARSHMALLOW_CORE_EXPORT
+	void Untrack(Resource resource, size_t bytes);
+
+	MARSHMALLOW_CORE_EXPORT
+	Statistics Stats(Tag tag);
+
+	MARSHMALLOW_CORE_EXPORT
+	Statistics Stats(Resource resource);
+
+	/*!
+	 * Mark a frame boundary, latches per-frame allocation counts
+	 */
+	MARSHMALLOW_CORE_EXPORT
+	void Frame(void);
+
+	/*!
+	 * Log usage of every tag and resource
+	 */
+	MARSHMALLOW_CORE_EXPORT
+	void Dump(void);
+
+	MARSHMALLOW_CORE_EXPORT
+	const char * TagName(Tag tag);
+
+	MARSHMALLOW_CORE_EXPORT
+	const char * ResourceName(Resource resource);
+
+} /*************************************************** Core::Memory Namespace */
+} /*********************************************************** Core Namespace */
+MARSHMALLOW_NAMESPACE_END
+
+#if MARSHMALLOW_MEMORY_TRACKING
+#   define MMMEMORY_CONCAT_(a, b) a##b
+#   define MMMEMORY_CONCAT(a, b) MMMEMORY_CONCAT_(a, b)
+#   define MMMEMORY_SCOPE(tag) \
+    MARSHMALLOW_NAMESPACE::Core::Memory::Scope \
+        MMMEMORY_CONCAT(l_memory_scope_, __LINE__)(MARSHMALLOW_NAMESPACE::Core::Memory::tag)
+#   define MMMEMORY_TRACK(resource, bytes) \
+    MARSHMALLOW_NAMESPACE::Core::Memory::Track(MARSHMALLOW_NAMESPACE::Core::Memory::resource, bytes)
+#   define MMMEMORY_UNTRACK(resource, bytes) \
+    MARSHMALLOW_NAMESPACE::Core::Memory::Untrack(MARSHMALLOW_NAMESPACE::Core::Memory::resource, bytes)
+#   define MMMEMORY_FRAME() MARSHMALLOW_NAMESPACE::Core::Memory::Frame()
+#else
+#   define MMMEMORY_SCOPE(tag) MMNOOP
+#   define MMMEMORY_TRACK(resource, bytes) MMNOOP
+#   define MMMEMORY_UNTRACK(resource, bytes) MMNOOP
+#   define MMMEMORY_FRAME() MMNOOP
+#endif
+
+#endif
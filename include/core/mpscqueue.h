@@ -0,0 +1,188 @@
+/*
+ * Copyright (c) 2011-2013, Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ * All rights reserved.
+ *
+ * This file is part of Marshmallow Game Engine.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE CONTRIBUTORS ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are
+ * those of the authors and should not be interpreted as representing official
+ * policies, either expressed or implied, of the project as a whole.
+ */
+
+#pragma once
+
+/*!
+ * @file
+ *
+ * @author Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ */
+
+#ifndef MARSHMALLOW_CORE_MPSCQUEUE_H
+#define MARSHMALLOW_CORE_MPSCQUEUE_H 1
+
+#include <core/environment.h>
+#include <core/global.h>
+#include <core/namespace.h>
+
+MARSHMALLOW_NAMESPACE_BEGIN
+namespace Core { /******************************************** Core Namespace */
+
+	/*!
+	 * @brief Bounded lock-free multi-producer single-consumer queue
+	 *
+	 * A ring of cells, each carrying a sequence number that tells
+	 * producers and the consumer whose turn it is. Producers claim a cell
+	 * with a single compare-and-swap on the tail, the consumer owns the
+	 * head.
+	 *
+	 * push() takes no locks, never allocates and never waits on other
+	 * producers, so it's async-signal-safe as long as copying T is (plain
+	 * pointers and integers). A producer interrupted between claiming and
+	 * publishing its cell only delays the consumer, not other producers
+	 * or a signal handler pushing on the same thread.
+	 *
+	 * T must be default constructible and assignable, values stay in
+	 * their cell until overwritten.
+	 */
+	template <typename T>
+	class MPSCQueue
+	{
+		struct Cell
+		{
+			volatile uint32_t sequence;
+			T value;
+		};
+
+		Cell *m_cells;
+		uint32_t m_mask;
+		char m_pad0[64];
+		volatile uint32_t m_tail;
+		char m_pad1[64];
+		uint32_t m_head;
+
+		NO_ASSIGN_COPY(MPSCQueue);
+	public:
+
+		/*!
+		 * @param capacity Rounded up to a power of two
+		 */
+		explicit MPSCQueue(uint32_t capacity);
+		~MPSCQueue(void);
+
+		uint32_t capacity(void) const
+		    { return(m_mask + 1); }
+
+		/*!
+		 * Push a value, any thread (or signal handler)
+		 *
+		 * @return false if the queue is full
+		 */
+		bool push(const T &value);
+
+		/*!
+		 * Pop the oldest published value, consumer thread only
+		 *
+		 * @return false if the queue is empty
+		 */
+		bool pop(T &value);
+	};
+
+	template <typename T>
+	MPSCQueue<T>::MPSCQueue(uint32_t capacity)
+	    : m_cells(0)
+	    , m_mask(0)
+	    , m_tail(0)
+	    , m_head(0)
+	{
+		uint32_t l_size = 2;
+		while (l_size < capacity)
+			l_size <<= 1;
+
+		m_cells = new Cell[l_size];
+		m_mask = l_size - 1;
+
+		for (uint32_t l_i = 0; l_i < l_size; ++l_i)
+			m_cells[l_i].sequence = l_i;
+	}
+
+	template <typename T>
+	MPSCQueue<T>::~MPSCQueue(void)
+	{
+		delete[] m_cells, m_cells = 0;
+	}
+
+	template <typename T>
+	bool
+	MPSCQueue<T>::push(const T &value)
+	{
+		uint32_t l_pos = m_tail;
+
+		for (;;) {
+			Cell &l_cell = m_cells[l_pos & m_mask];
+			const int32_t l_diff =
+			    static_cast<int32_t>(l_cell.sequence - l_pos);
+
+			/* cell is free for this lap, try to claim it */
+			if (l_diff == 0) {
+				if (MMATOMIC_CAS(m_tail, l_pos, l_pos + 1)) {
+					l_cell.value = value;
+					MMATOMIC_FENCE();
+					l_cell.sequence = l_pos + 1;
+					return(true);
+				}
+			}
+
+			/* consumer hasn't freed the cell yet, full */
+			else if (l_diff < 0)
+				return(false);
+
+			l_pos = m_tail;
+		}
+	}
+
+	template <typename T>
+	bool
+	MPSCQueue<T>::pop(T &value)
+	{
+		Cell &l_cell = m_cells[m_head & m_mask];
+
+		/* empty, or the next producer hasn't published yet */
+		if (static_cast<int32_t>(l_cell.sequence - (m_head + 1)) < 0)
+			return(false);
+
+		MMATOMIC_FENCE();
+		value = l_cell.value;
+		MMATOMIC_FENCE();
+
+		/* free the cell for the producers' next lap */
+		l_cell.sequence = m_head + m_mask + 1;
+		++m_head;
+
+		return(true);
+	}
+
+} /*********************************************************** Core Namespace */
+MARSHMALLOW_NAMESPACE_END
+
+#endif
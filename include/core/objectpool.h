@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2011-2013, Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ * All rights reserved.
+ *
+ * This file is part of Marshmallow Game Engine.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE CONTRIBUTORS ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are
+ * those of the authors and should not be interpreted as representing official
+ * policies, either expressed or implied, of the project as a whole.
+ */
+
+#pragma once
+
+/*!
+ * @file
+ *
+ * @author Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ */
+
+#ifndef MARSHMALLOW_CORE_OBJECTPOOL_H
+#define MARSHMALLOW_CORE_OBJECTPOOL_H 1
+
+#include <core/environment.h>
+#include <core/global.h>
+#include <core/namespace.h>
+
+#include <cstddef>
+
+MARSHMALLOW_NAMESPACE_BEGIN
+namespace Core { /******************************************** Core Namespace */
+
+/*!
+ * @brief Size-class pool for small, frequently allocated objects
+ *
+ * Objects up to MaxSize bytes are carved out of SlabSize slabs, one free
+ * list per Granularity sized class. Each thread keeps a small cache per
+ * class and only touches the shared lists to exchange batches, so the
+ * common allocation is a thread-local list pop.
+ *
+ * Larger requests go straight to the heap. Slabs are never returned to
+ * the system, released objects are recycled within their class.
+ */
+namespace ObjectPool { /************************** Core::ObjectPool Namespace */
+
+	enum
+	{
+		Granularity = 16,
+		MaxSize     = 256,
+		Classes     = MaxSize / Granularity,
+		SlabSize    = 64 * 1024,
+		CacheLimit  = 64
+	};
+
+	/*! @brief Size class usage */
+	struct Statistics
+	{
+		size_t        size;        /*!< Object size in bytes */
+		size_t        slabs;       /*!< Slabs reserved */
+		unsigned long capacity;    /*!< Objects carved out of slabs */
+		unsigned long available;   /*!< Objects in the shared free list */
+		unsigned long allocations; /*!< Lifetime allocations */
+		unsigned long releases;    /*!< Lifetime releases */
+	};
+
+	/*!
+	 * @return Size class serving size bytes, Classes if too large
+	 */
+	inline int SizeClass(size_t size)
+	    { return(size > MaxSize ? Classes : size ? static_cast<int>((size - 1) / Granularity) : 0); }
+
+	MARSHMALLOW_CORE_EXPORT
+	void * Allocate(size_t size);
+
+	/*!
+	 * @param size Must match the size passed to Allocate()
+	 */
+	MARSHMALLOW_CORE_EXPORT
+	void Release(void *ptr, size_t size);
+
+	/*!
+	 * Return objects cached by the calling thread to the shared lists,
+	 * threads should flush before exiting.
+	 */
+	MARSHMALLOW_CORE_EXPORT
+	void Flush(void);
+
+	/*!
+	 * Allocation counts of other threads are only published when they
+	 * exchange a batch or flush.
+	 */
+	MARSHMALLOW_CORE_EXPORT
+	Statistics Stats(int size_class);
+
+} /*********************************************** Core::ObjectPool Namespace */
+} /*********************************************************** Core Namespace */
+MARSHMALLOW_NAMESPACE_END
+
+/*!
+ * Route a class' new and delete through Core::ObjectPool, meant for the
+ * Private structs of frequently created objects.
+ */
+#define MMPOOLED \
+    static void * operator new(size_t size) \
+        { return(MARSHMALLOW_NAMESPACE::Core::ObjectPool::Allocate(size)); } \
+    static void operator delete(void *ptr, size_t size) \
+        { MARSHMALLOW_NAMESPACE::Core::ObjectPool::Release(ptr, size); } \
+    static void * operator new(size_t, void *ptr) \
+        { return(ptr); } \
+    static void operator delete(void *, void *) \
+        {}
+
+#endif
@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2013, Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ * All rights reserved.
+ *
+ * This file is part of Marshmallow Game Engine.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE CONTRIBUTORS ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are
+ * those of the authors and should not be interpreted as representing official
+ * policies, either expressed or implied, of the project as a whole.
+ */
+
+#pragma once
+
+/*!
+ * @file
+ *
+ * @author Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ */
+
+#ifndef MARSHMALLOW_CORE_PACKIO_H
+#define MARSHMALLOW_CORE_PACKIO_H 1
+
+#include <core/mappedfileio.h>
+
+#include <core/global.h>
+
+MARSHMALLOW_NAMESPACE_BEGIN
+namespace Core { /******************************************** Core Namespace */
+
+	template <class T> class Shared;
+	template <class T> class Weak;
+
+	/*!
+	 * @brief A read-only IDataIO implementation for asset pack entries
+	 *
+	 * Asset packs are built with PackWriter (or the mmpack tool) and
+	 * mounted once, every mounted pack stays memory-mapped. Entries are
+	 * addressed as "pack://path/in/pack"; the scheme is optional when
+	 * using PackIO directly. FileIO and MappedFileIO hand pack paths
+	 * over to PackIO, so loaders can use them unchanged.
+	 *
+	 * Stored entries are read straight from the mapping, compressed
+	 * entries are inflated into memory when opened.
+	 *
+	 * Mounting and lookups are not thread-safe.
+	 */
+	class MARSHMALLOW_CORE_EXPORT
+	PackIO : public IDataIO
+	{
+		struct Private;
+		Private *m_p;
+
+		NO_ASSIGN_COPY(PackIO);
+	public:
+
+		PackIO(void);
+
+		/*!
+		 * @brief Construct and attempt to open entry
+		 * @param filename Entry path
+		 * @param mode Open mode, only DIOReadOnly is supported
+		 */
+		PackIO(const Identifier &filename, DIOMode mode = DIOReadOnly);
+		virtual ~PackIO(void);
+
+		/*!
+		 * Path of entry
+		 * @return Path of entry
+		 */
+		const Identifier & fileName(void) const;
+
+		/*!
+		 * Set path of entry
+		 */
+		void setFileName(const Identifier &filename);
+
+		/*!
+		 * Size of entry (inflated)
+		 */
+		size_t size(void) const;
+
+		/*!
+		 * Hint the expected access pattern of a range to the kernel,
+		 * only meaningful for stored entries.
+		 *
+		 * @param advice Access pattern
+		 * @param offset Offset from start of entry
+		 * @param length Range length, zero means up to end of entry
+		 * @return true if the hint was accepted
+		 */
+		bool advise(DIOAdvice advice, size_t offset = 0, size_t length = 0);
+
+	public: /* virtual */
+
+		/*!
+		 * Open entry
+		 *
+		 * Requires a valid filename
+		 *
+		 * @param mode Open mode, only DIOReadOnly is supported
+		 * @return true on success
+		 */
+		VIRTUAL bool open(DIOMode mode = DIOReadOnly);
+		VIRTUAL void close(void);
+
+		VIRTUAL DIOMode mode(void) const;
+		VIRTUAL bool isOpen(void) const;
+		VIRTUAL bool atEOF(void) const;
+
+		VIRTUAL size_t read(void *buffer, size_t bsize);
+		VIRTUAL size_t write(const void *buffer, size_t bsize);
+
+		VIRTUAL bool seek(long offset, DIOSeek origin);
+		VIRTUAL long tell(void) const;
+
+		VIRTUAL const void * view(size_t offset, size_t length) const;
+
+	public: /* static */
+
+		/*!
+		 * Map and mount an asset pack, packs mounted later take
+		 * precedence.
+		 *
+		 * @param archive Path of pack file
+		 * @return true on success
+		 */
+		static bool Mount(const Identifier &archive);
+
+		/*!
+		 * Unmount an asset pack, open entries stay valid.
+		 *
+		 * @param archive Path used to mount the pack
+		 * @return true if pack was mounted
+		 */
+		static bool Unmount(const Identifier &archive);
+
+		/*!
+		 * @return true if path uses the "pack://" scheme
+		 */
+		static bool IsPackPath(const char *path);
+
+		/*!
+		 * Plain entry paths are looked up with the Identifier hash
+		 * directly, scheme prefixed or non-normalized paths are hashed
+		 * again.
+		 *
+		 * @return true if a mounted pack contains the entry
+		 */
+		static bool Exists(const Identifier &path);
+	};
+	typedef Shared<PackIO> SharedPackIO;
+	typedef Weak<PackIO> WeakPackIO;
+
+} /*********************************************************** Core Namespace */
+MARSHMALLOW_NAMESPACE_END
+
+#endif
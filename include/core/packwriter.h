@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2013, Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ * All rights reserved.
+ *
+ * This file is part of Marshmallow Game Engine.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE CONTRIBUTORS ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are
+ * those of the authors and should not be interpreted as representing official
+ * policies, either expressed or implied, of the project as a whole.
+ */
+
+#pragma once
+
+/*!
+ * @file
+ *
+ * @author Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ */
+
+#ifndef MARSHMALLOW_CORE_PACKWRITER_H
+#define MARSHMALLOW_CORE_PACKWRITER_H 1
+
+#include <core/environment.h>
+#include <core/global.h>
+#include <core/namespace.h>
+
+#include <string>
+
+MARSHMALLOW_NAMESPACE_BEGIN
+namespace Core { /******************************************** Core Namespace */
+
+	struct IDataIO;
+
+	/*!
+	 * @brief Builds asset packs for PackIO
+	 *
+	 * Entries are kept in memory until written. Entry names are
+	 * normalized, "pack://" prefixes are dropped.
+	 */
+	class MARSHMALLOW_CORE_EXPORT
+	PackWriter
+	{
+		struct Private;
+		Private *m_p;
+
+		NO_ASSIGN_COPY(PackWriter);
+	public:
+
+		/*!
+		 * @param alignment Entry data alignment, a power of two (use the
+		 *        page size to make every entry page aligned)
+		 */
+		PackWriter(size_t alignment = 16);
+		virtual ~PackWriter(void);
+
+		/*!
+		 * Add an entry from memory
+		 *
+		 * @param name Entry path
+		 * @param data Entry data
+		 * @param size Entry size
+		 * @param compress Store zlib compressed, kept only if it saves at
+		 *        least an eighth of the size
+		 * @return true on success, duplicate names are rejected
+		 */
+		bool add(const std::string &name, const void *data, size_t size,
+		    bool compress = false);
+
+		/*!
+		 * Add an entry from a file
+		 *
+		 * @param name Entry path
+		 * @param path File path
+		 * @param compress See add()
+		 * @return true on success
+		 */
+		bool addFile(const std::string &name, const std::string &path,
+		    bool compress = false);
+
+		/*!
+		 * Number of entries added
+		 */
+		size_t count(void) const;
+
+		/*!
+		 * Write pack to an open DataIO
+		 *
+		 * @return true on success
+		 */
+		bool write(IDataIO &sink);
+
+		/*!
+		 * Write pack to a file
+		 *
+		 * @return true on success
+		 */
+		bool write(const std::string &path);
+	};
+
+} /*********************************************************** Core Namespace */
+MARSHMALLOW_NAMESPACE_END
+
+#endif
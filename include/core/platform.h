@@ -47,6 +47,7 @@
 #include <string>
 
 #define NOW MARSHMALLOW_NAMESPACE::Core::Platform::TimeStamp
+#define NOW_TICKS MARSHMALLOW_NAMESPACE::Core::Platform::Ticks
 
 MARSHMALLOW_NAMESPACE_BEGIN
 
@@ -75,6 +76,14 @@ namespace Platform { /****************************** Core::Platform Namespace */
 	MARSHMALLOW_CORE_EXPORT
 	void Sleep(MMTIME timeout);
 
+	/*!
+	 * Suspend the calling thread with tick precision
+	 *
+	 * @param timeout Timeout in ticks (nanoseconds)
+	 */
+	MARSHMALLOW_CORE_EXPORT
+	void SleepTicks(MMTICK timeout);
+
 	/*!
 	 * Returns the engine start system time
 	 */
@@ -83,10 +92,35 @@ namespace Platform { /****************************** Core::Platform Namespace */
 
 	/*!
 	 * Returns Milliseconds since engine was started (StartTime())
+	 *
+	 * Derived from Ticks(), never goes backwards.
 	 */
 	MARSHMALLOW_CORE_EXPORT
 	MMTIME TimeStamp(void);
 
+	const MMTICK TicksPerMillisecond = 1000000;
+	const MMTICK TicksPerSecond = 1000 * TicksPerMillisecond;
+
+	/*!
+	 * Returns nanoseconds since engine was started
+	 *
+	 * Backed by a monotonic clock, unaffected by system time changes.
+	 */
+	MARSHMALLOW_CORE_EXPORT
+	MMTICK Ticks(void);
+
+	inline MMTIME
+	TicksToTime(MMTICK ticks)
+	    { return(static_cast<MMTIME>(ticks / TicksPerMillisecond)); }
+
+	inline MMTICK
+	TimeToTicks(MMTIME time)
+	    { return(static_cast<MMTICK>(time) * TicksPerMillisecond); }
+
+	inline float
+	TicksToSeconds(MMTICK ticks)
+	    { return(static_cast<float>(static_cast<double>(ticks) / TicksPerSecond)); }
+
 	/*!
 	 * Reinterprets an internal timestamp into TimeData
 	 *
@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) 2011-2013, Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ * All rights reserved.
+ *
+ * This file is part of Marshmallow Game Engine.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE CONTRIBUTORS ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are
+ * those of the authors and should not be interpreted as representing official
+ * policies, either expressed or implied, of the project as a whole.
+ */
+
+#pragma once
+
+/*!
+ * @file
+ *
+ * @author Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ */
+
+#ifndef MARSHMALLOW_CORE_PROFILER_H
+#define MARSHMALLOW_CORE_PROFILER_H 1
+
+#include <core/config.h>
+#include <core/environment.h>
+#include <core/global.h>
+#include <core/namespace.h>
+
+#include <string>
+
+MARSHMALLOW_NAMESPACE_BEGIN
+namespace Core { /******************************************** Core Namespace */
+
+	struct IDataIO;
+
+/*!
+ * @brief Hot path profiler
+ *
+ * Zones are placed with MMPROFILE_SCOPE() and only record while the
+ * profiler is started. Each thread records into its own lock-free
+ * buffer, Frame() collects them once per frame into the trace and the
+ * per-frame summary.
+ *
+ * Zone names must be string literals (or otherwise outlive the
+ * profiler), only the pointer is stored.
+ */
+namespace Profiler { /****************************** Core::Profiler Namespace */
+
+	/*!
+	 * @brief Time spent in a zone during a frame, nested zones included
+	 */
+	struct ZoneSummary
+	{
+		const char *name;
+		uint32_t    calls;
+		MMTICK      total;
+	};
+
+	/*!
+	 * @brief Records its own lifetime as a zone
+	 */
+	class MARSHMALLOW_CORE_EXPORT
+	Zone
+	{
+		NO_ASSIGN_COPY(Zone);
+	public:
+
+		explicit Zone(const char *name);
+		~Zone(void);
+
+	private:
+
+		const char *m_name;
+		MMTICK      m_begin;
+		bool        m_active;
+	};
+
+	/*!
+	 * Start recording, any previous capture is discarded
+	 */
+	MARSHMALLOW_CORE_EXPORT
+	void Start(void);
+
+	/*!
+	 * Stop recording, the capture is kept for export
+	 */
+	MARSHMALLOW_CORE_EXPORT
+	void Stop(void);
+
+	MARSHMALLOW_CORE_EXPORT
+	bool Active(void);
+
+	/*!
+	 * Mark a frame boundary, collects zones recorded since the last call
+	 */
+	MARSHMALLOW_CORE_EXPORT
+	void Frame(void);
+
+	/*!
+	 * Zones recorded during the last frame, longest first
+	 *
+	 * @param zones Set to the summary, valid until the next Frame()
+	 * @return Number of zones
+	 */
+	MARSHMALLOW_CORE_EXPORT
+	size_t LastFrame(const ZoneSummary **zones);
+
+	/*!
+	 * @return Duration of the last frame in ticks
+	 */
+	MARSHMALLOW_CORE_EXPORT
+	MMTICK LastFrameTime(void);
+
+	/*!
+	 * @return Number of zones lost to full buffers
+	 */
+	MARSHMALLOW_CORE_EXPORT
+	unsigned long Dropped(void);
+
+	/*!
+	 * Write the capture as Chrome trace-event JSON (chrome://tracing,
+	 * Perfetto).
+	 */
+	MARSHMALLOW_CORE_EXPORT
+	bool WriteChromeTrace(IDataIO &output);
+
+	MARSHMALLOW_CORE_EXPORT
+	bool WriteChromeTrace(const std::string &path);
+
+} /************************************************* Core::Profiler Namespace */
+} /*********************************************************** Core Namespace */
+MARSHMALLOW_NAMESPACE_END
+
+#if MARSHMALLOW_PROFILE
+#   define MMPROFILE_CONCAT_(a, b) a##b
+#   define MMPROFILE_CONCAT(a, b) MMPROFILE_CONCAT_(a, b)
+#   define MMPROFILE_SCOPE(name) \
+    MARSHMALLOW_NAMESPACE::Core::Profiler::Zone \
+        MMPROFILE_CONCAT(l_profile_zone_, __LINE__)(name)
+#   define MMPROFILE_FRAME() MARSHMALLOW_NAMESPACE::Core::Profiler::Frame()
+#else
+#   define MMPROFILE_SCOPE(name) MMNOOP
+#   define MMPROFILE_FRAME() MMNOOP
+#endif
+
+#endif
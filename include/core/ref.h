@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2013, Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ * All rights reserved.
+ *
+ * This file is part of Marshmallow Game Engine.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE CONTRIBUTORS ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are
+ * those of the authors and should not be interpreted as representing official
+ * policies, either expressed or implied, of the project as a whole.
+ */
+
+/*!
+ * @file
+ *
+ * @author Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ */
+
+#pragma once
+
+#ifndef MARSHMALLOW_CORE_REF_H
+#define MARSHMALLOW_CORE_REF_H 1
+
+#include <core/shared.h>
+#include <core/weak.h>
+
+MARSHMALLOW_NAMESPACE_BEGIN
+namespace Core { /******************************************** Core Namespace */
+
+	/*!
+	 * @brief Borrowed Shared Pointer
+	 *
+	 * Non-owning view of a shared object, no reference counting takes
+	 * place. A borrow is only valid while a Shared reference keeps the
+	 * object alive, convert it into a Shared or Weak to hold on to it.
+	 */
+	template <class T>
+	class Ref
+	{
+		template <class X> friend class Ref;
+		SharedData *m_data;
+
+		explicit Ref(SharedData *data)
+		    : m_data(data) {}
+
+	public:
+		Ref(void)
+		    : m_data(0) {}
+		Ref(const Shared<T> &shared)
+		    : m_data(shared.m_data) {}
+
+		inline T * raw(void) const
+		    { return(m_data ? reinterpret_cast<T *>(m_data->ptr) : 0); }
+
+		template <class U>
+		inline Ref<U> cast(void) const
+		    { return(Ref<U>(m_data)); }
+
+		template <class U>
+		inline Ref<U> staticCast(void) const
+		    { MMUNUSED(static_cast<U *>(raw()));
+		      return(Ref<U>(m_data)); }
+
+	public: /* operator */
+
+		inline operator bool(void) const
+		    { return(m_data != 0 && m_data->ptr != 0); }
+
+		inline operator Shared<T>(void) const
+		    { return(Shared<T>(m_data)); }
+
+		inline operator Weak<T>(void) const
+		    { return(Weak<T>(m_data)); }
+
+		inline T & operator *(void) const
+		    { return(*reinterpret_cast<T *>(m_data->ptr)); }
+
+		inline T * operator ->(void) const
+		    { return(reinterpret_cast<T *>(m_data->ptr)); }
+
+		inline bool operator ==(const Ref &rhs) const
+		    { return(m_data == rhs.m_data); }
+
+		inline bool operator !=(const Ref &rhs) const
+		    { return(m_data != rhs.m_data); }
+	};
+
+} /*********************************************************** Core Namespace */
+MARSHMALLOW_NAMESPACE_END
+
+#endif
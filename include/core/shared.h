@@ -46,18 +46,158 @@
 #include <core/namespace.h>
 
 #include <cassert>
+#include <cstddef>
+#include <new>
+
+#if MARSHMALLOW_CXX11
+#   include <utility>
+#endif
 
 MARSHMALLOW_NAMESPACE_BEGIN
 namespace Core { /******************************************** Core Namespace */
 
 	template <class T> class Weak;
+	template <class T> class Ref;
+
+#if MARSHMALLOW_DEBUG
+#   define MMSHARED_OPERATION ++SharedData::Operations
+#else
+#   define MMSHARED_OPERATION MMNOOP
+#endif
 
+	/*!
+	 * @brief Shared/Weak control block
+	 *
+	 * Weak references hold *wrefs*, strong references collectively hold
+	 * one extra weak reference, so the block is released exactly once when
+	 * the last reference of either kind goes away.
+	 *
+	 * Blocks come from Core::ObjectPool, *size* remembers the allocation
+	 * size for the release.
+	 *
+	 * Counters are atomic when MARSHMALLOW_ATOMIC_SHARED is enabled, debug
+	 * builds also count every reference operation in *Operations* (not
+	 * atomic, meant for per-frame statistics).
+	 */
 	struct MARSHMALLOW_CORE_EXPORT
 	SharedData
 	{
-	    void *ptr;
-	    int16_t refs;
-	    int16_t wrefs;
+	    typedef void (*DisposeFunction)(SharedData *data);
+
+	    void            *ptr;
+	    DisposeFunction  dispose;
+	    int32_t          refs;
+	    int32_t          wrefs;
+	    uint32_t         size;
+
+	    inline void ref(void);
+	    inline bool lock(void);
+	    inline void unref(void);
+
+	    inline void wref(void);
+	    inline void wunref(void);
+
+	    static SharedData * Allocate(size_t size);
+	    static void Release(SharedData *data);
+
+#if MARSHMALLOW_DEBUG
+	    static uint32_t Operations;
+#endif
+	};
+
+	void
+	SharedData::ref(void)
+	{
+		MMSHARED_OPERATION;
+#if MARSHMALLOW_ATOMIC_SHARED
+		MMATOMIC_INCREMENT(refs);
+#else
+		++refs;
+#endif
+	}
+
+	bool
+	SharedData::lock(void)
+	{
+		MMSHARED_OPERATION;
+#if MARSHMALLOW_ATOMIC_SHARED
+		int32_t l_refs;
+		do {
+			if ((l_refs = refs) <= 0)
+				return(false);
+		} while (!MMATOMIC_CAS(refs, l_refs, l_refs + 1));
+		return(true);
+#else
+		if (refs <= 0)
+			return(false);
+		++refs;
+		return(true);
+#endif
+	}
+
+	void
+	SharedData::unref(void)
+	{
+		MMSHARED_OPERATION;
+#if MARSHMALLOW_ATOMIC_SHARED
+		if (MMATOMIC_DECREMENT(refs) > 0)
+			return;
+#else
+		if (--refs > 0)
+			return;
+#endif
+		dispose(this);
+		ptr = 0;
+		wunref();
+	}
+
+	void
+	SharedData::wref(void)
+	{
+		MMSHARED_OPERATION;
+#if MARSHMALLOW_ATOMIC_SHARED
+		MMATOMIC_INCREMENT(wrefs);
+#else
+		++wrefs;
+#endif
+	}
+
+	void
+	SharedData::wunref(void)
+	{
+		MMSHARED_OPERATION;
+#if MARSHMALLOW_ATOMIC_SHARED
+		if (MMATOMIC_DECREMENT(wrefs) <= 0)
+#else
+		if (--wrefs <= 0)
+#endif
+			Release(this);
+	}
+
+	/*!
+	 * @brief Control block and object in a single allocation
+	 */
+	template <class T>
+	struct SharedBlock
+	{
+		SharedData data;
+		union {
+			char   storage[sizeof(T)];
+			long double align_ld;
+			int64_t     align_ll;
+			void       *align_p;
+		} object;
+
+		static SharedData * Allocate(void)
+		    { SharedData *l_data = SharedData::Allocate(sizeof(SharedBlock));
+		      l_data->ptr     = reinterpret_cast<SharedBlock *>(l_data)->object.storage;
+		      l_data->dispose = &SharedBlock::Dispose;
+		      l_data->refs    = 0;
+		      l_data->wrefs   = 1;
+		      return(l_data); }
+
+		static void Dispose(SharedData *data)
+		    { reinterpret_cast<T *>(data->ptr)->~T(); }
 	};
 
 	/*!
@@ -67,15 +207,23 @@ namespace Core { /******************************************** Core Namespace */
 	class Shared
 	{
 		template <class X> friend class Weak;
+		template <class X> friend class Ref;
 		SharedData *m_data;
 
+		static void Dispose(SharedData *data)
+		    { delete reinterpret_cast<T *>(data->ptr); }
+
 	public:
 		Shared(void)
 		    : m_data(0) {}
 		Shared(T *ptr);
 		Shared(SharedData *data)
-		    : m_data(data) { if (m_data) ++m_data->refs;}
+		    : m_data(data) { if (m_data) m_data->ref(); }
 		Shared(const Shared &copy);
+#if MARSHMALLOW_CXX11
+		Shared(Shared &&other)
+		    : m_data(other.m_data) { other.m_data = 0; }
+#endif
 		~Shared(void)
 		    { clear(); }
 
@@ -105,6 +253,9 @@ namespace Core { /******************************************** Core Namespace */
 		    { return(reinterpret_cast<T *>(m_data->ptr)); }
 
 		inline Shared & operator =(const Shared &rhs);
+#if MARSHMALLOW_CXX11
+		inline Shared & operator =(Shared &&rhs);
+#endif
 
 		inline bool operator ==(const Shared &rhs) const
 		    { return(this == &rhs || m_data == rhs.m_data); }
@@ -115,19 +266,20 @@ namespace Core { /******************************************** Core Namespace */
 
 	template <class T>
 	Shared<T>::Shared(T *ptr)
-	    : m_data(new SharedData)
+	    : m_data(SharedData::Allocate(sizeof(SharedData)))
 	{
 		assert(ptr);
-		m_data->ptr  = ptr;
-		m_data->refs = 1;
-		m_data->wrefs = 0;
+		m_data->ptr     = ptr;
+		m_data->dispose = &Shared::Dispose;
+		m_data->refs    = 1;
+		m_data->wrefs   = 1;
 	}
 
 	template <class T>
 	Shared<T>::Shared(const Shared &copy)
 	    : m_data(copy.m_data)
 	{
-		if (copy) ++m_data->refs;
+		if (m_data) m_data->ref();
 	}
 
 	template <class T>
@@ -149,33 +301,138 @@ namespace Core { /******************************************** Core Namespace */
 	Shared<T> &
 	Shared<T>::operator =(const Shared<T> &rhs)
 	{
-		if (*this == rhs)
+		if (m_data == rhs.m_data)
 			return(*this);
 
-		clear();
+		SharedData *l_data = m_data;
 
 		if ((m_data = rhs.m_data))
-			++m_data->refs;
+			m_data->ref();
+
+		if (l_data)
+			l_data->unref();
+
+		return(*this);
+	}
+
+#if MARSHMALLOW_CXX11
+	template <class T>
+	Shared<T> &
+	Shared<T>::operator =(Shared<T> &&rhs)
+	{
+		if (this == &rhs)
+			return(*this);
+
+		SharedData *l_data = m_data;
+		m_data = rhs.m_data;
+		rhs.m_data = 0;
+
+		if (l_data)
+			l_data->unref();
 
 		return(*this);
 	}
+#endif
 
 	template <class T>
 	void
 	Shared<T>::clear(void)
 	{
-		if (m_data && --m_data->refs <= 0) {
-			T *ptr = reinterpret_cast<T *>(m_data->ptr);
-			delete ptr;
-
-			if (m_data->wrefs <= 0)
-				delete m_data;
-			else
-				m_data->ptr = 0;
-                }
+		SharedData *l_data = m_data;
 		m_data = 0;
+
+		if (l_data)
+			l_data->unref();
+	}
+
+	/*!
+	 * @brief Construct a shared object
+	 *
+	 * Object and control block share a single allocation, the memory is
+	 * returned once both Shared and Weak references are gone.
+	 */
+#if MARSHMALLOW_CXX11
+	template <class T, class... Args>
+	inline Shared<T>
+	MakeShared(Args &&... args)
+	{
+		SharedData *l_data = SharedBlock<T>::Allocate();
+		new (l_data->ptr) T(std::forward<Args>(args)...);
+		return(Shared<T>(l_data));
+	}
+#else
+	/*
+	 * NOTE: Arguments are forwarded as const references, objects that need
+	 * a non-const reference must be built with Shared(new T(...)).
+	 */
+
+	template <class T>
+	inline Shared<T>
+	MakeShared(void)
+	{
+		SharedData *l_data = SharedBlock<T>::Allocate();
+		new (l_data->ptr) T();
+		return(Shared<T>(l_data));
+	}
+
+	template <class T, class A1>
+	inline Shared<T>
+	MakeShared(const A1 &a1)
+	{
+		SharedData *l_data = SharedBlock<T>::Allocate();
+		new (l_data->ptr) T(a1);
+		return(Shared<T>(l_data));
+	}
+
+	template <class T, class A1, class A2>
+	inline Shared<T>
+	MakeShared(const A1 &a1, const A2 &a2)
+	{
+		SharedData *l_data = SharedBlock<T>::Allocate();
+		new (l_data->ptr) T(a1, a2);
+		return(Shared<T>(l_data));
+	}
+
+	template <class T, class A1, class A2, class A3>
+	inline Shared<T>
+	MakeShared(const A1 &a1, const A2 &a2, const A3 &a3)
+	{
+		SharedData *l_data = SharedBlock<T>::Allocate();
+		new (l_data->ptr) T(a1, a2, a3);
+		return(Shared<T>(l_data));
+	}
+
+	template <class T, class A1, class A2, class A3, class A4>
+	inline Shared<T>
+	MakeShared(const A1 &a1, const A2 &a2, const A3 &a3, const A4 &a4)
+	{
+		SharedData *l_data = SharedBlock<T>::Allocate();
+		new (l_data->ptr) T(a1, a2, a3, a4);
+		return(Shared<T>(l_data));
 	}
 
+	template <class T, class A1, class A2, class A3, class A4, class A5>
+	inline Shared<T>
+	MakeShared(const A1 &a1, const A2 &a2, const A3 &a3, const A4 &a4,
+	           const A5 &a5)
+	{
+		SharedData *l_data = SharedBlock<T>::Allocate();
+		new (l_data->ptr) T(a1, a2, a3, a4, a5);
+		return(Shared<T>(l_data));
+	}
+
+	template <class T, class A1, class A2, class A3, class A4, class A5,
+	          class A6>
+	inline Shared<T>
+	MakeShared(const A1 &a1, const A2 &a2, const A3 &a3, const A4 &a4,
+	           const A5 &a5, const A6 &a6)
+	{
+		SharedData *l_data = SharedBlock<T>::Allocate();
+		new (l_data->ptr) T(a1, a2, a3, a4, a5, a6);
+		return(Shared<T>(l_data));
+	}
+#endif
+
 } /*********************************************************** Core Namespace */
 MARSHMALLOW_NAMESPACE_END
 
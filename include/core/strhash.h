@@ -50,12 +50,17 @@ namespace Core { /******************************************** Core Namespace */
 
 	/*!
 	 * An extended Core:Hash that uses a string as the buffer to hash.
+	 *
+	 * Strings are interned, identical strings share a single immutable
+	 * record for the lifetime of the process so copies are cheap.
 	 */
 	class MARSHMALLOW_CORE_EXPORT
 	StrHash : public Hash
 	{
 		struct Private;
-		Private *m_p;
+		const Private *m_p;
+
+		static const Private * Intern(const char *str, size_t length, MMUID hash);
 
 	public:
 
@@ -70,7 +75,16 @@ namespace Core { /******************************************** Core Namespace */
 		 * @param str String used for hash
 		 */
 		StrHash(const std::string &str);
-		StrHash(const StrHash &copy);
+
+		/*!
+		 * @param str String used for hash
+		 * @param hash Precomputed hash of *str*, see MMHASH()
+		 */
+		StrHash(const char *str, MMUID hash);
+
+		StrHash(const StrHash &copy)
+		    : Hash(copy)
+		    , m_p(copy.m_p) {}
 		virtual ~StrHash(void);
 
 		/*!
@@ -90,7 +104,10 @@ namespace Core { /******************************************** Core Namespace */
 
 		operator const char * (void) const;
 
-		StrHash & operator=(const StrHash &rhs);
+		StrHash & operator=(const StrHash &rhs)
+		    { Hash::operator=(rhs);
+		      m_p = rhs.m_p;
+		      return(*this); }
 
 	public:
 		static const StrHash Null;
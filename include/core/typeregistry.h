@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2013, Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ * All rights reserved.
+ *
+ * This file is part of Marshmallow Game Engine.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE CONTRIBUTORS ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are
+ * those of the authors and should not be interpreted as representing official
+ * policies, either expressed or implied, of the project as a whole.
+ */
+
+/*!
+ * @file
+ *
+ * @author Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ */
+
+#pragma once
+
+#ifndef MARSHMALLOW_CORE_TYPEREGISTRY_H
+#define MARSHMALLOW_CORE_TYPEREGISTRY_H 1
+
+#include <core/environment.h>
+#include <core/global.h>
+#include <core/namespace.h>
+
+#include <core/type.h>
+
+MARSHMALLOW_NAMESPACE_BEGIN
+
+namespace Core { /******************************************** Core Namespace */
+namespace TypeRegistry { /********************** Core::TypeRegistry Namespace */
+	/*!<
+	 * @brief Dense type indices
+	 *
+	 * Every registered type gets a small index (0, 1, 2, ...) so per-type
+	 * tables can be flat arrays instead of maps keyed by hash.
+	 */
+
+	enum { InvalidIndex = -1 };
+
+	/*!
+	 * Register a type, registering a type twice yields the same index.
+	 *
+	 * Returns InvalidIndex if the hash of *type* collides with a
+	 * different registered type.
+	 */
+	MARSHMALLOW_CORE_EXPORT
+	int Register(const Type &type);
+
+	/*!
+	 * Returns the index of a registered type or InvalidIndex.
+	 */
+	MARSHMALLOW_CORE_EXPORT
+	int Index(const Type &type);
+
+	/*!
+	 * Returns the type registered at *index*, Type::Null if invalid.
+	 */
+	MARSHMALLOW_CORE_EXPORT
+	Type TypeAt(int index);
+
+	/*!
+	 * Returns the number of registered types.
+	 */
+	MARSHMALLOW_CORE_EXPORT
+	int Count(void);
+
+} /******************************************** Core::TypeRegistry Namespace */
+
+	/*!
+	 * @brief Type index holder
+	 *
+	 * Instantiating TypeIndex<T>() registers *T::Type()* during static
+	 * initialization, first use before that registers it on demand.
+	 */
+	template <class T>
+	struct TypeIndexRegistrar
+	{
+		static int Index(void)
+		    { static const int s_index = TypeRegistry::Register(T::Type());
+		      return(s_index); }
+
+		static const int Static;
+	};
+
+	template <class T>
+	const int TypeIndexRegistrar<T>::Static = TypeIndexRegistrar<T>::Index();
+
+	/*!
+	 * @brief Dense index of *T::Type()*
+	 */
+	template <class T>
+	inline int
+	TypeIndex(void)
+	{
+		MMUNUSED(&TypeIndexRegistrar<T>::Static);
+		return(TypeIndexRegistrar<T>::Index());
+	}
+
+} /*********************************************************** Core Namespace */
+MARSHMALLOW_NAMESPACE_END
+
+#endif
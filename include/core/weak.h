@@ -63,8 +63,12 @@ namespace Core { /******************************************** Core Namespace */
 		Weak(void)
 		    : m_data(0) {};
 		Weak(SharedData *data)
-		    : m_data(data) { if (m_data) ++m_data->wrefs; }
+		    : m_data(data) { if (m_data) m_data->wref(); }
 		Weak(const Weak &copy);
+#if MARSHMALLOW_CXX11
+		Weak(Weak &&other)
+		    : m_data(other.m_data) { other.m_data = 0; }
+#endif
 		~Weak(void)
 		    { clear(); }
 
@@ -85,9 +89,7 @@ namespace Core { /******************************************** Core Namespace */
 		inline operator bool(void) const
 		    { return(m_data && m_data->ptr); }
 
-		inline operator Shared<T>(void) const
-		    { assert(m_data && m_data->ptr);
-		      return(Shared<T>(m_data)); }
+		inline operator Shared<T>(void) const;
 
 		inline T & operator *(void) const
 		    { assert(m_data && m_data->ptr);
@@ -98,6 +100,9 @@ namespace Core { /******************************************** Core Namespace */
 		      return(reinterpret_cast<T *>(m_data->ptr)); }
 
 		inline Weak & operator =(const Weak &rhs);
+#if MARSHMALLOW_CXX11
+		inline Weak & operator =(Weak &&rhs);
+#endif
 
 		inline bool operator ==(const Weak &rhs) const
 		    { return(this == &rhs || m_data == rhs.m_data); }
@@ -110,7 +115,16 @@ namespace Core { /******************************************** Core Namespace */
 	Weak<T>::Weak(const Weak &copy)
 	    : m_data(copy.m_data)
 	{
-		if (m_data) ++m_data->wrefs;
+		if (m_data) m_data->wref();
+	}
+
+	template <class T>
+	Weak<T>::operator Shared<T>(void) const
+	{
+		Shared<T> l_shared;
+		if (m_data && m_data->lock())
+			l_shared.m_data = m_data;
+		return(l_shared);
 	}
 
 	template <class T>
@@ -132,24 +146,48 @@ namespace Core { /******************************************** Core Namespace */
 	Weak<T> &
 	Weak<T>::operator =(const Weak<T> &rhs)
 	{
-		if (*this == rhs)
+		if (m_data == rhs.m_data)
 			return(*this);
 
-		clear();
+		SharedData *l_data = m_data;
 
 		if ((m_data = rhs.m_data))
-			++m_data->wrefs;
+			m_data->wref();
+
+		if (l_data)
+			l_data->wunref();
+
+		return(*this);
+	}
+
+#if MARSHMALLOW_CXX11
+	template <class T>
+	Weak<T> &
+	Weak<T>::operator =(Weak<T> &&rhs)
+	{
+		if (this == &rhs)
+			return(*this);
+
+		SharedData *l_data = m_data;
+		m_data = rhs.m_data;
+		rhs.m_data = 0;
+
+		if (l_data)
+			l_data->wunref();
 
 		return(*this);
 	}
+#endif
 
 	template <class T>
 	void
 	Weak<T>::clear(void)
 	{
-		if (m_data && --m_data->wrefs <= 0 && m_data->ptr == 0)
-			delete m_data;
+		SharedData *l_data = m_data;
 		m_data = 0;
+
+		if (l_data)
+			l_data->wunref();
 	}
 
 } /*********************************************************** Core Namespace */
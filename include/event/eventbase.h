@@ -70,22 +70,40 @@ namespace Event { /****************************************** Event Namespace */
 		NO_ASSIGN_COPY(EventBase);
 	public:
 
+		/*! @brief Frame transient tag
+		 *
+		 *  Selects the frame transient constructor of events that
+		 *  provide one. Transient events are meant for stack dispatch
+		 *  only, they must never be queued or kept alive past the frame
+		 *  that created them.
+		 */
+		struct FrameTransient {};
+
 		/*! @brief Event constructor
 		 *
 		 *  @param timestamp Event engine will process this message at
-		 *                   timestamp, use 0 for NOW.
+		 *                   timestamp (ticks), use 0 for NOW_TICKS.
 		 *
 		 *  @param priority  Use a higher value to get higher priority.
 		 */
 
-		EventBase(MMTIME timestamp = 0, uint8_t priority = 0);
+		EventBase(MMTICK timestamp = 0, uint8_t priority = 0);
 		virtual ~EventBase(void);
 
+	protected:
+
+		/*! @brief Frame transient event constructor
+		 *
+		 *  Private data is carved out of the Core::FrameArena, the event
+		 *  must be dispatched and destroyed before the next frame.
+		 */
+		EventBase(MMTICK timestamp, uint8_t priority, const FrameTransient &);
+
 	public: /* virtual */
 
 		VIRTUAL uint8_t priority(void) const;
 
-		VIRTUAL MMTIME timeStamp(void) const;
+		VIRTUAL MMTICK timeStamp(void) const;
 	};
 
 } /********************************************************** Event Namespace */
@@ -44,6 +44,7 @@
 #include <core/environment.h>
 #include <core/fd.h>
 #include <core/global.h>
+#include <core/shared.h>
 
 MARSHMALLOW_NAMESPACE_BEGIN
 namespace Event { /****************************************** Event Namespace */
@@ -51,10 +52,35 @@ namespace Event { /****************************************** Event Namespace */
 	struct IEventListener;
 	typedef Core::Weak<IEventListener> WeakEventListener;
 
+	struct IBatchEventListener;
+	struct IEventTap;
+
 	struct IEvent;
 	typedef Core::Shared<IEvent> SharedEvent;
 
-	/*! @brief Event Manager */
+	/*! @brief Queued event handle, zero is never a valid handle */
+	typedef uint64_t EventHandle;
+
+	/*! @brief Coalescing key, events with equal keys replace each other */
+	typedef uint64_t (*CoalesceFunction)(const IEvent &event);
+
+	/*! @brief Event Manager
+	 *
+	 * Queued events wait in a timer heap ordered by (timestamp, sequence)
+	 * until due, execute() then dispatches all due events by priority,
+	 * timestamp and queue order. Events queued during execute() are only
+	 * considered on the next call.
+	 *
+	 * Only post() may be called from threads other than the one running
+	 * execute().
+	 *
+	 * Event types with batch listeners or a coalescing rule are batched:
+	 * execute() gathers all due events of the type and delivers them
+	 * together where the first one would have been dispatched.
+	 * Listeners are called in connection order, batch listeners once
+	 * with the whole batch, plain listeners once per event not yet
+	 * handled.
+	 */
 	class MARSHMALLOW_EVENT_EXPORT
 	EventManager
 	{
@@ -71,14 +97,142 @@ namespace Event { /****************************************** Event Namespace */
 
 		virtual const Core::Identifier & id(void) const;
 
+		/*! @brief Connect a listener, safe from inside handleEvent()
+		 *
+		 *  Listeners connected while an event of the same type is being
+		 *  dispatched are called starting with the next event.
+		 */
 		virtual bool connect(IEventListener *handler, const Core::Type &type);
+
+		/*! @brief Connect a batch listener
+		 *
+		 *  Queued events of *type* are batched from now on, see
+		 *  IBatchEventListener.
+		 */
+		virtual bool connect(IBatchEventListener *handler, const Core::Type &type);
+
+		/*! @brief Disconnect a listener, safe from inside handleEvent()
+		 *
+		 *  A listener disconnected during a dispatch is not called for the
+		 *  rest of it, the listener table is compacted afterwards.
+		 */
 		virtual bool disconnect(IEventListener *handler, const Core::Type &type);
 
+		/*! @brief Dequeue an event, or all events of its type
+		 *
+		 *  Linear in the number of queued events, prefer cancel().
+		 */
 		virtual bool dequeue(const SharedEvent &event, bool all = false);
+
+		/*! @return true if *event* was queued */
 		virtual bool queue(const SharedEvent &event);
 
+		/*! @brief Queue an event, see queue()
+		 *
+		 *  @return Handle for cancel(), zero on failure
+		 */
+		virtual EventHandle queueHandle(const SharedEvent &event);
+
+		/*! @brief Construct and queue an event of type T
+		 *
+		 *  The event and its reference count share a single allocation
+		 *  from Core::ObjectPool, it's recycled once dispatched.
+		 *
+		 *  @return Handle for cancel(), zero on failure
+		 *
+		 *  @code
+		 *  manager->queue<JoystickAxisEvent>(axis, value, min, max, id());
+		 *  @endcode
+		 */
+#if MARSHMALLOW_CXX11
+		template <class T, class... Args>
+		EventHandle queue(Args &&... args)
+		    { return(queueHandle(Core::MakeShared<T>(std::forward<Args>(args)...)
+		                             .template staticCast<IEvent>())); }
+#else
+		template <class T>
+		EventHandle queue(void)
+		    { return(queueHandle(Core::MakeShared<T>()
+		                             .template staticCast<IEvent>())); }
+
+		template <class T, class A1>
+		EventHandle queue(const A1 &a1)
+		    { return(queueHandle(Core::MakeShared<T>(a1)
+		                             .template staticCast<IEvent>())); }
+
+		template <class T, class A1, class A2>
+		EventHandle queue(const A1 &a1, const A2 &a2)
+		    { return(queueHandle(Core::MakeShared<T>(a1, a2)
+		                             .template staticCast<IEvent>())); }
+
+		template <class T, class A1, class A2, class A3>
+		EventHandle queue(const A1 &a1, const A2 &a2, const A3 &a3)
+		    { return(queueHandle(Core::MakeShared<T>(a1, a2, a3)
+		                             .template staticCast<IEvent>())); }
+
+		template <class T, class A1, class A2, class A3, class A4>
+		EventHandle queue(const A1 &a1, const A2 &a2, const A3 &a3,
+		                  const A4 &a4)
+		    { return(queueHandle(Core::MakeShared<T>(a1, a2, a3, a4)
+		                             .template staticCast<IEvent>())); }
+
+		template <class T, class A1, class A2, class A3, class A4, class A5>
+		EventHandle queue(const A1 &a1, const A2 &a2, const A3 &a3,
+		                  const A4 &a4, const A5 &a5)
+		    { return(queueHandle(Core::MakeShared<T>(a1, a2, a3, a4, a5)
+		                             .template staticCast<IEvent>())); }
+#endif
+
+		/*! @brief Queue an event from any thread or a signal handler
+		 *
+		 *  Lock-free, never allocates. The manager takes ownership of
+		 *  *event*, it's queued at the start of the next execute().
+		 *
+		 *  @return false if the post queue is full, *event* remains
+		 *          owned by the caller
+		 */
+		virtual bool post(IEvent *event);
+
+		/*! @brief Cancel a queued event, constant time
+		 *
+		 *  @return false if already dispatched or cancelled
+		 */
+		virtual bool cancel(EventHandle handle);
+
+		/*! @brief Dispatch an event to its listeners right away
+		 *
+		 *  Listeners are called in connection order until one handles the
+		 *  event, no memory is allocated.
+		 *
+		 *  @return true if a listener handled the event
+		 */
 		virtual bool dispatch(const IEvent &event);
 
+		/*! @brief Coalesce queued events of a type
+		 *
+		 *  Of all events of *type* due in one execute() only the latest
+		 *  one for each key is delivered, cost is linear in the number
+		 *  of distinct keys. Directly dispatched events aren't affected.
+		 *
+		 *  @param key Key function, zero disables coalescing
+		 */
+		virtual void setCoalescing(const Core::Type &type, CoalesceFunction key);
+
+		/*! @brief Observe events entering from outside execute()
+		 *
+		 *  The tap sees queued, posted (when drained) and directly
+		 *  dispatched events. Events queued or dispatched by listeners
+		 *  while execute() delivers are derived and skipped.
+		 *
+		 *  @param tap Tap, zero to remove, not owned
+		 */
+		virtual void setTap(IEventTap *tap);
+
+		/*! @brief Dispatch due events
+		 *
+		 *  @return true if no queued events are left waiting for a later
+		 *          timestamp
+		 */
 		virtual bool execute(void);
 
 	public: /* static */
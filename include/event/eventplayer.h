@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2011-2013, Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ * All rights reserved.
+ *
+ * This file is part of Marshmallow Game Engine.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE CONTRIBUTORS ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are
+ * those of the authors and should not be interpreted as representing official
+ * policies, either expressed or implied, of the project as a whole.
+ */
+
+#pragma once
+
+/*!
+ * @file
+ *
+ * @author Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ */
+
+#ifndef MARSHMALLOW_EVENT_EVENTPLAYER_H
+#define MARSHMALLOW_EVENT_EVENTPLAYER_H 1
+
+#include <core/environment.h>
+#include <core/fd.h>
+#include <core/global.h>
+
+MARSHMALLOW_NAMESPACE_BEGIN
+namespace Core { /******************************************** Core Namespace */
+	struct IDataIO;
+} /*********************************************************** Core Namespace */
+
+namespace Event { /****************************************** Event Namespace */
+
+	class EventManager;
+
+	/*! @brief Plays back an EventRecorder log
+	 *
+	 * The whole log is loaded up front. Events are fed frame by frame,
+	 * queued events are queued again (due now, or after their recorded
+	 * delay) and dispatched events are dispatched right away.
+	 */
+	class MARSHMALLOW_EVENT_EXPORT
+	EventPlayer
+	{
+		struct Private;
+		Private *m_p;
+
+		NO_ASSIGN_COPY(EventPlayer);
+	public:
+
+		/*!
+		 * @param source Open device, read to the end
+		 */
+		EventPlayer(Core::IDataIO &source);
+		virtual ~EventPlayer(void);
+
+		/*!
+		 * @return false if the log is missing, corrupt or from an
+		 *         unknown version
+		 */
+		bool isValid(void) const;
+
+		/*!
+		 * @return Frame rate the log was recorded at
+		 */
+		int fps(void) const;
+
+		/*!
+		 * @return Number of frames the recorded session ran for
+		 */
+		uint32_t frames(void) const;
+
+		/*!
+		 * @return Number of events in the log
+		 */
+		size_t events(void) const;
+
+		/*!
+		 * @return true once every event has been played
+		 */
+		bool atEnd(void) const;
+
+		/*!
+		 * Feed all events recorded up to and including frame
+		 *
+		 * @return Number of events fed
+		 */
+		size_t play(EventManager &manager, uint32_t frame);
+
+		/*!
+		 * Start over from the first event
+		 */
+		void rewind(void);
+	};
+
+} /********************************************************** Event Namespace */
+MARSHMALLOW_NAMESPACE_END
+
+#endif
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2011-2013, Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ * All rights reserved.
+ *
+ * This file is part of Marshmallow Game Engine.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE CONTRIBUTORS ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are
+ * those of the authors and should not be interpreted as representing official
+ * policies, either expressed or implied, of the project as a whole.
+ */
+
+#pragma once
+
+/*!
+ * @file
+ *
+ * @author Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ */
+
+#ifndef MARSHMALLOW_EVENT_EVENTRECORDER_H
+#define MARSHMALLOW_EVENT_EVENTRECORDER_H 1
+
+#include <core/environment.h>
+#include <core/fd.h>
+#include <core/global.h>
+
+#include <event/ieventtap.h>
+
+MARSHMALLOW_NAMESPACE_BEGIN
+namespace Core { /******************************************** Core Namespace */
+	struct IDataIO;
+} /*********************************************************** Core Namespace */
+
+namespace Event { /****************************************** Event Namespace */
+
+	/*! @brief Records events to a binary log
+	 *
+	 * Attach with EventManager::setTap(), keyboard, joystick, touch,
+	 * sensor, quit and viewport events are written as they enter the
+	 * manager, tagged with the current frame. Other event types are
+	 * ignored. See EventPlayer.
+	 */
+	class MARSHMALLOW_EVENT_EXPORT
+	EventRecorder : public IEventTap
+	{
+		struct Private;
+		Private *m_p;
+
+		NO_ASSIGN_COPY(EventRecorder);
+	public:
+
+		/*!
+		 * The log is terminated with the final frame when the
+		 * recorder is destroyed.
+		 *
+		 * @param sink Open device, must outlive the recorder
+		 * @param fps Frame rate stored in the log header
+		 */
+		EventRecorder(Core::IDataIO &sink, int fps);
+		virtual ~EventRecorder(void);
+
+		/*!
+		 * @return false if a write to the sink failed
+		 */
+		bool isValid(void) const;
+
+		/*!
+		 * Frame subsequent events belong to, must not decrease
+		 */
+		void setFrame(uint32_t frame);
+
+		uint32_t frame(void) const;
+
+		/*!
+		 * @return Number of events recorded
+		 */
+		size_t recorded(void) const;
+
+	public: /* virtual */
+
+		VIRTUAL void tap(const IEvent &event, Origin origin);
+	};
+
+} /********************************************************** Event Namespace */
+MARSHMALLOW_NAMESPACE_END
+
+#endif
@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2011-2013, Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ * All rights reserved.
+ *
+ * This file is part of Marshmallow Game Engine.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE CONTRIBUTORS ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are
+ * those of the authors and should not be interpreted as representing official
+ * policies, either expressed or implied, of the project as a whole.
+ */
+
+#pragma once
+
+/*!
+ * @file
+ *
+ * @author Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ */
+
+#ifndef MARSHMALLOW_EVENT_IBATCHEVENTLISTENER_H
+#define MARSHMALLOW_EVENT_IBATCHEVENTLISTENER_H 1
+
+#include <event/ieventlistener.h>
+
+MARSHMALLOW_NAMESPACE_BEGIN
+namespace Event { /****************************************** Event Namespace */
+
+	/*! @brief Batch Event Listener Interface
+	 *
+	 * Connected through EventManager::connect(IBatchEventListener *, ...),
+	 * receives all events of a type due in one EventManager::execute() in
+	 * a single call. Events dispatched directly still arrive through
+	 * handleEvent().
+	 */
+	struct MARSHMALLOW_EVENT_EXPORT
+	IBatchEventListener : public IEventListener
+	{
+		virtual ~IBatchEventListener(void);
+
+		/*!
+		 * @brief Batch Event Handler
+		 * @param type Type of all events in the batch
+		 * @param events Events in dispatch order, valid during the call
+		 * @param count Number of events
+		 * @return true if the whole batch was handled, stops delivery
+		 *         to later listeners
+		 */
+		virtual bool handleEvents(const Core::Type &type,
+		                          const IEvent *const *events,
+		                          size_t count) = 0;
+	};
+
+} /********************************************************** Event Namespace */
+MARSHMALLOW_NAMESPACE_END
+
+#endif
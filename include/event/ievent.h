@@ -65,8 +65,10 @@ namespace Event { /****************************************** Event Namespace */
 
 		/*!
 		 * @brief Event TimeStamp
+		 *
+		 * Engine ticks (nanoseconds), see Core::Platform::Ticks()
 		 */
-		virtual MMTIME timeStamp(void) const = 0;
+		virtual MMTICK timeStamp(void) const = 0;
 	};
 	typedef Core::Shared<IEvent> SharedEvent;
 	typedef Core::Weak<IEvent> WeakEvent;
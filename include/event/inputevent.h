@@ -70,7 +70,7 @@ namespace Event { /****************************************** Event Namespace */
 	public:
 
 		InputEvent(InputType type, int code, int value,
-		           size_t source, MMTIME timestamp = 0);
+		           size_t source, MMTICK timestamp = 0);
 		virtual ~InputEvent(void);
 
 		InputType inputType(void) const;
@@ -63,7 +63,7 @@ namespace Event { /****************************************** Event Namespace */
 		                  int minimum,
 		                  int maximum,
 		                  size_t source,
-		                  MMTIME timestamp = 0);
+		                  MMTICK timestamp = 0);
 		virtual ~JoystickAxisEvent(void);
 
 		Input::Joystick::Axis axis(void) const
@@ -81,6 +81,14 @@ namespace Event { /****************************************** Event Namespace */
 	public: /* static */
 
 		static const Core::Type & Type(void);
+
+		/*!
+		 * @brief Coalescing key (source and axis)
+		 *
+		 * For EventManager::setCoalescing(), keeps the latest value per
+		 * device and axis.
+		 */
+		static uint64_t CoalesceKey(const IEvent &event);
 	};
 
 } /********************************************************** Event Namespace */
@@ -62,7 +62,7 @@ namespace Event { /****************************************** Event Namespace */
 		              Input::Joystick::Action action,
 		              int state,
 		              size_t source,
-		              MMTIME timestamp = 0);
+		              MMTICK timestamp = 0);
 		virtual ~JoystickButtonEvent(void);
 
 		Input::Joystick::Action action(void) const
@@ -58,7 +58,7 @@ namespace Event { /****************************************** Event Namespace */
 		KeyboardEvent(Input::Keyboard::Key key,
 		              Input::Keyboard::Action action,
 		              size_t source,
-		              MMTIME timestamp = 0);
+		              MMTICK timestamp = 0);
 		virtual ~KeyboardEvent(void);
 
 		Input::Keyboard::Action action(void) const
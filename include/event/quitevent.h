@@ -56,7 +56,7 @@ namespace Event { /****************************************** Event Namespace */
 		NO_ASSIGN_COPY(QuitEvent);
 	public:
 
-		QuitEvent(int code = 0, MMTIME timestamp = 0);
+		QuitEvent(int code = 0, MMTICK timestamp = 0);
 		virtual ~QuitEvent(void);
 
 		int code(void) const;
@@ -54,6 +54,15 @@ namespace Event { /****************************************** Event Namespace */
 	public:
 
 		RenderEvent(void);
+
+		/*! @brief Frame transient constructor
+		 *
+		 *  Private data is carved out of the Core::FrameArena, used by
+		 *  the engine for its stack dispatched render event. The event
+		 *  must never be queued, it has to be destroyed before the next
+		 *  frame.
+		 */
+		RenderEvent(const FrameTransient &);
 		virtual ~RenderEvent(void);
 
 	public: /* virtual */
@@ -61,7 +61,7 @@ namespace Event { /****************************************** Event Namespace */
 		SensorEvent(Input::Sensor::Type type,
 		           float x, float y, float z,
                            size_t source,
-		           MMTIME timestamp = 0);
+		           MMTICK timestamp = 0);
 		virtual ~SensorEvent(void);
 
 		Input::Sensor::Type sensor(void) const
@@ -79,6 +79,14 @@ namespace Event { /****************************************** Event Namespace */
 	public: /* static */
 
 		static const Core::Type & Type(void);
+
+		/*!
+		 * @brief Coalescing key (source and sensor)
+		 *
+		 * For EventManager::setCoalescing(), keeps the latest value per
+		 * device and sensor.
+		 */
+		static uint64_t CoalesceKey(const IEvent &event);
 	};
 
 } /********************************************************** Event Namespace */
@@ -61,7 +61,7 @@ namespace Event { /****************************************** Event Namespace */
 		TouchEvent(Input::Touch::Action action,
 		           int x, int y,
                            size_t source,
-		           MMTIME timestamp = 0);
+		           MMTICK timestamp = 0);
 		virtual ~TouchEvent(void);
 
 		Input::Touch::Action action(void) const
@@ -57,6 +57,15 @@ namespace Event { /****************************************** Event Namespace */
 	public:
 
 		UpdateEvent(float delta);
+
+		/*! @brief Frame transient constructor
+		 *
+		 *  Private data is carved out of the Core::FrameArena, used by
+		 *  the engine for its stack dispatched update event. The event
+		 *  must never be queued, it has to be destroyed before the next
+		 *  frame.
+		 */
+		UpdateEvent(float delta, const FrameTransient &);
 		virtual ~UpdateEvent(void);
 
 		float delta(void) const;
@@ -44,18 +44,12 @@
 #include <core/global.h>
 
 #include <game/config.h>
+#include <game/framepacer.h>
+#include <game/framestats.h>
 #include <game/iengine.h>
 
 MARSHMALLOW_NAMESPACE_BEGIN
 
-/*
- * Sleep Intervals
- */
-#define MMSLEEP_DISABLED  0
-#define MMSLEEP_INSOMNIAC 2
-#define MMSLEEP_LITESLEEP 4
-#define MMSLEEP_DEEPSLEEP 6
-
 namespace Event { /****************************************** Event Namespace */
 	class EventManager;
 	typedef Core::Shared<EventManager> SharedEventManager;
@@ -74,7 +68,14 @@ namespace Game { /******************************************** Game Namespace */
 
 	class EngineBaseEventListener;
 
-	/*! @brief Game Engine Base Class */
+	/*! @brief Game Engine Base Class
+	 *
+	 * MM_RECORD=<file> records input, quit and viewport events to a
+	 * binary log. MM_REPLAY=<file> feeds a log back instead of polling
+	 * input, every frame steps by exactly 1/fps and the frame pacer is
+	 * skipped, so a session replays as fast as it can be processed and
+	 * a frame time summary is logged on exit.
+	 */
 	class MARSHMALLOW_GAME_EXPORT
 	EngineBase : public IEngine
 	{
@@ -86,7 +87,7 @@ namespace Game { /******************************************** Game Namespace */
 
 		/*!
 		 * @param fps Desired frame rate
-		 * @param sleep Sleep interval
+		 * @param sleep Sleep interval preset for the default frame pacer
 		 */
 		EngineBase(int fps = MARSHMALLOW_ENGINE_FRAMERATE,
 		           int sleep = MMSLEEP_DISABLED);
@@ -107,6 +108,14 @@ namespace Game { /******************************************** Game Namespace */
 		 */
 		void setFactory(const SharedFactory &factory);
 
+		/*!
+		 * @brief Set Frame Pacer
+		 *
+		 * Takes effect the next time run() is called, a FramePacer
+		 * using the sleep preset is created if none is set.
+		 */
+		void setFramePacer(const SharedFramePacer &pacer);
+
 		/*!
 		 * @brief Target frames per second
 		 */
@@ -117,11 +126,29 @@ namespace Game { /******************************************** Game Namespace */
 		 */
 		MMTIME deltaTime(void) const;
 
+		/*!
+		 * @brief Time that has elapsed since last tick, in engine ticks
+		 */
+		MMTICK deltaTicks(void) const;
+
 		/*!
 		 * @brief Actual frame rate achieved
 		 */
 		int frameRate(void);
 
+		/*!
+		 * @brief Frame pacer in use
+		 */
+		SharedFramePacer framePacer(void) const;
+
+		/*!
+		 * @brief Frame time statistics of the running game loop
+		 *
+		 * Reset when run() starts, written to the file named by the
+		 * MM_FRAMESTATS environment variable on finalize.
+		 */
+		const FrameStats & frameStats(void) const;
+
 	public: /* virtual */
 
 		virtual void second(void);
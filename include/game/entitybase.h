@@ -50,6 +50,7 @@ MARSHMALLOW_NAMESPACE_BEGIN
 namespace Game { /******************************************** Game Namespace */
 
 	class EntitySceneLayer;
+	struct EntityHandle;
 
 	/*! @brief Game Entity Base Class */
 	class MARSHMALLOW_GAME_EXPORT
@@ -64,6 +65,12 @@ namespace Game { /******************************************** Game Namespace */
 		EntityBase(const Core::Identifier &identifier, EntitySceneLayer &layer);
 		virtual ~EntityBase(void);
 
+		/*!
+		 * Entity handle in the layer store, created on first use and
+		 * destroyed with the entity (unless the store is gone by then).
+		 */
+		const EntityHandle & handle(void);
+
 	public: /* virtual */
 
 		VIRTUAL const Core::Identifier & id(void) const;
@@ -75,6 +82,8 @@ namespace Game { /******************************************** Game Namespace */
 		VIRTUAL void removeComponent(const SharedComponent &component);
 		VIRTUAL SharedComponent getComponent(const Core::Identifier &identifier) const;
 		VIRTUAL SharedComponent getComponentType(const Core::Type &type) const;
+		VIRTUAL RefComponent borrowComponent(const Core::Identifier &identifier) const;
+		VIRTUAL RefComponent borrowComponentType(const Core::Type &type) const;
 
 		VIRTUAL void render(void);
 		VIRTUAL void update(float delta);
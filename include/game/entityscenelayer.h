@@ -49,6 +49,8 @@ MARSHMALLOW_NAMESPACE_BEGIN
 namespace Game { /******************************************** Game Namespace */
 
 	struct IEntity;
+	class EntityStore;
+	typedef Core::Shared<EntityStore> SharedEntityStore;
 	typedef Core::Shared<IEntity> SharedEntity;
 
 	typedef std::list<SharedEntity> EntityList;
@@ -73,6 +75,13 @@ namespace Game { /******************************************** Game Namespace */
 		SharedEntity getEntity(const Core::Identifier &identifier) const;
 		const EntityList & getEntities(void) const;
 
+		/*!
+		 * Component pools of the layer entities, updated before them.
+		 * Entities and store bound components only keep weak references,
+		 * they may outlive the layer.
+		 */
+		const SharedEntityStore & store(void) const;
+
 		bool visiblityTesting(void) const;
 		void setVisibilityTesting(bool value);
 
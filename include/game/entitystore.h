@@ -0,0 +1,203 @@
+/*
+ * Copyright (c) 2011-2013, Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ * All rights reserved.
+ *
+ * This file is part of Marshmallow Game Engine.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE CONTRIBUTORS ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are
+ * those of the authors and should not be interpreted as representing official
+ * policies, either expressed or implied, of the project as a whole.
+ */
+
+#pragma once
+
+/*!
+ * @file
+ *
+ * @author Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ */
+
+#ifndef MARSHMALLOW_GAME_ENTITYSTORE_H
+#define MARSHMALLOW_GAME_ENTITYSTORE_H 1
+
+#include <core/environment.h>
+#include <core/fd.h>
+#include <core/global.h>
+#include <core/iupdateable.h>
+
+#include <math/point2.h>
+#include <math/size2.h>
+#include <math/tuple2.h>
+#include <math/vector2.h>
+
+MARSHMALLOW_NAMESPACE_BEGIN
+namespace Game { /******************************************** Game Namespace */
+
+	/*! @brief Entity handle
+	 *
+	 * Slot index plus the generation it was issued for, handles of
+	 * destroyed entities go stale instead of aliasing the next entity
+	 * created in the same slot. Generation zero is the null handle.
+	 */
+	struct EntityHandle
+	{
+		uint32_t index;
+		uint32_t generation;
+
+		EntityHandle(void)
+		    : index(0), generation(0) {}
+		EntityHandle(uint32_t index_, uint32_t generation_)
+		    : index(index_), generation(generation_) {}
+
+		bool isNull(void) const
+		    { return(generation == 0); }
+
+		bool operator==(const EntityHandle &rhs) const
+		    { return(index == rhs.index && generation == rhs.generation); }
+		bool operator!=(const EntityHandle &rhs) const
+		    { return(!(*this == rhs)); }
+	};
+
+	/*! @brief Data-oriented entity component storage
+	 *
+	 * Position, movement and size data of every entity live in dense
+	 * per-type pools, one array per field, removal swaps the last
+	 * element in. Entities with both position and movement are kept at
+	 * the same index of both pools (see paired()). Systems walk the
+	 * pools linearly instead of visiting entities and calling each of
+	 * their components.
+	 *
+	 * Pointers returned by the accessors are only valid until a
+	 * component of the same type is attached or detached.
+	 *
+	 * PositionComponent, MovementComponent and SizeComponent can be
+	 * bound to a store (see their store constructors), which lets
+	 * IEntity based games move entities over gradually. Every
+	 * EntitySceneLayer owns a store.
+	 */
+	class MARSHMALLOW_GAME_EXPORT
+	EntityStore : public Core::IUpdateable
+	{
+		struct Private;
+		Private *m_p;
+
+		NO_ASSIGN_COPY(EntityStore);
+	public:
+
+		enum Component
+		{
+			Position,
+			Movement,
+			Size,
+			Components
+		};
+
+		enum ComponentFlag
+		{
+			PositionFlag = (1 << Position),
+			MovementFlag = (1 << Movement),
+			SizeFlag     = (1 << Size)
+		};
+
+		EntityStore(void);
+		virtual ~EntityStore(void);
+
+		/*!
+		 * Preallocate entities and components
+		 */
+		void reserve(size_t entities);
+
+		/*!
+		 * @param components ComponentFlag mask of components to attach
+		 */
+		EntityHandle create(int components = 0);
+		void destroy(const EntityHandle &handle);
+		bool isAlive(const EntityHandle &handle) const;
+
+		/*!
+		 * @return Number of live entities
+		 */
+		size_t size(void) const;
+
+		/*!
+		 * Attach default initialized component, no-op if present
+		 *
+		 * @return false if handle is stale
+		 */
+		bool attach(const EntityHandle &handle, Component component);
+		void detach(const EntityHandle &handle, Component component);
+
+		/*!
+		 * @return ComponentFlag mask, zero for stale handles
+		 */
+		int components(const EntityHandle &handle) const;
+
+		/*
+		 * Entity accessors, null if the handle is stale or the component
+		 * isn't attached.
+		 */
+
+		Math::Point2 * position(const EntityHandle &handle);
+		Math::Vector2 * velocity(const EntityHandle &handle);
+		Math::Vector2 * acceleration(const EntityHandle &handle);
+		Math::Pair * limitX(const EntityHandle &handle);
+		Math::Pair * limitY(const EntityHandle &handle);
+		Math::Size2f * size(const EntityHandle &handle);
+
+		/*
+		 * Pools, count(component) elements each. Movement arrays share
+		 * their indices.
+		 */
+
+		size_t count(Component component) const;
+
+		/*!
+		 * @return Number of leading position and movement elements
+		 * belonging to the same entities, in the same order
+		 */
+		size_t paired(void) const;
+		EntityHandle owner(Component component, size_t index) const;
+
+		Math::Point2 * positions(void);
+		Math::Vector2 * velocities(void);
+		Math::Vector2 * accelerations(void);
+		Math::Pair * limitsX(void);
+		Math::Pair * limitsY(void);
+		Math::Size2f * sizes(void);
+
+	public: /* virtual */
+
+		/*!
+		 * Movement system, applies acceleration and limits to velocity
+		 * and moves the position of every entity with both components.
+		 */
+		VIRTUAL void update(float delta);
+	};
+	typedef Core::Shared<EntityStore> SharedEntityStore;
+	typedef Core::Weak<EntityStore> WeakEntityStore;
+
+} /*********************************************************** Game Namespace */
+MARSHMALLOW_NAMESPACE_END
+
+#endif
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2011-2013, Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ * All rights reserved.
+ *
+ * This file is part of Marshmallow Game Engine.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE CONTRIBUTORS ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are
+ * those of the authors and should not be interpreted as representing official
+ * policies, either expressed or implied, of the project as a whole.
+ */
+
+#pragma once
+
+/*!
+ * @file
+ *
+ * @author Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ */
+
+#ifndef MARSHMALLOW_GAME_FRAMEPACER_H
+#define MARSHMALLOW_GAME_FRAMEPACER_H 1
+
+#include <core/global.h>
+
+#include <game/iframepacer.h>
+
+/*
+ * Sleep Intervals
+ */
+#define MMSLEEP_DISABLED  0
+#define MMSLEEP_INSOMNIAC 2
+#define MMSLEEP_LITESLEEP 4
+#define MMSLEEP_DEEPSLEEP 6
+
+MARSHMALLOW_NAMESPACE_BEGIN
+namespace Game { /******************************************** Game Namespace */
+
+	/*!
+	 * @brief Game Frame Pacer
+	 *
+	 * Sleeps until shortly before the frame deadline and spins the rest
+	 * of the way. The spin window follows how late the scheduler wakes
+	 * us up, capped by the sleep preset: higher presets spin less and
+	 * MMSLEEP_DEEPSLEEP never spins.
+	 *
+	 * With vsync enabled and a target interval no longer than the
+	 * measured present interval, buffer swaps already pace the loop and
+	 * wait() returns right away.
+	 */
+	class MARSHMALLOW_GAME_EXPORT
+	FramePacer : public IFramePacer
+	{
+		struct Private;
+		Private *m_p;
+
+		NO_ASSIGN_COPY(FramePacer);
+	public:
+
+		/*!
+		 * @param sleep Sleep interval preset (MMSLEEP_*)
+		 */
+		FramePacer(int sleep = MMSLEEP_DISABLED);
+		virtual ~FramePacer(void);
+
+		/*!
+		 * @brief Current spin window in ticks
+		 */
+		MMTICK spin(void) const;
+
+	public: /* virtual */
+
+		VIRTUAL void reset(MMTICK interval, int vsync);
+		VIRTUAL void wait(void);
+		VIRTUAL void presented(void);
+
+		VIRTUAL MMTICK interval(void) const;
+		VIRTUAL MMTICK jitter(void) const;
+	};
+
+} /*********************************************************** Game Namespace */
+MARSHMALLOW_NAMESPACE_END
+
+#endif
@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2011-2013, Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ * All rights reserved.
+ *
+ * This file is part of Marshmallow Game Engine.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE CONTRIBUTORS ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are
+ * those of the authors and should not be interpreted as representing official
+ * policies, either expressed or implied, of the project as a whole.
+ */
+
+#pragma once
+
+/*!
+ * @file
+ *
+ * @author Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ */
+
+#ifndef MARSHMALLOW_GAME_FRAMESTATS_H
+#define MARSHMALLOW_GAME_FRAMESTATS_H 1
+
+#include <core/environment.h>
+#include <core/global.h>
+#include <core/namespace.h>
+
+#include <string>
+
+MARSHMALLOW_NAMESPACE_BEGIN
+namespace Core { /******************************************** Core Namespace */
+	class Histogram;
+	struct IDataIO;
+} /*********************************************************** Core Namespace */
+
+namespace Game { /******************************************** Game Namespace */
+
+	/*!
+	 * @brief Game Loop Frame Statistics
+	 *
+	 * Fed once per frame by EngineBase. Percentiles, maxima and over
+	 * budget counts are reported over a rolling window of the most
+	 * recent frames, lifetime distributions are kept as histograms.
+	 *
+	 * Durations are in ticks.
+	 */
+	class MARSHMALLOW_GAME_EXPORT
+	FrameStats
+	{
+		struct Private;
+		Private *m_p;
+
+		NO_ASSIGN_COPY(FrameStats);
+	public:
+
+		enum Phase
+		{
+			Tick,   /*!< Backend ticks and event execution */
+			Update, /*!< Update dispatch */
+			Render, /*!< Render dispatch up to buffer swap */
+			Work,   /*!< Tick, update and render combined */
+			Frame,  /*!< Whole frame interval, pacing included */
+			Phases
+		};
+
+		/*!
+		 * @param window Number of frames in the rolling window
+		 */
+		explicit FrameStats(size_t window = 300);
+		~FrameStats(void);
+
+		/*!
+		 * @brief Discard all samples and set the frame budget
+		 *
+		 * A phase is over budget when it takes longer than the
+		 * budget, except for Frame which has to exceed it by half
+		 * (at least one missed refresh, a hitch).
+		 */
+		void reset(MMTICK budget);
+
+		/*!
+		 * @brief Record a frame
+		 */
+		void record(MMTICK tick, MMTICK update, MMTICK render, MMTICK frame);
+
+		MMTICK budget(void) const;
+		size_t window(void) const;
+
+		/*!
+		 * @return Frames recorded since reset
+		 */
+		uint64_t frames(void) const;
+
+		/*!
+		 * @return Rolling percentile of phase
+		 */
+		MMTICK percentile(Phase phase, double percent) const;
+
+		/*!
+		 * @return Rolling maximum of phase (exact)
+		 */
+		MMTICK maximum(Phase phase) const;
+
+		/*!
+		 * @return Rolling mean of phase
+		 */
+		MMTICK mean(Phase phase) const;
+
+		/*!
+		 * @return Frames in the rolling window with phase over budget
+		 */
+		size_t overBudget(Phase phase) const;
+
+		/*!
+		 * @return Frames with phase over budget since reset
+		 */
+		uint64_t totalOverBudget(Phase phase) const;
+
+		/*!
+		 * @return Distribution of phase since reset
+		 */
+		const Core::Histogram & histogram(Phase phase) const;
+
+		/*!
+		 * @brief Write a plain-text report of the lifetime statistics
+		 */
+		bool write(Core::IDataIO &output) const;
+		bool write(const std::string &path) const;
+
+	public: /* static */
+
+		static const char * PhaseName(Phase phase);
+	};
+
+} /*********************************************************** Game Namespace */
+MARSHMALLOW_NAMESPACE_END
+
+#endif
@@ -62,6 +62,7 @@ namespace Game { /******************************************** Game Namespace */
 	};
 	typedef Core::Shared<IComponent> SharedComponent;
 	typedef Core::Weak<IComponent> WeakComponent;
+	typedef Core::Ref<IComponent> RefComponent;
 
 } /*********************************************************** Game Namespace */
 MARSHMALLOW_NAMESPACE_END
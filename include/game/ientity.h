@@ -51,6 +51,7 @@ namespace Game { /******************************************** Game Namespace */
 
 	struct IComponent;
 	typedef Core::Shared<IComponent> SharedComponent;
+	typedef Core::Ref<IComponent> RefComponent;
 
 	class EntitySceneLayer;
 
@@ -75,6 +76,15 @@ namespace Game { /******************************************** Game Namespace */
 		virtual SharedComponent getComponent(const Core::Identifier &identifier) const = 0;
 		virtual SharedComponent getComponentType(const Core::Type &type) const = 0;
 
+		/*! @brief Borrowed component lookup
+		 *
+		 *  No reference counting takes place, the borrow is only valid
+		 *  while the component stays attached. Meant for render and
+		 *  update loops, use getComponent() to hold on to a component.
+		 */
+		virtual RefComponent borrowComponent(const Core::Identifier &identifier) const = 0;
+		virtual RefComponent borrowComponentType(const Core::Type &type) const = 0;
+
 		virtual void kill(void) = 0;
 		virtual bool isZombie(void) const = 0;
 	};
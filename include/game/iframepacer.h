@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2011-2013, Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ * All rights reserved.
+ *
+ * This file is part of Marshmallow Game Engine.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE CONTRIBUTORS ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are
+ * those of the authors and should not be interpreted as representing official
+ * policies, either expressed or implied, of the project as a whole.
+ */
+
+#pragma once
+
+/*!
+ * @file
+ *
+ * @author Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ */
+
+#ifndef MARSHMALLOW_GAME_IFRAMEPACER_H
+#define MARSHMALLOW_GAME_IFRAMEPACER_H 1
+
+#include <core/environment.h>
+#include <core/fd.h>
+
+MARSHMALLOW_NAMESPACE_BEGIN
+namespace Game { /******************************************** Game Namespace */
+
+	/*!
+	 * @brief Game Frame Pacer Interface
+	 *
+	 * Decides when the engine starts its next frame. EngineBase calls
+	 * presented() right after a frame is swapped and wait() before
+	 * starting the next one.
+	 */
+	struct MARSHMALLOW_GAME_EXPORT
+	IFramePacer
+	{
+		virtual ~IFramePacer(void);
+
+		/*!
+		 * @brief Start pacing
+		 *
+		 * @param interval Target frame interval in ticks
+		 * @param vsync    Swap interval in use, 0 when disabled
+		 */
+		virtual void reset(MMTICK interval, int vsync) = 0;
+
+		/*!
+		 * @brief Block until the next frame is due
+		 */
+		virtual void wait(void) = 0;
+
+		/*!
+		 * @brief Notify that a frame was presented
+		 */
+		virtual void presented(void) = 0;
+
+		/*!
+		 * @brief Measured interval between presented frames in ticks
+		 */
+		virtual MMTICK interval(void) const = 0;
+
+		/*!
+		 * @brief Frame time jitter in ticks
+		 *
+		 * Mean absolute deviation of presented frame intervals.
+		 */
+		virtual MMTICK jitter(void) const = 0;
+	};
+	typedef Core::Shared<IFramePacer> SharedFramePacer;
+	typedef Core::Weak<IFramePacer> WeakFramePacer;
+
+} /*********************************************************** Game Namespace */
+MARSHMALLOW_NAMESPACE_END
+
+#endif
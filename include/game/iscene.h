@@ -57,6 +57,7 @@ namespace Game { /******************************************** Game Namespace */
 
 	struct ISceneLayer;
 	typedef Core::Shared<ISceneLayer> SharedSceneLayer;
+	typedef Core::Ref<ISceneLayer> RefSceneLayer;
 
 	typedef std::list<SharedSceneLayer> SceneLayerList;
 
@@ -78,6 +79,15 @@ namespace Game { /******************************************** Game Namespace */
 		virtual SharedSceneLayer getLayerType(const Core::Type &type) const = 0;
 		virtual const SceneLayerList & getLayers(void) const = 0;
 
+		/*! @brief Borrowed layer lookup
+		 *
+		 *  No reference counting takes place, the borrow is only valid
+		 *  while the layer stays in the scene. Meant for render and
+		 *  update loops, use getLayer() to hold on to a layer.
+		 */
+		virtual RefSceneLayer borrowLayer(const Core::Identifier &identifier) const = 0;
+		virtual RefSceneLayer borrowLayerType(const Core::Type &type) const = 0;
+
 		virtual const Graphics::Color & background(void) const = 0;
 
 		virtual void activate(void) = 0;
@@ -77,6 +77,7 @@ namespace Game { /******************************************** Game Namespace */
 	};
 	typedef Core::Shared<ISceneLayer> SharedSceneLayer;
 	typedef Core::Weak<ISceneLayer> WeakSceneLayer;
+	typedef Core::Ref<ISceneLayer> RefSceneLayer;
 
 } /*********************************************************** Game Namespace */
 MARSHMALLOW_NAMESPACE_END
@@ -55,6 +55,11 @@ namespace Game { /******************************************** Game Namespace */
 	class PositionComponent;
 	typedef Core::Weak<PositionComponent> WeakPositionComponent;
 
+	class EntityStore;
+	typedef Core::Weak<EntityStore> WeakEntityStore;
+
+	struct EntityHandle;
+
 	/*! @brief Game Movement Component Class */
 	class MARSHMALLOW_GAME_EXPORT
 	MovementComponent : public ComponentBase
@@ -66,6 +71,18 @@ namespace Game { /******************************************** Game Namespace */
 	public:
 
 		MovementComponent(const Core::Identifier &identifier, IEntity &entity);
+
+		/*!
+		 * Store bound, movement data lives in the store (attached here
+		 * and detached on destruction, if the store is still around), see
+		 * EntityStore.
+		 *
+		 * EntityStore::update() integrates the velocity, update() only
+		 * moves an unbound position (and does nothing if the position is
+		 * in the store too).
+		 */
+		MovementComponent(const Core::Identifier &identifier, IEntity &entity,
+		    const WeakEntityStore &store, const EntityHandle &handle);
 		virtual ~MovementComponent(void);
 
 		Math::Vector2 & acceleration(void);
@@ -48,6 +48,11 @@
 MARSHMALLOW_NAMESPACE_BEGIN
 namespace Game { /******************************************** Game Namespace */
 
+	class EntityStore;
+	typedef Core::Weak<EntityStore> WeakEntityStore;
+
+	struct EntityHandle;
+
 	/*! @brief Game Position Component Class */
 	class MARSHMALLOW_GAME_EXPORT
 	PositionComponent : public ComponentBase
@@ -58,6 +63,14 @@ namespace Game { /******************************************** Game Namespace */
 		NO_ASSIGN_COPY(PositionComponent);
 	public:
 		PositionComponent(const Core::Identifier &i, IEntity &entity);
+
+		/*!
+		 * Store bound, the position lives in the store (attached here
+		 * and detached on destruction, if the store is still around), see
+		 * EntityStore.
+		 */
+		PositionComponent(const Core::Identifier &i, IEntity &entity,
+		    const WeakEntityStore &store, const EntityHandle &handle);
 		virtual ~PositionComponent(void);
 
 		Math::Point2 & position(void);
@@ -76,6 +89,7 @@ namespace Game { /******************************************** Game Namespace */
 	};
 	typedef Core::Shared<PositionComponent> SharedPositionComponent;
 	typedef Core::Weak<PositionComponent> WeakPositionComponent;
+	typedef Core::Ref<PositionComponent> RefPositionComponent;
 
 } /*********************************************************** Game Namespace */
 MARSHMALLOW_NAMESPACE_END
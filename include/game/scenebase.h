@@ -75,6 +75,8 @@ namespace Game { /******************************************** Game Namespace */
 		VIRTUAL void removeLayer(const Core::Identifier &identifier);
 		VIRTUAL SharedSceneLayer getLayer(const Core::Identifier &identifier) const;
 		VIRTUAL SharedSceneLayer getLayerType(const Core::Type &type) const;
+		VIRTUAL RefSceneLayer borrowLayer(const Core::Identifier &identifier) const;
+		VIRTUAL RefSceneLayer borrowLayerType(const Core::Type &type) const;
 		VIRTUAL const SceneLayerList & getLayers(void) const;
 
 		VIRTUAL const Graphics::Color & background(void) const;
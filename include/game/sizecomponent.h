@@ -51,6 +51,11 @@ namespace Math { /******************************************** Math Namespace */
 
 namespace Game { /******************************************** Game Namespace */
 
+	class EntityStore;
+	typedef Core::Weak<EntityStore> WeakEntityStore;
+
+	struct EntityHandle;
+
 	/*! @brief Game Size Component Class */
 	class MARSHMALLOW_GAME_EXPORT
 	SizeComponent : public ComponentBase
@@ -61,6 +66,14 @@ namespace Game { /******************************************** Game Namespace */
 		NO_ASSIGN_COPY(SizeComponent);
 	public:
 		SizeComponent(const Core::Identifier &i, IEntity &entity);
+
+		/*!
+		 * Store bound, the size lives in the store (attached here and
+		 * detached on destruction, if the store is still around), see
+		 * EntityStore.
+		 */
+		SizeComponent(const Core::Identifier &i, IEntity &entity,
+		    const WeakEntityStore &store, const EntityHandle &handle);
 		virtual ~SizeComponent(void);
 
 		Math::Size2f & size(void);
@@ -79,6 +92,7 @@ namespace Game { /******************************************** Game Namespace */
 	};
 	typedef Core::Shared<SizeComponent> SharedSizeComponent;
 	typedef Core::Weak<SizeComponent> WeakSizeComponent;
+	typedef Core::Ref<SizeComponent> RefSizeComponent;
 
 } /******************************************************* Graphics Namespace */
 MARSHMALLOW_NAMESPACE_END
@@ -62,6 +62,7 @@ namespace Graphics { /************************************ Graphics Namespace */
 	};
 	typedef Core::Shared<ITextureCoordinateData> SharedTextureCoordinateData;
 	typedef Core::Weak<ITextureCoordinateData> WeakTextureCoordinateData;
+	typedef Core::Ref<ITextureCoordinateData> RefTextureCoordinateData;
 
 } /******************************************************* Graphics Namespace */
 MARSHMALLOW_NAMESPACE_END
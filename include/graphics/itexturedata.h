@@ -81,6 +81,7 @@ namespace Graphics { /************************************ Graphics Namespace */
 	};
 	typedef Core::Shared<ITextureData> SharedTextureData;
 	typedef Core::Weak<ITextureData> WeakTextureData;
+	typedef Core::Ref<ITextureData> RefTextureData;
 
 } /******************************************************* Graphics Namespace */
 MARSHMALLOW_NAMESPACE_END
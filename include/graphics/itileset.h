@@ -80,6 +80,7 @@ namespace Graphics { /************************************ Graphics Namespace */
 	};
 	typedef Core::Shared<ITileset> SharedTileset;
 	typedef Core::Weak<ITileset> WeakTileset;
+	typedef Core::Ref<ITileset> RefTileset;
 
 } /******************************************************* Graphics Namespace */
 MARSHMALLOW_NAMESPACE_END
@@ -62,6 +62,7 @@ namespace Graphics { /************************************ Graphics Namespace */
 	};
 	typedef Core::Shared<IVertexData> SharedVertexData;
 	typedef Core::Weak<IVertexData> WeakVertexData;
+	typedef Core::Ref<IVertexData> RefVertexData;
 
 } /******************************************************* Graphics Namespace */
 MARSHMALLOW_NAMESPACE_END
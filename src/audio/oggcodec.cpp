@@ -57,6 +57,8 @@ namespace { /*********************************** Audio::<anonymous> Namespace */
 struct OVData
 {
 	Core::SharedDataIO dio;
+	const char *view;
+	long size;
 	long cursor;
 };
 
@@ -67,6 +69,15 @@ OVRead(void *buffer, size_t byte_size, size_t byte_count, void *data)
 
 	OVData *l_data = reinterpret_cast<OVData *>(data);
 
+	if (l_data->view) {
+		const size_t l_available = size_t(l_data->size - l_data->cursor);
+		const size_t l_read = byte_size * byte_count < l_available ?
+		    byte_size * byte_count : l_available;
+		memcpy(buffer, l_data->view + l_data->cursor, l_read);
+		l_data->cursor += long(l_read);
+		return(l_read);
+	}
+
 	if (!l_data->dio->seek(l_data->cursor, Core::DIOSet)) {
 		MMERROR("Failed to restore DataIO cursor! " << l_data->cursor);
 		return(0);
@@ -86,6 +97,22 @@ OVSeek(void *data, ogg_int64_t offset, int origin)
 
 	OVData *l_data = reinterpret_cast<OVData *>(data);
 
+	if (l_data->view) {
+		ogg_int64_t l_cursor;
+		switch (origin) {
+		case SEEK_SET: l_cursor = offset; break;
+		case SEEK_END: l_cursor = l_data->size + offset; break;
+		case SEEK_CUR: l_cursor = l_data->cursor + offset; break;
+		default: return(-1);
+		}
+
+		if (l_cursor < 0 || l_cursor > l_data->size)
+			return(-1);
+
+		l_data->cursor = long(l_cursor);
+		return(0);
+	}
+
 	/* translate origin */
 	Core::DIOSeek l_seek;
 	switch (origin) {
@@ -156,8 +183,18 @@ OggCodec::Private::open(const Core::SharedDataIO &_dio)
 	/* init data struct */
 	data = new OVData;
 	data->dio = _dio;
+	data->view = 0;
+	data->size = 0;
 	data->cursor = 0;
 
+	/* decode straight from memory when the device allows it */
+	if (_dio->seek(0, Core::DIOEnd)) {
+		const long l_size = _dio->tell();
+		if (l_size > 0 && (data->view = static_cast<const char *>
+		    (_dio->view(0, size_t(l_size)))))
+			data->size = l_size;
+	}
+
 	/* dataio callbacks */
 	ov_callbacks l_callbacks;
 	l_callbacks.read_func  = OVRead;
@@ -41,6 +41,7 @@
 #include <cstring>
 
 #include "core/logger.h"
+#include "core/profiler.h"
 #include "core/shared.h"
 
 #include "audio/icodec.h"
@@ -271,6 +272,8 @@ PCM::isOpen(void) const
 bool
 PCM::mix(char *_buffer, size_t _bsize)
 {
+	MMPROFILE_SCOPE("PCM::mix");
+
 	return(m_p->mix(_buffer, _bsize));
 }
 
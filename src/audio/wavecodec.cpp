@@ -49,7 +49,9 @@ namespace Audio { /****************************************** Audio Namespace */
 struct WaveCodec::Private
 {
 	Private(void)
-	    : cursor(0)
+	    : view(0)
+	    , size(0)
+	    , cursor(0)
 	    , start(0)
 	    , rate(0)
 	    , depth(0)
@@ -63,6 +65,8 @@ struct WaveCodec::Private
 	inline void reset(void);
 
 	Core::SharedDataIO dio;
+	const char *view;
+	long size;
 	long cursor;
 	long start;
 	uint32_t rate;
@@ -149,15 +153,23 @@ WaveCodec::Private::open(const Core::SharedDataIO &_dio)
 		return(false);
 	}
 
-	/* skip length */
-	_dio->seek(4, Core::DIOCurrent);
+	/* data length */
+	uint32_t l_data_size = 0;
+	if (4 != _dio->read(&l_data_size, 4)) {
+		MMDEBUG("Invalid WAVE (short read).");
+		return(false);
+	}
 
 	/* data start */
 	cursor = start = _dio->tell();
+	size = long(l_data_size);
 
 	/* store data io */
 	dio = _dio;
 
+	/* read samples straight from memory when the device allows it */
+	view = static_cast<const char *>(dio->view(size_t(start), l_data_size));
+
 	return(opened = true);
 }
 
@@ -166,6 +178,8 @@ WaveCodec::Private::close(void)
 {
 	if (!opened) return;
 
+	view = 0;
+	size = 0;
 	cursor = 0;
 	start = 0;
 	opened = false;
@@ -176,7 +190,18 @@ WaveCodec::Private::read(void *buffer, size_t bsize)
 {
 	if (!opened) return(0);
 
-	dio->seek(cursor, Core::DIOSet);
+	if (view) {
+		const long l_available = start + size - cursor;
+		const size_t l_read = long(bsize) < l_available ?
+		    bsize : size_t(l_available);
+		memcpy(buffer, view + (cursor - start), l_read);
+		cursor += long(l_read);
+		return(l_read);
+	}
+
+	/* dio may be shared, only reposition if someone moved it */
+	if (dio->tell() != cursor)
+		dio->seek(cursor, Core::DIOSet);
 	const size_t l_read = dio->read(buffer, bsize);
 	cursor = dio->tell();
 
@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2013, Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ * All rights reserved.
+ *
+ * This file is part of Marshmallow Game Engine.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE CONTRIBUTORS ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are
+ * those of the authors and should not be interpreted as representing official
+ * policies, either expressed or implied, of the project as a whole.
+ */
+
+#include <core/global.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <new>
+
+#include "tests/allocations.h"
+
+/*!
+ * @file
+ *
+ * @author Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ */
+
+static const char * s_bench_format = "[BENCH] %s:%d \"%s\" %lu ops in %.3f ms (%.2f ns/op)\n";
+static const char * s_bytes_format = "[BENCH] %s:%d \"%s\" %lu ops in %.3f ms (%.2f ns/op, %.1f MB/s)\n";
+static const char * s_count_format = "[COUNT] %s:%d \"%s\" %lu\n";
+
+static inline double
+BenchmarkNow(void)
+{
+	return(static_cast<double>(clock()) / CLOCKS_PER_SEC);
+}
+
+static inline void
+BenchmarkReport(const char *f, int l, const char *x, unsigned long n, double s)
+{
+	fprintf(stdout, s_bench_format, f, l, x, n, s * 1e3,
+	    (s * 1e9) / static_cast<double>(n));
+}
+
+static inline void
+BenchmarkReportBytes(const char *f, int l, const char *x, unsigned long n, double s,
+    size_t b)
+{
+	fprintf(stdout, s_bytes_format, f, l, x, n, s * 1e3,
+	    (s * 1e9) / static_cast<double>(n),
+	    (static_cast<double>(n) * static_cast<double>(b)) / (s * 1048576.0));
+}
+
+#define RUN_BENCHMARK(x) x()
+#define BENCHMARK_BEGIN(n) { \
+    const unsigned long l_bench_n = (n); \
+    const double l_bench_start = BenchmarkNow(); \
+    for (unsigned long l_bench_i = 0; l_bench_i < l_bench_n; ++l_bench_i) {
+#define BENCHMARK_END(x) } \
+    BenchmarkReport(__FUNCTION__, __LINE__, x, l_bench_n, BenchmarkNow() - l_bench_start); }
+#define BENCHMARK_END_BYTES(x, y) } \
+    BenchmarkReportBytes(__FUNCTION__, __LINE__, x, l_bench_n, BenchmarkNow() - l_bench_start, y); }
+#define BENCHMARK_COUNT(x, y) fprintf(stdout, s_count_format, __FUNCTION__, __LINE__, x, static_cast<unsigned long>(y))
+#define BENCHMARK_ALLOCATIONS TEST_ALLOCATIONS
+#define BENCHMARK_EXITCODE 0
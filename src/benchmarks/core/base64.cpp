@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2013, Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ * All rights reserved.
+ *
+ * This file is part of Marshmallow Game Engine.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE CONTRIBUTORS ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are
+ * those of the authors and should not be interpreted as representing official
+ * policies, either expressed or implied, of the project as a whole.
+ */
+
+#include "core/base64.h"
+#include "core/base64io.h"
+#include "core/bufferio.h"
+#include "core/shared.h"
+
+#include "benchmarks/common.h"
+
+/*!
+ * @file
+ *
+ * @author Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ */
+
+MARSHMALLOW_NAMESPACE_USE
+
+static const size_t s_size = 4 * 1024 * 1024;
+static const size_t s_chunk = 4096;
+static const unsigned long s_iterations = 16;
+
+static char *
+CreateContent(void)
+{
+	char *l_content = new char[s_size];
+	uint32_t l_seed = 0x1234;
+	for (size_t l_i = 0; l_i < s_size; ++l_i) {
+		l_seed = l_seed * 1103515245 + 12345;
+		l_content[l_i] = static_cast<char>(l_seed >> 16);
+	}
+	return(l_content);
+}
+
+void
+encode_benchmark(void)
+{
+	char *l_content = CreateContent();
+	char *l_encoded = new char[Core::Base64::EncodedSize(s_size)];
+	size_t l_total = 0;
+
+	BENCHMARK_BEGIN(s_iterations)
+		char *l_out;
+		l_total += Core::Base64::Encode(l_content, s_size, &l_out);
+		delete[] l_out;
+	BENCHMARK_END_BYTES("Core::Base64::Encode()", s_size);
+
+	BENCHMARK_BEGIN(s_iterations)
+		Core::Base64::EncodeTo(l_content, s_size, l_encoded);
+		l_total += size_t(l_encoded[0]);
+	BENCHMARK_END_BYTES("Core::Base64::EncodeTo()", s_size);
+
+	BENCHMARK_COUNT("encoded bytes", l_total);
+
+	delete[] l_encoded;
+	delete[] l_content;
+}
+
+void
+decode_benchmark(void)
+{
+	char *l_content = CreateContent();
+	char *l_encoded;
+	const size_t l_encoded_size =
+	    Core::Base64::Encode(l_content, s_size, &l_encoded);
+	size_t l_total = 0;
+
+	BENCHMARK_BEGIN(s_iterations)
+		char *l_out;
+		l_total += Core::Base64::Decode(l_encoded, l_encoded_size, &l_out);
+		delete[] l_out;
+	BENCHMARK_END_BYTES("Core::Base64::Decode()", l_encoded_size);
+
+	BENCHMARK_BEGIN(s_iterations)
+		l_total += Core::Base64::DecodeTo(l_encoded, l_encoded_size, l_content);
+	BENCHMARK_END_BYTES("Core::Base64::DecodeTo()", l_encoded_size);
+
+	char *l_chunk = new char[s_chunk];
+
+	BENCHMARK_BEGIN(s_iterations)
+		Core::Base64IO l_stream(Core::SharedDataIO(new Core::BufferIO
+		    (static_cast<const void *>(l_encoded), l_encoded_size)));
+		size_t l_read;
+		while ((l_read = l_stream.read(l_chunk, s_chunk)) > 0)
+			l_total += l_read;
+	BENCHMARK_END_BYTES("Core::Base64IO::read() 4K chunks", l_encoded_size);
+
+	BENCHMARK_COUNT("decoded bytes", l_total);
+
+	delete[] l_chunk;
+	delete[] l_encoded;
+	delete[] l_content;
+}
+
+int
+main(int, char *[])
+{
+	RUN_BENCHMARK(encode_benchmark);
+	RUN_BENCHMARK(decode_benchmark);
+
+	return(BENCHMARK_EXITCODE);
+}
@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2013, Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ * All rights reserved.
+ *
+ * This file is part of Marshmallow Game Engine.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE CONTRIBUTORS ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are
+ * those of the authors and should not be interpreted as representing official
+ * policies, either expressed or implied, of the project as a whole.
+ */
+
+#include "core/hash.h"
+
+#include "benchmarks/common.h"
+
+/*!
+ * @file
+ *
+ * @author Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ */
+
+MARSHMALLOW_NAMESPACE_USE
+
+static const unsigned long s_bytes = 64 * 1024 * 1024;
+
+static void
+hash_size_benchmark(size_t size)
+{
+	char l_key[256];
+	for (size_t l_i = 0; l_i < size; ++l_i)
+		l_key[l_i] = static_cast<char>('a' + l_i % 26);
+
+	const unsigned long l_iterations = s_bytes / size;
+	MMUID l_sink = 0;
+	char l_description[64];
+
+	sprintf(l_description, "Core::Hash::Algorithm() %lu bytes",
+	    static_cast<unsigned long>(size));
+	BENCHMARK_BEGIN(l_iterations)
+		l_key[0] = static_cast<char>(l_bench_i);
+		l_sink += Core::Hash::Algorithm(l_key, size, ~static_cast<MMUID>(0));
+	BENCHMARK_END_BYTES(l_description, size);
+
+	sprintf(l_description, "Core::Hash::LegacyAlgorithm() %lu bytes",
+	    static_cast<unsigned long>(size));
+	BENCHMARK_BEGIN(l_iterations)
+		l_key[0] = static_cast<char>(l_bench_i);
+		l_sink += Core::Hash::LegacyAlgorithm(l_key, size, ~static_cast<MMUID>(0));
+	BENCHMARK_END_BYTES(l_description, size);
+
+	BENCHMARK_COUNT("sink", l_sink);
+}
+
+void
+hash_8_benchmark(void)
+{
+	hash_size_benchmark(8);
+}
+
+void
+hash_32_benchmark(void)
+{
+	hash_size_benchmark(32);
+}
+
+void
+hash_256_benchmark(void)
+{
+	hash_size_benchmark(256);
+}
+
+int
+main(int, char *[])
+{
+	RUN_BENCHMARK(hash_8_benchmark);
+	RUN_BENCHMARK(hash_32_benchmark);
+	RUN_BENCHMARK(hash_256_benchmark);
+
+	return(BENCHMARK_EXITCODE);
+}
@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2013, Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ * All rights reserved.
+ *
+ * This file is part of Marshmallow Game Engine.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE CONTRIBUTORS ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are
+ * those of the authors and should not be interpreted as representing official
+ * policies, either expressed or implied, of the project as a whole.
+ */
+
+#include "core/identifier.h"
+
+#include "benchmarks/common.h"
+
+/*!
+ * @file
+ *
+ * @author Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ */
+
+MARSHMALLOW_NAMESPACE_USE
+
+static const unsigned long s_iterations = 1000000;
+
+void
+identifier_construct_benchmark(void)
+{
+	const unsigned long l_allocations = BENCHMARK_ALLOCATIONS;
+
+	BENCHMARK_BEGIN(s_iterations)
+		Core::Identifier l_id("Game::PositionComponent");
+		MMUNUSED(l_id);
+	BENCHMARK_END("Core::Identifier::Identifier(const char *)");
+
+	BENCHMARK_COUNT("allocations per identifier",
+	    (BENCHMARK_ALLOCATIONS - l_allocations) / s_iterations);
+}
+
+void
+identifier_copy_benchmark(void)
+{
+	const Core::Identifier l_id("Game::PositionComponent");
+	const unsigned long l_allocations = BENCHMARK_ALLOCATIONS;
+
+	BENCHMARK_BEGIN(s_iterations)
+		Core::Identifier l_copy(l_id);
+		MMUNUSED(l_copy);
+	BENCHMARK_END("Core::Identifier::Identifier(const Identifier &)");
+
+	BENCHMARK_COUNT("allocations per copy",
+	    (BENCHMARK_ALLOCATIONS - l_allocations) / s_iterations);
+}
+
+void
+identifier_compare_benchmark(void)
+{
+	const Core::Identifier l_a("Game::PositionComponent");
+	const Core::Identifier l_b("Game::SizeComponent");
+	unsigned long l_equal = 0;
+
+	BENCHMARK_BEGIN(s_iterations * 10)
+		l_equal += (l_a == (l_bench_i & 1 ? l_a : l_b));
+	BENCHMARK_END("Core::Identifier::operator==()");
+
+	BENCHMARK_COUNT("equal", l_equal);
+}
+
+int
+main(int, char *[])
+{
+	RUN_BENCHMARK(identifier_construct_benchmark);
+	RUN_BENCHMARK(identifier_copy_benchmark);
+	RUN_BENCHMARK(identifier_compare_benchmark);
+
+	return(BENCHMARK_EXITCODE);
+}
+
@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2013, Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ * All rights reserved.
+ *
+ * This file is part of Marshmallow Game Engine.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE CONTRIBUTORS ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are
+ * those of the authors and should not be interpreted as representing official
+ * policies, either expressed or implied, of the project as a whole.
+ */
+
+#include "core/bufferio.h"
+#include "core/deflateio.h"
+#include "core/inflateio.h"
+#include "core/shared.h"
+#include "core/zlib.h"
+
+#include "benchmarks/common.h"
+
+/*!
+ * @file
+ *
+ * @author Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ */
+
+MARSHMALLOW_NAMESPACE_USE
+
+static const size_t s_size = 8 * 1024 * 1024;
+static const size_t s_chunk = 4096;
+static const unsigned long s_iterations = 8;
+
+static char *
+CreateContent(void)
+{
+	static const char s_words[][8] =
+	    { "tile ", "layer ", "sprite ", "entity ", "scene ", "asset " };
+
+	char *l_content = new char[s_size];
+	uint32_t l_seed = 0x1234;
+	for (size_t l_i = 0; l_i < s_size;) {
+		l_seed = l_seed * 1103515245 + 12345;
+		const char *l_word = s_words[(l_seed >> 16) % 6];
+		while (*l_word && l_i < s_size)
+			l_content[l_i++] = *l_word++;
+	}
+	return(l_content);
+}
+
+void
+inflate_benchmark(void)
+{
+	char *l_content = CreateContent();
+	char *l_compressed;
+	const size_t l_compressed_size =
+	    Core::Zlib::Deflate(l_content, s_size, &l_compressed);
+	BENCHMARK_COUNT("compressed bytes", l_compressed_size);
+
+	size_t l_total = 0;
+
+	BENCHMARK_BEGIN(s_iterations)
+		char *l_inflated;
+		l_total += Core::Zlib::Inflate(l_compressed, l_compressed_size,
+		    s_size, &l_inflated);
+		delete[] l_inflated;
+	BENCHMARK_END_BYTES("Core::Zlib::Inflate() one-shot", s_size);
+
+	char *l_chunk = new char[s_chunk];
+	const unsigned long l_allocations = BENCHMARK_ALLOCATIONS;
+
+	BENCHMARK_BEGIN(s_iterations)
+		Core::InflateIO l_inflate(Core::SharedDataIO(new Core::BufferIO
+		    (static_cast<const void *>(l_compressed), l_compressed_size)));
+		size_t l_read;
+		while ((l_read = l_inflate.read(l_chunk, s_chunk)) > 0)
+			l_total += l_read;
+	BENCHMARK_END_BYTES("Core::InflateIO::read() 4K chunks", s_size);
+
+	BENCHMARK_COUNT("allocations per stream",
+	    (BENCHMARK_ALLOCATIONS - l_allocations) / s_iterations);
+	BENCHMARK_COUNT("inflated bytes", l_total);
+
+	delete[] l_chunk;
+	delete[] l_compressed;
+	delete[] l_content;
+}
+
+void
+deflate_benchmark(void)
+{
+	char *l_content = CreateContent();
+	char *l_compressed = new char[s_size];
+	size_t l_total = 0;
+
+	BENCHMARK_BEGIN(s_iterations)
+		char *l_deflated;
+		l_total += Core::Zlib::Deflate(l_content, s_size, &l_deflated);
+		delete[] l_deflated;
+	BENCHMARK_END_BYTES("Core::Zlib::Deflate() one-shot", s_size);
+
+	BENCHMARK_BEGIN(s_iterations)
+		Core::SharedDataIO l_sink(new Core::BufferIO
+		    (static_cast<void *>(l_compressed), s_size));
+		{
+			Core::DeflateIO l_deflate(l_sink);
+			for (size_t l_i = 0; l_i < s_size; l_i += s_chunk)
+				l_deflate.write(l_content + l_i, s_chunk);
+		}
+		l_total += size_t(l_sink->tell());
+	BENCHMARK_END_BYTES("Core::DeflateIO::write() 4K chunks", s_size);
+
+	BENCHMARK_COUNT("deflated bytes", l_total);
+
+	delete[] l_compressed;
+	delete[] l_content;
+}
+
+int
+main(int, char *[])
+{
+	RUN_BENCHMARK(inflate_benchmark);
+	RUN_BENCHMARK(deflate_benchmark);
+
+	return(BENCHMARK_EXITCODE);
+}
@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2013, Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ * All rights reserved.
+ *
+ * This file is part of Marshmallow Game Engine.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE CONTRIBUTORS ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are
+ * those of the authors and should not be interpreted as representing official
+ * policies, either expressed or implied, of the project as a whole.
+ */
+
+#include "core/jobsystem.h"
+#include "core/platform.h"
+#include "core/thread_p.h"
+
+#include "benchmarks/common.h"
+
+#include <cmath>
+#include <vector>
+
+/*!
+ * @file
+ *
+ * @author Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ */
+
+MARSHMALLOW_NAMESPACE_USE
+
+/*
+ * Wall-clock timing, clock() adds up the CPU time of every thread.
+ */
+#define BENCHMARK_WALL_BEGIN(n) { \
+    const unsigned long l_bench_n = (n); \
+    const MMTICK l_bench_start = Core::Platform::Ticks(); \
+    for (unsigned long l_bench_i = 0; l_bench_i < l_bench_n; ++l_bench_i) {
+#define BENCHMARK_WALL_END(x) } \
+    BenchmarkReport(__FUNCTION__, __LINE__, x, l_bench_n, \
+        Core::Platform::TicksToSeconds(Core::Platform::Ticks() - l_bench_start)); }
+
+static const size_t s_elements = 1 << 20;
+static std::vector<float> s_data(s_elements);
+
+static void
+Kernel(void *c, size_t b, size_t e)
+{
+	float *l_data = static_cast<float *>(c);
+	for (size_t l_i = b; l_i < e; ++l_i)
+		l_data[l_i] = sqrtf(l_data[l_i] * 1.0001f + 1.f) * sinf(l_data[l_i]);
+}
+
+static void
+Empty(void *)
+{
+}
+
+static void
+ParallelFor(int threads)
+{
+	Core::JobSystem::Initialize(threads - 1);
+
+	char l_name[64];
+	sprintf(l_name, "Core::JobSystem::ParallelFor %d threads", Core::JobSystem::Threads());
+
+	BENCHMARK_WALL_BEGIN(50)
+		Core::JobSystem::ParallelFor(s_elements, Kernel, &s_data[0]);
+	BENCHMARK_WALL_END(l_name);
+
+	Core::JobSystem::Finalize();
+}
+
+static void
+ForkJoin(int threads)
+{
+	Core::JobSystem::Initialize(threads - 1);
+
+	char l_name[64];
+	sprintf(l_name, "Core::JobSystem fork-join of 1024 jobs, %d threads", Core::JobSystem::Threads());
+
+	BENCHMARK_WALL_BEGIN(1000)
+		Core::JobSystem::Job *l_root = Core::JobSystem::Create(0, 0);
+		for (int l_j = 0; l_j < 1023; ++l_j)
+			Core::JobSystem::Run(Core::JobSystem::Create(Empty, 0, l_root));
+		Core::JobSystem::Run(l_root);
+		Core::JobSystem::Wait(l_root);
+	BENCHMARK_WALL_END(l_name);
+
+	Core::JobSystem::Finalize();
+}
+
+void
+jobsystem_benchmark(void)
+{
+	for (size_t l_i = 0; l_i < s_elements; ++l_i)
+		s_data[l_i] = static_cast<float>(l_i % 1000);
+
+	const int l_cores = Core::Thread::Concurrency();
+	BENCHMARK_COUNT("hardware threads", l_cores);
+
+	for (int l_threads = 1; l_threads < l_cores; l_threads *= 2)
+		ParallelFor(l_threads);
+	ParallelFor(l_cores);
+
+	for (int l_threads = 1; l_threads < l_cores; l_threads *= 2)
+		ForkJoin(l_threads);
+	ForkJoin(l_cores);
+}
+
+int
+main(int, char *[])
+{
+	RUN_BENCHMARK(jobsystem_benchmark);
+
+	return(BENCHMARK_EXITCODE);
+}
@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2013, Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ * All rights reserved.
+ *
+ * This file is part of Marshmallow Game Engine.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE CONTRIBUTORS ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are
+ * those of the authors and should not be interpreted as representing official
+ * policies, either expressed or implied, of the project as a whole.
+ */
+
+#include "core/base64.h"
+#include "core/base64io.h"
+#include "core/bufferio.h"
+#include "core/logger.h"
+
+#include "benchmarks/common.h"
+
+#include <cstdio>
+#include <fstream>
+
+/*!
+ * @file
+ *
+ * @author Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ */
+
+MARSHMALLOW_NAMESPACE_USE
+
+static const unsigned long s_iterations = 20000;
+static const char s_log_file[] = "bench_core_logger.log";
+static FILE *s_log = 0;
+
+static void
+FileSink(const char *text, size_t length)
+{
+	fwrite(text, 1, length, s_log);
+	fflush(s_log);
+}
+
+void
+submit_benchmark(void)
+{
+	const int l_value = 42;
+
+	/* previous MMLOG expansion, two flushes per message */
+	std::ofstream l_stream(s_log_file);
+	BENCHMARK_BEGIN(s_iterations)
+		l_stream << __FILE__ << ":" << __LINE__ << " [" "ERROR" "]" << std::endl
+		         << "\t" << MMFUNCTION << ": "
+		         << "value " << l_value << " iteration " << l_bench_i << std::endl;
+	BENCHMARK_END("std::ostream MMLOG");
+	l_stream.close();
+
+	s_log = fopen(s_log_file, "w");
+	Core::Logger::SetSink(FileSink);
+
+	Core::Logger::SetAsynchronous(false);
+	BENCHMARK_BEGIN(s_iterations)
+		MMERROR("value " << l_value << " iteration " << l_bench_i);
+	BENCHMARK_END("Core::Logger synchronous");
+
+	Core::Logger::SetAsynchronous(true);
+	const unsigned long l_dropped = Core::Logger::Dropped();
+	BENCHMARK_BEGIN(s_iterations)
+		MMERROR("value " << l_value << " iteration " << l_bench_i);
+	BENCHMARK_END("Core::Logger asynchronous");
+	Core::Logger::Flush();
+	BENCHMARK_COUNT("dropped", Core::Logger::Dropped() - l_dropped);
+
+	Core::Logger::SetThreshold(Core::Logger::FatalLevel);
+	BENCHMARK_BEGIN(s_iterations)
+		MMERROR("value " << l_value << " iteration " << l_bench_i);
+	BENCHMARK_END("Core::Logger filtered");
+	Core::Logger::SetThreshold(Core::Logger::VerboseLevel);
+
+	Core::Logger::SetSink(0);
+	fclose(s_log), s_log = 0;
+	remove(s_log_file);
+}
+
+int
+main(int, char *[])
+{
+	RUN_BENCHMARK(submit_benchmark);
+
+	return(BENCHMARK_EXITCODE);
+}
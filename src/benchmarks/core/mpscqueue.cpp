@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2013, Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ * All rights reserved.
+ *
+ * This file is part of Marshmallow Game Engine.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE CONTRIBUTORS ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are
+ * those of the authors and should not be interpreted as representing official
+ * policies, either expressed or implied, of the project as a whole.
+ */
+
+#include "core/histogram.h"
+#include "core/mpscqueue.h"
+#include "core/platform.h"
+#include "core/thread_p.h"
+
+#include "benchmarks/common.h"
+
+/*!
+ * @file
+ *
+ * @author Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ */
+
+MARSHMALLOW_NAMESPACE_USE
+
+static const unsigned long s_iterations = 1000000;
+static const int s_samples = 100000;
+
+typedef Core::MPSCQueue<MMTICK> Queue;
+
+struct Producer
+{
+	Queue *queue;
+	int samples;
+};
+
+static void
+Produce(void *c)
+{
+	Producer *l_producer = static_cast<Producer *>(c);
+
+	for (int l_i = 0; l_i < l_producer->samples; ++l_i) {
+		while (!l_producer->queue->push(NOW_TICKS()))
+			Core::Thread::YieldSlice();
+		Core::Thread::YieldSlice();
+	}
+}
+
+void
+mpscqueue_throughput_benchmark(void)
+{
+	Queue l_queue(1024);
+	MMTICK l_value = 0;
+
+	BENCHMARK_BEGIN(s_iterations)
+		l_queue.push(static_cast<MMTICK>(l_bench_i));
+		l_queue.pop(l_value);
+	BENCHMARK_END("Core::MPSCQueue push() + pop() uncontended");
+
+	BENCHMARK_COUNT("last", l_value);
+}
+
+/*
+ * Time from push() on a producer thread to pop() on the consumer,
+ * producers yield after each push so samples aren't all queueing delay.
+ */
+static void
+Latency(int producers)
+{
+	Queue l_queue(1024);
+	Core::Histogram l_latency;
+
+	Producer l_producer;
+	l_producer.queue = &l_queue;
+	l_producer.samples = s_samples / producers;
+
+	Core::Thread::Handle *l_threads[8];
+	for (int l_i = 0; l_i < producers; ++l_i)
+		l_threads[l_i] = Core::Thread::Start(Produce, &l_producer);
+
+	const int l_total = l_producer.samples * producers;
+	MMTICK l_stamp;
+	for (int l_received = 0; l_received < l_total;) {
+		if (l_queue.pop(l_stamp)) {
+			l_latency.record(NOW_TICKS() - l_stamp);
+			++l_received;
+		} else Core::Thread::YieldSlice();
+	}
+
+	for (int l_i = 0; l_i < producers; ++l_i)
+		Core::Thread::Join(l_threads[l_i]);
+
+	fprintf(stdout, "[BENCH] %s: %d producers, push to pop latency "
+	    "p50 %ld ns, p99 %ld ns, p99.9 %ld ns, max %ld ns\n", __FUNCTION__,
+	    producers,
+	    static_cast<long>(l_latency.percentile(50)),
+	    static_cast<long>(l_latency.percentile(99)),
+	    static_cast<long>(l_latency.percentile(99.9)),
+	    static_cast<long>(l_latency.maximum()));
+}
+
+void
+mpscqueue_latency_benchmark(void)
+{
+	BENCHMARK_COUNT("hardware threads", Core::Thread::Concurrency());
+
+	for (int l_producers = 1; l_producers <= 8; l_producers *= 2)
+		Latency(l_producers);
+}
+
+int
+main(int, char *[])
+{
+	RUN_BENCHMARK(mpscqueue_throughput_benchmark);
+	RUN_BENCHMARK(mpscqueue_latency_benchmark);
+
+	return(BENCHMARK_EXITCODE);
+}
@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2013, Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ * All rights reserved.
+ *
+ * This file is part of Marshmallow Game Engine.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE CONTRIBUTORS ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are
+ * those of the authors and should not be interpreted as representing official
+ * policies, either expressed or implied, of the project as a whole.
+ */
+
+#include "core/fileio.h"
+#include "core/identifier.h"
+#include "core/packio.h"
+#include "core/packwriter.h"
+#include "core/platform.h"
+
+#include "benchmarks/common.h"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+/*!
+ * @file
+ *
+ * @author Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ */
+
+MARSHMALLOW_NAMESPACE_USE
+
+/* roughly a small game worth of assets */
+static const size_t s_assets = 1400;
+static const size_t s_asset_size = 3000;
+static const unsigned long s_iterations = 8;
+
+static std::string
+AssetName(size_t index)
+{
+	char l_name[32];
+	sprintf(l_name, "mmbench-asset-%04lu.dat", static_cast<unsigned long>(index));
+	return(l_name);
+}
+
+void
+startup_benchmark(void)
+{
+	const std::string l_directory = Core::Platform::TemporaryDirectory();
+	const std::string l_pack_file = l_directory + "mmbench-assets.pack";
+
+	std::vector<char> l_asset(s_asset_size);
+	std::vector<Core::Identifier> l_files;
+	std::vector<Core::Identifier> l_entries;
+	Core::PackWriter l_pack;
+
+	for (size_t l_i = 0; l_i < s_assets; ++l_i) {
+		const std::string l_name = AssetName(l_i);
+		for (size_t l_j = 0; l_j < s_asset_size; ++l_j)
+			l_asset[l_j] = char(l_i + l_j);
+
+		Core::FileIO l_file(l_directory + l_name, Core::DIOTruncate);
+		l_file.write(&l_asset[0], s_asset_size);
+		l_pack.add(l_name, &l_asset[0], s_asset_size);
+
+		l_files.push_back(l_directory + l_name);
+		l_entries.push_back("pack://" + l_name);
+	}
+	l_pack.write(l_pack_file);
+
+	size_t l_total = 0;
+
+	BENCHMARK_BEGIN(s_iterations)
+		for (size_t l_i = 0; l_i < s_assets; ++l_i) {
+			Core::FileIO l_file(l_files[l_i]);
+			l_total += l_file.read(&l_asset[0], l_file.size());
+		}
+	BENCHMARK_END_BYTES("Core::FileIO loose files", s_assets * s_asset_size);
+
+	BENCHMARK_BEGIN(s_iterations)
+		Core::PackIO::Mount(l_pack_file);
+		for (size_t l_i = 0; l_i < s_assets; ++l_i) {
+			Core::FileIO l_file(l_entries[l_i]);
+			l_total += l_file.read(&l_asset[0], l_file.size());
+		}
+		Core::PackIO::Unmount(l_pack_file);
+	BENCHMARK_END_BYTES("Core::FileIO pack:// (mount included)",
+	    s_assets * s_asset_size);
+
+	Core::PackIO::Mount(l_pack_file);
+
+	BENCHMARK_BEGIN(s_iterations)
+		for (size_t l_i = 0; l_i < s_assets; ++l_i) {
+			Core::PackIO l_entry(l_entries[l_i]);
+			l_total += l_entry.view(0, l_entry.size()) ? l_entry.size() : 0;
+		}
+	BENCHMARK_END_BYTES("Core::PackIO::view() zero-copy", s_assets * s_asset_size);
+
+	Core::PackIO::Unmount(l_pack_file);
+
+	BENCHMARK_COUNT("bytes", l_total);
+
+	for (size_t l_i = 0; l_i < s_assets; ++l_i)
+		remove(l_files[l_i]);
+	remove(l_pack_file.c_str());
+}
+
+int
+main(int, char *[])
+{
+	RUN_BENCHMARK(startup_benchmark);
+
+	return(BENCHMARK_EXITCODE);
+}
@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2013, Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ * All rights reserved.
+ *
+ * This file is part of Marshmallow Game Engine.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE CONTRIBUTORS ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are
+ * those of the authors and should not be interpreted as representing official
+ * policies, either expressed or implied, of the project as a whole.
+ */
+
+#include "core/shared.h"
+#include "core/weak.h"
+
+#include "benchmarks/common.h"
+
+/*!
+ * @file
+ *
+ * @author Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ */
+
+MARSHMALLOW_NAMESPACE_USE
+
+static const unsigned long s_iterations = 1000000;
+
+struct BenchObject
+{
+	int value[4];
+};
+
+void
+shared_new_benchmark(void)
+{
+	const unsigned long l_allocations = BENCHMARK_ALLOCATIONS;
+
+	BENCHMARK_BEGIN(s_iterations)
+		Core::Shared<BenchObject> l_shared(new BenchObject);
+	BENCHMARK_END("Core::Shared(new T) create/destroy");
+
+	BENCHMARK_COUNT("allocations per object",
+	    (BENCHMARK_ALLOCATIONS - l_allocations) / s_iterations);
+}
+
+void
+shared_make_benchmark(void)
+{
+	const unsigned long l_allocations = BENCHMARK_ALLOCATIONS;
+
+	BENCHMARK_BEGIN(s_iterations)
+		Core::Shared<BenchObject> l_shared =
+		    Core::MakeShared<BenchObject>();
+	BENCHMARK_END("Core::MakeShared() create/destroy");
+
+	BENCHMARK_COUNT("allocations per object",
+	    (BENCHMARK_ALLOCATIONS - l_allocations) / s_iterations);
+}
+
+void
+shared_copy_benchmark(void)
+{
+	Core::Shared<BenchObject> l_legacy(new BenchObject);
+	Core::Shared<BenchObject> l_single = Core::MakeShared<BenchObject>();
+
+	BENCHMARK_BEGIN(s_iterations * 10)
+		Core::Shared<BenchObject> l_copy(l_legacy);
+	BENCHMARK_END("Core::Shared(new T) copy/destroy");
+
+	BENCHMARK_BEGIN(s_iterations * 10)
+		Core::Shared<BenchObject> l_copy(l_single);
+	BENCHMARK_END("Core::MakeShared() copy/destroy");
+}
+
+void
+weak_lock_benchmark(void)
+{
+	Core::Shared<BenchObject> l_shared = Core::MakeShared<BenchObject>();
+	Core::Weak<BenchObject> l_weak(l_shared);
+
+	BENCHMARK_BEGIN(s_iterations * 10)
+		Core::Shared<BenchObject> l_lock(l_weak);
+	BENCHMARK_END("Core::Weak::operator Shared()");
+}
+
+int
+main(int, char *[])
+{
+	RUN_BENCHMARK(shared_new_benchmark);
+	RUN_BENCHMARK(shared_make_benchmark);
+	RUN_BENCHMARK(shared_copy_benchmark);
+	RUN_BENCHMARK(weak_lock_benchmark);
+
+	return(BENCHMARK_EXITCODE);
+}
+
@@ -0,0 +1,300 @@
+/*
+ * Copyright (c) 2013, Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ * All rights reserved.
+ *
+ * This file is part of Marshmallow Game Engine.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE CONTRIBUTORS ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are
+ * those of the authors and should not be interpreted as representing official
+ * policies, either expressed or implied, of the project as a whole.
+ */
+
+#include "core/identifier.h"
+#include "core/platform.h"
+#include "core/shared.h"
+#include "core/type.h"
+
+#include "event/eventbase.h"
+#include "event/eventmanager.h"
+#include "event/ibatcheventlistener.h"
+#include "event/ieventlistener.h"
+#include "event/joystickaxisevent.h"
+
+#include "benchmarks/common.h"
+
+#include <vector>
+
+/*!
+ * @file
+ *
+ * @author Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ */
+
+MARSHMALLOW_NAMESPACE_USE
+
+static const unsigned long s_events = 100000;
+
+class BenchEvent : public Event::EventBase
+{
+	NO_ASSIGN_COPY(BenchEvent);
+public:
+
+	BenchEvent(MMTICK timestamp, uint8_t priority)
+	    : EventBase(timestamp, priority) {}
+
+	VIRTUAL const Core::Type & type(void) const
+	    { return(Type()); }
+
+	static const Core::Type & Type(void)
+	{
+		static const Core::Type s_type("BenchEvent");
+		return(s_type);
+	}
+};
+
+class BenchListener : public Event::IEventListener
+{
+	NO_ASSIGN_COPY(BenchListener);
+public:
+
+	BenchListener(void)
+	    : handled(0) {}
+
+	unsigned long handled;
+
+	VIRTUAL bool handleEvent(const Event::IEvent &)
+	    { ++handled; return(false); }
+};
+
+class BenchBatchListener : public Event::IBatchEventListener
+{
+	NO_ASSIGN_COPY(BenchBatchListener);
+public:
+
+	BenchBatchListener(void)
+	    : handled(0), batches(0) {}
+
+	unsigned long handled;
+	unsigned long batches;
+
+	VIRTUAL bool handleEvent(const Event::IEvent &)
+	    { ++handled; return(false); }
+
+	VIRTUAL bool handleEvents(const Core::Type &, const Event::IEvent *const *,
+	                          size_t count)
+	    { handled += count; ++batches; return(false); }
+};
+
+static void
+CreateEvents(std::vector<Event::SharedEvent> &events, MMTICK base, MMTICK spread)
+{
+	events.reserve(s_events);
+	for (unsigned long l_i = 0; l_i < s_events; ++l_i) {
+		const MMTICK l_offset = spread ? static_cast<MMTICK>((l_i * 7919) % s_events) * spread : 0;
+		events.push_back(new BenchEvent(base + l_offset,
+		    static_cast<uint8_t>(l_i % Event::HighestPriority)));
+	}
+}
+
+void
+eventmanager_immediate_benchmark(void)
+{
+	Event::EventManager l_manager("bench");
+	BenchListener l_listener;
+	l_manager.connect(&l_listener, BenchEvent::Type());
+
+	std::vector<Event::SharedEvent> l_events;
+	CreateEvents(l_events, NOW_TICKS(), 0);
+
+	BENCHMARK_BEGIN(s_events)
+		l_manager.queue(l_events[l_bench_i]);
+	BENCHMARK_END("Event::EventManager::queue() 100k due events");
+
+	BENCHMARK_BEGIN(1)
+		l_manager.execute();
+	BENCHMARK_END("Event::EventManager::execute() 100k due events");
+
+	BENCHMARK_COUNT("handled", l_listener.handled);
+	l_manager.disconnect(&l_listener, BenchEvent::Type());
+}
+
+void
+eventmanager_delayed_benchmark(void)
+{
+	Event::EventManager l_manager("bench");
+	BenchListener l_listener;
+	l_manager.connect(&l_listener, BenchEvent::Type());
+
+	/* spread over the next 100 seconds, in shuffled order */
+	std::vector<Event::SharedEvent> l_events;
+	CreateEvents(l_events, NOW_TICKS() + Core::Platform::TicksPerSecond,
+	    Core::Platform::TicksPerMillisecond);
+
+	std::vector<Event::EventHandle> l_handles(s_events);
+
+	BENCHMARK_BEGIN(s_events)
+		l_handles[l_bench_i] = l_manager.queueHandle(l_events[l_bench_i]);
+	BENCHMARK_END("Event::EventManager::queue() 100k delayed events");
+
+	BENCHMARK_BEGIN(100)
+		l_manager.execute();
+	BENCHMARK_END("Event::EventManager::execute() 100k pending timers");
+
+	BENCHMARK_BEGIN(s_events)
+		l_manager.cancel(l_handles[l_bench_i]);
+	BENCHMARK_END("Event::EventManager::cancel() 100k delayed events");
+
+	BENCHMARK_BEGIN(1)
+		l_manager.execute();
+	BENCHMARK_END("Event::EventManager::execute() 100k cancelled timers");
+
+	BENCHMARK_COUNT("handled", l_listener.handled);
+	l_manager.disconnect(&l_listener, BenchEvent::Type());
+}
+
+void
+eventmanager_dispatch_benchmark(void)
+{
+	Event::EventManager l_manager("bench");
+	BenchListener l_listeners[4];
+	for (int l_i = 0; l_i < 4; ++l_i)
+		l_manager.connect(&l_listeners[l_i], BenchEvent::Type());
+
+	BenchEvent l_event(NOW_TICKS(), Event::NormalPriority);
+
+	const unsigned long l_allocations = BENCHMARK_ALLOCATIONS;
+
+	BENCHMARK_BEGIN(s_events)
+		l_manager.dispatch(l_event);
+	BENCHMARK_END("Event::EventManager::dispatch() 4 listeners");
+
+	BENCHMARK_COUNT("allocations", BENCHMARK_ALLOCATIONS - l_allocations);
+	BENCHMARK_COUNT("handled", l_listeners[3].handled);
+
+	for (int l_i = 0; l_i < 4; ++l_i)
+		l_manager.disconnect(&l_listeners[l_i], BenchEvent::Type());
+}
+
+/*
+ * Joystick axis flood, one event per sample queued and dispatched in
+ * batches of a frame's worth.
+ */
+void
+eventmanager_flood_benchmark(void)
+{
+	static const unsigned long s_batch = 100;
+
+	Event::EventManager l_manager("bench");
+	BenchListener l_listener;
+	l_manager.connect(&l_listener, Event::JoystickAxisEvent::Type());
+
+	/* warm up pools and queue storage */
+	for (unsigned long l_i = 0; l_i < s_batch; ++l_i)
+		l_manager.queue<Event::JoystickAxisEvent>(Input::Joystick::JSA_X,
+		    static_cast<int>(l_i), -1, 1, size_t(0));
+	l_manager.execute();
+
+	unsigned long l_allocations = BENCHMARK_ALLOCATIONS;
+
+	BENCHMARK_BEGIN(s_events / s_batch)
+		for (unsigned long l_i = 0; l_i < s_batch; ++l_i)
+			l_manager.queue(new Event::JoystickAxisEvent(Input::Joystick::JSA_X,
+			    static_cast<int>(l_i), -1, 1, 0));
+		l_manager.execute();
+	BENCHMARK_END("Event::EventManager::queue(new T) + execute() 100 per batch");
+
+	BENCHMARK_COUNT("allocations per event",
+	    (BENCHMARK_ALLOCATIONS - l_allocations) / s_events);
+
+	l_allocations = BENCHMARK_ALLOCATIONS;
+
+	BENCHMARK_BEGIN(s_events / s_batch)
+		for (unsigned long l_i = 0; l_i < s_batch; ++l_i)
+			l_manager.queue<Event::JoystickAxisEvent>(Input::Joystick::JSA_X,
+			    static_cast<int>(l_i), -1, 1, size_t(0));
+		l_manager.execute();
+	BENCHMARK_END("Event::EventManager::queue<T>() + execute() 100 per batch");
+
+	BENCHMARK_COUNT("allocations per event",
+	    (BENCHMARK_ALLOCATIONS - l_allocations) / s_events);
+	BENCHMARK_COUNT("handled", l_listener.handled);
+
+	l_manager.disconnect(&l_listener, Event::JoystickAxisEvent::Type());
+}
+
+/*
+ * Same flood as above, 4 devices with 2 axes each
+ */
+static void
+Flood(Event::EventManager &manager, const char *name)
+{
+	static const unsigned long s_batch = 100;
+
+	BENCHMARK_BEGIN(s_events / s_batch)
+		for (unsigned long l_i = 0; l_i < s_batch; ++l_i)
+			manager.queue<Event::JoystickAxisEvent>(
+			    (l_i & 1) ? Input::Joystick::JSA_X : Input::Joystick::JSA_Y,
+			    static_cast<int>(l_i), -1, 1, size_t(l_i & 3));
+		manager.execute();
+	BENCHMARK_END(name);
+}
+
+void
+eventmanager_batch_benchmark(void)
+{
+	Event::EventManager l_manager("bench");
+
+	BenchListener l_plain;
+	l_manager.connect(&l_plain, Event::JoystickAxisEvent::Type());
+	Flood(l_manager, "Event::EventManager axis flood, plain listener");
+	BENCHMARK_COUNT("handled", l_plain.handled);
+	l_manager.disconnect(&l_plain, Event::JoystickAxisEvent::Type());
+
+	BenchBatchListener l_batch;
+	l_manager.connect(&l_batch, Event::JoystickAxisEvent::Type());
+	Flood(l_manager, "Event::EventManager axis flood, batch listener");
+	BENCHMARK_COUNT("handled", l_batch.handled);
+	BENCHMARK_COUNT("batches", l_batch.batches);
+
+	l_batch.handled = l_batch.batches = 0;
+	l_manager.setCoalescing(Event::JoystickAxisEvent::Type(),
+	    Event::JoystickAxisEvent::CoalesceKey);
+	Flood(l_manager, "Event::EventManager axis flood, batch listener, coalesced");
+	BENCHMARK_COUNT("handled", l_batch.handled);
+	BENCHMARK_COUNT("batches", l_batch.batches);
+
+	l_manager.disconnect(&l_batch, Event::JoystickAxisEvent::Type());
+}
+
+int
+main(int, char *[])
+{
+	RUN_BENCHMARK(eventmanager_dispatch_benchmark);
+	RUN_BENCHMARK(eventmanager_flood_benchmark);
+	RUN_BENCHMARK(eventmanager_batch_benchmark);
+	RUN_BENCHMARK(eventmanager_immediate_benchmark);
+	RUN_BENCHMARK(eventmanager_delayed_benchmark);
+
+	return(BENCHMARK_EXITCODE);
+}
@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2013, Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ * All rights reserved.
+ *
+ * This file is part of Marshmallow Game Engine.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE CONTRIBUTORS ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are
+ * those of the authors and should not be interpreted as representing official
+ * policies, either expressed or implied, of the project as a whole.
+ */
+
+#include "core/identifier.h"
+#include "core/shared.h"
+
+#include "game/entity.h"
+#include "game/entityscenelayer.h"
+#include "game/movementcomponent.h"
+#include "game/positioncomponent.h"
+#include "game/scene.h"
+#include "game/sizecomponent.h"
+
+#include "benchmarks/common.h"
+
+#include <sstream>
+
+/*!
+ * @file
+ *
+ * @author Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ */
+
+MARSHMALLOW_NAMESPACE_USE
+
+static const int s_entities = 10000;
+static const unsigned long s_frames = 100;
+static const unsigned long s_spawns = 100000;
+
+void
+entityscenelayer_render_benchmark(void)
+{
+	Game::Scene l_scene("bench");
+	Game::SharedSceneLayer l_slayer(new Game::EntitySceneLayer("entities", l_scene));
+	l_scene.pushLayer(l_slayer);
+
+	Game::SharedEntitySceneLayer l_layer =
+	    l_slayer.staticCast<Game::EntitySceneLayer>();
+
+	for (int i = 0; i < s_entities; ++i) {
+		std::stringstream l_id;
+		l_id << "entity" << i;
+
+		Game::SharedEntity l_entity(new Game::Entity(l_id.str(), *l_layer));
+		l_entity->pushComponent(new Game::PositionComponent("position", *l_entity));
+		l_entity->pushComponent(new Game::SizeComponent("size", *l_entity));
+		l_layer->addEntity(l_entity);
+	}
+
+#if MARSHMALLOW_DEBUG
+	Core::SharedData::Operations = 0;
+#endif
+
+	BENCHMARK_BEGIN(s_frames)
+		l_layer->render();
+	BENCHMARK_END("Game::EntitySceneLayer::render() 10k entities");
+
+#if MARSHMALLOW_DEBUG
+	BENCHMARK_COUNT("shared operations per frame",
+	    Core::SharedData::Operations / s_frames);
+#endif
+}
+
+void
+entityscenelayer_update_benchmark(void)
+{
+	Game::Scene l_scene("bench");
+	Game::SharedSceneLayer l_slayer(new Game::EntitySceneLayer("entities", l_scene));
+	l_scene.pushLayer(l_slayer);
+
+	Game::SharedEntitySceneLayer l_layer =
+	    l_slayer.staticCast<Game::EntitySceneLayer>();
+
+	for (int i = 0; i < s_entities; ++i) {
+		std::stringstream l_id;
+		l_id << "entity" << i;
+
+		Game::SharedEntity l_entity(new Game::Entity(l_id.str(), *l_layer));
+		l_entity->pushComponent(new Game::PositionComponent("position", *l_entity));
+		l_entity->pushComponent(new Game::SizeComponent("size", *l_entity));
+		l_entity->pushComponent(new Game::MovementComponent("movement", *l_entity));
+		l_layer->addEntity(l_entity);
+	}
+
+	BENCHMARK_BEGIN(s_frames)
+		l_layer->update(1.f / 60.f);
+	BENCHMARK_END("Game::EntitySceneLayer::update() 10k entities");
+}
+
+void
+entityscenelayer_spawn_benchmark(void)
+{
+	Game::Scene l_scene("bench");
+	Game::SharedSceneLayer l_slayer(new Game::EntitySceneLayer("entities", l_scene));
+	l_scene.pushLayer(l_slayer);
+
+	Game::SharedEntitySceneLayer l_layer =
+	    l_slayer.staticCast<Game::EntitySceneLayer>();
+
+	const Core::Identifier l_id("entity");
+	const Core::Identifier l_position("position");
+	const Core::Identifier l_size("size");
+
+	const unsigned long l_allocations = BENCHMARK_ALLOCATIONS;
+
+	BENCHMARK_BEGIN(s_spawns)
+		Game::SharedEntity l_entity(new Game::Entity(l_id, *l_layer));
+		l_entity->pushComponent(new Game::PositionComponent(l_position, *l_entity));
+		l_entity->pushComponent(new Game::SizeComponent(l_size, *l_entity));
+		l_layer->addEntity(l_entity);
+		l_layer->removeEntity(l_entity);
+	BENCHMARK_END("Game::EntitySceneLayer spawn/despawn");
+
+	BENCHMARK_COUNT("heap allocations per spawn",
+	    (BENCHMARK_ALLOCATIONS - l_allocations) / s_spawns);
+}
+
+int
+main(int, char *[])
+{
+	RUN_BENCHMARK(entityscenelayer_render_benchmark);
+	RUN_BENCHMARK(entityscenelayer_update_benchmark);
+	RUN_BENCHMARK(entityscenelayer_spawn_benchmark);
+
+	return(BENCHMARK_EXITCODE);
+}
+
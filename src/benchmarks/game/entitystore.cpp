@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2013, Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ * All rights reserved.
+ *
+ * This file is part of Marshmallow Game Engine.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE CONTRIBUTORS ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are
+ * those of the authors and should not be interpreted as representing official
+ * policies, either expressed or implied, of the project as a whole.
+ */
+
+#include "core/identifier.h"
+#include "core/shared.h"
+#include "core/weak.h"
+
+#include "game/entity.h"
+#include "game/entityscenelayer.h"
+#include "game/entitystore.h"
+#include "game/movementcomponent.h"
+#include "game/positioncomponent.h"
+#include "game/scene.h"
+#include "game/sizecomponent.h"
+
+#include "benchmarks/common.h"
+
+/*!
+ * @file
+ *
+ * @author Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ */
+
+MARSHMALLOW_NAMESPACE_USE
+
+static const int s_entities = 100000;
+static const int s_adapted = 10000;
+static const unsigned long s_frames = 100;
+static const unsigned long s_spawns = 100000;
+
+void
+entitystore_update_benchmark(void)
+{
+	Game::EntityStore l_store;
+	l_store.reserve(s_entities);
+
+	for (int i = 0; i < s_entities; ++i) {
+		const Game::EntityHandle l_handle = l_store.create
+		    (Game::EntityStore::PositionFlag
+		    | Game::EntityStore::MovementFlag
+		    | Game::EntityStore::SizeFlag);
+		*l_store.velocity(l_handle) = Math::Vector2(1.f, -1.f);
+		*l_store.acceleration(l_handle) = Math::Vector2(0.f, 9.8f);
+		*l_store.limitY(l_handle) = Math::Pair(-1.f, 10.f);
+	}
+
+	/* one op per frame, 60 Hz budget is 16.6 ms/op */
+	BENCHMARK_BEGIN(s_frames)
+		l_store.update(1.f / 60.f);
+	BENCHMARK_END("Game::EntityStore::update() 100k entities");
+}
+
+void
+entitystore_adapter_benchmark(void)
+{
+	Game::Scene l_scene("bench");
+	Game::SharedSceneLayer l_slayer(new Game::EntitySceneLayer("entities", l_scene));
+	l_scene.pushLayer(l_slayer);
+
+	Game::SharedEntitySceneLayer l_layer =
+	    l_slayer.staticCast<Game::EntitySceneLayer>();
+	const Game::SharedEntityStore &l_store = l_layer->store();
+	l_store->reserve(s_adapted);
+
+	const Core::Identifier l_id("entity");
+	const Core::Identifier l_position("position");
+	const Core::Identifier l_movement("movement");
+	const Core::Identifier l_size("size");
+
+	for (int i = 0; i < s_adapted; ++i) {
+		Game::Entity *l_entity = new Game::Entity(l_id, *l_layer);
+		Game::SharedEntity l_shared(l_entity);
+		const Game::EntityHandle &l_handle = l_entity->handle();
+		l_entity->pushComponent(new Game::PositionComponent
+		    (l_position, *l_entity, l_store, l_handle));
+		l_entity->pushComponent(new Game::SizeComponent
+		    (l_size, *l_entity, l_store, l_handle));
+		l_entity->pushComponent(new Game::MovementComponent
+		    (l_movement, *l_entity, l_store, l_handle));
+		l_layer->addEntity(l_shared);
+	}
+
+	/* compare with Game::EntitySceneLayer::update() 10k entities */
+	BENCHMARK_BEGIN(s_frames)
+		l_layer->update(1.f / 60.f);
+	BENCHMARK_END("Game::EntitySceneLayer::update() 10k store bound entities");
+}
+
+void
+entitystore_spawn_benchmark(void)
+{
+	Game::EntityStore l_store;
+
+	const unsigned long l_allocations = BENCHMARK_ALLOCATIONS;
+
+	BENCHMARK_BEGIN(s_spawns)
+		const Game::EntityHandle l_handle = l_store.create
+		    (Game::EntityStore::PositionFlag | Game::EntityStore::SizeFlag);
+		l_store.destroy(l_handle);
+	BENCHMARK_END("Game::EntityStore spawn/despawn");
+
+	BENCHMARK_COUNT("heap allocations per spawn",
+	    (BENCHMARK_ALLOCATIONS - l_allocations) / s_spawns);
+}
+
+int
+main(int, char *[])
+{
+	RUN_BENCHMARK(entitystore_update_benchmark);
+	RUN_BENCHMARK(entitystore_adapter_benchmark);
+	RUN_BENCHMARK(entitystore_spawn_benchmark);
+
+	return(BENCHMARK_EXITCODE);
+}
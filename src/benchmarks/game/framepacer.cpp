@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2013, Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ * All rights reserved.
+ *
+ * This file is part of Marshmallow Game Engine.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE CONTRIBUTORS ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are
+ * those of the authors and should not be interpreted as representing official
+ * policies, either expressed or implied, of the project as a whole.
+ */
+
+#include "core/identifier.h"
+#include "core/shared.h"
+
+#include "core/platform.h"
+
+#include "game/framepacer.h"
+
+#include "benchmarks/common.h"
+
+/*!
+ * @file
+ *
+ * @author Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ */
+
+MARSHMALLOW_NAMESPACE_USE
+
+static const unsigned long s_frames = 60;
+static const MMTICK s_interval = Core::Platform::TicksPerSecond / 60;
+static const MMTICK s_work = 4 * Core::Platform::TicksPerMillisecond;
+
+static void
+Pace(const char *name, int sleep)
+{
+	Game::FramePacer l_pacer(sleep);
+	l_pacer.reset(s_interval, 0);
+
+	BENCHMARK_BEGIN(s_frames)
+		/* simulated frame */
+		const MMTICK l_done = Core::Platform::Ticks() + s_work;
+		while (Core::Platform::Ticks() < l_done);
+
+		l_pacer.presented();
+		l_pacer.wait();
+	BENCHMARK_END(name);
+
+	BENCHMARK_COUNT("interval (us)", l_pacer.interval() / 1000);
+	BENCHMARK_COUNT("jitter (us)", l_pacer.jitter() / 1000);
+	BENCHMARK_COUNT("spin (us)", l_pacer.spin() / 1000);
+}
+
+void
+framepacer_benchmark(void)
+{
+	Pace("Game::FramePacer MMSLEEP_DISABLED", MMSLEEP_DISABLED);
+	Pace("Game::FramePacer MMSLEEP_INSOMNIAC", MMSLEEP_INSOMNIAC);
+	Pace("Game::FramePacer MMSLEEP_LITESLEEP", MMSLEEP_LITESLEEP);
+	Pace("Game::FramePacer MMSLEEP_DEEPSLEEP", MMSLEEP_DEEPSLEEP);
+}
+
+int
+main(int, char *[])
+{
+	RUN_BENCHMARK(framepacer_benchmark);
+
+	return(BENCHMARK_EXITCODE);
+}
@@ -40,105 +40,539 @@
 
 #include "core/logger.h"
 
+#include "cpu_p.h"
+
+#if MMCPU_X86
+#   include <immintrin.h>
+#elif MMCPU_NEON
+#   include <arm_neon.h>
+#endif
+
 MARSHMALLOW_NAMESPACE_BEGIN
 namespace Core { /******************************************** Core Namespace */
 namespace { /************************************ Core::<anonymous> Namespace */
 
-	static const char s_encoder64[] =
+	static const unsigned char s_encoder64[] =
 	    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
 
-	static const char s_decoder64[] = {
-	    0 , 0 , 0 , 0 , 0 , 0 , 0 , 0 , 0 , 0 ,
-	    0 , 0 , 0 , 0 , 0 , 0 , 0 , 0 , 0 , 0 ,
-	    0 , 0 , 0 , 0 , 0 , 0 , 0 , 0 , 0 , 0 ,
-	    0 , 0 , 0 , 0 , 0 , 0 , 0 , 0 , 0 , 0 ,
-	    0 , 0 , 0 , 62, 0 , 0 , 0 , 63, 52, 53,
-	    54, 55, 56, 57, 58, 59, 60, 61, 0 , 0 ,
-	    0 , 0 , 0 , 0 , 0 , 0 , 1 , 2 , 3 , 4 ,
-	    5 , 6 , 7 , 8 , 9 , 10, 11, 12, 13, 14,
-	    15, 16, 17, 18, 19, 20, 21, 22, 23, 24,
-	    25, 0 , 0 , 0 , 0 , 0 , 0 , 26, 27, 28,
-	    29, 30, 31, 32, 33, 34, 35, 36, 37, 38,
-	    39, 40, 41, 42, 43, 44, 45, 46, 47, 48,
-	    49, 50, 51
+	/* 0xFF marks characters outside of the alphabet (padding included) */
+	static const unsigned char s_decoder64[256] = {
+	    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,   62, 0xFF, 0xFF, 0xFF,   63,
+	      52,   53,   54,   55,   56,   57,   58,   59,   60,   61, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	    0xFF,    0,    1,    2,    3,    4,    5,    6,    7,    8,    9,   10,   11,   12,   13,   14,
+	      15,   16,   17,   18,   19,   20,   21,   22,   23,   24,   25, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	    0xFF,   26,   27,   28,   29,   30,   31,   32,   33,   34,   35,   36,   37,   38,   39,   40,
+	      41,   42,   43,   44,   45,   46,   47,   48,   49,   50,   51, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF
 	};
 
+	/*
+	 * Kernels work on whole quads (4 characters, 3 bytes) and triples
+	 * (3 bytes, 4 characters). They return how many they handled, a
+	 * decode kernel stops in front of the first block containing a
+	 * character outside of the alphabet and leaves the exact error (or
+	 * the padding) to the scalar loop.
+	 */
+	typedef size_t (*DecodeKernel)(const unsigned char *in, size_t quads,
+	    unsigned char *out);
+	typedef size_t (*EncodeKernel)(const unsigned char *in, size_t triples,
+	    unsigned char *out);
+
+	size_t
+	DecodeScalar(const unsigned char *in, size_t quads, unsigned char *out)
+	{
+		size_t l_q;
+
+		for (l_q = 0; l_q < quads; ++l_q, in += 4, out += 3) {
+			const uint32_t l_a = s_decoder64[in[0]];
+			const uint32_t l_b = s_decoder64[in[1]];
+			const uint32_t l_c = s_decoder64[in[2]];
+			const uint32_t l_d = s_decoder64[in[3]];
+
+			if ((l_a | l_b | l_c | l_d) & 0x80)
+				break;
+
+			const uint32_t l_v = l_a << 18 | l_b << 12 | l_c << 6 | l_d;
+			out[0] = static_cast<unsigned char>(l_v >> 16);
+			out[1] = static_cast<unsigned char>(l_v >> 8);
+			out[2] = static_cast<unsigned char>(l_v);
+		}
+
+		return(l_q);
+	}
+
+	size_t
+	EncodeScalar(const unsigned char *in, size_t triples, unsigned char *out)
+	{
+		for (size_t l_t = 0; l_t < triples; ++l_t, in += 3, out += 4) {
+			const uint32_t l_v =
+			    uint32_t(in[0]) << 16 | uint32_t(in[1]) << 8 | in[2];
+			out[0] = s_encoder64[(l_v >> 18) & 0x3F];
+			out[1] = s_encoder64[(l_v >> 12) & 0x3F];
+			out[2] = s_encoder64[(l_v >> 6) & 0x3F];
+			out[3] = s_encoder64[l_v & 0x3F];
+		}
+
+		return(triples);
+	}
+
+#if MMCPU_X86
+	/*
+	 * Vector kernels after W. Mula and D. Lemire, "Faster Base64 Encoding
+	 * and Decoding Using AVX2 Instructions" (2018).
+	 */
+
+	MMCPU_TARGET("ssse3") inline __m128i
+	DecodeLookupSSSE3(__m128i c, bool &valid)
+	{
+		const __m128i l_lut_lo = _mm_setr_epi8(
+		    0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+		    0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+		const __m128i l_lut_hi = _mm_setr_epi8(
+		    0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+		    0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+		const __m128i l_lut_roll = _mm_setr_epi8(
+		    0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+		const __m128i l_mask = _mm_set1_epi8(0x2F);
+
+		const __m128i l_hi_nibbles =
+		    _mm_and_si128(_mm_srli_epi32(c, 4), l_mask);
+		const __m128i l_lo = _mm_shuffle_epi8(l_lut_lo, _mm_and_si128(c, l_mask));
+		const __m128i l_hi = _mm_shuffle_epi8(l_lut_hi, l_hi_nibbles);
+
+		valid = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(l_lo, l_hi),
+		    _mm_setzero_si128())) == 0xFFFF;
+
+		const __m128i l_roll = _mm_shuffle_epi8(l_lut_roll,
+		    _mm_add_epi8(_mm_cmpeq_epi8(c, l_mask), l_hi_nibbles));
+		return(_mm_add_epi8(c, l_roll));
+	}
+
+	MMCPU_TARGET("ssse3") size_t
+	DecodeSSSE3(const unsigned char *in, size_t quads, unsigned char *out)
+	{
+		size_t l_q = 0;
+
+		/* 16 byte stores, 12 valid */
+		for (; l_q + 6 <= quads; l_q += 4, in += 16, out += 12) {
+			bool l_valid;
+			const __m128i l_values = DecodeLookupSSSE3(
+			    _mm_loadu_si128(reinterpret_cast<const __m128i *>(in)), l_valid);
+			if (!l_valid)
+				break;
+
+			const __m128i l_merged = _mm_madd_epi16(
+			    _mm_maddubs_epi16(l_values, _mm_set1_epi32(0x01400140)),
+			    _mm_set1_epi32(0x00011000));
+			const __m128i l_packed = _mm_shuffle_epi8(l_merged, _mm_setr_epi8(
+			    2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+			_mm_storeu_si128(reinterpret_cast<__m128i *>(out), l_packed);
+		}
+
+		return(l_q);
+	}
+
+	MMCPU_TARGET("ssse3") inline __m128i
+	EncodeLookupSSSE3(__m128i indices)
+	{
+		const __m128i l_shift_lut = _mm_setr_epi8(
+		    'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+		    '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62,
+		    '/' - 63, 'A', 0, 0);
+
+		__m128i l_result = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+		const __m128i l_less = _mm_cmpgt_epi8(_mm_set1_epi8(26), indices);
+		l_result = _mm_or_si128(l_result, _mm_and_si128(l_less, _mm_set1_epi8(13)));
+		return(_mm_add_epi8(_mm_shuffle_epi8(l_shift_lut, l_result), indices));
+	}
+
+	MMCPU_TARGET("ssse3") inline __m128i
+	EncodeSplitSSSE3(__m128i in)
+	{
+		in = _mm_shuffle_epi8(in, _mm_set_epi8(
+		    10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+		const __m128i l_t0 = _mm_and_si128(in, _mm_set1_epi32(0x0FC0FC00));
+		const __m128i l_t1 = _mm_mulhi_epu16(l_t0, _mm_set1_epi32(0x04000040));
+		const __m128i l_t2 = _mm_and_si128(in, _mm_set1_epi32(0x003F03F0));
+		const __m128i l_t3 = _mm_mullo_epi16(l_t2, _mm_set1_epi32(0x01000010));
+		return(_mm_or_si128(l_t1, l_t3));
+	}
+
+	MMCPU_TARGET("ssse3") size_t
+	EncodeSSSE3(const unsigned char *in, size_t triples, unsigned char *out)
+	{
+		size_t l_t = 0;
+
+		/* 16 byte loads, 12 used */
+		for (; l_t + 6 <= triples; l_t += 4, in += 12, out += 16) {
+			const __m128i l_indices = EncodeSplitSSSE3(
+			    _mm_loadu_si128(reinterpret_cast<const __m128i *>(in)));
+			_mm_storeu_si128(reinterpret_cast<__m128i *>(out),
+			    EncodeLookupSSSE3(l_indices));
+		}
+
+		return(l_t);
+	}
+
+	MMCPU_TARGET("avx2") size_t
+	DecodeAVX2(const unsigned char *in, size_t quads, unsigned char *out)
+	{
+		const __m256i l_lut_lo = _mm256_setr_epi8(
+		    0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+		    0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A,
+		    0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+		    0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+		const __m256i l_lut_hi = _mm256_setr_epi8(
+		    0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+		    0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+		    0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+		    0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+		const __m256i l_lut_roll = _mm256_setr_epi8(
+		    0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0,
+		    0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+		const __m256i l_mask = _mm256_set1_epi8(0x2F);
+
+		size_t l_q = 0;
+
+		/* 32 byte stores, 24 valid */
+		for (; l_q + 11 <= quads; l_q += 8, in += 32, out += 24) {
+			const __m256i l_c =
+			    _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in));
+
+			const __m256i l_hi_nibbles =
+			    _mm256_and_si256(_mm256_srli_epi32(l_c, 4), l_mask);
+			const __m256i l_lo = _mm256_shuffle_epi8(l_lut_lo,
+			    _mm256_and_si256(l_c, l_mask));
+			const __m256i l_hi = _mm256_shuffle_epi8(l_lut_hi, l_hi_nibbles);
+			if (!_mm256_testz_si256(l_lo, l_hi))
+				break;
+
+			const __m256i l_roll = _mm256_shuffle_epi8(l_lut_roll,
+			    _mm256_add_epi8(_mm256_cmpeq_epi8(l_c, l_mask), l_hi_nibbles));
+			const __m256i l_values = _mm256_add_epi8(l_c, l_roll);
+
+			const __m256i l_merged = _mm256_madd_epi16(
+			    _mm256_maddubs_epi16(l_values, _mm256_set1_epi32(0x01400140)),
+			    _mm256_set1_epi32(0x00011000));
+			__m256i l_packed = _mm256_shuffle_epi8(l_merged, _mm256_setr_epi8(
+			    2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+			    2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+			l_packed = _mm256_permutevar8x32_epi32(l_packed,
+			    _mm256_setr_epi32(0, 1, 2, 4, 5, 6, -1, -1));
+			_mm256_storeu_si256(reinterpret_cast<__m256i *>(out), l_packed);
+		}
+
+		return(l_q + DecodeSSSE3(in, quads - l_q, out));
+	}
+
+	MMCPU_TARGET("avx2") size_t
+	EncodeAVX2(const unsigned char *in, size_t triples, unsigned char *out)
+	{
+		const __m256i l_shuffle = _mm256_set_epi8(
+		    10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1,
+		    10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1);
+		const __m256i l_shift_lut = _mm256_setr_epi8(
+		    'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+		    '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62,
+		    '/' - 63, 'A', 0, 0,
+		    'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+		    '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62,
+		    '/' - 63, 'A', 0, 0);
+
+		size_t l_t = 0;
+
+		/* two 16 byte loads, 12 used from each */
+		for (; l_t + 10 <= triples; l_t += 8, in += 24, out += 32) {
+			__m256i l_in = _mm256_inserti128_si256(_mm256_castsi128_si256(
+			    _mm_loadu_si128(reinterpret_cast<const __m128i *>(in))),
+			    _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + 12)), 1);
+			l_in = _mm256_shuffle_epi8(l_in, l_shuffle);
+
+			const __m256i l_t0 = _mm256_and_si256(l_in, _mm256_set1_epi32(0x0FC0FC00));
+			const __m256i l_t1 = _mm256_mulhi_epu16(l_t0, _mm256_set1_epi32(0x04000040));
+			const __m256i l_t2 = _mm256_and_si256(l_in, _mm256_set1_epi32(0x003F03F0));
+			const __m256i l_t3 = _mm256_mullo_epi16(l_t2, _mm256_set1_epi32(0x01000010));
+			const __m256i l_indices = _mm256_or_si256(l_t1, l_t3);
+
+			__m256i l_result = _mm256_subs_epu8(l_indices, _mm256_set1_epi8(51));
+			const __m256i l_less = _mm256_cmpgt_epi8(_mm256_set1_epi8(26), l_indices);
+			l_result = _mm256_or_si256(l_result,
+			    _mm256_and_si256(l_less, _mm256_set1_epi8(13)));
+			l_result = _mm256_add_epi8(
+			    _mm256_shuffle_epi8(l_shift_lut, l_result), l_indices);
+			_mm256_storeu_si256(reinterpret_cast<__m256i *>(out), l_result);
+		}
+
+		return(l_t + EncodeSSSE3(in, triples - l_t, out));
+	}
+#endif
+
+#if MMCPU_NEON
+	inline uint8x16x4_t
+	LoadTableNEON(const unsigned char *table)
+	{
+		uint8x16x4_t l_table;
+		l_table.val[0] = vld1q_u8(table);
+		l_table.val[1] = vld1q_u8(table + 16);
+		l_table.val[2] = vld1q_u8(table + 32);
+		l_table.val[3] = vld1q_u8(table + 48);
+		return(l_table);
+	}
+
+	size_t
+	DecodeNEON(const unsigned char *in, size_t quads, unsigned char *out)
+	{
+		const uint8x16x4_t l_table_lo = LoadTableNEON(s_decoder64);
+		const uint8x16x4_t l_table_hi = LoadTableNEON(s_decoder64 + 64);
+		const uint8x16_t l_offset = vdupq_n_u8(0x40);
+
+		size_t l_q = 0;
+
+		for (; l_q + 16 <= quads; l_q += 16, in += 64, out += 48) {
+			const uint8x16x4_t l_c = vld4q_u8(in);
+			uint8x16_t l_v[4];
+			uint8x16_t l_error = vdupq_n_u8(0);
+
+			for (int l_k = 0; l_k < 4; ++l_k) {
+				/* 0..63 from the low table, 64..127 from the high one */
+				l_v[l_k] = vqtbx4q_u8(vqtbl4q_u8(l_table_lo, l_c.val[l_k]),
+				    l_table_hi, veorq_u8(l_c.val[l_k], l_offset));
+				l_error = vorrq_u8(l_error, vorrq_u8(l_v[l_k],
+				    vcgeq_u8(l_c.val[l_k], vdupq_n_u8(0x80))));
+			}
+
+			if (vmaxvq_u8(l_error) & 0x80)
+				break;
+
+			uint8x16x3_t l_o;
+			l_o.val[0] = vorrq_u8(vshlq_n_u8(l_v[0], 2), vshrq_n_u8(l_v[1], 4));
+			l_o.val[1] = vorrq_u8(vshlq_n_u8(l_v[1], 4), vshrq_n_u8(l_v[2], 2));
+			l_o.val[2] = vorrq_u8(vshlq_n_u8(l_v[2], 6), l_v[3]);
+			vst3q_u8(out, l_o);
+		}
+
+		return(l_q);
+	}
+
+	size_t
+	EncodeNEON(const unsigned char *in, size_t triples, unsigned char *out)
+	{
+		const uint8x16x4_t l_table = LoadTableNEON(s_encoder64);
+		const uint8x16_t l_mask = vdupq_n_u8(0x3F);
+
+		size_t l_t = 0;
+
+		for (; l_t + 16 <= triples; l_t += 16, in += 48, out += 64) {
+			const uint8x16x3_t l_s = vld3q_u8(in);
+			uint8x16x4_t l_o;
+
+			l_o.val[0] = vshrq_n_u8(l_s.val[0], 2);
+			l_o.val[1] = vandq_u8(vorrq_u8(vshlq_n_u8(l_s.val[0], 4),
+			    vshrq_n_u8(l_s.val[1], 4)), l_mask);
+			l_o.val[2] = vandq_u8(vorrq_u8(vshlq_n_u8(l_s.val[1], 2),
+			    vshrq_n_u8(l_s.val[2], 6)), l_mask);
+			l_o.val[3] = vandq_u8(l_s.val[2], l_mask);
+
+			for (int l_k = 0; l_k < 4; ++l_k)
+				l_o.val[l_k] = vqtbl4q_u8(l_table, l_o.val[l_k]);
+
+			vst4q_u8(out, l_o);
+		}
+
+		return(l_t);
+	}
+#endif
+
+	DecodeKernel
+	SelectDecodeKernel(void)
+	{
+#if MMCPU_X86
+		if (CPU::HasAVX2())
+			return(DecodeAVX2);
+		if (CPU::HasSSSE3())
+			return(DecodeSSSE3);
+#elif MMCPU_NEON
+		return(DecodeNEON);
+#endif
+		return(DecodeScalar);
+	}
+
+	EncodeKernel
+	SelectEncodeKernel(void)
+	{
+#if MMCPU_X86
+		if (CPU::HasAVX2())
+			return(EncodeAVX2);
+		if (CPU::HasSSSE3())
+			return(EncodeSSSE3);
+#elif MMCPU_NEON
+		return(EncodeNEON);
+#endif
+		return(EncodeScalar);
+	}
+
+	size_t
+	DecodeQuads(const unsigned char *in, size_t quads, unsigned char *out)
+	{
+		static const DecodeKernel s_kernel = SelectDecodeKernel();
+
+		const size_t l_done = s_kernel(in, quads, out);
+		return(l_done + DecodeScalar(in + l_done * 4, quads - l_done,
+		    out + l_done * 3));
+	}
+
+	void
+	EncodeTriples(const unsigned char *in, size_t triples, unsigned char *out)
+	{
+		static const EncodeKernel s_kernel = SelectEncodeKernel();
+
+		const size_t l_done = s_kernel(in, triples, out);
+		EncodeScalar(in + l_done * 3, triples - l_done, out + l_done * 4);
+	}
+
 } /********************************************** Core::<anonymous> Namespace */
 
 size_t
 Base64::Decode(const char *in, size_t in_size, char **out)
 {
-	/* check in buffer */
-	if (in_size % 4) {
+	const size_t l_out_size = DecodedSize(in, in_size);
+
+	if (in_size > 0 && l_out_size == 0) {
 		MMWARNING("Base64 decode in buffer incomplete.");
+		*out = 0;
 		return(0);
 	}
 
-	/* calculate out data size */
-	size_t l_out_size = ((in_size * 3) / 4) + 1 /* null-term */;
-	if (in[in_size - 2] == '=')
-	    l_out_size -= 2;
-	else if (in[in_size - 1] == '=')
-	    l_out_size -= 1;
-
 	/* TODO(gamaral) replace with double buffered allocator */
-	*out = new char[l_out_size];
+	*out = new char[l_out_size + 1 /* null-term */];
 
-	char *l_out = *out;
-	char *l_out_max = *out + l_out_size - 1 /* null-term */;
+	if (!DecodeTo(in, in_size, *out)) {
+		MMWARNING("Base64 decode in buffer is malformed.");
+		delete[] *out, *out = 0;
+		return(0);
+	}
 
-	for (size_t i = 0; i < in_size; i = i + 4) {
-		l_out[0] = static_cast<char>
-		    ( s_decoder64[static_cast<int>(in[i])]   << 2
-		    | s_decoder64[static_cast<int>(in[i+1])] >> 4);
+	/* null-term */
+	(*out)[l_out_size] = '\0';
 
-		if (++l_out >= l_out_max) break;
-		*l_out = static_cast<char>
-		    ( s_decoder64[static_cast<int>(in[i+1])] << 4
-		    | s_decoder64[static_cast<int>(in[i+2])] >> 2);
+	return(l_out_size + 1);
+}
 
-		if (++l_out >= l_out_max) break;
-		*l_out = static_cast<char>
-		    ( s_decoder64[static_cast<int>(in[i+2])] << 6
-		    | s_decoder64[static_cast<int>(in[i+3])]);
+size_t
+Base64::Encode(const char *in, size_t in_size, char **out)
+{
+	const size_t l_out_size = EncodedSize(in_size);
 
-		++l_out;
-	}
+	/* TODO(gamaral) replace with double buffered allocator */
+	*out = new char[l_out_size + 1 /* null-term */];
+
+	EncodeTo(in, in_size, *out);
 
 	/* null-term */
-	*l_out_max = '\0';
+	(*out)[l_out_size] = '\0';
 
 	return(l_out_size);
 }
 
 size_t
-Base64::Encode(const char *in, size_t in_size, char **out)
+Base64::DecodedSize(const char *in, size_t in_size)
 {
-	const size_t l_out_size = ((in_size * 4) / 3) + (in_size % 3 ? 3 : 0);
+	if (in_size == 0 || in_size % 4)
+		return(0);
 
-	/* TODO(gamaral) replace with double buffered allocator */
-	*out = new char[l_out_size + 1 /* null-term */];
+	size_t l_padding = 0;
+	if (in[in_size - 1] == '=')
+		l_padding = (in[in_size - 2] == '=' ? 2 : 1);
 
-	char *l_out = *out;
+	return((in_size / 4) * 3 - l_padding);
+}
 
-	for (size_t i = 0; i < in_size; i = i + 3) {
-		const size_t l_pad = (i + 3 < in_size ? 0 : (i + 3) - in_size);
+size_t
+Base64::EncodedSize(size_t in_size)
+{
+	return(((in_size + 2) / 3) * 4);
+}
 
-		l_out[0] = static_cast<char>
-		    (s_encoder64[in[i] >> 2]);
-		l_out[1] = static_cast<char>
-		    (s_encoder64[((in[i] & 0x03) << 4) | ((in[i+1] & 0xF0) >> 4)]);
-		l_out[2] = (2 == l_pad ? '=' : static_cast<char>
-		    (s_encoder64[((in[i+1] & 0x0F) << 2) | ((in[i+2] & 0xC0) >> 6)]));
-		l_out[3] = (1 <= l_pad ? '=' : static_cast<char>
-		    (s_encoder64[in[i+2] & 0x3F]));
-		l_out += 4;
-	}
+bool
+Base64::DecodeTo(const char *in, size_t in_size, char *out)
+{
+	if (in_size % 4)
+		return(false);
+	if (in_size == 0)
+		return(true);
 
-	/* null-term */
-	*l_out = '\0';
+	const unsigned char *l_in = reinterpret_cast<const unsigned char *>(in);
+	unsigned char *l_out = reinterpret_cast<unsigned char *>(out);
 
-	return(l_out_size);
+	/* padding may only show up in the last quad */
+	const size_t l_quads = in_size / 4;
+	const bool l_padded = (in[in_size - 1] == '=');
+	const size_t l_full = l_padded ? l_quads - 1 : l_quads;
+
+	if (DecodeQuads(l_in, l_full, l_out) != l_full)
+		return(false);
+
+	if (!l_padded)
+		return(true);
+
+	l_in += l_full * 4;
+	l_out += l_full * 3;
+
+	const unsigned char l_a = s_decoder64[l_in[0]];
+	const unsigned char l_b = s_decoder64[l_in[1]];
+	if ((l_a | l_b) & 0x80)
+		return(false);
+
+	l_out[0] = static_cast<unsigned char>(l_a << 2 | l_b >> 4);
+
+	/* "xx==", leftover bits must be zero */
+	if (l_in[2] == '=')
+		return((l_b & 0x0F) == 0);
+
+	/* "xxx=" */
+	const unsigned char l_c = s_decoder64[l_in[2]];
+	if ((l_c & 0x80) || (l_c & 0x03))
+		return(false);
+
+	l_out[1] = static_cast<unsigned char>(l_b << 4 | l_c >> 2);
+	return(true);
+}
+
+void
+Base64::EncodeTo(const char *in, size_t in_size, char *out)
+{
+	const unsigned char *l_in = reinterpret_cast<const unsigned char *>(in);
+	unsigned char *l_out = reinterpret_cast<unsigned char *>(out);
+
+	const size_t l_triples = in_size / 3;
+	EncodeTriples(l_in, l_triples, l_out);
+
+	l_in += l_triples * 3;
+	l_out += l_triples * 4;
+
+	switch (in_size % 3) {
+	case 1:
+		l_out[0] = s_encoder64[l_in[0] >> 2];
+		l_out[1] = s_encoder64[(l_in[0] & 0x03) << 4];
+		l_out[2] = '=';
+		l_out[3] = '=';
+		break;
+	case 2:
+		l_out[0] = s_encoder64[l_in[0] >> 2];
+		l_out[1] = s_encoder64[((l_in[0] & 0x03) << 4) | (l_in[1] >> 4)];
+		l_out[2] = s_encoder64[(l_in[1] & 0x0F) << 2];
+		l_out[3] = '=';
+		break;
+	}
 }
 
 } /*********************************************************** Core Namespace */
@@ -0,0 +1,342 @@
+/*
+ * Copyright (c) 2013, Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ * All rights reserved.
+ *
+ * This file is part of Marshmallow Game Engine.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE CONTRIBUTORS ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are
+ * those of the authors and should not be interpreted as representing official
+ * policies, either expressed or implied, of the project as a whole.
+ */
+
+#include "core/base64io.h"
+
+/*!
+ * @file
+ *
+ * @author Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ */
+
+#include "core/base64.h"
+#include "core/logger.h"
+#include "core/shared.h"
+
+#include <cassert>
+#include <climits>
+#include <cstring>
+
+MARSHMALLOW_NAMESPACE_BEGIN
+namespace Core { /******************************************** Core Namespace */
+
+struct Base64IO::Private
+{
+	Private(const SharedDataIO &source_, size_t window_size_)
+	    : source(source_)
+	    , window_size(window_size_ & ~size_t(3))
+	    , window(new char[window_size])
+	    , chunk(new char[(window_size / 4) * 3])
+	    , pending(0)
+	    , chunk_pos(0)
+	    , chunk_len(0)
+	    , origin(0)
+	    , cursor(0)
+	    , mode(DIOInvalid)
+	    , finished(false)
+	    , padded(false)
+	    , failed(false)
+	    , eof(false)
+	{}
+
+	~Private(void)
+	{
+		delete[] chunk, chunk = 0;
+		delete[] window, window = 0;
+	}
+
+	bool refill(void);
+	size_t decode(void *buffer, size_t bsize);
+	bool rewind(void);
+	bool skip(long count);
+	void fail(const char *reason);
+
+	SharedDataIO source;
+	size_t   window_size;
+	char    *window;
+	char    *chunk;
+	size_t   pending;
+	size_t   chunk_pos;
+	size_t   chunk_len;
+	long     origin;
+	long     cursor;
+	DIOMode  mode;
+	bool     finished;
+	bool     padded;
+	bool     failed;
+	bool     eof;
+};
+
+void
+Base64IO::Private::fail(const char *r)
+{
+	MMERROR(r);
+	finished = failed = true;
+}
+
+bool
+Base64IO::Private::refill(void)
+{
+	/* window starts with the incomplete quad left over from last time */
+	const size_t l_read =
+	    source->read(window + pending, window_size - pending);
+	const size_t l_have = pending + l_read;
+
+	if (l_read == 0) {
+		if (pending > 0)
+			fail("Base64 stream ended in the middle of a quad.");
+		finished = true;
+		return(false);
+	}
+
+	if (padded) {
+		fail("Base64 stream continues after padding.");
+		return(false);
+	}
+
+	const size_t l_usable = l_have & ~size_t(3);
+	pending = l_have - l_usable;
+
+	if (l_usable > 0) {
+		chunk_len = Base64::DecodedSize(window, l_usable);
+		if (chunk_len == 0 || !Base64::DecodeTo(window, l_usable, chunk)) {
+			fail("Malformed Base64 stream.");
+			return(false);
+		}
+		padded = (window[l_usable - 1] == '=');
+	}
+	else chunk_len = 0;
+
+	chunk_pos = 0;
+	memmove(window, window + l_usable, pending);
+	return(true);
+}
+
+size_t
+Base64IO::Private::decode(void *b, size_t bs)
+{
+	char *l_buffer = reinterpret_cast<char *>(b);
+	size_t l_produced = 0;
+
+	while (l_produced < bs) {
+		if (chunk_pos == chunk_len && (finished || !refill()))
+			break;
+
+		size_t l_count = chunk_len - chunk_pos;
+		if (l_count > bs - l_produced)
+			l_count = bs - l_produced;
+
+		memcpy(l_buffer + l_produced, chunk + chunk_pos, l_count);
+		chunk_pos += l_count;
+		l_produced += l_count;
+	}
+
+	cursor += long(l_produced);
+	return(l_produced);
+}
+
+bool
+Base64IO::Private::rewind(void)
+{
+	if (!source->seek(origin, DIOSet)) {
+		MMERROR("Failed to rewind source DIO.");
+		return(false);
+	}
+
+	pending = chunk_pos = chunk_len = 0;
+	cursor = 0;
+	finished = padded = failed = false;
+	return(true);
+}
+
+bool
+Base64IO::Private::skip(long c)
+{
+	char l_scratch[1024];
+
+	while (c > 0) {
+		const size_t l_chunk =
+		    c < long(sizeof(l_scratch)) ? size_t(c) : sizeof(l_scratch);
+		const size_t l_skipped = decode(l_scratch, l_chunk);
+		if (l_skipped == 0)
+			break;
+		c -= long(l_skipped);
+	}
+
+	return(c <= 0);
+}
+
+Base64IO::Base64IO(const SharedDataIO &s, size_t w)
+    : m_p(new Private(s, w))
+{
+	assert(w >= 4 && "Invalid window size!");
+	open(DIOReadOnly);
+}
+
+Base64IO::~Base64IO(void)
+{
+	close();
+	delete m_p, m_p = 0;
+}
+
+bool
+Base64IO::failed(void) const
+{
+	return(m_p->failed);
+}
+
+bool
+Base64IO::open(DIOMode m)
+{
+	if (isOpen()) {
+		MMWARNING("Device is already open.");
+		return(false);
+	}
+
+	if ((m & DIOReadWrite) != DIOReadOnly) {
+		MMERROR("Base64 streams can only be opened read-only.");
+		return(false);
+	}
+
+	if (!m_p->source
+	    || (!m_p->source->isOpen() && !m_p->source->open(DIOReadOnly))) {
+		MMERROR("Source DIO is closed!");
+		return(false);
+	}
+
+	if ((m_p->origin = m_p->source->tell()) == -1) {
+		MMERROR("Failed to get current position for source DIO.");
+		return(false);
+	}
+
+	m_p->pending = m_p->chunk_pos = m_p->chunk_len = 0;
+	m_p->cursor = 0;
+	m_p->mode = m;
+	m_p->finished = m_p->padded = m_p->failed = false;
+	m_p->eof = false;
+
+	return(true);
+}
+
+void
+Base64IO::close(void)
+{
+	if (!isOpen())
+		return;
+
+	m_p->pending = m_p->chunk_pos = m_p->chunk_len = 0;
+	m_p->cursor = 0;
+	m_p->mode = DIOInvalid;
+	m_p->finished = m_p->padded = false;
+	m_p->eof = false;
+}
+
+DIOMode
+Base64IO::mode(void) const
+{
+	return(m_p->mode);
+}
+
+bool
+Base64IO::isOpen(void) const
+{
+	return(m_p->mode != DIOInvalid);
+}
+
+bool
+Base64IO::atEOF(void) const
+{
+	return(m_p->eof);
+}
+
+size_t
+Base64IO::read(void *b, size_t bs)
+{
+	assert(isOpen() && "Device is not open!");
+
+	const size_t l_rcount = m_p->decode(b, bs);
+
+	/* set end-of-file flag */
+	m_p->eof = (bs > l_rcount);
+
+	return(l_rcount);
+}
+
+size_t
+Base64IO::write(const void *, size_t)
+{
+	MMERROR("Base64 streams are read-only.");
+	return(0);
+}
+
+bool
+Base64IO::seek(long o, DIOSeek on)
+{
+	if (!isOpen())
+		return(false);
+
+	long l_cursor;
+
+	switch (on) {
+	case DIOSet:
+		l_cursor = o;
+		break;
+	case DIOCurrent:
+		l_cursor = m_p->cursor + o;
+		break;
+	case DIOEnd:
+		m_p->skip(LONG_MAX);
+		l_cursor = m_p->cursor + o;
+		break;
+	default: return(false);
+	}
+
+	if (l_cursor < 0)
+		return(false);
+
+	if (l_cursor < m_p->cursor && !m_p->rewind())
+		return(false);
+
+	/* reset end-of-file flag */
+	m_p->eof = false;
+
+	return(m_p->skip(l_cursor - m_p->cursor));
+}
+
+long
+Base64IO::tell(void) const
+{
+	return(m_p->cursor);
+}
+
+} /*********************************************************** Core Namespace */
+MARSHMALLOW_NAMESPACE_END
@@ -272,6 +272,17 @@ BufferIO::tell(void) const
 	return(m_p->cursor);
 }
 
+const void *
+BufferIO::view(size_t o, size_t l) const
+{
+	const size_t l_size = size_t(m_p->size);
+
+	if (!m_p->const_buffer || o > l_size || l > l_size - o)
+		return(0);
+
+	return(m_p->const_buffer + o);
+}
+
 } /*********************************************************** Core Namespace */
 MARSHMALLOW_NAMESPACE_END
 
@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2013, Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ * All rights reserved.
+ *
+ * This file is part of Marshmallow Game Engine.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE CONTRIBUTORS ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are
+ * those of the authors and should not be interpreted as representing official
+ * policies, either expressed or implied, of the project as a whole.
+ */
+
+#include "cpu_p.h"
+
+/*!
+ * @file
+ *
+ * @author Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ */
+
+#if MMCPU_X86 && defined(_MSC_VER)
+#   include <intrin.h>
+#endif
+
+MARSHMALLOW_NAMESPACE_BEGIN
+namespace Core { /******************************************** Core Namespace */
+namespace { /************************************ Core::<anonymous> Namespace */
+
+#if MMCPU_X86 && defined(_MSC_VER)
+	struct Features
+	{
+		bool ssse3;
+		bool sse42;
+		bool avx2;
+
+		Features(void)
+		    : ssse3(false), sse42(false), avx2(false)
+		{
+			int l_info[4];
+
+			__cpuid(l_info, 0);
+			const int l_max = l_info[0];
+
+			__cpuid(l_info, 1);
+			ssse3 = (l_info[2] & (1 << 9)) != 0;
+			sse42 = (l_info[2] & (1 << 20)) != 0;
+
+			/* AVX state must be enabled by the OS (OSXSAVE + XCR0) */
+			const bool l_avx = (l_info[2] & (1 << 27)) && (l_info[2] & (1 << 28))
+			    && (_xgetbv(0) & 0x6) == 0x6;
+
+			if (l_avx && l_max >= 7) {
+				__cpuidex(l_info, 7, 0);
+				avx2 = (l_info[1] & (1 << 5)) != 0;
+			}
+		}
+	};
+
+	const Features &
+	Detect(void)
+	{
+		static const Features s_features;
+		return(s_features);
+	}
+#endif
+
+} /********************************************** Core::<anonymous> Namespace */
+
+/*
+ * These may be called before static constructors have run, GCC's
+ * __builtin_cpu_init() is safe to call more than once.
+ */
+
+bool
+CPU::HasSSSE3(void)
+{
+#if MMCPU_X86 && defined(_MSC_VER)
+	return(Detect().ssse3);
+#elif MMCPU_X86
+	__builtin_cpu_init();
+	return(__builtin_cpu_supports("ssse3"));
+#else
+	return(false);
+#endif
+}
+
+bool
+CPU::HasSSE42(void)
+{
+#if MMCPU_X86 && defined(_MSC_VER)
+	return(Detect().sse42);
+#elif MMCPU_X86
+	__builtin_cpu_init();
+	return(__builtin_cpu_supports("sse4.2"));
+#else
+	return(false);
+#endif
+}
+
+bool
+CPU::HasAVX2(void)
+{
+#if MMCPU_X86 && defined(_MSC_VER)
+	return(Detect().avx2);
+#elif MMCPU_X86
+	__builtin_cpu_init();
+	return(__builtin_cpu_supports("avx2"));
+#else
+	return(false);
+#endif
+}
+
+} /*********************************************************** Core Namespace */
+MARSHMALLOW_NAMESPACE_END
+
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2013, Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ * All rights reserved.
+ *
+ * This file is part of Marshmallow Game Engine.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE CONTRIBUTORS ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are
+ * those of the authors and should not be interpreted as representing official
+ * policies, either expressed or implied, of the project as a whole.
+ */
+
+#pragma once
+
+/*!
+ * @file
+ *
+ * @author Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ */
+
+#ifndef MARSHMALLOW_CORE_CPU_P_H
+#define MARSHMALLOW_CORE_CPU_P_H 1
+
+#include "core/environment.h"
+#include "core/namespace.h"
+
+/*
+ * MMCPU_X86 is set when x86 kernels can be compiled without global ISA
+ * flags, MMCPU_TARGET() enables an instruction set for one function.
+ * Callers must check the matching CPU::Has*() before calling into it.
+ */
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && \
+    (defined(__clang__) || __GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))
+#   define MMCPU_X86 1
+#   define MMCPU_TARGET(x) __attribute__((target(x)))
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#   define MMCPU_X86 1
+#   define MMCPU_TARGET(x)
+#else
+#   define MMCPU_X86 0
+#endif
+
+/* NEON is part of the AArch64 base ISA, no runtime check required */
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#   define MMCPU_NEON 1
+#else
+#   define MMCPU_NEON 0
+#endif
+
+MARSHMALLOW_NAMESPACE_BEGIN
+namespace Core { /******************************************** Core Namespace */
+
+/*! @brief Runtime CPU feature detection
+ *
+ */
+namespace CPU { /**************************************** Core::CPU Namespace */
+
+	bool HasSSSE3(void);
+	bool HasSSE42(void);
+	bool HasAVX2(void);
+
+} /****************************************************** Core::CPU Namespace */
+} /*********************************************************** Core Namespace */
+MARSHMALLOW_NAMESPACE_END
+
+#endif
@@ -0,0 +1,244 @@
+/*
+ * Copyright (c) 2013, Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ * All rights reserved.
+ *
+ * This file is part of Marshmallow Game Engine.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE CONTRIBUTORS ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are
+ * those of the authors and should not be interpreted as representing official
+ * policies, either expressed or implied, of the project as a whole.
+ */
+
+#include "core/deflateio.h"
+
+/*!
+ * @file
+ *
+ * @author Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ */
+
+#include "core/logger.h"
+#include "core/shared.h"
+
+#include <cassert>
+#include <climits>
+
+#include <zlib.h>
+
+MARSHMALLOW_NAMESPACE_BEGIN
+namespace Core { /******************************************** Core Namespace */
+
+struct DeflateIO::Private
+{
+	Private(const SharedDataIO &sink_, Format format_, int level_,
+	    size_t window_size_)
+	    : sink(sink_)
+	    , window(new Bytef[window_size_])
+	    , window_size(window_size_)
+	    , format(format_)
+	    , level(level_)
+	    , cursor(0)
+	    , mode(DIOInvalid)
+	    , failed(false)
+	{}
+
+	~Private(void)
+	    { delete[] window, window = 0; }
+
+	bool drain(int flush);
+
+	SharedDataIO sink;
+	z_stream stream;
+	Bytef   *window;
+	size_t   window_size;
+	Format   format;
+	int      level;
+	long     cursor;
+	DIOMode  mode;
+	bool     failed;
+};
+
+bool
+DeflateIO::Private::drain(int f)
+{
+	if (failed)
+		return(false);
+
+	do {
+		stream.next_out  = window;
+		stream.avail_out = static_cast<uInt>(window_size);
+
+		const int l_rc = ::deflate(&stream, f);
+		if (l_rc == Z_STREAM_ERROR) {
+			MMERROR("Failed during deflation.");
+			failed = true;
+			return(false);
+		}
+
+		const size_t l_produced = window_size - stream.avail_out;
+		if (l_produced && l_produced != sink->write(window, l_produced)) {
+			MMERROR("Failed to write compressed data to sink DIO.");
+			failed = true;
+			return(false);
+		}
+	} while (stream.avail_out == 0);
+
+	return(true);
+}
+
+DeflateIO::DeflateIO(const SharedDataIO &s, Format f, int l, size_t w)
+    : m_p(new Private(s, f, l, w))
+{
+	assert(w > 0 && w <= UINT_MAX && "Invalid window size!");
+	open(DIOWriteOnly);
+}
+
+DeflateIO::~DeflateIO(void)
+{
+	close();
+	delete m_p, m_p = 0;
+}
+
+bool
+DeflateIO::flush(void)
+{
+	if (!isOpen())
+		return(false);
+
+	return(m_p->drain(Z_SYNC_FLUSH));
+}
+
+bool
+DeflateIO::open(DIOMode m)
+{
+	if (isOpen()) {
+		MMWARNING("Device is already open.");
+		return(false);
+	}
+
+	if ((m & DIOReadWrite) != DIOWriteOnly) {
+		MMERROR("Deflate streams can only be opened write-only.");
+		return(false);
+	}
+
+	if (!m_p->sink
+	    || (!m_p->sink->isOpen() && !m_p->sink->open(DIOWriteOnly))) {
+		MMERROR("Sink DIO is closed!");
+		return(false);
+	}
+
+	m_p->stream.zalloc = Z_NULL;
+	m_p->stream.zfree  = Z_NULL;
+	m_p->stream.opaque = Z_NULL;
+
+	const int l_bits =
+	    m_p->format == GzipFormat ? MAX_WBITS + 16 : MAX_WBITS;
+
+	if (deflateInit2(&m_p->stream, m_p->level, Z_DEFLATED, l_bits, 8,
+	        Z_DEFAULT_STRATEGY) != Z_OK) {
+		MMWARNING("Failed to initialize deflate.");
+		return(false);
+	}
+
+	m_p->cursor = 0;
+	m_p->mode = m;
+	m_p->failed = false;
+
+	return(true);
+}
+
+void
+DeflateIO::close(void)
+{
+	if (!isOpen())
+		return;
+
+	m_p->stream.next_in  = Z_NULL;
+	m_p->stream.avail_in = 0;
+
+	if (!m_p->drain(Z_FINISH))
+		MMERROR("Compressed stream was left incomplete.");
+
+	deflateEnd(&m_p->stream);
+
+	m_p->cursor = 0;
+	m_p->mode = DIOInvalid;
+}
+
+DIOMode
+DeflateIO::mode(void) const
+{
+	return(m_p->mode);
+}
+
+bool
+DeflateIO::isOpen(void) const
+{
+	return(m_p->mode != DIOInvalid);
+}
+
+bool
+DeflateIO::atEOF(void) const
+{
+	return(false);
+}
+
+size_t
+DeflateIO::read(void *, size_t)
+{
+	MMERROR("Deflate streams are write-only.");
+	return(0);
+}
+
+size_t
+DeflateIO::write(const void *b, size_t bs)
+{
+	assert(isOpen() && "Device is not open!");
+	assert(bs <= UINT_MAX && "Buffer too large!");
+
+	m_p->stream.next_in  = reinterpret_cast<Bytef *>(const_cast<void *>(b));
+	m_p->stream.avail_in = static_cast<uInt>(bs);
+
+	if (!m_p->drain(Z_NO_FLUSH))
+		return(0);
+
+	m_p->cursor += long(bs);
+	return(bs);
+}
+
+bool
+DeflateIO::seek(long, DIOSeek)
+{
+	return(false);
+}
+
+long
+DeflateIO::tell(void) const
+{
+	return(m_p->cursor);
+}
+
+} /*********************************************************** Core Namespace */
+MARSHMALLOW_NAMESPACE_END
+
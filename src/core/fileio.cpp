@@ -40,6 +40,7 @@
 
 #include "core/identifier.h"
 #include "core/logger.h"
+#include "core/packio.h"
 
 #include <cassert>
 #include <cstring>
@@ -52,12 +53,14 @@ struct FileIO::Private
 	Identifier filename;
 	DIOMode    mode;
 	FILE      *handle;
+	PackIO    *entry;
 };
 
 FileIO::FileIO(void)
     : m_p(new Private)
 {
 	m_p->handle = 0;
+	m_p->entry = 0;
 	m_p->mode = DIOInvalid;
 }
 
@@ -65,6 +68,7 @@ FileIO::FileIO(const Identifier &fn, DIOMode m)
     : m_p(new Private)
 {
 	m_p->handle = 0;
+	m_p->entry = 0;
 	m_p->mode = DIOInvalid;
 	setFileName(fn);
 	open(m);
@@ -101,6 +105,24 @@ FileIO::open(DIOMode m)
 		return(false);
 	}
 
+	/* asset pack entries */
+	if (PackIO::IsPackPath(m_p->filename)) {
+		if (m & DIOWriteOnly) {
+			MMERROR("Asset pack entries are read-only.");
+			return(false);
+		}
+
+		PackIO *l_entry = new PackIO(m_p->filename, DIOReadOnly);
+		if (!l_entry->isOpen()) {
+			delete l_entry;
+			return(false);
+		}
+
+		m_p->entry = l_entry;
+		m_p->mode = m;
+		return(true);
+	}
+
 	char l_mode[4];
 
 	/* null terminate */
@@ -127,7 +149,7 @@ FileIO::open(DIOMode m)
 	m_p->handle = fopen(m_p->filename, l_mode);
 	m_p->mode = m;
 
-	return(m_p->handle != 0);
+	return(m_p->handle != 0 || m_p->entry != 0);
 }
 
 void
@@ -135,6 +157,7 @@ FileIO::close(void)
 {
 	if (m_p->handle)
 		fclose(m_p->handle);
+	delete m_p->entry, m_p->entry = 0;
 	m_p->handle = 0;
 	m_p->mode = DIOInvalid;
 	m_p->filename = Identifier();
@@ -149,12 +172,14 @@ FileIO::mode(void) const
 bool
 FileIO::isOpen(void) const
 {
-	return(m_p->handle != 0);
+	return(m_p->handle != 0 || m_p->entry != 0);
 }
 
 bool
 FileIO::atEOF(void) const
 {
+	if (m_p->entry)
+		return(m_p->entry->atEOF());
 	return(feof(m_p->handle));
 }
 
@@ -162,6 +187,8 @@ FileIO::atEOF(void) const
 size_t
 FileIO::read(void *b, size_t bs)
 {
+	if (m_p->entry)
+		return(m_p->entry->read(b, bs));
 	assert(m_p->handle && "Invalid file handle!");
 	return(fread(b, 1, bs, m_p->handle));
 }
@@ -169,6 +196,8 @@ FileIO::read(void *b, size_t bs)
 size_t
 FileIO::write(const void *b, size_t bs)
 {
+	if (m_p->entry)
+		return(m_p->entry->write(b, bs));
 	assert(m_p->handle && "Invalid file handle!");
 	return(fwrite(b, 1, bs, m_p->handle));
 }
@@ -176,6 +205,8 @@ FileIO::write(const void *b, size_t bs)
 bool
 FileIO::seek(long o, DIOSeek on)
 {
+	if (m_p->entry)
+		return(m_p->entry->seek(o, on));
 	assert(m_p->handle && "Invalid file handle!");
 	int l_origin;
 
@@ -195,13 +226,25 @@ FileIO::seek(long o, DIOSeek on)
 long
 FileIO::tell(void) const
 {
+	if (m_p->entry)
+		return(m_p->entry->tell());
 	assert(m_p->handle && "Invalid file handle!");
 	return(ftell(m_p->handle));
 }
 
+const void *
+FileIO::view(size_t o, size_t l) const
+{
+	if (m_p->entry)
+		return(m_p->entry->view(o, l));
+	return(0);
+}
+
 size_t
 FileIO::size(void) const
 {
+	if (m_p->entry)
+		return(m_p->entry->size());
 	assert(m_p->handle && "Invalid file handle!");
 	const long l_cursor = ftell(m_p->handle);
 	if (l_cursor == -1) {
@@ -0,0 +1,228 @@
+/*
+ * Copyright (c) 2013, Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ * All rights reserved.
+ *
+ * This file is part of Marshmallow Game Engine.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE CONTRIBUTORS ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are
+ * those of the authors and should not be interpreted as representing official
+ * policies, either expressed or implied, of the project as a whole.
+ */
+
+#include "core/framearena.h"
+
+/*!
+ * @file
+ *
+ * @author Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ */
+
+#include "core/logger.h"
+
+#include "core/thread_p.h"
+
+MARSHMALLOW_NAMESPACE_BEGIN
+namespace Core { /******************************************** Core Namespace */
+namespace FrameArena { /************************** Core::FrameArena Namespace */
+namespace { /************************ Core::FrameArena::<anonymous> Namespace */
+
+	/* heap allocation that didn't fit, freed on reset */
+	struct Spill
+	{
+		Spill *next;
+	};
+
+	struct Buffer
+	{
+		char          *storage;
+		char          *data;
+		volatile long  offset;
+		long           capacity;
+		Spill         *spills;
+		size_t         spilled;
+	};
+
+	Buffer        s_buffers[2];
+	int           s_current = 0;
+	size_t        s_capacity = DefaultCapacity;
+	unsigned long s_spill_count = 0;
+	Thread::Mutex s_lock;
+
+	inline size_t
+	Round(size_t size)
+	{
+		return((size + Alignment - 1) & ~static_cast<size_t>(Alignment - 1));
+	}
+
+	inline char *
+	Align(char *p)
+	{
+		const size_t l_address = reinterpret_cast<size_t>(p);
+		return(p + (Round(l_address) - l_address));
+	}
+
+	/* both locked */
+	void
+	Resize(Buffer &buffer, size_t capacity)
+	{
+		delete[] buffer.storage;
+		buffer.storage = new char[capacity + Alignment];
+		buffer.data = Align(buffer.storage);
+		buffer.capacity = static_cast<long>(capacity);
+	}
+
+	void
+	Reset(Buffer &buffer)
+	{
+		s_lock.lock();
+
+		while (buffer.spills) {
+			Spill *l_next = buffer.spills->next;
+			delete[] reinterpret_cast<char *>(buffer.spills);
+			buffer.spills = l_next;
+		}
+
+		/* grow to fit what the last frame needed */
+		if (buffer.spilled) {
+			const size_t l_needed = static_cast<size_t>(buffer.offset) + buffer.spilled;
+			while (s_capacity < l_needed)
+				s_capacity *= 2;
+			MMDEBUG("Frame arena grown to " << s_capacity << " bytes.");
+			buffer.spilled = 0;
+		}
+
+		if (buffer.storage && static_cast<size_t>(buffer.capacity) < s_capacity)
+			Resize(buffer, s_capacity);
+
+		buffer.offset = 0;
+
+		s_lock.unlock();
+	}
+
+	void *
+	Overflow(Buffer &buffer, size_t size)
+	{
+		s_lock.lock();
+
+		/* first allocation */
+		if (!buffer.storage) {
+			Resize(buffer, s_capacity);
+			s_lock.unlock();
+			return(Allocate(size));
+		}
+
+		char *l_chunk = new char[Round(sizeof(Spill)) + size + Alignment];
+		Spill *l_spill = reinterpret_cast<Spill *>(l_chunk);
+		l_spill->next = buffer.spills;
+		buffer.spills = l_spill;
+		buffer.spilled += size;
+		++s_spill_count;
+
+		s_lock.unlock();
+
+		return(Align(l_chunk + sizeof(Spill)));
+	}
+
+} /********************************** Core::FrameArena::<anonymous> Namespace */
+
+void *
+Allocate(size_t size)
+{
+	Buffer &l_buffer = s_buffers[s_current];
+	const long l_size = static_cast<long>(Round(size));
+
+	long l_offset;
+	do {
+		l_offset = l_buffer.offset;
+		if (l_offset + l_size > l_buffer.capacity)
+			return(Overflow(l_buffer, static_cast<size_t>(l_size)));
+	} while (!MMATOMIC_CAS(l_buffer.offset, l_offset, l_offset + l_size));
+
+	return(l_buffer.data + l_offset);
+}
+
+void
+Swap(void)
+{
+	s_current ^= 1;
+	Reset(s_buffers[s_current]);
+}
+
+void
+Reserve(size_t capacity)
+{
+	s_lock.lock();
+	if (s_capacity < capacity)
+		s_capacity = capacity;
+	s_lock.unlock();
+
+	/* current buffer grows now unless it's in use */
+	Buffer &l_buffer = s_buffers[s_current];
+	if (!l_buffer.offset && !l_buffer.spilled) {
+		s_lock.lock();
+		if (static_cast<size_t>(l_buffer.capacity) < s_capacity)
+			Resize(l_buffer, s_capacity);
+		s_lock.unlock();
+	}
+}
+
+void
+Release(void)
+{
+	for (int l_i = 0; l_i < 2; ++l_i) {
+		Buffer &l_buffer = s_buffers[l_i];
+		l_buffer.spilled = 0;
+		Reset(l_buffer);
+
+		delete[] l_buffer.storage;
+		l_buffer.storage = l_buffer.data = 0;
+		l_buffer.capacity = 0;
+	}
+
+	s_capacity = DefaultCapacity;
+}
+
+size_t
+Used(void)
+{
+	const Buffer &l_buffer = s_buffers[s_current];
+	return(static_cast<size_t>(l_buffer.offset) + l_buffer.spilled);
+}
+
+size_t
+Capacity(void)
+{
+	const Buffer &l_buffer = s_buffers[s_current];
+	return(l_buffer.storage ? static_cast<size_t>(l_buffer.capacity) : s_capacity);
+}
+
+unsigned long
+Spilled(void)
+{
+	return(s_spill_count);
+}
+
+} /*********************************************** Core::FrameArena Namespace */
+} /*********************************************************** Core Namespace */
+MARSHMALLOW_NAMESPACE_END
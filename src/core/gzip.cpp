@@ -60,7 +60,7 @@ Gzip::Inflate(const char *in, size_t in_size, size_t out_size, char **out)
 	l_stream.zalloc = static_cast<alloc_func>(0);
 	l_stream.zfree  = static_cast<free_func>(0);
 
-	if (inflateInit2(&l_stream, 16) != Z_OK) {
+	if (inflateInit2(&l_stream, MAX_WBITS + 16) != Z_OK) {
 		MMWARNING("Failed to initialize inflate.");
 		return(0);
 	}
@@ -81,7 +81,8 @@ size_t
 Gzip::Deflate(const char *in, size_t in_size, char **out, int l)
 {
 	z_stream l_stream;
-	uLongf l_out_size = compressBound(in_size);
+	/* compressBound() only accounts for the zlib wrapper */
+	uLongf l_out_size = compressBound(in_size) + 18;
 
 	*out = new char[l_out_size];
 
@@ -95,7 +96,7 @@ Gzip::Deflate(const char *in, size_t in_size, char **out, int l)
 	l_stream.zfree  = static_cast<free_func>(0);
 	l_stream.opaque = static_cast<voidpf>(0);
 
-	if (deflateInit2(&l_stream, l, Z_DEFLATED, 16, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+	if (deflateInit2(&l_stream, l, Z_DEFLATED, MAX_WBITS + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
 		MMWARNING("Failed to initialize deflate.");
 		return(0);
 	}
@@ -32,82 +32,142 @@
 
 #include "core/hash.h"
 
-/*!
- * @file
- *
- * @author Guillermo A. Amaral B. (gamaral) <g@maral.me>
- */
+#include <cstring>
 
-MARSHMALLOW_NAMESPACE_BEGIN
-namespace Core { /******************************************** Core Namespace */
+#include "cpu_p.h"
 
-struct Hash::Private
-{
-	MMUID result;
-};
+#if MMCPU_X86
+#   include <nmmintrin.h>
+#endif
 
-Hash::Hash(void)
-    : m_p(new Private)
-{
-	m_p->result = 0;
-}
+MARSHMALLOW_NAMESPACE_BEGIN
+namespace Core { /******************************************** Core Namespace */
+namespace { /************************************ Core::<anonymous> Namespace */
+
+#if !MARSHMALLOW_LEGACY_HASH
+	typedef MMUID (*CRC32CFunction)(const unsigned char *, size_t, MMUID);
+
+	/*
+	 * Slicing-by-8 tables for the reflected Castagnoli polynomial, the
+	 * same CRC the SSE4.2 crc32 instruction computes.
+	 */
+	struct CRC32CTable
+	{
+		MMUID slice[8][256];
+
+		CRC32CTable(void)
+		{
+			for (MMUID l_i = 0; l_i < 256; ++l_i) {
+				MMUID l_crc = l_i;
+				for (int l_k = 0; l_k < 8; ++l_k)
+					l_crc = (l_crc >> 1) ^ (0x82F63B78 & (0u - (l_crc & 1)));
+				slice[0][l_i] = l_crc;
+			}
+
+			for (MMUID l_i = 0; l_i < 256; ++l_i)
+				for (int l_s = 1; l_s < 8; ++l_s)
+					slice[l_s][l_i] = (slice[l_s - 1][l_i] >> 8)
+					    ^ slice[0][slice[l_s - 1][l_i] & 0xFF];
+		}
+	};
+
+	MMUID
+	CRC32CScalar(const unsigned char *d, size_t n, MMUID crc)
+	{
+		static const CRC32CTable s_table;
+		const MMUID (*l_t)[256] = s_table.slice;
+
+		/* words are assembled byte by byte, so big-endian hosts agree */
+		for (; n >= 8; d += 8, n -= 8) {
+			const MMUID l_lo = crc ^ (static_cast<MMUID>(d[0])
+			    | static_cast<MMUID>(d[1]) << 8
+			    | static_cast<MMUID>(d[2]) << 16
+			    | static_cast<MMUID>(d[3]) << 24);
+			crc = l_t[7][l_lo & 0xFF]
+			    ^ l_t[6][(l_lo >> 8) & 0xFF]
+			    ^ l_t[5][(l_lo >> 16) & 0xFF]
+			    ^ l_t[4][l_lo >> 24]
+			    ^ l_t[3][d[4]]
+			    ^ l_t[2][d[5]]
+			    ^ l_t[1][d[6]]
+			    ^ l_t[0][d[7]];
+		}
+
+		while (n--)
+			crc = (crc >> 8) ^ l_t[0][(crc ^ *d++) & 0xFF];
+
+		return(crc);
+	}
 
-Hash::Hash(const char *d, size_t length, MMUID mask)
-    : m_p(new Private)
-{
-	m_p->result = Algorithm(d, length, mask);
-}
+#if MMCPU_X86
+	MMCPU_TARGET("sse4.2") MMUID
+	CRC32CSSE42(const unsigned char *d, size_t n, MMUID crc)
+	{
+#if defined(__x86_64__) || defined(_M_X64)
+		uint64_t l_crc = crc;
+		for (; n >= 8; d += 8, n -= 8) {
+			uint64_t l_word;
+			memcpy(&l_word, d, sizeof(l_word));
+			l_crc = _mm_crc32_u64(l_crc, l_word);
+		}
+		crc = static_cast<MMUID>(l_crc);
+#endif
+		for (; n >= 4; d += 4, n -= 4) {
+			uint32_t l_word;
+			memcpy(&l_word, d, sizeof(l_word));
+			crc = _mm_crc32_u32(crc, l_word);
+		}
+
+		while (n--)
+			crc = _mm_crc32_u8(crc, *d++);
+
+		return(crc);
+	}
+#endif
+
+	CRC32CFunction
+	SelectCRC32C(void)
+	{
+#if MMCPU_X86
+		if (CPU::HasSSE42())
+			return(CRC32CSSE42);
+#endif
+		return(CRC32CScalar);
+	}
+#endif
 
-Hash::Hash(const Hash &copy)
-    : m_p(new Private)
-{
-	m_p->result = copy.m_p->result;
-}
+} /********************************************** Core::<anonymous> Namespace */
 
 Hash::~Hash(void)
 {
-	delete m_p, m_p = 0;
 }
 
 MMUID
-Hash::result(void) const
-{
-	return(m_p->result);
-}
-
-Hash::operator MMUID() const
+Hash::Algorithm(const char *data, size_t length, MMUID mask)
 {
-	return(m_p->result);
-}
+#if MARSHMALLOW_LEGACY_HASH
+	return(LegacyAlgorithm(data, length, mask));
+#else
+	if (!data) return(0);
 
-Hash &
-Hash::operator=(const Core::Hash &rhs)
-{
-	if (this != &rhs)
-		m_p->result = rhs.m_p->result;
-	return(*this);
-}
+	static const CRC32CFunction s_crc32c = SelectCRC32C();
 
-bool
-Hash::operator==(const Hash &rhs) const
-{
-	return(m_p->result == rhs.m_p->result);
-}
+	MMUID l_hash = ~s_crc32c(reinterpret_cast<const unsigned char *>(data),
+	    length, ~static_cast<MMUID>(0));
 
-bool
-Hash::operator!=(const Hash &rhs) const
-{
-	return(m_p->result != rhs.m_p->result);
-}
+	/* crc32c avalanches poorly on its own, finish with a murmur3 mix */
+	l_hash ^= (l_hash >> 0x10);
+	l_hash *= 0x85EBCA6B;
+	l_hash ^= (l_hash >> 0x0D);
+	l_hash *= 0xC2B2AE35;
+	l_hash ^= (l_hash >> 0x10);
 
-bool
-Hash::operator<(const Hash &rhs) const
-{
-	return(m_p->result < rhs.m_p->result);
+	return(l_hash & mask);
+#endif
 }
 
 MMUID
-Hash::Algorithm(const char *data, size_t length, MMUID mask)
+Hash::LegacyAlgorithm(const char *data, size_t length, MMUID mask)
 {
 	if (!data) return(0);
 
@@ -127,12 +187,6 @@ Hash::Algorithm(const char *data, size_t length, MMUID mask)
 	return(l_hash & mask);
 }
 
-void
-Hash::rehash(const char *d, size_t length, MMUID mask)
-{
-	m_p->result = Algorithm(d, length, mask);
-}
-
 } /*********************************************************** Core Namespace */
 MARSHMALLOW_NAMESPACE_END
 
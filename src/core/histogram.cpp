@@ -0,0 +1,283 @@
+/*
+ * Copyright (c) 2013, Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ * All rights reserved.
+ *
+ * This file is part of Marshmallow Game Engine.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE CONTRIBUTORS ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are
+ * those of the authors and should not be interpreted as representing official
+ * policies, either expressed or implied, of the project as a whole.
+ */
+
+#include "core/histogram.h"
+
+/*!
+ * @file
+ *
+ * @author Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ */
+
+#include <cmath>
+#include <cstring>
+
+MARSHMALLOW_NAMESPACE_BEGIN
+namespace Core { /******************************************** Core Namespace */
+namespace { /************************************ Core::<anonymous> Namespace */
+
+inline int
+MostSignificantBit(uint64_t v)
+{
+#if defined(__GNUC__)
+	return(63 - __builtin_clzll(v));
+#else
+	int l_bit = 0;
+	while (v >>= 1)
+		++l_bit;
+	return(l_bit);
+#endif
+}
+
+} /********************************************** Core::<anonymous> Namespace */
+
+struct Histogram::Private
+{
+	uint32_t *counts;
+	size_t    buckets;
+	int64_t   highest;
+	uint64_t  count;
+	double    sum;
+
+	/* exact extremes recorded since reset, not updated by remove() */
+	int64_t   lowest;
+	int64_t   greatest;
+
+	inline int64_t
+	clamp(int64_t value) const
+	{
+		if (value > greatest) return(greatest);
+		if (value < lowest) return(lowest);
+		return(value);
+	}
+};
+
+Histogram::Histogram(int64_t h)
+    : m_p(new Private)
+{
+	m_p->highest = h > 0 ? h : 0;
+	m_p->buckets = BucketOf(m_p->highest) + 1;
+	m_p->counts  = new uint32_t[m_p->buckets];
+	reset();
+}
+
+Histogram::~Histogram(void)
+{
+	delete[] m_p->counts;
+	delete m_p, m_p = 0;
+}
+
+void
+Histogram::record(int64_t v, uint32_t c)
+{
+	if (v < 0) v = 0;
+	else if (v > m_p->highest) v = m_p->highest;
+
+	m_p->counts[BucketOf(v)] += c;
+	m_p->count += c;
+	m_p->sum += static_cast<double>(v) * c;
+
+	if (v < m_p->lowest) m_p->lowest = v;
+	if (v > m_p->greatest) m_p->greatest = v;
+}
+
+void
+Histogram::remove(int64_t v, uint32_t c)
+{
+	if (v < 0) v = 0;
+	else if (v > m_p->highest) v = m_p->highest;
+
+	uint32_t &l_bucket = m_p->counts[BucketOf(v)];
+	if (c > l_bucket) c = l_bucket;
+
+	l_bucket -= c;
+	m_p->count -= c;
+	m_p->sum -= static_cast<double>(v) * c;
+
+	/* avoid accumulating rounding errors once empty */
+	if (!m_p->count)
+		m_p->sum = 0;
+}
+
+void
+Histogram::reset(void)
+{
+	memset(m_p->counts, 0, m_p->buckets * sizeof(uint32_t));
+	m_p->count = 0;
+	m_p->sum = 0;
+	m_p->lowest = m_p->highest;
+	m_p->greatest = 0;
+}
+
+void
+Histogram::merge(const Histogram &o)
+{
+	/* buckets are laid out identically regardless of range */
+	for (size_t l_i = 0; l_i < o.m_p->buckets; ++l_i) {
+		if (!o.m_p->counts[l_i])
+			continue;
+
+		if (l_i < m_p->buckets)
+			m_p->counts[l_i] += o.m_p->counts[l_i];
+		else m_p->counts[m_p->buckets - 1] += o.m_p->counts[l_i];
+	}
+
+	m_p->count += o.m_p->count;
+	m_p->sum += o.m_p->sum;
+
+	if (o.m_p->count) {
+		if (o.m_p->lowest < m_p->lowest)
+			m_p->lowest = o.m_p->lowest < m_p->highest ? o.m_p->lowest : m_p->highest;
+		if (o.m_p->greatest > m_p->greatest)
+			m_p->greatest = o.m_p->greatest < m_p->highest ? o.m_p->greatest : m_p->highest;
+	}
+}
+
+int64_t
+Histogram::highest(void) const
+{
+	return(m_p->highest);
+}
+
+uint64_t
+Histogram::count(void) const
+{
+	return(m_p->count);
+}
+
+double
+Histogram::mean(void) const
+{
+	if (!m_p->count)
+		return(0);
+	return(m_p->sum / static_cast<double>(m_p->count));
+}
+
+int64_t
+Histogram::minimum(void) const
+{
+	for (size_t l_i = 0; l_i < m_p->buckets; ++l_i)
+		if (m_p->counts[l_i])
+			return(m_p->clamp(BucketLowest(l_i)));
+	return(0);
+}
+
+int64_t
+Histogram::maximum(void) const
+{
+	for (size_t l_i = m_p->buckets; l_i > 0; --l_i)
+		if (m_p->counts[l_i - 1])
+			return(m_p->clamp(BucketHighest(l_i - 1)));
+	return(0);
+}
+
+int64_t
+Histogram::percentile(double p) const
+{
+	if (!m_p->count)
+		return(0);
+
+	if (p < 0.) p = 0.;
+	else if (p > 100.) p = 100.;
+
+	/* rank of the value we are looking for (1-based) */
+	uint64_t l_rank =
+	    static_cast<uint64_t>(ceil(p / 100. * static_cast<double>(m_p->count)));
+	if (l_rank < 1) l_rank = 1;
+
+	uint64_t l_seen = 0;
+	for (size_t l_i = 0; l_i < m_p->buckets; ++l_i) {
+		l_seen += m_p->counts[l_i];
+		if (l_seen >= l_rank)
+			return(m_p->clamp(BucketHighest(l_i)));
+	}
+
+	return(m_p->greatest);
+}
+
+uint64_t
+Histogram::countAbove(int64_t v) const
+{
+	if (v < 0)
+		return(m_p->count);
+	if (v >= m_p->highest)
+		return(0);
+
+	/* values sharing a bucket with value are considered equivalent */
+	size_t l_i = BucketOf(v) + 1;
+
+	uint64_t l_count = 0;
+	for (; l_i < m_p->buckets; ++l_i)
+		l_count += m_p->counts[l_i];
+	return(l_count);
+}
+
+size_t
+Histogram::BucketOf(int64_t v)
+{
+	if (v < 2 * SubBuckets)
+		return(v > 0 ? static_cast<size_t>(v) : 0);
+
+	/* SubBuckets linear buckets per power of two */
+	const int l_shift = MostSignificantBit(static_cast<uint64_t>(v)) - SubBucketBits;
+	const size_t l_sub = static_cast<size_t>(v >> l_shift) - SubBuckets;
+	return(static_cast<size_t>(l_shift + 1) * SubBuckets + l_sub);
+}
+
+int64_t
+Histogram::BucketLowest(size_t b)
+{
+	if (b < 2 * SubBuckets)
+		return(static_cast<int64_t>(b));
+
+	const int l_shift = static_cast<int>(b / SubBuckets) - 1;
+	const int64_t l_sub = static_cast<int64_t>(b % SubBuckets) + SubBuckets;
+	return(l_sub << l_shift);
+}
+
+int64_t
+Histogram::BucketHighest(size_t b)
+{
+	if (b < 2 * SubBuckets)
+		return(static_cast<int64_t>(b));
+
+	const int l_shift = static_cast<int>(b / SubBuckets) - 1;
+	const int64_t l_sub = static_cast<int64_t>(b % SubBuckets) + SubBuckets;
+
+	/* top bucket would overflow */
+	if (l_shift + SubBucketBits >= 62 && l_sub == 2 * SubBuckets - 1)
+		return(MMTICK_MAX);
+	return(((l_sub + 1) << l_shift) - 1);
+}
+
+} /*********************************************************** Core Namespace */
+MARSHMALLOW_NAMESPACE_END
@@ -0,0 +1,324 @@
+/*
+ * Copyright (c) 2013, Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ * All rights reserved.
+ *
+ * This file is part of Marshmallow Game Engine.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE CONTRIBUTORS ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are
+ * those of the authors and should not be interpreted as representing official
+ * policies, either expressed or implied, of the project as a whole.
+ */
+
+#include "core/inflateio.h"
+
+/*!
+ * @file
+ *
+ * @author Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ */
+
+#include "core/logger.h"
+#include "core/shared.h"
+
+#include <cassert>
+#include <climits>
+
+#include <zlib.h>
+
+MARSHMALLOW_NAMESPACE_BEGIN
+namespace Core { /******************************************** Core Namespace */
+
+struct InflateIO::Private
+{
+	Private(const SharedDataIO &source_, size_t window_size_)
+	    : source(source_)
+	    , window(new Bytef[window_size_])
+	    , window_size(window_size_)
+	    , origin(0)
+	    , cursor(0)
+	    , size(-1)
+	    , mode(DIOInvalid)
+	    , finished(false)
+	    , eof(false)
+	{}
+
+	~Private(void)
+	    { delete[] window, window = 0; }
+
+	size_t inflate(void *buffer, size_t bsize);
+	bool rewind(void);
+	bool skip(long count);
+
+	SharedDataIO source;
+	z_stream stream;
+	Bytef   *window;
+	size_t   window_size;
+	long     origin;
+	long     cursor;
+	long     size;
+	DIOMode  mode;
+	bool     finished;
+	bool     eof;
+};
+
+size_t
+InflateIO::Private::inflate(void *b, size_t bs)
+{
+	stream.next_out  = reinterpret_cast<Bytef *>(b);
+	stream.avail_out = static_cast<uInt>(bs);
+
+	while (stream.avail_out > 0 && !finished) {
+		if (stream.avail_in == 0) {
+			const size_t l_read = source->read(window, window_size);
+			if (l_read == 0) {
+				MMWARNING("Compressed stream ended prematurely.");
+				finished = true;
+				break;
+			}
+
+			stream.next_in  = window;
+			stream.avail_in = static_cast<uInt>(l_read);
+		}
+
+		const int l_rc = ::inflate(&stream, Z_NO_FLUSH);
+		if (l_rc == Z_STREAM_END)
+			finished = true;
+		else if (l_rc != Z_OK && l_rc != Z_BUF_ERROR) {
+			MMERROR("Failed during inflation (" << l_rc << ").");
+			finished = true;
+		}
+	}
+
+	const size_t l_produced = bs - stream.avail_out;
+	cursor += long(l_produced);
+
+	if (finished)
+		size = cursor;
+
+	return(l_produced);
+}
+
+bool
+InflateIO::Private::rewind(void)
+{
+	if (!source->seek(origin, DIOSet)) {
+		MMERROR("Failed to rewind source DIO.");
+		return(false);
+	}
+
+	inflateReset(&stream);
+	stream.next_in  = Z_NULL;
+	stream.avail_in = 0;
+
+	cursor = 0;
+	finished = false;
+	return(true);
+}
+
+bool
+InflateIO::Private::skip(long c)
+{
+	char l_scratch[1024];
+
+	while (c > 0 && !finished) {
+		const size_t l_chunk =
+		    c < long(sizeof(l_scratch)) ? size_t(c) : sizeof(l_scratch);
+		c -= long(inflate(l_scratch, l_chunk));
+	}
+
+	return(c <= 0);
+}
+
+InflateIO::InflateIO(const SharedDataIO &s, size_t w)
+    : m_p(new Private(s, w))
+{
+	assert(w > 0 && w <= UINT_MAX && "Invalid window size!");
+	open(DIOReadOnly);
+}
+
+InflateIO::~InflateIO(void)
+{
+	close();
+	delete m_p, m_p = 0;
+}
+
+size_t
+InflateIO::size(void)
+{
+	if (!isOpen())
+		return(0);
+
+	if (m_p->size == -1) {
+		const long l_cursor = m_p->cursor;
+		m_p->skip(LONG_MAX);
+		if (!seek(l_cursor, DIOSet))
+			MMERROR("Failed to return to last position.");
+	}
+
+	return(m_p->size > 0 ? size_t(m_p->size) : 0);
+}
+
+bool
+InflateIO::open(DIOMode m)
+{
+	if (isOpen()) {
+		MMWARNING("Device is already open.");
+		return(false);
+	}
+
+	if ((m & DIOReadWrite) != DIOReadOnly) {
+		MMERROR("Inflate streams can only be opened read-only.");
+		return(false);
+	}
+
+	if (!m_p->source
+	    || (!m_p->source->isOpen() && !m_p->source->open(DIOReadOnly))) {
+		MMERROR("Source DIO is closed!");
+		return(false);
+	}
+
+	if ((m_p->origin = m_p->source->tell()) == -1) {
+		MMERROR("Failed to get current position for source DIO.");
+		return(false);
+	}
+
+	m_p->stream.next_in  = Z_NULL;
+	m_p->stream.avail_in = 0;
+	m_p->stream.zalloc   = Z_NULL;
+	m_p->stream.zfree    = Z_NULL;
+	m_p->stream.opaque   = Z_NULL;
+
+	/* automatic zlib/gzip header detection */
+	if (inflateInit2(&m_p->stream, MAX_WBITS + 32) != Z_OK) {
+		MMWARNING("Failed to initialize inflate.");
+		return(false);
+	}
+
+	m_p->cursor = 0;
+	m_p->size = -1;
+	m_p->mode = m;
+	m_p->finished = false;
+	m_p->eof = false;
+
+	return(true);
+}
+
+void
+InflateIO::close(void)
+{
+	if (!isOpen())
+		return;
+
+	inflateEnd(&m_p->stream);
+
+	m_p->cursor = 0;
+	m_p->size = -1;
+	m_p->mode = DIOInvalid;
+	m_p->finished = false;
+	m_p->eof = false;
+}
+
+DIOMode
+InflateIO::mode(void) const
+{
+	return(m_p->mode);
+}
+
+bool
+InflateIO::isOpen(void) const
+{
+	return(m_p->mode != DIOInvalid);
+}
+
+bool
+InflateIO::atEOF(void) const
+{
+	return(m_p->eof);
+}
+
+size_t
+InflateIO::read(void *b, size_t bs)
+{
+	assert(isOpen() && "Device is not open!");
+	assert(bs <= UINT_MAX && "Buffer too large!");
+
+	const size_t l_rcount = m_p->inflate(b, bs);
+
+	/* set end-of-file flag */
+	m_p->eof = (bs > l_rcount);
+
+	return(l_rcount);
+}
+
+size_t
+InflateIO::write(const void *, size_t)
+{
+	MMERROR("Inflate streams are read-only.");
+	return(0);
+}
+
+bool
+InflateIO::seek(long o, DIOSeek on)
+{
+	if (!isOpen())
+		return(false);
+
+	long l_cursor;
+
+	switch (on) {
+	case DIOSet:
+		l_cursor = o;
+		break;
+	case DIOCurrent:
+		l_cursor = m_p->cursor + o;
+		break;
+	case DIOEnd:
+		if (m_p->size == -1)
+			m_p->skip(LONG_MAX);
+		l_cursor = m_p->size + o;
+		break;
+	default: return(false);
+	}
+
+	if (l_cursor < 0 || (m_p->size != -1 && l_cursor > m_p->size))
+		return(false);
+
+	if (l_cursor < m_p->cursor && !m_p->rewind())
+		return(false);
+
+	/* reset end-of-file flag */
+	m_p->eof = false;
+
+	return(m_p->skip(l_cursor - m_p->cursor));
+}
+
+long
+InflateIO::tell(void) const
+{
+	return(m_p->cursor);
+}
+
+} /*********************************************************** Core Namespace */
+MARSHMALLOW_NAMESPACE_END
+
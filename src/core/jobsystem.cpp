@@ -0,0 +1,502 @@
+/*
+ * Copyright (c) 2013, Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ * All rights reserved.
+ *
+ * This file is part of Marshmallow Game Engine.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE CONTRIBUTORS ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are
+ * those of the authors and should not be interpreted as representing official
+ * policies, either expressed or implied, of the project as a whole.
+ */
+
+#include "core/jobsystem.h"
+
+/*!
+ * @file
+ *
+ * @author Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ */
+
+#include "core/logger.h"
+#include "core/objectpool.h"
+
+#include "core/thread_p.h"
+
+#include <vector>
+
+MARSHMALLOW_NAMESPACE_BEGIN
+namespace Core { /******************************************** Core Namespace */
+namespace JobSystem { /**************************** Core::JobSystem Namespace */
+
+struct Job
+{
+	Function       function;
+	RangeFunction  range;
+	void          *context;
+	Job           *parent;
+	size_t         begin;
+	size_t         end;
+
+	/* itself plus unfinished children */
+	volatile long  unfinished;
+
+	/* keep jobs on separate cache lines */
+	char           padding[64 - 6 * sizeof(void *) - sizeof(long)];
+};
+
+namespace { /************************* Core::JobSystem::<anonymous> Namespace */
+
+	enum
+	{
+		PoolSize   = 4096, /* jobs per thread, power of two */
+		DequeSize  = 4096, /* queued jobs per worker, power of two */
+		MaxRanges  = 256,  /* ParallelFor split limit */
+		SpinRounds = 64    /* idle rounds before a worker sleeps */
+	};
+
+	/*
+	 * Per-thread job ring, slots are recycled in order
+	 */
+	struct Pool
+	{
+		Job           jobs[PoolSize];
+		unsigned long next;
+	};
+
+	/*
+	 * Chase-Lev work-stealing deque
+	 *
+	 * The owner pushes and pops at the bottom, thieves take from the
+	 * top. Indices only grow, their difference is the size.
+	 */
+	class Deque
+	{
+		Job *m_jobs[DequeSize];
+		volatile unsigned long m_top;
+		char m_padding[64];
+		volatile unsigned long m_bottom;
+
+	public:
+
+		Deque(void)
+		    : m_top(0)
+		    , m_bottom(0) {}
+
+		bool
+		push(Job *job)
+		{
+			const unsigned long l_bottom = m_bottom;
+			if (static_cast<long>(l_bottom - m_top) >= DequeSize)
+				return(false);
+
+			m_jobs[l_bottom & (DequeSize - 1)] = job;
+			MMATOMIC_FENCE();
+			m_bottom = l_bottom + 1;
+			return(true);
+		}
+
+		Job *
+		pop(void)
+		{
+			const unsigned long l_bottom = m_bottom - 1;
+			m_bottom = l_bottom;
+			MMATOMIC_FENCE();
+			const unsigned long l_top = m_top;
+
+			const long l_size = static_cast<long>(l_bottom - l_top);
+			if (l_size < 0) {
+				m_bottom = l_top;
+				return(0);
+			}
+
+			Job *l_job = m_jobs[l_bottom & (DequeSize - 1)];
+			if (l_size > 0)
+				return(l_job);
+
+			/* last job, race thieves for it */
+			if (!MMATOMIC_CAS(m_top, l_top, l_top + 1))
+				l_job = 0;
+			m_bottom = l_top + 1;
+			return(l_job);
+		}
+
+		Job *
+		steal(void)
+		{
+			const unsigned long l_top = m_top;
+			MMATOMIC_FENCE();
+			const unsigned long l_bottom = m_bottom;
+
+			if (static_cast<long>(l_bottom - l_top) <= 0)
+				return(0);
+
+			Job *l_job = m_jobs[l_top & (DequeSize - 1)];
+			if (!MMATOMIC_CAS(m_top, l_top, l_top + 1))
+				return(0);
+			return(l_job);
+		}
+	};
+
+	struct Worker
+	{
+		Deque           deque;
+		Thread::Handle *handle;
+		uint32_t        seed;
+		int             index;
+	};
+
+	Worker *s_workers = 0;
+	int     s_threads = 0;
+
+	volatile long s_quit = 0;
+	volatile long s_sleepers = 0;
+	Thread::Semaphore *s_wake = 0;
+
+	/* every thread creating jobs gets a pool, released by Finalize() */
+	Thread::Mutex       s_pools_lock;
+	std::vector<Pool *> s_pools;
+	volatile long       s_generation = 1;
+
+	MMTHREADLOCAL Worker *s_self = 0;
+	MMTHREADLOCAL Pool   *s_pool = 0;
+	MMTHREADLOCAL long    s_pool_generation = 0;
+
+	inline uint32_t
+	XorShift(uint32_t &state)
+	{
+		state ^= state << 13;
+		state ^= state >> 17;
+		state ^= state << 5;
+		return(state);
+	}
+
+	Job *
+	Next(Worker &self)
+	{
+		Job *l_job = self.deque.pop();
+		if (l_job || s_threads == 1)
+			return(l_job);
+
+		/* steal, starting from a random victim */
+		int l_victim = static_cast<int>(XorShift(self.seed) % static_cast<uint32_t>(s_threads));
+		for (int l_i = 0; l_i < s_threads; ++l_i, ++l_victim) {
+			if (l_victim == s_threads)
+				l_victim = 0;
+			if (l_victim == self.index)
+				continue;
+			if ((l_job = s_workers[l_victim].deque.steal()))
+				return(l_job);
+		}
+
+		return(0);
+	}
+
+	void
+	Finish(Job *job)
+	{
+		while (job) {
+			/* slot may be recycled as soon as it's finished */
+			Job *l_parent = job->parent;
+			if (MMATOMIC_DECREMENT(job->unfinished) > 0)
+				return;
+			job = l_parent;
+		}
+	}
+
+	void
+	Execute(Job *job)
+	{
+		if (job->range)
+			job->range(job->context, job->begin, job->end);
+		else if (job->function)
+			job->function(job->context);
+
+		Finish(job);
+	}
+
+	/*
+	 * Claim a sleeping worker, if any
+	 */
+	bool
+	ClaimSleeper(void)
+	{
+		long l_sleepers;
+		while ((l_sleepers = s_sleepers) > 0)
+			if (MMATOMIC_CAS(s_sleepers, l_sleepers, l_sleepers - 1))
+				return(true);
+		return(false);
+	}
+
+	void
+	Wake(void)
+	{
+		/* job must be visible before we look for sleepers */
+		MMATOMIC_FENCE();
+		if (ClaimSleeper())
+			s_wake->post();
+	}
+
+	void
+	WorkerMain(void *w)
+	{
+		Worker &l_self = *static_cast<Worker *>(w);
+		s_self = &l_self;
+
+		int l_idle = 0;
+		while (!s_quit) {
+			Job *l_job = Next(l_self);
+			if (l_job) {
+				Execute(l_job);
+				l_idle = 0;
+				continue;
+			}
+
+			if (++l_idle < SpinRounds) {
+				Thread::YieldSlice();
+				continue;
+			}
+
+			/*
+			 * Sleep, checking once more after registering so a job
+			 * pushed in between isn't missed. If our registration
+			 * was already claimed, a post is on its way.
+			 */
+			MMATOMIC_INCREMENT(s_sleepers);
+			if (!s_quit && (l_job = Next(l_self))) {
+				if (!ClaimSleeper())
+					s_wake->wait();
+				Execute(l_job);
+			}
+			else s_wake->wait();
+			l_idle = 0;
+		}
+
+		/* objects released on this worker go back to the shared pool */
+		ObjectPool::Flush();
+
+		s_self = 0;
+	}
+
+	Pool *
+	ThreadPool(void)
+	{
+		if (!s_pool || s_pool_generation != s_generation) {
+			s_pool = new Pool();
+			s_pool_generation = s_generation;
+
+			s_pools_lock.lock();
+			s_pools.push_back(s_pool);
+			s_pools_lock.unlock();
+		}
+		return(s_pool);
+	}
+
+	Job *
+	Allocate(Function function, RangeFunction range, void *context,
+	         Job *parent, size_t begin, size_t end)
+	{
+		Pool *l_pool = ThreadPool();
+		Job *l_job = &l_pool->jobs[l_pool->next++ & (PoolSize - 1)];
+
+		/* ring wrapped onto a job still in flight */
+		if (l_job->unfinished > 0)
+			Wait(l_job);
+
+		l_job->function = function;
+		l_job->range = range;
+		l_job->context = context;
+		l_job->parent = parent;
+		l_job->begin = begin;
+		l_job->end = end;
+		l_job->unfinished = 1;
+
+		if (parent)
+			MMATOMIC_INCREMENT(parent->unfinished);
+
+		return(l_job);
+	}
+
+} /*********************************** Core::JobSystem::<anonymous> Namespace */
+
+bool
+Initialize(int workers)
+{
+	if (s_threads > 0) {
+		MMWARNING("Job system already initialized.");
+		return(true);
+	}
+
+	if (workers < 0)
+		workers = Thread::Concurrency() - 1;
+
+	s_quit = 0;
+	s_sleepers = 0;
+	s_wake = new Thread::Semaphore;
+
+	/* worker zero is the calling thread */
+	s_threads = workers + 1;
+	s_workers = new Worker[s_threads];
+	for (int l_i = 0; l_i < s_threads; ++l_i) {
+		s_workers[l_i].handle = 0;
+		s_workers[l_i].seed = 2463534242u + static_cast<uint32_t>(l_i) * 7919u;
+		s_workers[l_i].index = l_i;
+	}
+	s_self = &s_workers[0];
+
+	for (int l_i = 1; l_i < s_threads; ++l_i) {
+		s_workers[l_i].handle = Thread::Start(WorkerMain, &s_workers[l_i]);
+		if (!s_workers[l_i].handle) {
+			MMERROR("Failed to start job worker " << l_i << ".");
+			Finalize();
+			return(false);
+		}
+	}
+
+	MMINFO("Job system started with " << s_threads << " threads.");
+	return(true);
+}
+
+void
+Finalize(void)
+{
+	if (s_threads <= 0)
+		return;
+
+	s_quit = 1;
+	MMATOMIC_FENCE();
+	s_wake->post(s_threads);
+
+	for (int l_i = 1; l_i < s_threads; ++l_i)
+		Thread::Join(s_workers[l_i].handle);
+
+	s_self = 0;
+	delete[] s_workers, s_workers = 0;
+	s_threads = 0;
+
+	delete s_wake, s_wake = 0;
+
+	/* invalidate every thread's pool */
+	s_pools_lock.lock();
+	MMATOMIC_INCREMENT(s_generation);
+	for (size_t l_i = 0; l_i < s_pools.size(); ++l_i)
+		delete s_pools[l_i];
+	s_pools.clear();
+	s_pools_lock.unlock();
+}
+
+bool
+Active(void)
+{
+	return(s_threads > 0);
+}
+
+int
+Threads(void)
+{
+	return(s_threads > 0 ? s_threads : 1);
+}
+
+Job *
+Create(Function f, void *c, Job *p)
+{
+	return(Allocate(f, 0, c, p, 0, 0));
+}
+
+void
+Run(Job *job)
+{
+	if (!job)
+		return;
+
+	Worker *l_self = s_self;
+	if (!l_self || s_threads == 1 || !l_self->deque.push(job)) {
+		Execute(job);
+		return;
+	}
+
+	Wake();
+}
+
+void
+Wait(const Job *job)
+{
+	if (!job)
+		return;
+
+	while (job->unfinished > 0) {
+		Worker *l_self = s_self;
+		Job *l_job = l_self ? Next(*l_self) : 0;
+		if (l_job)
+			Execute(l_job);
+		else
+			Thread::YieldSlice();
+	}
+
+	/* see the job's writes */
+	MMATOMIC_FENCE();
+}
+
+bool
+Finished(const Job *job)
+{
+	return(!job || job->unfinished <= 0);
+}
+
+void
+ParallelFor(size_t count, RangeFunction f, void *c, size_t grain)
+{
+	if (!count)
+		return;
+
+	const size_t l_threads = static_cast<size_t>(Threads());
+	if (!s_self || l_threads == 1) {
+		f(c, 0, count);
+		return;
+	}
+
+	if (!grain)
+		grain = count / (l_threads * 4);
+	if (grain < 1)
+		grain = 1;
+	if (count / grain > MaxRanges)
+		grain = (count + MaxRanges - 1) / MaxRanges;
+
+	if (grain >= count) {
+		f(c, 0, count);
+		return;
+	}
+
+	Job *l_root = Allocate(0, 0, 0, 0, 0, 0);
+	for (size_t l_begin = 0; l_begin < count; l_begin += grain) {
+		const size_t l_end = count - l_begin > grain ? l_begin + grain : count;
+		Run(Allocate(0, f, c, l_root, l_begin, l_end));
+	}
+
+	Run(l_root);
+	Wait(l_root);
+}
+
+} /************************************************ Core::JobSystem Namespace */
+} /*********************************************************** Core Namespace */
+MARSHMALLOW_NAMESPACE_END
@@ -0,0 +1,546 @@
+/*
+ * Copyright (c) 2013, Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ * All rights reserved.
+ *
+ * This file is part of Marshmallow Game Engine.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE CONTRIBUTORS ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are
+ * those of the authors and should not be interpreted as representing official
+ * policies, either expressed or implied, of the project as a whole.
+ */
+
+#include "core/logger.h"
+
+/*!
+ * @file
+ *
+ * @author Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ */
+
+#include "core/platform.h"
+
+#include "thread_p.h"
+#include "threadring_p.h"
+
+#include <cstdarg>
+#include <cstdio>
+
+MARSHMALLOW_NAMESPACE_BEGIN
+namespace Core { /******************************************** Core Namespace */
+namespace Logger { /********************************** Core::Logger Namespace */
+namespace { /**************************** Core::Logger::<anonymous> Namespace */
+
+	enum {
+		RingSize    = 64 * 1024,
+		OutputSize  = 8 * 1024,
+		MaxDisabled = 8,
+		MaxName     = 32,
+		IdleSleep   = 2
+	};
+
+	const uint32_t WrapMarker = 0xFFFFFFFF;
+
+	struct Entry
+	{
+		uint32_t    size;
+		uint32_t    length;
+		int         level;
+		int         line;
+		MMTICK      time;
+		bool        truncated;
+		const char *file;
+		const char *function;
+	};
+
+	/* whoever holds the drain lock consumes */
+	struct Ring : public ThreadRing<char, RingSize>
+	{
+		unsigned long reported;
+		Ring         *next;
+	};
+
+	enum WriterState
+	{
+		WriterNone,
+		WriterStarting,
+		WriterRunning,
+		WriterFailed
+	};
+
+	/*
+	 * Everything below is zero initialized, the logger must work
+	 * before (and after) static constructors.
+	 */
+
+	MMTHREADLOCAL Ring *s_ring;
+	ThreadRingList<Ring> s_rings;
+
+	Thread::SpinLock s_drain_lock;
+	volatile int32_t s_writer_state;
+	volatile int32_t s_writer_stop;
+	Thread::Handle  *s_writer;
+	bool             s_synchronous;
+
+	Level s_threshold;
+	Sink  s_sink;
+
+	char s_disabled[MaxDisabled][MaxName];
+	int  s_disabled_count;
+
+	char   s_output[OutputSize];
+	size_t s_output_length;
+
+	inline uint32_t
+	Align(size_t size)
+	{
+		return(static_cast<uint32_t>((size + 7) & ~size_t(7)));
+	}
+
+	inline const char *
+	LevelTag(int level)
+	{
+		switch (level) {
+		case FatalLevel:   return("FATAL");
+		case ErrorLevel:   return("ERROR");
+		case WarningLevel: return("WARN");
+		case DebugLevel:   return("DEBUG");
+		case InfoLevel:    return("INFO");
+		default:           return("VERB");
+		}
+	}
+
+	Ring *
+	LocalRing(void)
+	{
+		if (s_ring)
+			return(s_ring);
+
+		Ring *l_ring = new Ring;
+		l_ring->reported = 0;
+
+		return(s_ring = s_rings.attach(l_ring));
+	}
+
+	bool
+	Push(Ring &ring, const Record &record)
+	{
+		const uint32_t l_size =
+		    Align(sizeof(Entry) + record.length());
+
+		const uint32_t l_head = ring.head;
+		const uint32_t l_pos  = l_head % RingSize;
+		const uint32_t l_free = ring.available();
+
+		/* entries never straddle the end of the buffer */
+		uint32_t l_skip = 0;
+		if (l_size > RingSize - l_pos)
+			l_skip = RingSize - l_pos;
+
+		if (l_skip + l_size > l_free)
+			return(false);
+
+		if (l_skip)
+			memcpy(ring.data + l_pos, &WrapMarker, sizeof(WrapMarker));
+
+		Entry l_entry;
+		l_entry.size      = l_size;
+		l_entry.length    = static_cast<uint32_t>(record.length());
+		l_entry.level     = record.level();
+		l_entry.line      = record.line();
+		l_entry.time      = Platform::Ticks();
+		l_entry.truncated = record.truncated();
+		l_entry.file      = record.file();
+		l_entry.function  = record.function();
+
+		char *l_data = ring.data + ((l_head + l_skip) % RingSize);
+		memcpy(l_data, &l_entry, sizeof(Entry));
+		memcpy(l_data + sizeof(Entry), record.text(), record.length());
+
+		ring.publish(l_head + l_skip + l_size);
+		return(true);
+	}
+
+	/*
+	 * Skip a wrap marker, returns the next entry or null when the
+	 * ring is empty.
+	 */
+	const Entry *
+	Peek(Ring &ring)
+	{
+		const uint32_t l_head = ring.acquire();
+		uint32_t l_tail = ring.tail;
+		if (l_tail == l_head)
+			return(0);
+
+		uint32_t l_pos = l_tail % RingSize;
+		uint32_t l_marker;
+		memcpy(&l_marker, ring.data + l_pos, sizeof(l_marker));
+		if (l_marker == WrapMarker) {
+			ring.tail = l_tail += RingSize - l_pos;
+			if (l_tail == l_head)
+				return(0);
+			l_pos = 0;
+		}
+
+		return(reinterpret_cast<const Entry *>(ring.data + l_pos));
+	}
+
+	void
+	Write(const char *text, size_t length)
+	{
+		if (s_sink)
+			s_sink(text, length);
+		else {
+			fwrite(text, 1, length, stderr);
+			fflush(stderr);
+		}
+	}
+
+	void
+	FlushOutput(void)
+	{
+		if (s_output_length)
+			Write(s_output, s_output_length);
+		s_output_length = 0;
+	}
+
+	void
+	Output(const char *format, ...)
+	{
+		if (OutputSize - s_output_length < Record::Capacity + 256)
+			FlushOutput();
+
+		va_list l_args;
+		va_start(l_args, format);
+		const int l_count = vsnprintf(s_output + s_output_length,
+		    OutputSize - s_output_length, format, l_args);
+		va_end(l_args);
+
+		if (l_count < 0)
+			return;
+
+		s_output_length += size_t(l_count) < OutputSize - s_output_length ?
+		    size_t(l_count) : OutputSize - s_output_length - 1;
+	}
+
+	inline int
+	Seconds(MMTICK ticks)
+	{
+		return(static_cast<int>(ticks / Platform::TicksPerSecond));
+	}
+
+	inline int
+	Microseconds(MMTICK ticks)
+	{
+		return(static_cast<int>((ticks % Platform::TicksPerSecond) / 1000));
+	}
+
+	void
+	Format(const Entry &entry)
+	{
+		Output("%d.%06ds %s:%d [%s]\n\t%s: %.*s%s\n",
+		    Seconds(entry.time), Microseconds(entry.time),
+		    entry.file, entry.line, LevelTag(entry.level),
+		    entry.function,
+		    static_cast<int>(entry.length),
+		    reinterpret_cast<const char *>(&entry + 1),
+		    entry.truncated ? "..." : "");
+	}
+
+	/*
+	 * Write out queued entries of all rings, merged by timestamp.
+	 *
+	 * Must hold the drain lock. Returns false if there was nothing
+	 * to do.
+	 */
+	bool
+	Drain(void)
+	{
+		bool l_drained = false;
+
+		for (;;) {
+			Ring *l_pick = 0;
+			const Entry *l_first = 0;
+
+			for (Ring *l_ring = s_rings.first; l_ring; l_ring = l_ring->next) {
+				const Entry *l_entry = Peek(*l_ring);
+				if (l_entry && (!l_first || l_entry->time < l_first->time))
+					l_pick = l_ring, l_first = l_entry;
+			}
+
+			if (!l_pick)
+				break;
+
+			Format(*l_first);
+			const uint32_t l_size = l_first->size;
+
+			l_pick->release(l_pick->tail + l_size);
+			l_drained = true;
+		}
+
+		for (Ring *l_ring = s_rings.first; l_ring; l_ring = l_ring->next) {
+			const unsigned long l_dropped = l_ring->dropped;
+			if (l_dropped == l_ring->reported)
+				continue;
+
+			const MMTICK l_now = Platform::Ticks();
+			Output("%d.%06ds [WARN]\n\t%lu log messages dropped\n",
+			    Seconds(l_now), Microseconds(l_now),
+			    l_dropped - l_ring->reported);
+			l_ring->reported = l_dropped;
+			l_drained = true;
+		}
+
+		FlushOutput();
+		return(l_drained);
+	}
+
+	void
+	WriterMain(void *)
+	{
+		while (!s_writer_stop) {
+			bool l_drained = false;
+
+			if (s_drain_lock.tryLock()) {
+				l_drained = Drain();
+				s_drain_lock.unlock();
+			}
+
+			if (!l_drained)
+				Thread::Sleep(IdleSleep);
+		}
+	}
+
+	void
+	Shutdown(void)
+	{
+		if (s_writer_state == WriterRunning) {
+			s_writer_stop = 1;
+			Thread::Join(s_writer), s_writer = 0;
+			s_writer_state = WriterFailed;
+		}
+
+		Flush();
+	}
+
+	/*
+	 * Start the writer on first use, returns true if it's running.
+	 */
+	bool
+	StartWriter(void)
+	{
+		if (s_writer_state == WriterRunning)
+			return(true);
+
+		if (!MMATOMIC_CAS(s_writer_state, WriterNone, WriterStarting))
+			return(false);
+
+		/* can't use MMERROR in here, we are the logger */
+		s_writer = Thread::Start(WriterMain, 0);
+		if (!s_writer) {
+			s_writer_state = WriterFailed;
+			return(false);
+		}
+
+		atexit(Shutdown);
+
+		MMATOMIC_FENCE();
+		s_writer_state = WriterRunning;
+		return(true);
+	}
+
+	/*
+	 * Subsystem is the directory right below src/ or include/
+	 */
+	bool
+	Subsystem(const char *file, const char *&begin, size_t &length)
+	{
+		const char *l_match = 0;
+
+		for (const char *l_c = file; *l_c; ++l_c) {
+			if (l_c != file && l_c[-1] != '/' && l_c[-1] != '\\')
+				continue;
+
+			if (strncmp(l_c, "src", 3) == 0
+			    && (l_c[3] == '/' || l_c[3] == '\\'))
+				l_match = l_c + 4;
+			else if (strncmp(l_c, "include", 7) == 0
+			    && (l_c[7] == '/' || l_c[7] == '\\'))
+				l_match = l_c + 8;
+		}
+
+		if (!l_match)
+			return(false);
+
+		length = strcspn(l_match, "/\\");
+		begin = l_match;
+		return(l_match[length] != '\0');
+	}
+
+	int
+	FindDisabled(const char *subsystem, size_t length)
+	{
+		for (int i = 0; i < s_disabled_count; ++i)
+			if (strlen(s_disabled[i]) == length
+			    && strncmp(s_disabled[i], subsystem, length) == 0)
+				return(i);
+		return(-1);
+	}
+
+} /************************************** Core::Logger::<anonymous> Namespace */
+
+Record &
+Record::format(const char *format_, ...)
+{
+	char l_buffer[64];
+
+	va_list l_args;
+	va_start(l_args, format_);
+	const int l_count =
+	    vsnprintf(l_buffer, sizeof(l_buffer), format_, l_args);
+	va_end(l_args);
+
+	if (l_count > 0)
+		append(l_buffer, size_t(l_count) < sizeof(l_buffer) ?
+		    size_t(l_count) : sizeof(l_buffer) - 1);
+
+	return(*this);
+}
+
+bool
+Enabled(Level level, const char *file)
+{
+	if (level < s_threshold)
+		return(false);
+
+	if (!s_disabled_count || level == FatalLevel)
+		return(true);
+
+	const char *l_subsystem;
+	size_t l_length;
+	if (!Subsystem(file, l_subsystem, l_length))
+		return(true);
+
+	return(FindDisabled(l_subsystem, l_length) == -1);
+}
+
+void
+Submit(const Record &record)
+{
+	const bool l_async =
+	    !s_synchronous && record.level() != FatalLevel && StartWriter();
+
+	Ring &l_ring = *LocalRing();
+	if (Push(l_ring, record)) {
+		if (!l_async)
+			Flush();
+		return;
+	}
+
+	/*
+	 * Ring is full, drain it ourselves unless the writer is already
+	 * busy doing so. Synchronous callers never drop, they wait.
+	 */
+	if (l_async) {
+		bool l_pushed = false;
+		if (s_drain_lock.tryLock()) {
+			Drain();
+			l_pushed = Push(l_ring, record);
+			s_drain_lock.unlock();
+		}
+		if (!l_pushed)
+			++l_ring.dropped;
+	}
+	else {
+		Flush();
+		Push(l_ring, record);
+		Flush();
+	}
+}
+
+void
+Flush(void)
+{
+	Thread::ScopedSpinLock l_lock(s_drain_lock);
+	Drain();
+}
+
+void
+SetThreshold(Level level)
+{
+	s_threshold = level;
+}
+
+Level
+Threshold(void)
+{
+	return(s_threshold);
+}
+
+void
+SetSubsystem(const char *subsystem, bool enabled)
+{
+	const size_t l_length = strlen(subsystem);
+	const int l_index = FindDisabled(subsystem, l_length);
+
+	if (enabled && l_index != -1) {
+		--s_disabled_count;
+		memmove(s_disabled[l_index], s_disabled[s_disabled_count], MaxName);
+	}
+	else if (!enabled && l_index == -1) {
+		if (s_disabled_count == MaxDisabled || l_length >= MaxName) {
+			MMERROR("Unable to disable logging subsystem '" << subsystem << "'.");
+			return;
+		}
+		memcpy(s_disabled[s_disabled_count++], subsystem, l_length + 1);
+	}
+}
+
+void
+SetSink(Sink sink)
+{
+	Flush();
+	s_sink = sink;
+}
+
+void
+SetAsynchronous(bool asynchronous)
+{
+	s_synchronous = !asynchronous;
+	if (s_synchronous)
+		Flush();
+}
+
+unsigned long
+Dropped(void)
+{
+	unsigned long l_dropped = 0;
+	for (Ring *l_ring = s_rings.first; l_ring; l_ring = l_ring->next)
+		l_dropped += l_ring->dropped;
+	return(l_dropped);
+}
+
+} /*************************************************** Core::Logger Namespace */
+} /*********************************************************** Core Namespace */
+MARSHMALLOW_NAMESPACE_END
@@ -0,0 +1,301 @@
+/*
+ * Copyright (c) 2013, Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ * All rights reserved.
+ *
+ * This file is part of Marshmallow Game Engine.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE CONTRIBUTORS ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are
+ * those of the authors and should not be interpreted as representing official
+ * policies, either expressed or implied, of the project as a whole.
+ */
+
+#include "core/mappedfileio.h"
+
+/*!
+ * @file
+ *
+ * @author Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ */
+
+#include "core/identifier.h"
+#include "core/logger.h"
+#include "core/packio.h"
+
+#include <cassert>
+#include <climits>
+#include <cstring>
+
+#include "mappedfileio_p.h"
+
+MARSHMALLOW_NAMESPACE_BEGIN
+namespace Core { /******************************************** Core Namespace */
+
+struct MappedFileIO::Private
+{
+	Identifier   filename;
+	PackIO      *entry;
+	const char  *data;
+	size_t       size;
+	long         cursor;
+	DIOMode      mode;
+	bool         eof;
+};
+
+MappedFileIO::MappedFileIO(void)
+    : m_p(new Private)
+{
+	m_p->entry = 0;
+	m_p->data = 0;
+	m_p->size = 0;
+	m_p->cursor = 0;
+	m_p->mode = DIOInvalid;
+	m_p->eof = false;
+}
+
+MappedFileIO::MappedFileIO(const Identifier &fn, DIOMode m)
+    : m_p(new Private)
+{
+	m_p->entry = 0;
+	m_p->data = 0;
+	m_p->size = 0;
+	m_p->cursor = 0;
+	m_p->mode = DIOInvalid;
+	m_p->eof = false;
+	setFileName(fn);
+	open(m);
+}
+
+MappedFileIO::~MappedFileIO(void)
+{
+	close();
+	delete m_p, m_p = 0;
+}
+
+const Identifier &
+MappedFileIO::fileName(void) const
+{
+	return(m_p->filename);
+}
+
+void
+MappedFileIO::setFileName(const Identifier &fn)
+{
+	if (isOpen()) {
+		MMERROR("Can't change filename on open device.");
+		return;
+	}
+
+	m_p->filename = fn;
+}
+
+size_t
+MappedFileIO::size(void) const
+{
+	return(m_p->size);
+}
+
+bool
+MappedFileIO::advise(DIOAdvice a, size_t o, size_t l)
+{
+	if (!isOpen() || o > m_p->size)
+		return(false);
+
+	if (l == 0 || l > m_p->size - o)
+		l = m_p->size - o;
+
+	if (m_p->entry)
+		return(m_p->entry->advise(a, o, l));
+
+	/* nothing mapped (empty file) */
+	if (!m_p->data || l == 0)
+		return(true);
+
+	return(MappedFile::Advise(m_p->data, o, l, a));
+}
+
+bool
+MappedFileIO::open(DIOMode m)
+{
+	if (isOpen()) {
+		MMWARNING("Device is already open.");
+		return(false);
+	}
+
+	if (!m_p->filename) {
+		MMWARNING("Tried to open device without a filename.");
+		return(false);
+	}
+
+	if ((m & DIOReadWrite) != DIOReadOnly) {
+		MMERROR("Mapped files can only be opened read-only.");
+		return(false);
+	}
+
+	const void *l_data = 0;
+	size_t l_size = 0;
+
+	/* asset pack entries are already mapped */
+	if (PackIO::IsPackPath(m_p->filename)) {
+		PackIO *l_entry = new PackIO(m_p->filename, m);
+		if (!l_entry->isOpen()) {
+			delete l_entry;
+			return(false);
+		}
+
+		m_p->entry = l_entry;
+		l_size = l_entry->size();
+		l_data = l_entry->view(0, l_size);
+	}
+	else if (!MappedFile::Map(m_p->filename, l_data, l_size)) {
+		MMWARNING("Failed to map file: " << m_p->filename.str());
+		return(false);
+	}
+
+	if (l_size > LONG_MAX) {
+		MMERROR("File too large to map: " << m_p->filename.str());
+		if (m_p->entry)
+			delete m_p->entry, m_p->entry = 0;
+		else MappedFile::Unmap(l_data, l_size);
+		return(false);
+	}
+
+	m_p->data = static_cast<const char *>(l_data);
+	m_p->size = l_size;
+	m_p->cursor = 0;
+	m_p->mode = m;
+	m_p->eof = false;
+
+	return(true);
+}
+
+void
+MappedFileIO::close(void)
+{
+	if (m_p->entry)
+		delete m_p->entry, m_p->entry = 0;
+	else if (m_p->data)
+		MappedFile::Unmap(m_p->data, m_p->size);
+
+	m_p->data = 0;
+	m_p->size = 0;
+	m_p->cursor = 0;
+	m_p->mode = DIOInvalid;
+	m_p->eof = false;
+}
+
+DIOMode
+MappedFileIO::mode(void) const
+{
+	return(m_p->mode);
+}
+
+bool
+MappedFileIO::isOpen(void) const
+{
+	return(m_p->mode != DIOInvalid);
+}
+
+bool
+MappedFileIO::atEOF(void) const
+{
+	return(m_p->eof);
+}
+
+size_t
+MappedFileIO::read(void *b, size_t bs)
+{
+	assert(isOpen() && "Device is not open!");
+
+	const size_t l_cursor = size_t(m_p->cursor);
+	const size_t l_available = m_p->size - l_cursor;
+	const size_t l_rcount = bs < l_available ? bs : l_available;
+
+	if (l_rcount)
+		memcpy(b, m_p->data + l_cursor, l_rcount);
+	m_p->cursor += long(l_rcount);
+
+	/* set end-of-file flag */
+	m_p->eof = (bs > l_rcount);
+
+	return(l_rcount);
+}
+
+size_t
+MappedFileIO::write(const void *, size_t)
+{
+	MMERROR("Mapped files are read-only.");
+	return(0);
+}
+
+bool
+MappedFileIO::seek(long o, DIOSeek on)
+{
+	const long l_size = long(m_p->size);
+	long l_cursor = -1;
+
+	switch (on) {
+	case DIOSet:
+		l_cursor = o;
+		break;
+	case DIOEnd:
+		l_cursor = l_size + o;
+		break;
+	case DIOCurrent:
+		l_cursor = m_p->cursor + o;
+		break;
+	default: return(false);
+	}
+
+	if (l_cursor < 0 || l_cursor > l_size)
+		return(false);
+
+	/* reset end-of-file flag */
+	m_p->eof = false;
+
+	m_p->cursor = l_cursor;
+	return(true);
+}
+
+long
+MappedFileIO::tell(void) const
+{
+	return(m_p->cursor);
+}
+
+const void *
+MappedFileIO::view(size_t o, size_t l) const
+{
+	if (!isOpen() || o > m_p->size || l > m_p->size - o)
+		return(0);
+
+	/* empty files have no mapping, hand out something non-null */
+	if (!m_p->data)
+		return("");
+
+	return(m_p->data + o);
+}
+
+} /*********************************************************** Core Namespace */
+MARSHMALLOW_NAMESPACE_END
+
@@ -0,0 +1,327 @@
+/*
+ * Copyright (c) 2013, Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ * All rights reserved.
+ *
+ * This file is part of Marshmallow Game Engine.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE CONTRIBUTORS ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are
+ * those of the authors and should not be interpreted as representing official
+ * policies, either expressed or implied, of the project as a whole.
+ */
+
+#include "core/memory.h"
+
+/*!
+ * @file
+ *
+ * @author Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ */
+
+#include "core/logger.h"
+
+#include <cstdlib>
+#include <new>
+
+MARSHMALLOW_NAMESPACE_BEGIN
+namespace Core { /******************************************** Core Namespace */
+namespace Memory { /********************************** Core::Memory Namespace */
+namespace { /**************************** Core::Memory::<anonymous> Namespace */
+
+	/* plain data, usable by allocations made during static initialization */
+	struct Counter
+	{
+		volatile long live;
+		volatile long peak;
+		volatile long allocations;
+		long          mark;
+		long          frame;
+	};
+
+	Counter s_tags[Tags];
+	Counter s_resources[Resources];
+
+	MMTHREADLOCAL int s_current = UntaggedMemory;
+
+	const char *s_tag_names[Tags] = {
+		"untagged",
+		"core",
+		"event",
+		"graphics",
+		"audio",
+		"game",
+		"input"
+	};
+
+	const char *s_resource_names[Resources] = {
+		"texture",
+		"vertex",
+		"texture coordinate"
+	};
+
+	inline void
+	Charge(Counter &counter, long bytes)
+	{
+		const long l_live = MMATOMIC_ADD(counter.live, bytes);
+		MMATOMIC_INCREMENT(counter.allocations);
+
+		long l_peak;
+		while ((l_peak = counter.peak) < l_live
+		    && !MMATOMIC_CAS(counter.peak, l_peak, l_live))
+			continue;
+	}
+
+	inline void
+	Credit(Counter &counter, long bytes)
+	{
+		MMATOMIC_ADD(counter.live, -bytes);
+	}
+
+	inline Statistics
+	Read(const Counter &counter)
+	{
+		Statistics l_stats;
+		l_stats.live        = counter.live;
+		l_stats.peak        = counter.peak;
+		l_stats.allocations = static_cast<unsigned long>(counter.allocations);
+		l_stats.frame       = static_cast<unsigned long>(counter.frame);
+		return(l_stats);
+	}
+
+	inline void
+	Latch(Counter &counter)
+	{
+		const long l_allocations = counter.allocations;
+		counter.frame = l_allocations - counter.mark;
+		counter.mark = l_allocations;
+	}
+
+	/* dumps are requested explicitly, they ignore the debug verbosity */
+	void
+	Log(const char *name, const Counter &counter)
+	{
+		MMLOG("INFO", "Memory " << name
+		    << ": live=" << (counter.live / 1024)
+		    << "KiB peak=" << (counter.peak / 1024)
+		    << "KiB allocations=" << counter.allocations
+		    << " (" << counter.frame << "/frame)");
+	}
+
+#if MARSHMALLOW_MEMORY_TRACKING
+	/* keeps the returned block 16 byte aligned */
+	union Header
+	{
+		struct Info
+		{
+			size_t size;
+			int    tag;
+		} info;
+		char align[16];
+	};
+
+	inline void *
+	Acquire(size_t size)
+	{
+		Header *l_header = static_cast<Header *>(malloc(sizeof(Header) + size));
+		if (!l_header)
+			return(0);
+
+		l_header->info.size = size;
+		l_header->info.tag = s_current;
+		Charge(s_tags[s_current], static_cast<long>(size));
+
+		return(l_header + 1);
+	}
+
+	inline void
+	Dispose(void *ptr)
+	{
+		if (!ptr) return;
+
+		Header *l_header = static_cast<Header *>(ptr) - 1;
+		Credit(s_tags[l_header->info.tag], static_cast<long>(l_header->info.size));
+		free(l_header);
+	}
+#endif
+
+} /************************************** Core::Memory::<anonymous> Namespace */
+
+Scope::Scope(Tag tag)
+    : m_previous(static_cast<Tag>(s_current))
+{
+	s_current = tag;
+}
+
+Scope::~Scope(void)
+{
+	s_current = m_previous;
+}
+
+bool
+Enabled(void)
+{
+	return(MARSHMALLOW_MEMORY_TRACKING != 0);
+}
+
+Tag
+Current(void)
+{
+	return(static_cast<Tag>(s_current));
+}
+
+void
+Track(Resource resource, size_t bytes)
+{
+	Charge(s_resources[resource], static_cast<long>(bytes));
+}
+
+void
+Untrack(Resource resource, size_t bytes)
+{
+	Credit(s_resources[resource], static_cast<long>(bytes));
+}
+
+Statistics
+Stats(Tag tag)
+{
+	return(Read(s_tags[tag]));
+}
+
+Statistics
+Stats(Resource resource)
+{
+	return(Read(s_resources[resource]));
+}
+
+void
+Frame(void)
+{
+	for (int l_i = 0; l_i < Tags; ++l_i)
+		Latch(s_tags[l_i]);
+	for (int l_i = 0; l_i < Resources; ++l_i)
+		Latch(s_resources[l_i]);
+}
+
+void
+Dump(void)
+{
+	if (!Enabled())
+		MMLOG("INFO", "Memory tracking is disabled, only GPU estimates are available.");
+	else for (int l_i = 0; l_i < Tags; ++l_i)
+		Log(s_tag_names[l_i], s_tags[l_i]);
+
+	for (int l_i = 0; l_i < Resources; ++l_i)
+		Log(s_resource_names[l_i], s_resources[l_i]);
+}
+
+const char *
+TagName(Tag tag)
+{
+	return(tag >= 0 && tag < Tags ? s_tag_names[tag] : "unknown");
+}
+
+const char *
+ResourceName(Resource resource)
+{
+	return(resource >= 0 && resource < Resources ? s_resource_names[resource] : "unknown");
+}
+
+} /*************************************************** Core::Memory Namespace */
+} /*********************************************************** Core Namespace */
+MARSHMALLOW_NAMESPACE_END
+
+#if MARSHMALLOW_MEMORY_TRACKING
+/********************************************************** global new/delete */
+
+#if MARSHMALLOW_CXX11
+#   define MEMORY_THROW_BAD_ALLOC
+#else
+#   define MEMORY_THROW_BAD_ALLOC throw (std::bad_alloc)
+#endif
+
+/* exceptions are disabled, running out of memory is fatal */
+
+void *
+operator new(size_t size) MEMORY_THROW_BAD_ALLOC
+{
+	void *l_ptr = MARSHMALLOW_NAMESPACE::Core::Memory::Acquire(size);
+	if (!l_ptr) abort();
+	return(l_ptr);
+}
+
+void *
+operator new[](size_t size) MEMORY_THROW_BAD_ALLOC
+{
+	void *l_ptr = MARSHMALLOW_NAMESPACE::Core::Memory::Acquire(size);
+	if (!l_ptr) abort();
+	return(l_ptr);
+}
+
+void *
+operator new(size_t size, const std::nothrow_t &) throw ()
+{
+	return(MARSHMALLOW_NAMESPACE::Core::Memory::Acquire(size));
+}
+
+void *
+operator new[](size_t size, const std::nothrow_t &) throw ()
+{
+	return(MARSHMALLOW_NAMESPACE::Core::Memory::Acquire(size));
+}
+
+void
+operator delete(void *ptr) throw ()
+{
+	MARSHMALLOW_NAMESPACE::Core::Memory::Dispose(ptr);
+}
+
+void
+operator delete[](void *ptr) throw ()
+{
+	MARSHMALLOW_NAMESPACE::Core::Memory::Dispose(ptr);
+}
+
+void
+operator delete(void *ptr, const std::nothrow_t &) throw ()
+{
+	MARSHMALLOW_NAMESPACE::Core::Memory::Dispose(ptr);
+}
+
+void
+operator delete[](void *ptr, const std::nothrow_t &) throw ()
+{
+	MARSHMALLOW_NAMESPACE::Core::Memory::Dispose(ptr);
+}
+
+void
+operator delete(void *ptr, size_t) throw ()
+{
+	MARSHMALLOW_NAMESPACE::Core::Memory::Dispose(ptr);
+}
+
+void
+operator delete[](void *ptr, size_t) throw ()
+{
+	MARSHMALLOW_NAMESPACE::Core::Memory::Dispose(ptr);
+}
+#endif
@@ -0,0 +1,244 @@
+/*
+ * Copyright (c) 2013, Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ * All rights reserved.
+ *
+ * This file is part of Marshmallow Game Engine.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE CONTRIBUTORS ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are
+ * those of the authors and should not be interpreted as representing official
+ * policies, either expressed or implied, of the project as a whole.
+ */
+
+#include "core/objectpool.h"
+
+/*!
+ * @file
+ *
+ * @author Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ */
+
+#include "core/thread_p.h"
+
+#include <new>
+
+MARSHMALLOW_NAMESPACE_BEGIN
+namespace Core { /******************************************** Core Namespace */
+namespace ObjectPool { /************************** Core::ObjectPool Namespace */
+namespace { /************************ Core::ObjectPool::<anonymous> Namespace */
+
+	enum { Batch = CacheLimit / 2 };
+
+	struct Node
+	{
+		Node *next;
+	};
+
+	/*
+	 * Shared state is plain data so it's usable during static
+	 * initialization, before any constructor runs.
+	 */
+	struct Central
+	{
+		Thread::SpinLock lock;
+		Node            *free;
+		char            *cursor;
+		char            *end;
+		size_t           slabs;
+		unsigned long    capacity;
+		unsigned long    available;
+		unsigned long    allocations;
+		unsigned long    releases;
+	};
+
+	/* one thread-local block, a single TLS lookup per call */
+	struct Cache
+	{
+		Node          *free[Classes];
+		unsigned int   cached[Classes];
+		unsigned long  allocations[Classes];
+		unsigned long  releases[Classes];
+	};
+
+	Central s_central[Classes];
+
+	MMTHREADLOCAL Cache s_cache;
+
+	inline size_t
+	ObjectSize(int c)
+	{
+		return(static_cast<size_t>(c + 1) * Granularity);
+	}
+
+	/* locked */
+	inline void
+	Publish(Central &central, Cache &cache, int c)
+	{
+		central.allocations += cache.allocations[c];
+		central.releases += cache.releases[c];
+		cache.allocations[c] = cache.releases[c] = 0;
+	}
+
+	Node *
+	Refill(Cache &cache, int c)
+	{
+		Central &l_central = s_central[c];
+		const size_t l_size = ObjectSize(c);
+		Node *l_head = 0;
+		unsigned int l_count = 0;
+
+		l_central.lock.lock();
+
+		while (l_central.free && l_count < Batch) {
+			Node *l_node = l_central.free;
+			l_central.free = l_node->next;
+			l_node->next = l_head;
+			l_head = l_node;
+			++l_count;
+		}
+		l_central.available -= l_count;
+
+		while (l_count < Batch) {
+			if (l_central.cursor + l_size > l_central.end) {
+				l_central.cursor = new char[SlabSize];
+				l_central.end = l_central.cursor + SlabSize;
+				++l_central.slabs;
+			}
+
+			Node *l_node = reinterpret_cast<Node *>(l_central.cursor);
+			l_central.cursor += l_size;
+			l_node->next = l_head;
+			l_head = l_node;
+			++l_count;
+			++l_central.capacity;
+		}
+
+		Publish(l_central, cache, c);
+		l_central.lock.unlock();
+
+		/* keep one, cache the rest */
+		cache.free[c] = l_head->next;
+		cache.cached[c] = l_count - 1;
+		return(l_head);
+	}
+
+	void
+	Drain(Cache &cache, int c, unsigned int count)
+	{
+		Central &l_central = s_central[c];
+		Node *l_head = cache.free[c];
+		Node *l_tail = 0;
+		unsigned int l_count = 0;
+
+		/* detach count nodes off the front */
+		Node *l_node = l_head;
+		while (l_node && l_count < count) {
+			l_tail = l_node;
+			l_node = l_node->next;
+			++l_count;
+		}
+		cache.free[c] = l_node;
+		cache.cached[c] -= l_count;
+
+		Thread::ScopedSpinLock l_lock(l_central.lock);
+		if (l_tail) {
+			l_tail->next = l_central.free;
+			l_central.free = l_head;
+			l_central.available += l_count;
+		}
+		Publish(l_central, cache, c);
+	}
+
+} /********************************** Core::ObjectPool::<anonymous> Namespace */
+
+void *
+Allocate(size_t size)
+{
+	const int l_class = SizeClass(size);
+	if (l_class == Classes)
+		return(::operator new(size));
+
+	Cache &l_cache = s_cache;
+	++l_cache.allocations[l_class];
+
+	Node *l_node = l_cache.free[l_class];
+	if (!l_node)
+		return(Refill(l_cache, l_class));
+
+	l_cache.free[l_class] = l_node->next;
+	--l_cache.cached[l_class];
+	return(l_node);
+}
+
+void
+Release(void *ptr, size_t size)
+{
+	if (!ptr) return;
+
+	const int l_class = SizeClass(size);
+	if (l_class == Classes) {
+		::operator delete(ptr);
+		return;
+	}
+
+	Cache &l_cache = s_cache;
+	++l_cache.releases[l_class];
+
+	Node *l_node = static_cast<Node *>(ptr);
+	l_node->next = l_cache.free[l_class];
+	l_cache.free[l_class] = l_node;
+
+	if (++l_cache.cached[l_class] > CacheLimit)
+		Drain(l_cache, l_class, Batch);
+}
+
+void
+Flush(void)
+{
+	Cache &l_cache = s_cache;
+	for (int l_class = 0; l_class < Classes; ++l_class)
+		Drain(l_cache, l_class, l_cache.cached[l_class]);
+}
+
+Statistics
+Stats(int c)
+{
+	Statistics l_stats = { 0, 0, 0, 0, 0, 0 };
+	if (c < 0 || c >= Classes)
+		return(l_stats);
+
+	Central &l_central = s_central[c];
+	Thread::ScopedSpinLock l_lock(l_central.lock);
+	l_stats.size        = ObjectSize(c);
+	l_stats.slabs       = l_central.slabs;
+	l_stats.capacity    = l_central.capacity;
+	l_stats.available   = l_central.available;
+	l_stats.allocations = l_central.allocations + s_cache.allocations[c];
+	l_stats.releases    = l_central.releases + s_cache.releases[c];
+
+	return(l_stats);
+}
+
+} /*********************************************** Core::ObjectPool Namespace */
+} /*********************************************************** Core Namespace */
+MARSHMALLOW_NAMESPACE_END
@@ -0,0 +1,217 @@
+/*
+ * Copyright (c) 2013, Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ * All rights reserved.
+ *
+ * This file is part of Marshmallow Game Engine.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE CONTRIBUTORS ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are
+ * those of the authors and should not be interpreted as representing official
+ * policies, either expressed or implied, of the project as a whole.
+ */
+
+#pragma once
+
+/*!
+ * @file
+ *
+ * @author Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ */
+
+#ifndef MARSHMALLOW_CORE_PACK_P_H
+#define MARSHMALLOW_CORE_PACK_P_H 1
+
+#include "core/environment.h"
+#include "core/namespace.h"
+
+#include <cstring>
+#include <string>
+
+MARSHMALLOW_NAMESPACE_BEGIN
+namespace Core { /******************************************** Core Namespace */
+
+/*! @brief Asset pack file format
+ *
+ * All fields are little-endian uint32_t.
+ *
+ *   header     32 bytes, see HeaderField
+ *   buckets    (bucket count + 1) entry indices, bucket b spans
+ *              [buckets[b], buckets[b + 1])
+ *   entries    32 byte records, see EntryField, sorted by hash then name
+ *   names      entry names, not null-terminated
+ *   data       entry data, each entry starts on a multiple of the
+ *              header alignment
+ *
+ * Entry hashes are Core::Hash::Algorithm() of the name with a full mask,
+ * the same value an Identifier of the name carries.
+ */
+namespace Pack { /************************************** Core::Pack Namespace */
+
+	const char     Magic[4] = { 'M', 'M', 'P', 'K' };
+	const uint32_t Version  = 1;
+
+	const size_t HeaderSize = 32;
+	const size_t RecordSize = 32;
+
+	enum HeaderField
+	{
+		HeaderMagic     = 0,
+		HeaderVersion   = 4,
+		HeaderFlags     = 8,
+		HeaderCount     = 12,
+		HeaderBuckets   = 16,
+		HeaderAlignment = 20,
+		HeaderDirectory = 24,
+		HeaderNames     = 28
+	};
+
+	enum HeaderFlag
+	{
+		/* hashes were built with the one-at-a-time algorithm */
+		LegacyHashFlag = (1 << 0)
+	};
+
+	enum EntryField
+	{
+		EntryHash       = 0,
+		EntryName       = 4,
+		EntryNameLength = 8,
+		EntryFlags      = 12,
+		EntryOffset     = 16,
+		EntrySize       = 20,
+		EntryStored     = 24
+	};
+
+	enum EntryFlag
+	{
+		/* stored as a zlib stream, size is the inflated size */
+		ZlibFlag = (1 << 0)
+	};
+
+	inline uint32_t
+	Load32(const unsigned char *p)
+	{
+		return(uint32_t(p[0])       | uint32_t(p[1]) << 8
+		     | uint32_t(p[2]) << 16 | uint32_t(p[3]) << 24);
+	}
+
+	inline void
+	Store32(unsigned char *p, uint32_t v)
+	{
+		p[0] = static_cast<unsigned char>(v);
+		p[1] = static_cast<unsigned char>(v >> 8);
+		p[2] = static_cast<unsigned char>(v >> 16);
+		p[3] = static_cast<unsigned char>(v >> 24);
+	}
+
+	/* monotonic in hash, so sorted entries keep buckets contiguous */
+	inline uint32_t
+	Bucket(MMUID hash, uint32_t buckets)
+	{
+		return(static_cast<uint32_t>((uint64_t(hash) * buckets) >> 32));
+	}
+
+	/*
+	 * Strip the "pack:" scheme (and any slashes after it) from a path.
+	 *
+	 * @return true if path used the pack scheme
+	 */
+	inline bool
+	StripScheme(const char *&path, size_t &length)
+	{
+		if (length < 5 || 0 != memcmp(path, "pack:", 5))
+			return(false);
+
+		path += 5, length -= 5;
+		while (length > 0 && *path == '/')
+			++path, --length;
+		return(true);
+	}
+
+	/*
+	 * @return true if path has no empty, "." or ".." segments
+	 */
+	inline bool
+	IsNormalized(const char *path, size_t length)
+	{
+		size_t l_begin = 0;
+		for (size_t l_i = 0; l_i <= length; ++l_i) {
+			if (l_i < length && path[l_i] != '/')
+				continue;
+
+			const size_t l_segment = l_i - l_begin;
+			if (l_segment == 0 || (path[l_begin] == '.' && (l_segment == 1
+			    || (l_segment == 2 && path[l_begin + 1] == '.'))))
+				return(false);
+
+			l_begin = l_i + 1;
+		}
+
+		return(true);
+	}
+
+	/*
+	 * Resolve "." and ".." segments and repeated slashes.
+	 *
+	 * @return false if the path climbs above the pack root
+	 */
+	inline bool
+	Normalize(const char *path, size_t length, std::string &out)
+	{
+		out.clear();
+		out.reserve(length);
+
+		size_t l_begin = 0;
+		while (l_begin < length) {
+			size_t l_end = l_begin;
+			while (l_end < length && path[l_end] != '/')
+				++l_end;
+
+			const size_t l_segment = l_end - l_begin;
+			const bool l_dot = (l_segment == 1 && path[l_begin] == '.');
+			const bool l_dotdot = (l_segment == 2 && path[l_begin] == '.'
+			    && path[l_begin + 1] == '.');
+
+			if (l_dotdot) {
+				if (out.empty())
+					return(false);
+				const size_t l_slash = out.rfind('/');
+				out.erase(l_slash == std::string::npos ? 0 : l_slash);
+			}
+			else if (l_segment > 0 && !l_dot) {
+				if (!out.empty())
+					out += '/';
+				out.append(path + l_begin, l_segment);
+			}
+
+			l_begin = l_end + 1;
+		}
+
+		return(true);
+	}
+
+} /***************************************************** Core::Pack Namespace */
+} /*********************************************************** Core Namespace */
+MARSHMALLOW_NAMESPACE_END
+
+#endif
@@ -0,0 +1,535 @@
+/*
+ * Copyright (c) 2013, Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ * All rights reserved.
+ *
+ * This file is part of Marshmallow Game Engine.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE CONTRIBUTORS ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are
+ * those of the authors and should not be interpreted as representing official
+ * policies, either expressed or implied, of the project as a whole.
+ */
+
+#include "core/packio.h"
+
+/*!
+ * @file
+ *
+ * @author Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ */
+
+#include "core/hash.h"
+#include "core/identifier.h"
+#include "core/logger.h"
+#include "core/shared.h"
+#include "core/zlib.h"
+
+#include <cassert>
+#include <cstring>
+#include <vector>
+
+#include "mappedfileio_p.h"
+#include "pack_p.h"
+
+MARSHMALLOW_NAMESPACE_BEGIN
+namespace Core { /******************************************** Core Namespace */
+namespace { /************************************ Core::<anonymous> Namespace */
+
+	struct Archive
+	{
+		Archive(void)
+		    : data(0)
+		    , size(0)
+		    , count(0)
+		    , buckets(0)
+		    , table(0)
+		    , records(0)
+		    , names(0)
+		    , names_size(0)
+		{}
+
+		~Archive(void)
+		{
+			if (data)
+				MappedFile::Unmap(data, size);
+		}
+
+		bool load(const Identifier &filename);
+		const unsigned char * find(const char *name, size_t length,
+		    MMUID hash) const;
+
+		Identifier           filename;
+		const unsigned char *data;
+		size_t               size;
+		uint32_t             count;
+		uint32_t             buckets;
+		const unsigned char *table;
+		const unsigned char *records;
+		const unsigned char *names;
+		size_t               names_size;
+	};
+	typedef Shared<Archive> SharedArchive;
+	typedef std::vector<SharedArchive> ArchiveList;
+
+	ArchiveList &
+	Archives(void)
+	{
+		static ArchiveList s_archives;
+		return(s_archives);
+	}
+
+	bool
+	Archive::load(const Identifier &fn)
+	{
+		const void *l_data = 0;
+
+		if (!MappedFile::Map(fn, l_data, size)) {
+			MMWARNING("Failed to map asset pack: " << fn.str());
+			return(false);
+		}
+
+		data = static_cast<const unsigned char *>(l_data);
+		filename = fn;
+
+		if (size < Pack::HeaderSize
+		    || 0 != memcmp(data + Pack::HeaderMagic, Pack::Magic, 4)) {
+			MMERROR("Not an asset pack: " << fn.str());
+			return(false);
+		}
+
+		if (Pack::Load32(data + Pack::HeaderVersion) != Pack::Version) {
+			MMERROR("Unsupported asset pack version: " << fn.str());
+			return(false);
+		}
+
+		const bool l_legacy =
+		    (Pack::Load32(data + Pack::HeaderFlags) & Pack::LegacyHashFlag);
+		if (l_legacy != bool(MARSHMALLOW_LEGACY_HASH)) {
+			MMERROR("Asset pack was built with a different hash algorithm: "
+			    << fn.str());
+			return(false);
+		}
+
+		count   = Pack::Load32(data + Pack::HeaderCount);
+		buckets = Pack::Load32(data + Pack::HeaderBuckets);
+
+		const uint64_t l_directory = Pack::Load32(data + Pack::HeaderDirectory);
+		const uint64_t l_names = Pack::Load32(data + Pack::HeaderNames);
+		const uint64_t l_records = l_directory + (uint64_t(buckets) + 1) * 4;
+		const uint64_t l_records_end = l_records + uint64_t(count) * Pack::RecordSize;
+
+		if (buckets == 0 || l_directory < Pack::HeaderSize
+		    || l_records_end > l_names || l_names > size) {
+			MMERROR("Corrupt asset pack directory: " << fn.str());
+			return(false);
+		}
+
+		table = data + l_directory;
+		records = data + l_records;
+		names = data + l_names;
+		names_size = size - size_t(l_names);
+
+		/* buckets must partition the entries in order */
+		uint32_t l_index = Pack::Load32(table);
+		bool l_valid = (l_index == 0);
+		for (uint32_t l_b = 1; l_b <= buckets && l_valid; ++l_b) {
+			const uint32_t l_next = Pack::Load32(table + l_b * 4);
+			l_valid = (l_next >= l_index);
+			l_index = l_next;
+		}
+
+		if (!l_valid || l_index != count) {
+			MMERROR("Corrupt asset pack buckets: " << fn.str());
+			return(false);
+		}
+
+		return(true);
+	}
+
+	const unsigned char *
+	Archive::find(const char *name, size_t length, MMUID hash) const
+	{
+		const uint32_t l_bucket = Pack::Bucket(hash, buckets);
+		const uint32_t l_last = Pack::Load32(table + (l_bucket + 1) * 4);
+
+		for (uint32_t l_i = Pack::Load32(table + l_bucket * 4); l_i < l_last; ++l_i) {
+			const unsigned char *l_record = records + l_i * Pack::RecordSize;
+			const MMUID l_hash = Pack::Load32(l_record + Pack::EntryHash);
+
+			if (l_hash < hash)
+				continue;
+			else if (l_hash > hash)
+				break;
+
+			const size_t l_name = Pack::Load32(l_record + Pack::EntryName);
+			const size_t l_length = Pack::Load32(l_record + Pack::EntryNameLength);
+			if (l_length == length && l_name <= names_size
+			    && l_length <= names_size - l_name
+			    && 0 == memcmp(names + l_name, name, length))
+				return(l_record);
+		}
+
+		return(0);
+	}
+
+	const unsigned char *
+	Resolve(const Identifier &path, SharedArchive &archive)
+	{
+		const char *l_name = path.str().c_str();
+		size_t l_length = path.str().size();
+		MMUID l_hash = path.result();
+
+		bool l_rehash = Pack::StripScheme(l_name, l_length);
+
+		std::string l_normalized;
+		if (!Pack::IsNormalized(l_name, l_length)) {
+			if (!Pack::Normalize(l_name, l_length, l_normalized))
+				return(0);
+			l_name = l_normalized.c_str();
+			l_length = l_normalized.size();
+			l_rehash = true;
+		}
+
+		if (l_rehash)
+			l_hash = Hash::Algorithm(l_name, l_length, ~static_cast<MMUID>(0));
+
+		/* most recently mounted first */
+		ArchiveList &l_archives = Archives();
+		ArchiveList::reverse_iterator l_i;
+		for (l_i = l_archives.rbegin(); l_i != l_archives.rend(); ++l_i) {
+			const unsigned char *l_record = (*l_i)->find(l_name, l_length, l_hash);
+			if (l_record) {
+				archive = *l_i;
+				return(l_record);
+			}
+		}
+
+		return(0);
+	}
+
+} /********************************************** Core::<anonymous> Namespace */
+
+struct PackIO::Private
+{
+	Identifier           filename;
+	SharedArchive        archive;
+	const char          *data;
+	char                *buffer;
+	size_t               offset;
+	size_t               size;
+	long                 cursor;
+	DIOMode              mode;
+	bool                 eof;
+};
+
+PackIO::PackIO(void)
+    : m_p(new Private)
+{
+	m_p->data = 0;
+	m_p->buffer = 0;
+	m_p->offset = 0;
+	m_p->size = 0;
+	m_p->cursor = 0;
+	m_p->mode = DIOInvalid;
+	m_p->eof = false;
+}
+
+PackIO::PackIO(const Identifier &fn, DIOMode m)
+    : m_p(new Private)
+{
+	m_p->data = 0;
+	m_p->buffer = 0;
+	m_p->offset = 0;
+	m_p->size = 0;
+	m_p->cursor = 0;
+	m_p->mode = DIOInvalid;
+	m_p->eof = false;
+	setFileName(fn);
+	open(m);
+}
+
+PackIO::~PackIO(void)
+{
+	close();
+	delete m_p, m_p = 0;
+}
+
+const Identifier &
+PackIO::fileName(void) const
+{
+	return(m_p->filename);
+}
+
+void
+PackIO::setFileName(const Identifier &fn)
+{
+	if (isOpen()) {
+		MMERROR("Can't change filename on open device.");
+		return;
+	}
+
+	m_p->filename = fn;
+}
+
+size_t
+PackIO::size(void) const
+{
+	return(m_p->size);
+}
+
+bool
+PackIO::advise(DIOAdvice a, size_t o, size_t l)
+{
+	if (!isOpen() || o > m_p->size)
+		return(false);
+
+	if (l == 0 || l > m_p->size - o)
+		l = m_p->size - o;
+
+	/* inflated entries live in memory */
+	if (m_p->buffer || l == 0)
+		return(true);
+
+	return(MappedFile::Advise(m_p->archive->data, m_p->offset + o, l, a));
+}
+
+bool
+PackIO::open(DIOMode m)
+{
+	if (isOpen()) {
+		MMWARNING("Device is already open.");
+		return(false);
+	}
+
+	if (!m_p->filename) {
+		MMWARNING("Tried to open device without a filename.");
+		return(false);
+	}
+
+	if ((m & DIOReadWrite) != DIOReadOnly) {
+		MMERROR("Asset pack entries can only be opened read-only.");
+		return(false);
+	}
+
+	SharedArchive l_archive;
+	const unsigned char *l_record = Resolve(m_p->filename, l_archive);
+	if (!l_record) {
+		MMWARNING("Asset not found in mounted packs: " << m_p->filename.str());
+		return(false);
+	}
+
+	const size_t l_offset = Pack::Load32(l_record + Pack::EntryOffset);
+	const size_t l_size = Pack::Load32(l_record + Pack::EntrySize);
+	const size_t l_stored = Pack::Load32(l_record + Pack::EntryStored);
+	const uint32_t l_flags = Pack::Load32(l_record + Pack::EntryFlags);
+
+	if (l_offset > l_archive->size || l_stored > l_archive->size - l_offset
+	    || (!(l_flags & Pack::ZlibFlag) && l_stored != l_size)) {
+		MMERROR("Corrupt asset pack entry: " << m_p->filename.str());
+		return(false);
+	}
+
+	const char *l_data =
+	    reinterpret_cast<const char *>(l_archive->data + l_offset);
+
+	if ((l_flags & Pack::ZlibFlag) && l_size > 0) {
+		char *l_buffer;
+		if (Zlib::Inflate(l_data, l_stored, l_size, &l_buffer) != l_size) {
+			MMERROR("Failed to inflate asset pack entry: "
+			    << m_p->filename.str());
+			delete[] l_buffer;
+			return(false);
+		}
+		m_p->buffer = l_buffer;
+		l_data = l_buffer;
+	}
+
+	m_p->archive = l_archive;
+	m_p->data = l_data;
+	m_p->offset = l_offset;
+	m_p->size = l_size;
+	m_p->cursor = 0;
+	m_p->mode = m;
+	m_p->eof = false;
+
+	return(true);
+}
+
+void
+PackIO::close(void)
+{
+	delete[] m_p->buffer, m_p->buffer = 0;
+
+	m_p->archive.clear();
+	m_p->data = 0;
+	m_p->offset = 0;
+	m_p->size = 0;
+	m_p->cursor = 0;
+	m_p->mode = DIOInvalid;
+	m_p->eof = false;
+}
+
+DIOMode
+PackIO::mode(void) const
+{
+	return(m_p->mode);
+}
+
+bool
+PackIO::isOpen(void) const
+{
+	return(m_p->mode != DIOInvalid);
+}
+
+bool
+PackIO::atEOF(void) const
+{
+	return(m_p->eof);
+}
+
+size_t
+PackIO::read(void *b, size_t bs)
+{
+	assert(isOpen() && "Device is not open!");
+
+	const size_t l_cursor = size_t(m_p->cursor);
+	const size_t l_available = m_p->size - l_cursor;
+	const size_t l_rcount = bs < l_available ? bs : l_available;
+
+	if (l_rcount)
+		memcpy(b, m_p->data + l_cursor, l_rcount);
+	m_p->cursor += long(l_rcount);
+
+	/* set end-of-file flag */
+	m_p->eof = (bs > l_rcount);
+
+	return(l_rcount);
+}
+
+size_t
+PackIO::write(const void *, size_t)
+{
+	MMERROR("Asset pack entries are read-only.");
+	return(0);
+}
+
+bool
+PackIO::seek(long o, DIOSeek on)
+{
+	const long l_size = long(m_p->size);
+	long l_cursor = -1;
+
+	switch (on) {
+	case DIOSet:
+		l_cursor = o;
+		break;
+	case DIOEnd:
+		l_cursor = l_size + o;
+		break;
+	case DIOCurrent:
+		l_cursor = m_p->cursor + o;
+		break;
+	default: return(false);
+	}
+
+	if (l_cursor < 0 || l_cursor > l_size)
+		return(false);
+
+	/* reset end-of-file flag */
+	m_p->eof = false;
+
+	m_p->cursor = l_cursor;
+	return(true);
+}
+
+long
+PackIO::tell(void) const
+{
+	return(m_p->cursor);
+}
+
+const void *
+PackIO::view(size_t o, size_t l) const
+{
+	if (!isOpen() || o > m_p->size || l > m_p->size - o)
+		return(0);
+
+	/* empty entries may have no data, hand out something non-null */
+	if (!m_p->data)
+		return("");
+
+	return(m_p->data + o);
+}
+
+bool
+PackIO::Mount(const Identifier &fn)
+{
+	ArchiveList &l_archives = Archives();
+	ArchiveList::const_iterator l_i;
+	for (l_i = l_archives.begin(); l_i != l_archives.end(); ++l_i)
+		if ((*l_i)->filename == fn) {
+			MMWARNING("Asset pack is already mounted: " << fn.str());
+			return(false);
+		}
+
+	SharedArchive l_archive(new Archive);
+	if (!l_archive->load(fn))
+		return(false);
+
+	l_archives.push_back(l_archive);
+
+	MMINFO("Mounted asset pack " << fn.str()
+	    << " (" << l_archive->count << " entries).");
+	return(true);
+}
+
+bool
+PackIO::Unmount(const Identifier &fn)
+{
+	ArchiveList &l_archives = Archives();
+	ArchiveList::iterator l_i;
+	for (l_i = l_archives.begin(); l_i != l_archives.end(); ++l_i)
+		if ((*l_i)->filename == fn) {
+			l_archives.erase(l_i);
+			return(true);
+		}
+
+	return(false);
+}
+
+bool
+PackIO::IsPackPath(const char *path)
+{
+	size_t l_length = path ? strlen(path) : 0;
+	return(l_length > 0 && Pack::StripScheme(path, l_length));
+}
+
+bool
+PackIO::Exists(const Identifier &path)
+{
+	SharedArchive l_archive;
+	return(Resolve(path, l_archive) != 0);
+}
+
+} /*********************************************************** Core Namespace */
+MARSHMALLOW_NAMESPACE_END
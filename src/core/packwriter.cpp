@@ -0,0 +1,300 @@
+/*
+ * Copyright (c) 2013, Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ * All rights reserved.
+ *
+ * This file is part of Marshmallow Game Engine.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE CONTRIBUTORS ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are
+ * those of the authors and should not be interpreted as representing official
+ * policies, either expressed or implied, of the project as a whole.
+ */
+
+#include "core/packwriter.h"
+
+/*!
+ * @file
+ *
+ * @author Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ */
+
+#include "core/fileio.h"
+#include "core/hash.h"
+#include "core/identifier.h"
+#include "core/logger.h"
+#include "core/zlib.h"
+
+#include <algorithm>
+#include <cassert>
+#include <climits>
+#include <set>
+#include <vector>
+
+#include "pack_p.h"
+
+MARSHMALLOW_NAMESPACE_BEGIN
+namespace Core { /******************************************** Core Namespace */
+namespace { /************************************ Core::<anonymous> Namespace */
+
+	struct Entry
+	{
+		std::string       name;
+		MMUID             hash;
+		uint32_t          size;
+		uint32_t          flags;
+		std::vector<char> data;
+	};
+	typedef std::vector<Entry *> EntryList;
+
+	bool
+	EntryLess(const Entry *lhs, const Entry *rhs)
+	{
+		if (lhs->hash != rhs->hash)
+			return(lhs->hash < rhs->hash);
+		return(lhs->name < rhs->name);
+	}
+
+} /********************************************** Core::<anonymous> Namespace */
+
+struct PackWriter::Private
+{
+	Private(size_t alignment_)
+	    : alignment(alignment_)
+	{}
+
+	~Private(void)
+	{
+		EntryList::iterator l_i;
+		for (l_i = entries.begin(); l_i != entries.end(); ++l_i)
+			delete *l_i;
+	}
+
+	inline uint64_t align(uint64_t offset) const
+	    { return((offset + alignment - 1) & ~uint64_t(alignment - 1)); }
+
+	size_t                alignment;
+	EntryList             entries;
+	std::set<std::string> names;
+};
+
+PackWriter::PackWriter(size_t a)
+    : m_p(new Private(a))
+{
+	assert(a > 0 && (a & (a - 1)) == 0 && a <= 65536
+	    && "Alignment must be a power of two!");
+}
+
+PackWriter::~PackWriter(void)
+{
+	delete m_p, m_p = 0;
+}
+
+bool
+PackWriter::add(const std::string &n, const void *d, size_t s, bool c)
+{
+	const char *l_path = n.c_str();
+	size_t l_length = n.size();
+	std::string l_name;
+
+	Pack::StripScheme(l_path, l_length);
+	if (!Pack::Normalize(l_path, l_length, l_name) || l_name.empty()) {
+		MMWARNING("Invalid asset pack entry name: " << n);
+		return(false);
+	}
+
+	if (s > UINT_MAX) {
+		MMERROR("Asset pack entry too large: " << l_name);
+		return(false);
+	}
+
+	if (!m_p->names.insert(l_name).second) {
+		MMWARNING("Duplicate asset pack entry: " << l_name);
+		return(false);
+	}
+
+	Entry *l_entry = new Entry;
+	l_entry->name = l_name;
+	l_entry->hash = Hash::Algorithm(l_name.data(), l_name.size(),
+	    ~static_cast<MMUID>(0));
+	l_entry->size = static_cast<uint32_t>(s);
+	l_entry->flags = 0;
+
+	const char *l_data = static_cast<const char *>(d);
+
+	/* already compressed formats (png, ogg) rarely make the cut */
+	if (c && s > 0) {
+		char *l_deflated;
+		const size_t l_deflated_size =
+		    Zlib::Deflate(l_data, s, &l_deflated, Zlib::BestCompression);
+		if (l_deflated_size > 0 && l_deflated_size <= s - s / 8) {
+			l_entry->data.assign(l_deflated, l_deflated + l_deflated_size);
+			l_entry->flags |= Pack::ZlibFlag;
+		}
+		delete[] l_deflated;
+	}
+
+	if (!(l_entry->flags & Pack::ZlibFlag))
+		l_entry->data.assign(l_data, l_data + s);
+
+	m_p->entries.push_back(l_entry);
+	return(true);
+}
+
+bool
+PackWriter::addFile(const std::string &n, const std::string &p, bool c)
+{
+	FileIO l_file(p, DIOReadOnly);
+	if (!l_file.isOpen()) {
+		MMWARNING("Failed to open asset: " << p);
+		return(false);
+	}
+
+	std::vector<char> l_data(l_file.size());
+	if (!l_data.empty()
+	    && l_file.read(&l_data[0], l_data.size()) != l_data.size()) {
+		MMWARNING("Failed to read asset: " << p);
+		return(false);
+	}
+
+	return(add(n, l_data.empty() ? 0 : &l_data[0], l_data.size(), c));
+}
+
+size_t
+PackWriter::count(void) const
+{
+	return(m_p->entries.size());
+}
+
+bool
+PackWriter::write(IDataIO &sink)
+{
+	EntryList l_sorted(m_p->entries);
+	std::sort(l_sorted.begin(), l_sorted.end(), EntryLess);
+
+	const uint32_t l_count = static_cast<uint32_t>(l_sorted.size());
+
+	/* roughly one entry per bucket */
+	uint32_t l_buckets = 1;
+	while (l_buckets < l_count)
+		l_buckets <<= 1;
+
+	const size_t l_records = Pack::HeaderSize + (l_buckets + 1) * 4;
+	const size_t l_names = l_records + l_count * Pack::RecordSize;
+
+	size_t l_names_size = 0;
+	for (uint32_t l_i = 0; l_i < l_count; ++l_i)
+		l_names_size += l_sorted[l_i]->name.size();
+
+	const uint64_t l_data = m_p->align(l_names + l_names_size);
+	if (l_data > UINT_MAX) {
+		MMERROR("Asset pack directory too large.");
+		return(false);
+	}
+
+	std::vector<unsigned char> l_head(size_t(l_data), 0);
+	unsigned char *l_header = &l_head[0];
+
+	memcpy(l_header + Pack::HeaderMagic, Pack::Magic, 4);
+	Pack::Store32(l_header + Pack::HeaderVersion, Pack::Version);
+	Pack::Store32(l_header + Pack::HeaderFlags,
+	    MARSHMALLOW_LEGACY_HASH ? Pack::LegacyHashFlag : 0);
+	Pack::Store32(l_header + Pack::HeaderCount, l_count);
+	Pack::Store32(l_header + Pack::HeaderBuckets, l_buckets);
+	Pack::Store32(l_header + Pack::HeaderAlignment,
+	    static_cast<uint32_t>(m_p->alignment));
+	Pack::Store32(l_header + Pack::HeaderDirectory, Pack::HeaderSize);
+	Pack::Store32(l_header + Pack::HeaderNames, static_cast<uint32_t>(l_names));
+
+	/* bucket b starts at the first entry hashing into b or later */
+	unsigned char *l_table = l_header + Pack::HeaderSize;
+	uint32_t l_index = 0;
+	for (uint32_t l_b = 0; l_b <= l_buckets; ++l_b) {
+		while (l_index < l_count
+		    && Pack::Bucket(l_sorted[l_index]->hash, l_buckets) < l_b)
+			++l_index;
+		Pack::Store32(l_table + l_b * 4, l_index);
+	}
+
+	uint64_t l_offset = l_data;
+	uint32_t l_name = 0;
+	for (uint32_t l_i = 0; l_i < l_count; ++l_i) {
+		const Entry &l_entry = *l_sorted[l_i];
+		unsigned char *l_record = l_header + l_records + l_i * Pack::RecordSize;
+		const uint32_t l_length = static_cast<uint32_t>(l_entry.name.size());
+		const uint32_t l_stored = static_cast<uint32_t>(l_entry.data.size());
+
+		if (l_offset + l_stored > UINT_MAX) {
+			MMERROR("Asset pack too large.");
+			return(false);
+		}
+
+		Pack::Store32(l_record + Pack::EntryHash, l_entry.hash);
+		Pack::Store32(l_record + Pack::EntryName, l_name);
+		Pack::Store32(l_record + Pack::EntryNameLength, l_length);
+		Pack::Store32(l_record + Pack::EntryFlags, l_entry.flags);
+		Pack::Store32(l_record + Pack::EntryOffset, uint32_t(l_offset));
+		Pack::Store32(l_record + Pack::EntrySize, l_entry.size);
+		Pack::Store32(l_record + Pack::EntryStored, l_stored);
+
+		memcpy(l_header + l_names + l_name, l_entry.name.data(), l_length);
+		l_name += l_length;
+
+		l_offset = m_p->align(l_offset + l_stored);
+	}
+
+	if (sink.write(l_header, l_head.size()) != l_head.size()) {
+		MMERROR("Failed to write asset pack directory.");
+		return(false);
+	}
+
+	const std::vector<char> l_padding(m_p->alignment, 0);
+	for (uint32_t l_i = 0; l_i < l_count; ++l_i) {
+		const std::vector<char> &l_entry = l_sorted[l_i]->data;
+		const size_t l_pad = size_t(m_p->align(l_entry.size()) - l_entry.size());
+
+		if ((!l_entry.empty()
+		    && sink.write(&l_entry[0], l_entry.size()) != l_entry.size())
+		    || (l_pad && sink.write(&l_padding[0], l_pad) != l_pad)) {
+			MMERROR("Failed to write asset pack entry: "
+			    << l_sorted[l_i]->name);
+			return(false);
+		}
+	}
+
+	return(true);
+}
+
+bool
+PackWriter::write(const std::string &p)
+{
+	FileIO l_file(p, DIOWriteOnly);
+	if (!l_file.isOpen()) {
+		MMERROR("Failed to create asset pack: " << p);
+		return(false);
+	}
+
+	return(write(l_file));
+}
+
+} /*********************************************************** Core Namespace */
+MARSHMALLOW_NAMESPACE_END
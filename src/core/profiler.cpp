@@ -0,0 +1,384 @@
+/*
+ * Copyright (c) 2013, Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ * All rights reserved.
+ *
+ * This file is part of Marshmallow Game Engine.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE CONTRIBUTORS ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are
+ * those of the authors and should not be interpreted as representing official
+ * policies, either expressed or implied, of the project as a whole.
+ */
+
+#include "core/profiler.h"
+
+/*!
+ * @file
+ *
+ * @author Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ */
+
+#include "core/fileio.h"
+#include "core/identifier.h"
+#include "core/logger.h"
+#include "core/platform.h"
+
+#include "thread_p.h"
+#include "threadring_p.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+MARSHMALLOW_NAMESPACE_BEGIN
+namespace Core { /******************************************** Core Namespace */
+namespace Profiler { /****************************** Core::Profiler Namespace */
+namespace { /************************** Core::Profiler::<anonymous> Namespace */
+
+	enum {
+		RingSize   = 8192,
+		MaxTrace   = 512 * 1024,
+		OutputSize = 64 * 1024
+	};
+
+	struct Event
+	{
+		const char *name;
+		MMTICK      begin;
+		MMTICK      end;
+	};
+
+	struct TraceEvent
+	{
+		Event    event;
+		uint32_t thread;
+	};
+
+	/* Collect() consumes */
+	struct Ring : public ThreadRing<Event, RingSize>
+	{
+		uint32_t thread;
+		Ring    *next;
+	};
+
+	typedef std::vector<TraceEvent> TraceList;
+	typedef std::vector<ZoneSummary> SummaryList;
+
+	MMTHREADLOCAL Ring *s_ring;
+	ThreadRingList<Ring> s_rings;
+	volatile int32_t s_threads;
+
+	volatile int32_t s_active;
+	Thread::SpinLock s_lock;
+
+	/* consumer side, guarded by s_lock */
+	TraceList     *s_trace;
+	SummaryList   *s_summary;
+	MMTICK         s_frame_begin;
+	MMTICK         s_frame_time;
+	unsigned long  s_truncated;
+
+	Ring *
+	LocalRing(void)
+	{
+		if (s_ring)
+			return(s_ring);
+
+		Ring *l_ring = new Ring;
+		l_ring->thread = static_cast<uint32_t>(MMATOMIC_INCREMENT(s_threads));
+
+		return(s_ring = s_rings.attach(l_ring));
+	}
+
+	bool
+	SummaryLess(const ZoneSummary &lhs, const ZoneSummary &rhs)
+	{
+		return(lhs.total > rhs.total);
+	}
+
+	void
+	Summarize(SummaryList &summary, const Event &event)
+	{
+		SummaryList::iterator l_i;
+		for (l_i = summary.begin(); l_i != summary.end(); ++l_i)
+			if (l_i->name == event.name || 0 == strcmp(l_i->name, event.name))
+				break;
+
+		if (l_i == summary.end()) {
+			ZoneSummary l_zone;
+			l_zone.name = event.name;
+			l_zone.calls = 0;
+			l_zone.total = 0;
+			l_i = summary.insert(summary.end(), l_zone);
+		}
+
+		++l_i->calls;
+		l_i->total += event.end - event.begin;
+	}
+
+	void
+	Trace(const Event &event, uint32_t thread)
+	{
+		if (s_trace->size() >= MaxTrace) {
+			++s_truncated;
+			return;
+		}
+
+		TraceEvent l_trace;
+		l_trace.event = event;
+		l_trace.thread = thread;
+		s_trace->push_back(l_trace);
+	}
+
+	/*
+	 * Move recorded zones out of every ring, must hold s_lock.
+	 */
+	void
+	Collect(SummaryList *summary)
+	{
+		for (Ring *l_ring = s_rings.first; l_ring; l_ring = l_ring->next) {
+			const uint32_t l_head = l_ring->acquire();
+
+			uint32_t l_tail = l_ring->tail;
+			for (; l_tail != l_head; ++l_tail) {
+				const Event &l_event = l_ring->data[l_tail % RingSize];
+				if (summary)
+					Summarize(*summary, l_event);
+				Trace(l_event, l_ring->thread);
+			}
+
+			l_ring->release(l_tail);
+		}
+	}
+
+	/*
+	 * Escape a zone name for a JSON string
+	 */
+	size_t
+	Escape(const char *name, char *out, size_t size)
+	{
+		size_t l_length = 0;
+		for (; *name && l_length + 2 < size; ++name) {
+			const char l_c = *name;
+			if (l_c == '"' || l_c == '\\')
+				out[l_length++] = '\\';
+			out[l_length++] =
+			    (static_cast<unsigned char>(l_c) < ' ' ? ' ' : l_c);
+		}
+		out[l_length] = '\0';
+		return(l_length);
+	}
+
+} /************************************ Core::Profiler::<anonymous> Namespace */
+
+Zone::Zone(const char *n)
+    : m_name(n)
+    , m_begin(0)
+    , m_active(s_active != 0)
+{
+	if (m_active)
+		m_begin = Platform::Ticks();
+}
+
+Zone::~Zone(void)
+{
+	if (!m_active)
+		return;
+
+	const MMTICK l_end = Platform::Ticks();
+
+	Ring &l_ring = *LocalRing();
+	const uint32_t l_head = l_ring.head;
+	if (!l_ring.available()) {
+		++l_ring.dropped;
+		return;
+	}
+
+	Event &l_event = l_ring.data[l_head % RingSize];
+	l_event.name  = m_name;
+	l_event.begin = m_begin;
+	l_event.end   = l_end;
+
+	l_ring.publish(l_head + 1);
+}
+
+void
+Start(void)
+{
+	s_lock.lock();
+
+	if (!s_trace) {
+		s_trace = new TraceList;
+		s_summary = new SummaryList;
+	}
+
+	/* discard anything left in the rings */
+	s_active = 0;
+	MMATOMIC_FENCE();
+	for (Ring *l_ring = s_rings.first; l_ring; l_ring = l_ring->next)
+		l_ring->tail = l_ring->head;
+
+	s_trace->clear();
+	s_summary->clear();
+	s_frame_begin = Platform::Ticks();
+	s_frame_time = 0;
+	s_truncated = 0;
+
+	MMATOMIC_FENCE();
+	s_active = 1;
+
+	s_lock.unlock();
+}
+
+void
+Stop(void)
+{
+	s_active = 0;
+}
+
+bool
+Active(void)
+{
+	return(s_active != 0);
+}
+
+void
+Frame(void)
+{
+	if (!s_active)
+		return;
+
+	const MMTICK l_now = Platform::Ticks();
+
+	s_lock.lock();
+
+	s_summary->clear();
+	Collect(s_summary);
+	std::sort(s_summary->begin(), s_summary->end(), SummaryLess);
+
+	/* frame itself shows up as a zone on the calling thread */
+	Event l_frame;
+	l_frame.name  = "Frame";
+	l_frame.begin = s_frame_begin;
+	l_frame.end   = l_now;
+	Trace(l_frame, LocalRing()->thread);
+
+	s_frame_time = l_now - s_frame_begin;
+	s_frame_begin = l_now;
+
+	s_lock.unlock();
+}
+
+size_t
+LastFrame(const ZoneSummary **zones)
+{
+	if (!s_summary || s_summary->empty()) {
+		*zones = 0;
+		return(0);
+	}
+
+	*zones = &(*s_summary)[0];
+	return(s_summary->size());
+}
+
+MMTICK
+LastFrameTime(void)
+{
+	return(s_frame_time);
+}
+
+unsigned long
+Dropped(void)
+{
+	unsigned long l_dropped = s_truncated;
+	for (Ring *l_ring = s_rings.first; l_ring; l_ring = l_ring->next)
+		l_dropped += l_ring->dropped;
+	return(l_dropped);
+}
+
+bool
+WriteChromeTrace(IDataIO &output)
+{
+	s_lock.lock();
+
+	if (!s_trace)
+		s_trace = new TraceList, s_summary = new SummaryList;
+
+	/* zones recorded after the last frame */
+	Collect(0);
+
+	std::vector<char> l_buffer(OutputSize);
+	size_t l_length = 0;
+	bool l_ok = true;
+
+	l_length += static_cast<size_t>(sprintf(&l_buffer[0],
+	    "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n"));
+
+	const size_t l_count = s_trace->size();
+	for (size_t l_i = 0; l_i < l_count && l_ok; ++l_i) {
+		const TraceEvent &l_trace = (*s_trace)[l_i];
+
+		char l_name[128];
+		Escape(l_trace.event.name, l_name, sizeof(l_name));
+
+		/* timestamps in microseconds */
+		l_length += static_cast<size_t>(sprintf(&l_buffer[l_length],
+		    "{\"name\":\"%s\",\"cat\":\"marshmallow\",\"ph\":\"X\","
+		    "\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}%s\n",
+		    l_name, static_cast<unsigned int>(l_trace.thread),
+		    static_cast<double>(l_trace.event.begin) / 1000.,
+		    static_cast<double>(l_trace.event.end - l_trace.event.begin) / 1000.,
+		    l_i + 1 < l_count ? "," : ""));
+
+		if (l_length > OutputSize - 512) {
+			l_ok = (output.write(&l_buffer[0], l_length) == l_length);
+			l_length = 0;
+		}
+	}
+
+	l_length += static_cast<size_t>(sprintf(&l_buffer[l_length], "]}\n"));
+	l_ok = l_ok && (output.write(&l_buffer[0], l_length) == l_length);
+
+	s_lock.unlock();
+
+	if (!l_ok)
+		MMERROR("Failed to write profiler trace.");
+	return(l_ok);
+}
+
+bool
+WriteChromeTrace(const std::string &p)
+{
+	FileIO l_file(p, DIOWriteOnly);
+	if (!l_file.isOpen()) {
+		MMERROR("Failed to create profiler trace: " << p);
+		return(false);
+	}
+
+	return(WriteChromeTrace(l_file));
+}
+
+} /************************************************* Core::Profiler Namespace */
+} /*********************************************************** Core Namespace */
+MARSHMALLOW_NAMESPACE_END
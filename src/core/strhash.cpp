@@ -38,51 +38,142 @@
  * @author Guillermo A. Amaral B. (gamaral) <g@maral.me>
  */
 
+#include "core/logger.h"
+#include "core/thread_p.h"
+
 #include <cassert>
 #include <cstring>
 
 MARSHMALLOW_NAMESPACE_BEGIN
 namespace Core { /******************************************** Core Namespace */
 
+namespace { /************************************ Core::<anonymous> Namespace */
+
+	Thread::SpinLock s_intern_lock;
+
+} /********************************************** Core::<anonymous> Namespace */
+
 const StrHash StrHash::Null;
 
 struct StrHash::Private
 {
 	std::string str;
+	MMUID uid;
+	Private *next;
 };
 
+const StrHash::Private *
+StrHash::Intern(const char *s, size_t length, MMUID hash)
+{
+	static Private **s_buckets = 0;
+	static size_t s_size = 0;
+	static size_t s_count = 0;
+
+	const Private *l_collision = 0;
+
+	s_intern_lock.lock();
+
+	/* lookup */
+
+	if (s_buckets) {
+		Private *l_record = s_buckets[hash & (s_size - 1)];
+		for (; l_record; l_record = l_record->next) {
+			if (l_record->uid != hash)
+				continue;
+
+			if (l_record->str.length() == length
+			    && 0 == memcmp(l_record->str.data(), s, length)) {
+				s_intern_lock.unlock();
+				return(l_record);
+			}
+			else l_collision = l_record;
+		}
+	}
+
+	/* grow */
+
+	if (s_count >= s_size) {
+		const size_t l_size = s_size ? s_size * 2 : 256;
+		Private **l_buckets = new Private *[l_size];
+		memset(l_buckets, 0, sizeof(Private *) * l_size);
+
+		for (size_t i = 0; i < s_size; ++i)
+			while (s_buckets[i]) {
+				Private *l_record = s_buckets[i];
+				s_buckets[i] = l_record->next;
+
+				Private *&l_bucket = l_buckets[l_record->uid & (l_size - 1)];
+				l_record->next = l_bucket;
+				l_bucket = l_record;
+			}
+
+		delete[] s_buckets;
+		s_buckets = l_buckets;
+		s_size = l_size;
+	}
+
+	/* insert */
+
+	Private *&l_bucket = s_buckets[hash & (s_size - 1)];
+	Private *l_record = new Private;
+	l_record->str.assign(s, length);
+	l_record->uid = hash;
+	l_record->next = l_bucket;
+	l_bucket = l_record;
+	++s_count;
+
+	s_intern_lock.unlock();
+
+	/* different strings, same uid: they will compare equal */
+	if (l_collision)
+		MMWARNING("Hash collision between \"" << l_record->str
+		    << "\" and \"" << l_collision->str << "\"!");
+
+	return(l_record);
+}
+
 StrHash::StrHash(void)
     : Hash()
-    , m_p(new Private)
+    , m_p(0)
 {
+	static const Private *s_empty = Intern("", 0, 0);
+	m_p = s_empty;
 }
 
 StrHash::StrHash(const char *s)
     : Hash()
-    , m_p(new Private)
+    , m_p(0)
 {
-	m_p->str = s;
-	rehash(s, m_p->str.length(), ~static_cast<MMUID>(0));
+	assert(s);
+	const size_t l_length = strlen(s);
+	rehash(s, l_length, ~static_cast<MMUID>(0));
+	m_p = Intern(s, l_length, result());
 }
 
 StrHash::StrHash(const std::string &s)
     : Hash()
-    , m_p(new Private)
+    , m_p(0)
 {
-	m_p->str = s;
-	rehash(m_p->str.c_str(), m_p->str.length(), ~static_cast<MMUID>(0));
+	rehash(s.c_str(), s.length(), ~static_cast<MMUID>(0));
+	m_p = Intern(s.c_str(), s.length(), result());
 }
 
-StrHash::StrHash(const StrHash &c)
-    : Hash(c)
-    , m_p(new Private)
+StrHash::StrHash(const char *s, MMUID h)
+    : Hash()
+    , m_p(0)
 {
-	m_p->str = c.m_p->str;
+	assert(s);
+	const size_t l_length = strlen(s);
+	assert(Algorithm(s, l_length, ~static_cast<MMUID>(0)) == h
+	    && "Precomputed hash mismatch!");
+	rehash(h);
+	m_p = Intern(s, l_length, h);
 }
 
 StrHash::~StrHash(void)
 {
-	delete m_p, m_p = 0;
+	/* interned records are never released */
+	m_p = 0;
 }
 
 const std::string &
@@ -101,16 +192,6 @@ StrHash::operator const char * (void) const
 	return(m_p->str.c_str());
 }
 
-StrHash &
-StrHash::operator=(const StrHash &rhs)
-{
-	if (this != &rhs) {
-		Hash::operator=(rhs);
-		m_p->str = rhs.m_p->str;
-	}
-	return(*this);
-}
-
 } /*********************************************************** Core Namespace */
 MARSHMALLOW_NAMESPACE_END
 
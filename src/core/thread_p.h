@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) 2013, Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ * All rights reserved.
+ *
+ * This file is part of Marshmallow Game Engine.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE CONTRIBUTORS ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are
+ * those of the authors and should not be interpreted as representing official
+ * policies, either expressed or implied, of the project as a whole.
+ */
+
+#pragma once
+
+/*!
+ * @file
+ *
+ * @author Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ */
+
+#ifndef MARSHMALLOW_CORE_THREAD_P_H
+#define MARSHMALLOW_CORE_THREAD_P_H 1
+
+#include "core/environment.h"
+#include "core/global.h"
+#include "core/namespace.h"
+
+MARSHMALLOW_NAMESPACE_BEGIN
+namespace Core { /******************************************** Core Namespace */
+
+/*! @brief Platform thread interface
+ *
+ */
+namespace Thread { /********************************** Core::Thread Namespace */
+
+	typedef void (*Function)(void *context);
+
+	struct Handle;
+
+	/*!
+	 * Spawn a thread running function(context)
+	 *
+	 * @return thread handle, null on failure
+	 */
+	MARSHMALLOW_CORE_EXPORT
+	Handle * Start(Function function, void *context);
+
+	/*!
+	 * Wait for thread to finish and release its handle
+	 */
+	MARSHMALLOW_CORE_EXPORT
+	void Join(Handle *handle);
+
+	/*!
+	 * Give up the rest of the time slice
+	 */
+	MARSHMALLOW_CORE_EXPORT
+	void YieldSlice(void);
+
+	/*!
+	 * Suspend the calling thread, unlike Platform::Sleep() this never
+	 * logs, it's safe to use from the logger.
+	 */
+	MARSHMALLOW_CORE_EXPORT
+	void Sleep(int milliseconds);
+
+	/*!
+	 * @return Number of hardware threads, at least one
+	 */
+	MARSHMALLOW_CORE_EXPORT
+	int Concurrency(void);
+
+	/*!
+	 * @brief Non-recursive mutual exclusion lock
+	 */
+	class MARSHMALLOW_CORE_EXPORT
+	Mutex
+	{
+		struct Private;
+		Private *m_p;
+
+		NO_ASSIGN_COPY(Mutex);
+	public:
+
+		Mutex(void);
+		~Mutex(void);
+
+		void lock(void);
+		bool tryLock(void);
+		void unlock(void);
+	};
+
+	/*!
+	 * @brief Busy-wait lock for short critical sections
+	 *
+	 * Plain data, zero initialized is unlocked, so it's usable during
+	 * static initialization. Contended waiters yield their time slice.
+	 */
+	struct SpinLock
+	{
+		volatile int32_t state;
+
+		inline bool tryLock(void)
+		    { return(MMATOMIC_CAS(state, 0, 1)); }
+
+		inline void lock(void)
+		    { while (!tryLock()) YieldSlice(); }
+
+		inline void unlock(void)
+		    { MMATOMIC_CAS(state, 1, 0); }
+	};
+
+	/*!
+	 * @brief Holds a spin lock for its lifetime
+	 */
+	class ScopedSpinLock
+	{
+		SpinLock &m_lock;
+
+		NO_ASSIGN_COPY(ScopedSpinLock);
+	public:
+
+		explicit ScopedSpinLock(SpinLock &lock_)
+		    : m_lock(lock_) { m_lock.lock(); }
+
+		~ScopedSpinLock(void)
+		    { m_lock.unlock(); }
+	};
+
+	/*!
+	 * @brief Counting semaphore
+	 */
+	class MARSHMALLOW_CORE_EXPORT
+	Semaphore
+	{
+		struct Private;
+		Private *m_p;
+
+		NO_ASSIGN_COPY(Semaphore);
+	public:
+
+		Semaphore(void);
+		~Semaphore(void);
+
+		/*!
+		 * Release count waiters (or future waits)
+		 */
+		void post(int count = 1);
+
+		/*!
+		 * Block until posted
+		 */
+		void wait(void);
+	};
+
+} /*************************************************** Core::Thread Namespace */
+} /*********************************************************** Core Namespace */
+MARSHMALLOW_NAMESPACE_END
+
+#endif
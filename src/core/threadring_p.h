@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2013, Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ * All rights reserved.
+ *
+ * This file is part of Marshmallow Game Engine.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE CONTRIBUTORS ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are
+ * those of the authors and should not be interpreted as representing official
+ * policies, either expressed or implied, of the project as a whole.
+ */
+
+#pragma once
+
+/*!
+ * @file
+ *
+ * @author Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ */
+
+#ifndef MARSHMALLOW_CORE_THREADRING_P_H
+#define MARSHMALLOW_CORE_THREADRING_P_H 1
+
+#include "core/environment.h"
+#include "core/global.h"
+#include "core/namespace.h"
+
+MARSHMALLOW_NAMESPACE_BEGIN
+namespace Core { /******************************************** Core Namespace */
+
+	/*!
+	 * @brief Per-thread single producer, single consumer ring
+	 *
+	 * The owning thread advances head, a single consumer (holding
+	 * whatever lock its owner uses for that) advances tail. Both only
+	 * ever grow, positions are taken modulo Size.
+	 *
+	 * Plain data, users derive to add a next pointer and per-thread
+	 * state, see ThreadRingList.
+	 */
+	template <typename T, uint32_t Size>
+	struct ThreadRing
+	{
+		T                      data[Size];
+		volatile uint32_t      head;
+		volatile uint32_t      tail;
+		volatile unsigned long dropped;
+
+		/* producer side */
+
+		inline uint32_t available(void) const
+		    { return(Size - (head - tail)); }
+
+		/*!
+		 * Make everything written below position visible to the
+		 * consumer.
+		 */
+		inline void publish(uint32_t position)
+		    { MMATOMIC_FENCE(); head = position; }
+
+		/* consumer side */
+
+		/*!
+		 * @return Head, contents below it are safe to read
+		 */
+		inline uint32_t acquire(void) const
+		    { const uint32_t l_head = head; MMATOMIC_FENCE(); return(l_head); }
+
+		/*!
+		 * Hand everything below position back to the producer.
+		 */
+		inline void release(uint32_t position)
+		    { MMATOMIC_FENCE(); tail = position; }
+	};
+
+	/*!
+	 * @brief Lock-free list of thread rings
+	 *
+	 * Rings are pushed once by their owning thread and never removed,
+	 * consumers walk the list from first through next. Zero initialized
+	 * is empty.
+	 */
+	template <typename R>
+	struct ThreadRingList
+	{
+		R * volatile first;
+
+		/*!
+		 * Reset ring positions and link it in, R must be fully set up
+		 * otherwise, consumers may see it right away.
+		 */
+		R * attach(R *ring)
+		{
+			ring->head = ring->tail = 0;
+			ring->dropped = 0;
+
+			do ring->next = first;
+			while (!MMATOMIC_CASPTR(first, ring->next, ring));
+			return(ring);
+		}
+	};
+
+} /*********************************************************** Core Namespace */
+MARSHMALLOW_NAMESPACE_END
+
+#endif
@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2013, Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ * All rights reserved.
+ *
+ * This file is part of Marshmallow Game Engine.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE CONTRIBUTORS ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are
+ * those of the authors and should not be interpreted as representing official
+ * policies, either expressed or implied, of the project as a whole.
+ */
+
+#include "core/typeregistry.h"
+
+/*!
+ * @file
+ *
+ * @author Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ */
+
+#include "core/logger.h"
+#include "core/thread_p.h"
+
+#include <cassert>
+#include <vector>
+
+MARSHMALLOW_NAMESPACE_BEGIN
+namespace Core { /******************************************** Core Namespace */
+namespace { /************************************ Core::<anonymous> Namespace */
+
+	struct Slot
+	{
+		MMUID uid;
+		int   index;
+	};
+	typedef std::vector<Slot> SlotTable;
+	typedef std::vector<Type> TypeTable;
+
+	Thread::SpinLock s_lock;
+
+	/* construct on first use, types register during static init */
+
+	SlotTable &
+	Slots(void)
+	{
+		static SlotTable s_slots;
+		return(s_slots);
+	}
+
+	TypeTable &
+	Types(void)
+	{
+		static TypeTable s_types;
+		return(s_types);
+	}
+
+	/* open addressing, slot table size is a power of two */
+	Slot *
+	Find(SlotTable &slots, MMUID uid)
+	{
+		if (slots.empty())
+			return(0);
+
+		const size_t l_mask = slots.size() - 1;
+		for (size_t l_i = uid & l_mask;; l_i = (l_i + 1) & l_mask) {
+			Slot &l_slot = slots[l_i];
+			if (l_slot.index == TypeRegistry::InvalidIndex
+			    || l_slot.uid == uid)
+				return(&l_slot);
+		}
+	}
+
+	void
+	Grow(SlotTable &slots)
+	{
+		Slot l_empty;
+		l_empty.uid = 0;
+		l_empty.index = TypeRegistry::InvalidIndex;
+
+		SlotTable l_slots(slots.empty() ? 64 : slots.size() * 2, l_empty);
+		for (size_t l_i = 0; l_i < slots.size(); ++l_i)
+			if (slots[l_i].index != TypeRegistry::InvalidIndex)
+				*Find(l_slots, slots[l_i].uid) = slots[l_i];
+		slots.swap(l_slots);
+	}
+
+} /********************************************** Core::<anonymous> Namespace */
+
+namespace TypeRegistry { /********************** Core::TypeRegistry Namespace */
+
+int
+Register(const Type &type)
+{
+	s_lock.lock();
+
+	SlotTable &l_slots = Slots();
+	TypeTable &l_types = Types();
+
+	Slot *l_slot = Find(l_slots, type.uid());
+	if (l_slot && l_slot->index != InvalidIndex) {
+		const int l_index = l_slot->index;
+		const bool l_collision = (l_types[l_index].str() != type.str());
+		s_lock.unlock();
+
+		if (l_collision) {
+			MMERROR("Type hash collision between \"" << type.str()
+			    << "\" and \"" << TypeAt(l_index).str() << "\"!");
+			return(InvalidIndex);
+		}
+		return(l_index);
+	}
+
+	/* keep load factor under one half */
+	if ((l_types.size() + 1) * 2 > l_slots.size()) {
+		Grow(l_slots);
+		l_slot = Find(l_slots, type.uid());
+	}
+
+	l_slot->uid = type.uid();
+	l_slot->index = static_cast<int>(l_types.size());
+	l_types.push_back(type);
+
+	const int l_index = l_slot->index;
+	s_lock.unlock();
+
+	return(l_index);
+}
+
+int
+Index(const Type &type)
+{
+	Thread::ScopedSpinLock l_lock(s_lock);
+	const Slot *l_slot = Find(Slots(), type.uid());
+	return(l_slot ? l_slot->index : InvalidIndex);
+}
+
+Type
+TypeAt(int index)
+{
+	Thread::ScopedSpinLock l_lock(s_lock);
+	const TypeTable &l_types = Types();
+	return((index >= 0 && index < static_cast<int>(l_types.size())) ?
+	    l_types[static_cast<size_t>(index)] : Type::Null);
+}
+
+int
+Count(void)
+{
+	Thread::ScopedSpinLock l_lock(s_lock);
+	return(static_cast<int>(Types().size()));
+}
+
+} /******************************************** Core::TypeRegistry Namespace */
+} /*********************************************************** Core Namespace */
+MARSHMALLOW_NAMESPACE_END
+
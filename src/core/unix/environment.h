@@ -50,6 +50,8 @@
 
 #define MMTIME     int
 #define MMTIME_MAX INT_MAX
+#define MMTICK     int64_t
+#define MMTICK_MAX int64_t(~(uint64_t(1) << 63))
 #define MMUID      uint32_t
 
 /******************************************************************** defines */
@@ -61,6 +63,19 @@
 #define MMSTRCASECMP strcasecmp
 #define MMSTRDUP     strdup
 
+/******************************************************************** atomics */
+
+#define MMATOMIC_INCREMENT(x) __sync_add_and_fetch(&(x), 1)
+#define MMATOMIC_DECREMENT(x) __sync_sub_and_fetch(&(x), 1)
+#define MMATOMIC_ADD(x, v) __sync_add_and_fetch(&(x), v)
+#define MMATOMIC_CAS(x, o, n) __sync_bool_compare_and_swap(&(x), o, n)
+#define MMATOMIC_CASPTR(x, o, n) __sync_bool_compare_and_swap(&(x), o, n)
+#define MMATOMIC_FENCE() __sync_synchronize()
+
+/*************************************************************** thread local */
+
+#define MMTHREADLOCAL __thread
+
 /******************************************************************** unused */
 
 #define MARSHMALLOW_CORE_EXPORT
@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2013, Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ * All rights reserved.
+ *
+ * This file is part of Marshmallow Game Engine.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE CONTRIBUTORS ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are
+ * those of the authors and should not be interpreted as representing official
+ * policies, either expressed or implied, of the project as a whole.
+ */
+
+#include "../mappedfileio_p.h"
+
+/*!
+ * @file
+ *
+ * @author Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ */
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "core/logger.h"
+
+MARSHMALLOW_NAMESPACE_BEGIN
+namespace Core { /******************************************** Core Namespace */
+namespace MappedFile { /************************** Core::MappedFile Namespace */
+
+bool
+Map(const char *path, const void *&data, size_t &size)
+{
+	const int l_fd = ::open(path, O_RDONLY);
+	if (l_fd == -1)
+		return(false);
+
+	struct stat l_stat;
+	if (fstat(l_fd, &l_stat) != 0 || !S_ISREG(l_stat.st_mode)) {
+		::close(l_fd);
+		return(false);
+	}
+
+	data = 0;
+	size = static_cast<size_t>(l_stat.st_size);
+
+	/* zero length mappings are invalid */
+	if (size > 0) {
+		void *l_data = mmap(0, size, PROT_READ, MAP_PRIVATE, l_fd, 0);
+		if (l_data == MAP_FAILED) {
+			MMERROR("mmap failed for " << path);
+			::close(l_fd);
+			return(false);
+		}
+		data = l_data;
+	}
+
+	/* mapping holds its own reference to the file */
+	::close(l_fd);
+
+	return(true);
+}
+
+void
+Unmap(const void *data, size_t size)
+{
+	if (data && size > 0)
+		munmap(const_cast<void *>(data), size);
+}
+
+bool
+Advise(const void *data, size_t offset, size_t length, DIOAdvice advice)
+{
+	int l_advice;
+
+	switch (advice) {
+	case DIOAdviceNormal:     l_advice = POSIX_MADV_NORMAL; break;
+	case DIOAdviceSequential: l_advice = POSIX_MADV_SEQUENTIAL; break;
+	case DIOAdviceRandom:     l_advice = POSIX_MADV_RANDOM; break;
+	case DIOAdviceWillNeed:   l_advice = POSIX_MADV_WILLNEED; break;
+	case DIOAdviceDontNeed:   l_advice = POSIX_MADV_DONTNEED; break;
+	default: return(false);
+	}
+
+	/* ranges must start on a page boundary */
+	static const size_t s_page_size = size_t(sysconf(_SC_PAGESIZE));
+	const size_t l_skew = offset % s_page_size;
+	char *l_start = const_cast<char *>(static_cast<const char *>(data))
+	    + offset - l_skew;
+
+	return(posix_madvise(l_start, length + l_skew, l_advice) == 0);
+}
+
+} /*********************************************** Core::MappedFile Namespace */
+} /*********************************************************** Core Namespace */
+MARSHMALLOW_NAMESPACE_END
+
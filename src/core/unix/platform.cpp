@@ -39,6 +39,7 @@
  */
 
 #include <sys/time.h>
+#include <cerrno>
 #include <cmath>
 #include <cstdio>
 #include <cstring>
@@ -55,7 +56,24 @@ using namespace Core;
 
 namespace
 {
+	inline MMTICK
+	Monotonic(void)
+	{
+#ifdef CLOCK_MONOTONIC
+		struct timespec l_ts;
+		clock_gettime(CLOCK_MONOTONIC, &l_ts);
+		return((static_cast<MMTICK>(l_ts.tv_sec) * Platform::TicksPerSecond)
+		    + l_ts.tv_nsec);
+#else
+		struct timeval l_tv;
+		gettimeofday(&l_tv, 0);
+		return((static_cast<MMTICK>(l_tv.tv_sec) * Platform::TicksPerSecond)
+		    + (static_cast<MMTICK>(l_tv.tv_usec) * 1000));
+#endif
+	}
+
 	static time_t s_start_time = time(0);
+	static MMTICK s_start_ticks = Monotonic();
 } // namespace
 
 /******************************************************************************/
@@ -78,14 +96,20 @@ Platform::Sleep(MMTIME timeout)
 
 	MMVERBOSE("Sleeping for " << timeout << " milliseconds.");
 
+	SleepTicks(TimeToTicks(timeout));
+}
+
+void
+Platform::SleepTicks(MMTICK timeout)
+{
+	if (timeout <= 0) return;
+
 	struct timespec l_ts;
-#define MILLISECONDS_PER_SECOND 1000
-	l_ts.tv_sec = timeout / MILLISECONDS_PER_SECOND;
-#define NANOSECONDS_PER_MILLISECOND 1000000
-	l_ts.tv_nsec = static_cast<long int>
-	    ((timeout % MILLISECONDS_PER_SECOND)
-	        * NANOSECONDS_PER_MILLISECOND);
-	nanosleep(&l_ts, 0);
+	l_ts.tv_sec = static_cast<time_t>(timeout / TicksPerSecond);
+	l_ts.tv_nsec = static_cast<long int>(timeout % TicksPerSecond);
+
+	/* resume after signals */
+	while (nanosleep(&l_ts, &l_ts) == -1 && errno == EINTR);
 }
 
 time_t
@@ -97,10 +121,13 @@ Platform::StartTime(void)
 MMTIME
 Platform::TimeStamp(void)
 {
-	struct timeval time;
-	gettimeofday(&time, 0);
-	MMTIME out = static_cast<MMTIME>(((time.tv_sec - s_start_time) * 1000) + (time.tv_usec / 1000));
-	return(out);
+	return(TicksToTime(Ticks()));
+}
+
+MMTICK
+Platform::Ticks(void)
+{
+	return(Monotonic() - s_start_ticks);
 }
 
 TimeData
@@ -0,0 +1,205 @@
+/*
+ * Copyright (c) 2013, Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ * All rights reserved.
+ *
+ * This file is part of Marshmallow Game Engine.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE CONTRIBUTORS ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are
+ * those of the authors and should not be interpreted as representing official
+ * policies, either expressed or implied, of the project as a whole.
+ */
+
+#include "../thread_p.h"
+
+/*!
+ * @file
+ *
+ * @author Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ */
+
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "core/logger.h"
+
+MARSHMALLOW_NAMESPACE_BEGIN
+namespace Core { /******************************************** Core Namespace */
+namespace Thread { /********************************** Core::Thread Namespace */
+
+struct Handle
+{
+	pthread_t thread;
+	Function  function;
+	void     *context;
+};
+
+namespace { /**************************** Core::Thread::<anonymous> Namespace */
+
+	void *
+	Run(void *h)
+	{
+		Handle *l_handle = static_cast<Handle *>(h);
+		l_handle->function(l_handle->context);
+		return(0);
+	}
+
+} /************************************** Core::Thread::<anonymous> Namespace */
+
+Handle *
+Start(Function f, void *c)
+{
+	Handle *l_handle = new Handle;
+	l_handle->function = f;
+	l_handle->context = c;
+
+	if (pthread_create(&l_handle->thread, 0, Run, l_handle) != 0) {
+		MMERROR("Failed to create thread.");
+		delete l_handle;
+		return(0);
+	}
+
+	return(l_handle);
+}
+
+void
+Join(Handle *h)
+{
+	if (!h)
+		return;
+
+	pthread_join(h->thread, 0);
+	delete h;
+}
+
+void
+YieldSlice(void)
+{
+	sched_yield();
+}
+
+void
+Sleep(int ms)
+{
+	if (ms <= 0) return;
+
+	struct timespec l_ts;
+	l_ts.tv_sec = ms / 1000;
+	l_ts.tv_nsec = static_cast<long>(ms % 1000) * 1000000L;
+	nanosleep(&l_ts, 0);
+}
+
+int
+Concurrency(void)
+{
+	const long l_count = sysconf(_SC_NPROCESSORS_ONLN);
+	return(l_count > 0 ? static_cast<int>(l_count) : 1);
+}
+
+struct Mutex::Private
+{
+	pthread_mutex_t mutex;
+};
+
+Mutex::Mutex(void)
+    : m_p(new Private)
+{
+	pthread_mutex_init(&m_p->mutex, 0);
+}
+
+Mutex::~Mutex(void)
+{
+	pthread_mutex_destroy(&m_p->mutex);
+	delete m_p, m_p = 0;
+}
+
+void
+Mutex::lock(void)
+{
+	pthread_mutex_lock(&m_p->mutex);
+}
+
+bool
+Mutex::tryLock(void)
+{
+	return(pthread_mutex_trylock(&m_p->mutex) == 0);
+}
+
+void
+Mutex::unlock(void)
+{
+	pthread_mutex_unlock(&m_p->mutex);
+}
+
+struct Semaphore::Private
+{
+	pthread_mutex_t mutex;
+	pthread_cond_t  condition;
+	int             count;
+};
+
+Semaphore::Semaphore(void)
+    : m_p(new Private)
+{
+	pthread_mutex_init(&m_p->mutex, 0);
+	pthread_cond_init(&m_p->condition, 0);
+	m_p->count = 0;
+}
+
+Semaphore::~Semaphore(void)
+{
+	pthread_cond_destroy(&m_p->condition);
+	pthread_mutex_destroy(&m_p->mutex);
+	delete m_p, m_p = 0;
+}
+
+void
+Semaphore::post(int c)
+{
+	if (c <= 0) return;
+
+	pthread_mutex_lock(&m_p->mutex);
+	m_p->count += c;
+	if (c == 1)
+		pthread_cond_signal(&m_p->condition);
+	else
+		pthread_cond_broadcast(&m_p->condition);
+	pthread_mutex_unlock(&m_p->mutex);
+}
+
+void
+Semaphore::wait(void)
+{
+	pthread_mutex_lock(&m_p->mutex);
+	while (m_p->count <= 0)
+		pthread_cond_wait(&m_p->condition, &m_p->mutex);
+	--m_p->count;
+	pthread_mutex_unlock(&m_p->mutex);
+}
+
+} /*************************************************** Core::Thread Namespace */
+} /*********************************************************** Core Namespace */
+MARSHMALLOW_NAMESPACE_END
+
@@ -50,6 +50,8 @@
 
 #define MMTIME     int
 #define MMTIME_MAX INT_MAX
+#define MMTICK     int64_t
+#define MMTICK_MAX int64_t(~(uint64_t(1) << 63))
 #define MMUID      uint32_t
 
 /******************************************************************** defines */
@@ -61,6 +63,24 @@
 #define MMSTRCASECMP lstrcmpiA
 #define MMSTRDUP     _strdup
 
+/******************************************************************** atomics */
+
+#define MMATOMIC_INCREMENT(x) \
+    InterlockedIncrement(reinterpret_cast<volatile LONG *>(&(x)))
+#define MMATOMIC_DECREMENT(x) \
+    InterlockedDecrement(reinterpret_cast<volatile LONG *>(&(x)))
+#define MMATOMIC_ADD(x, v) \
+    (InterlockedExchangeAdd(reinterpret_cast<volatile LONG *>(&(x)), v) + (v))
+#define MMATOMIC_CAS(x, o, n) \
+    (InterlockedCompareExchange(reinterpret_cast<volatile LONG *>(&(x)), n, o) == o)
+#define MMATOMIC_CASPTR(x, o, n) \
+    (InterlockedCompareExchangePointer(reinterpret_cast<PVOID volatile *>(&(x)), n, o) == o)
+#define MMATOMIC_FENCE() MemoryBarrier()
+
+/*************************************************************** thread local */
+
+#define MMTHREADLOCAL __declspec(thread)
+
 /******************************************************************** exports */
 
 #ifdef MARSHMALLOW_SHARED
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2013, Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ * All rights reserved.
+ *
+ * This file is part of Marshmallow Game Engine.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE CONTRIBUTORS ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are
+ * those of the authors and should not be interpreted as representing official
+ * policies, either expressed or implied, of the project as a whole.
+ */
+
+#include "../mappedfileio_p.h"
+
+/*!
+ * @file
+ *
+ * @author Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ */
+
+#include <windows.h>
+
+#include "core/logger.h"
+
+MARSHMALLOW_NAMESPACE_BEGIN
+namespace Core { /******************************************** Core Namespace */
+namespace MappedFile { /************************** Core::MappedFile Namespace */
+
+bool
+Map(const char *path, const void *&data, size_t &size)
+{
+	HANDLE l_file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, 0,
+	    OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, 0);
+	if (l_file == INVALID_HANDLE_VALUE)
+		return(false);
+
+	LARGE_INTEGER l_size;
+	if (!GetFileSizeEx(l_file, &l_size)
+	    || static_cast<ULONGLONG>(l_size.QuadPart) > static_cast<size_t>(-1)) {
+		CloseHandle(l_file);
+		return(false);
+	}
+
+	data = 0;
+	size = static_cast<size_t>(l_size.QuadPart);
+
+	/* zero length mappings are invalid */
+	if (size > 0) {
+		HANDLE l_mapping =
+		    CreateFileMappingA(l_file, 0, PAGE_READONLY, 0, 0, 0);
+		if (!l_mapping) {
+			MMERROR("CreateFileMapping failed for " << path);
+			CloseHandle(l_file);
+			return(false);
+		}
+
+		data = MapViewOfFile(l_mapping, FILE_MAP_READ, 0, 0, 0);
+
+		/* view holds its own reference to the mapping */
+		CloseHandle(l_mapping);
+
+		if (!data) {
+			MMERROR("MapViewOfFile failed for " << path);
+			CloseHandle(l_file);
+			return(false);
+		}
+	}
+
+	CloseHandle(l_file);
+
+	return(true);
+}
+
+void
+Unmap(const void *data, size_t)
+{
+	if (data)
+		UnmapViewOfFile(data);
+}
+
+bool
+Advise(const void *, size_t, size_t, DIOAdvice)
+{
+	/*
+	 * The memory manager already reads ahead on sequential faults; there
+	 * is no portable equivalent of madvise() before Windows 8.
+	 */
+	return(true);
+}
+
+} /*********************************************** Core::MappedFile Namespace */
+} /*********************************************************** Core Namespace */
+MARSHMALLOW_NAMESPACE_END
+
@@ -48,7 +48,25 @@ using namespace Core;
 
 namespace
 {
+	inline MMTICK
+	Monotonic(void)
+	{
+		static LARGE_INTEGER s_frequency = { { 0, 0 } };
+		if (!s_frequency.QuadPart)
+			QueryPerformanceFrequency(&s_frequency);
+
+		LARGE_INTEGER l_counter;
+		QueryPerformanceCounter(&l_counter);
+
+		/* split to avoid overflowing counter * TicksPerSecond */
+		const MMTICK l_frequency = s_frequency.QuadPart;
+		return(((l_counter.QuadPart / l_frequency) * Platform::TicksPerSecond)
+		    + (((l_counter.QuadPart % l_frequency) * Platform::TicksPerSecond)
+		        / l_frequency));
+	}
+
 	static time_t s_start_time = time(0);
+	static MMTICK s_start_ticks = Monotonic();
 } // namespace
 
 /******************************************************************************/
@@ -69,6 +87,17 @@ Platform::Sleep(MMTIME t)
 	if (t > 0) SleepEx(static_cast<DWORD>(t), true);
 }
 
+void
+Platform::SleepTicks(MMTICK t)
+{
+	/* the scheduler can't do better than milliseconds */
+	const MMTICK l_deadline = Ticks() + t;
+	if (t >= TicksPerMillisecond)
+		SleepEx(static_cast<DWORD>(t / TicksPerMillisecond), true);
+	while (Ticks() < l_deadline)
+		SwitchToThread();
+}
+
 time_t
 Platform::StartTime(void)
 {
@@ -78,22 +107,13 @@ Platform::StartTime(void)
 MMTIME
 Platform::TimeStamp(void)
 {
-	FILETIME        l_ft;
-	LARGE_INTEGER   l_li;
-	INT64           l_micro_seconds;
-	MMTIME          l_mseconds;
-
-	GetSystemTimeAsFileTime(&l_ft);
-	l_li.LowPart  = l_ft.dwLowDateTime;
-	l_li.HighPart = l_ft.dwHighDateTime;
-#define EPOCHFILEMMTIME (1164447360000000i64)
-	l_micro_seconds = (l_li.QuadPart / 10) - EPOCHFILEMMTIME;
-#define MICROSECONDS_PER_MILLISECOND 1000
-#define MILLISECONDS_PER_SECOND 1000
-	l_mseconds = static_cast<MMTIME>
-	    ((l_micro_seconds / MICROSECONDS_PER_MILLISECOND)
-	         - (s_start_time * MILLISECONDS_PER_SECOND));
-	return(l_mseconds);
+	return(TicksToTime(Ticks()));
+}
+
+MMTICK
+Platform::Ticks(void)
+{
+	return(Monotonic() - s_start_ticks);
 }
 
 TimeData
@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) 2013, Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ * All rights reserved.
+ *
+ * This file is part of Marshmallow Game Engine.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE CONTRIBUTORS ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are
+ * those of the authors and should not be interpreted as representing official
+ * policies, either expressed or implied, of the project as a whole.
+ */
+
+#include "../thread_p.h"
+
+/*!
+ * @file
+ *
+ * @author Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ */
+
+#include <climits>
+
+#include <windows.h>
+
+#include "core/logger.h"
+
+MARSHMALLOW_NAMESPACE_BEGIN
+namespace Core { /******************************************** Core Namespace */
+namespace Thread { /********************************** Core::Thread Namespace */
+
+struct Handle
+{
+	HANDLE    thread;
+	Function  function;
+	void     *context;
+};
+
+namespace { /**************************** Core::Thread::<anonymous> Namespace */
+
+	DWORD WINAPI
+	Run(LPVOID h)
+	{
+		Handle *l_handle = static_cast<Handle *>(h);
+		l_handle->function(l_handle->context);
+		return(0);
+	}
+
+} /************************************** Core::Thread::<anonymous> Namespace */
+
+Handle *
+Start(Function f, void *c)
+{
+	Handle *l_handle = new Handle;
+	l_handle->function = f;
+	l_handle->context = c;
+
+	if (!(l_handle->thread = CreateThread(0, 0, Run, l_handle, 0, 0))) {
+		MMERROR("Failed to create thread.");
+		delete l_handle;
+		return(0);
+	}
+
+	return(l_handle);
+}
+
+void
+Join(Handle *h)
+{
+	if (!h)
+		return;
+
+	WaitForSingleObject(h->thread, INFINITE);
+	CloseHandle(h->thread);
+	delete h;
+}
+
+void
+YieldSlice(void)
+{
+	SwitchToThread();
+}
+
+void
+Sleep(int ms)
+{
+	if (ms <= 0) return;
+	::Sleep(static_cast<DWORD>(ms));
+}
+
+int
+Concurrency(void)
+{
+	SYSTEM_INFO l_info;
+	GetSystemInfo(&l_info);
+	return(l_info.dwNumberOfProcessors > 0
+	    ? static_cast<int>(l_info.dwNumberOfProcessors) : 1);
+}
+
+struct Mutex::Private
+{
+	CRITICAL_SECTION section;
+};
+
+Mutex::Mutex(void)
+    : m_p(new Private)
+{
+	InitializeCriticalSection(&m_p->section);
+}
+
+Mutex::~Mutex(void)
+{
+	DeleteCriticalSection(&m_p->section);
+	delete m_p, m_p = 0;
+}
+
+void
+Mutex::lock(void)
+{
+	EnterCriticalSection(&m_p->section);
+}
+
+bool
+Mutex::tryLock(void)
+{
+	return(TryEnterCriticalSection(&m_p->section) != 0);
+}
+
+void
+Mutex::unlock(void)
+{
+	LeaveCriticalSection(&m_p->section);
+}
+
+struct Semaphore::Private
+{
+	HANDLE semaphore;
+};
+
+Semaphore::Semaphore(void)
+    : m_p(new Private)
+{
+	m_p->semaphore = CreateSemaphore(0, 0, LONG_MAX, 0);
+}
+
+Semaphore::~Semaphore(void)
+{
+	CloseHandle(m_p->semaphore);
+	delete m_p, m_p = 0;
+}
+
+void
+Semaphore::post(int c)
+{
+	if (c <= 0) return;
+	ReleaseSemaphore(m_p->semaphore, c, 0);
+}
+
+void
+Semaphore::wait(void)
+{
+	WaitForSingleObject(m_p->semaphore, INFINITE);
+}
+
+} /*************************************************** Core::Thread Namespace */
+} /*********************************************************** Core Namespace */
+MARSHMALLOW_NAMESPACE_END
+
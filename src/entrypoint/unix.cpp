@@ -37,11 +37,10 @@
  */
 
 #include <cstdio>
+#include <cstdlib>
 #include <cstring>
 #include <signal.h>
-
-#include "core/logger.h"
-#include "core/shared.h"
+#include <unistd.h>
 
 #include "event/eventmanager.h"
 #include "event/quitevent.h"
@@ -50,6 +49,19 @@ extern int MMain(int argc, char *argv[]);
 
 MARSHMALLOW_NAMESPACE_USE
 
+/*
+ * Allocated up front, signal handlers can't allocate or log. Taken by
+ * the first signal that manages to post it.
+ */
+static Event::IEvent * volatile s_quit_event = 0;
+
+static void
+SignalMessage(const char *message)
+{
+	if (write(STDERR_FILENO, message, strlen(message)) < 0)
+		MMNOOP;
+}
+
 static void
 SignalHandler(int signal, siginfo_t *siginfo, void *context)
 {
@@ -57,19 +69,65 @@ SignalHandler(int signal, siginfo_t *siginfo, void *context)
 	MMUNUSED(siginfo);
 	MMUNUSED(context);
 
-	if (!Event::EventManager::Instance()) {
-		MMERROR("\n*** Unix system signal received. But can't queueing quit event message yet... Ignoring. ***\n");
+	Event::EventManager *l_manager = Event::EventManager::Instance();
+	if (!l_manager) {
+		SignalMessage("\n*** Unix system signal received. But can't queueing quit event message yet... Ignoring. ***\n");
 		return;
 	}
 
-	MMDEBUG("\n*** Unix system signal received. Queueing quit event message. ***\n");
-	Event::SharedEvent l_event = new Event::QuitEvent;
-	Event::EventManager::Instance()->queue(l_event);
+	Event::IEvent *l_event = s_quit_event;
+	if (!l_event || !MMATOMIC_CASPTR(s_quit_event, l_event, 0))
+		return;
+
+#if MARSHMALLOW_DEBUG
+	SignalMessage("\n*** Unix system signal received. Queueing quit event message. ***\n");
+#endif
+	if (!l_manager->post(l_event))
+		s_quit_event = l_event;
+}
+
+/*
+ * Engine options are passed on as environment variables and removed
+ * from argv, see EngineBase.
+ *
+ *   --mm-record=<file>  MM_RECORD, record input events
+ *   --mm-replay=<file>  MM_REPLAY, replay recorded events as a benchmark
+ */
+static void
+ParseEngineArguments(int &argc, char *argv[])
+{
+	static const char s_record[] = "--mm-record=";
+	static const char s_replay[] = "--mm-replay=";
+
+	int l_kept = 1;
+	for (int l_i = 1; l_i < argc; ++l_i) {
+		if (0 == strncmp(argv[l_i], s_record, sizeof(s_record) - 1))
+			setenv("MM_RECORD", argv[l_i] + sizeof(s_record) - 1, 1);
+		else if (0 == strncmp(argv[l_i], s_replay, sizeof(s_replay) - 1))
+			setenv("MM_REPLAY", argv[l_i] + sizeof(s_replay) - 1, 1);
+		else
+			argv[l_kept++] = argv[l_i];
+	}
+
+	if (argc > 0) {
+		argv[l_kept] = 0;
+		argc = l_kept;
+	}
 }
 
 int
 main(int argc, char *argv[])
 {
+	ParseEngineArguments(argc, argv);
+
+	/*
+	 * Built long before the signal it answers, a zero timestamp would
+	 * be replaced by NOW_TICKS() right here. Use the earliest explicit
+	 * tick instead, so once posted it's due and sorts ahead of anything
+	 * already queued.
+	 */
+	s_quit_event = new Event::QuitEvent(0, 1);
+
 	/* prep signal action*/
 
 	struct sigaction action;
@@ -82,6 +140,12 @@ main(int argc, char *argv[])
 	sigaction(SIGQUIT, &action, NULL);
 	sigaction(SIGTERM, &action, NULL);
 
-	return(MMain(argc, argv));
+	const int l_result = MMain(argc, argv);
+
+	Event::IEvent *l_event = s_quit_event;
+	if (l_event && MMATOMIC_CASPTR(s_quit_event, l_event, 0))
+		delete l_event;
+
+	return(l_result);
 }
 
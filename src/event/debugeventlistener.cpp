@@ -75,8 +75,9 @@ DebugEventListener::handleEvent(const IEvent &e)
 {
 	if (m_p->filestream.is_open())
 		m_p->filestream
-		    << Core::Platform::TimeStampToTimeData(e.timeStamp()).string
-		    << ": MS " << e.timeStamp()
+		    << Core::Platform::TimeStampToTimeData
+		           (Core::Platform::TicksToTime(e.timeStamp())).string
+		    << ": NS " << e.timeStamp()
 		    << ": Event " << static_cast<const void *>(&e)
 		    << ": Type (" << e.type().uid() << ")" << e.type().str().c_str()
 		    << std::endl;
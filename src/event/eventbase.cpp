@@ -38,27 +38,46 @@
  * @author Guillermo A. Amaral B. (gamaral) <g@maral.me>
  */
 
+#include "core/framearena.h"
+#include "core/objectpool.h"
 #include "core/platform.h"
 
+#include <new>
+
 MARSHMALLOW_NAMESPACE_BEGIN
 namespace Event { /****************************************** Event Namespace */
 
 struct EventBase::Private
 {
-	MMTIME timestamp;
+	MMPOOLED
+
+	MMTICK timestamp;
 	uint8_t priority;
+	bool transient;
 };
 
-EventBase::EventBase(MMTIME t, uint8_t p)
+EventBase::EventBase(MMTICK t, uint8_t p)
     : m_p(new Private)
 {
-	m_p->timestamp = (t == 0) ? NOW() : t;
+	m_p->timestamp = (t == 0) ? NOW_TICKS() : t;
+	m_p->priority = p;
+	m_p->transient = false;
+}
+
+EventBase::EventBase(MMTICK t, uint8_t p, const FrameTransient &)
+    : m_p(new (Core::FrameArena::Allocate(sizeof(Private))) Private)
+{
+	m_p->timestamp = (t == 0) ? NOW_TICKS() : t;
 	m_p->priority = p;
+	m_p->transient = true;
 }
 
 EventBase::~EventBase(void)
 {
-	delete m_p, m_p = 0;
+	if (m_p->transient)
+		m_p->~Private();
+	else delete m_p;
+	m_p = 0;
 }
 
 uint8_t
@@ -67,7 +86,7 @@ EventBase::priority(void) const
 	return(m_p->priority);
 }
 
-MMTIME
+MMTICK
 EventBase::timeStamp(void) const
 {
 	return(m_p->timestamp);
@@ -0,0 +1,228 @@
+/*
+ * Copyright (c) 2013, Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ * All rights reserved.
+ *
+ * This file is part of Marshmallow Game Engine.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE CONTRIBUTORS ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are
+ * those of the authors and should not be interpreted as representing official
+ * policies, either expressed or implied, of the project as a whole.
+ */
+
+#pragma once
+
+/*!
+ * @file
+ *
+ * @author Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ */
+
+#ifndef MARSHMALLOW_EVENT_EVENTLOG_P_H
+#define MARSHMALLOW_EVENT_EVENTLOG_P_H 1
+
+#include "core/environment.h"
+#include "core/namespace.h"
+
+#include <cstring>
+#include <string>
+
+MARSHMALLOW_NAMESPACE_BEGIN
+namespace Event { /****************************************** Event Namespace */
+
+/*! @brief Event log file format
+ *
+ *   header     12 bytes, "MMEV", version and frame rate as little-endian
+ *              uint32_t
+ *   records    until end of file, the last one is an EndTag record
+ *              carrying the final frame of the session
+ *
+ * Each record is
+ *
+ *   varint     frame delta from the previous record
+ *   byte       tag, ORed with DispatchedFlag for dispatched events
+ *   varint     ticks since the previous record
+ *   varint     ticks until the event was due, zero if immediate
+ *   zigzag     IntegerFields(tag) signed varints
+ *   float      FloatFields(tag) little-endian IEEE 754 singles
+ *
+ * Varints are little-endian base 128, seven bits per byte.
+ */
+namespace Log { /*************************************** Event::Log Namespace */
+
+	const char     Magic[4] = { 'M', 'M', 'E', 'V' };
+	const uint32_t Version  = 1;
+
+	const size_t HeaderSize = 12;
+
+	enum Tag
+	{
+		InvalidTag = 0,
+		KeyboardTag,       /* key, action, source */
+		JoystickAxisTag,   /* axis, value, minimum, maximum, source */
+		JoystickButtonTag, /* button, action, state, source */
+		TouchTag,          /* action, x, y, source */
+		SensorTag,         /* sensor, source; x, y, z */
+		QuitTag,           /* code */
+		ViewportTag,       /* reason */
+		EndTag,
+		Tags
+	};
+
+	const uint8_t DispatchedFlag = 0x80;
+	const uint8_t TagMask        = 0x7f;
+
+	const int MaxIntegerFields = 5;
+	const int MaxFloatFields   = 3;
+
+	inline int
+	IntegerFields(int tag)
+	{
+		static const int s_fields[Tags] = { 0, 3, 5, 4, 4, 2, 1, 1, 0 };
+		return(tag > InvalidTag && tag < Tags ? s_fields[tag] : 0);
+	}
+
+	inline int
+	FloatFields(int tag)
+	{
+		return(tag == SensorTag ? 3 : 0);
+	}
+
+	inline uint32_t
+	Load32(const unsigned char *p)
+	{
+		return(uint32_t(p[0])       | uint32_t(p[1]) << 8
+		     | uint32_t(p[2]) << 16 | uint32_t(p[3]) << 24);
+	}
+
+	inline void
+	Store32(unsigned char *p, uint32_t v)
+	{
+		p[0] = static_cast<unsigned char>(v);
+		p[1] = static_cast<unsigned char>(v >> 8);
+		p[2] = static_cast<unsigned char>(v >> 16);
+		p[3] = static_cast<unsigned char>(v >> 24);
+	}
+
+	inline void
+	PutVarint(std::string &out, uint64_t v)
+	{
+		while (v >= 0x80) {
+			out += static_cast<char>((v & 0x7f) | 0x80);
+			v >>= 7;
+		}
+		out += static_cast<char>(v);
+	}
+
+	inline void
+	PutSigned(std::string &out, int64_t v)
+	{
+		PutVarint(out, (static_cast<uint64_t>(v) << 1)
+		    ^ static_cast<uint64_t>(v >> 63));
+	}
+
+	inline void
+	PutFloat(std::string &out, float v)
+	{
+		uint32_t l_bits;
+		memcpy(&l_bits, &v, sizeof(l_bits));
+
+		unsigned char l_bytes[4];
+		Store32(l_bytes, l_bits);
+		out.append(reinterpret_cast<const char *>(l_bytes), 4);
+	}
+
+	/*
+	 * Bounded read cursor, reads past the end return zero and clear ok.
+	 */
+	struct Cursor
+	{
+		const unsigned char *data;
+		const unsigned char *end;
+		bool ok;
+
+		Cursor(const unsigned char *data_, size_t size)
+		    : data(data_), end(data_ + size), ok(true) {}
+
+		bool atEnd(void) const
+		    { return(data >= end); }
+	};
+
+	inline uint64_t
+	GetVarint(Cursor &c)
+	{
+		uint64_t l_value = 0;
+		for (int l_shift = 0; l_shift < 64; l_shift += 7) {
+			if (c.data >= c.end)
+				break;
+
+			const unsigned char l_byte = *c.data++;
+			l_value |= uint64_t(l_byte & 0x7f) << l_shift;
+			if (!(l_byte & 0x80))
+				return(l_value);
+		}
+
+		c.ok = false;
+		return(0);
+	}
+
+	inline int64_t
+	GetSigned(Cursor &c)
+	{
+		const uint64_t l_value = GetVarint(c);
+		return(static_cast<int64_t>(l_value >> 1)
+		    ^ -static_cast<int64_t>(l_value & 1));
+	}
+
+	inline uint8_t
+	GetByte(Cursor &c)
+	{
+		if (c.data >= c.end) {
+			c.ok = false;
+			return(0);
+		}
+		return(*c.data++);
+	}
+
+	inline float
+	GetFloat(Cursor &c)
+	{
+		if (c.end - c.data < 4) {
+			c.ok = false;
+			return(0.f);
+		}
+
+		const uint32_t l_bits = Load32(c.data);
+		c.data += 4;
+
+		float l_value;
+		memcpy(&l_value, &l_bits, sizeof(l_value));
+		return(l_value);
+	}
+
+} /***************************************************** Event::Log Namespace */
+
+} /********************************************************** Event Namespace */
+MARSHMALLOW_NAMESPACE_END
+
+#endif
@@ -39,17 +39,21 @@
  */
 
 #include <algorithm>
-#include <list>
-#include <map>
+#include <vector>
 
 #include "core/identifier.h"
 #include "core/logger.h"
+#include "core/mpscqueue.h"
 #include "core/platform.h"
+#include "core/profiler.h"
 #include "core/shared.h"
+#include "core/typeregistry.h"
 #include "core/weak.h"
 
+#include "event/ibatcheventlistener.h"
 #include "event/ievent.h"
 #include "event/ieventlistener.h"
+#include "event/ieventtap.h"
 
 MARSHMALLOW_NAMESPACE_BEGIN
 namespace { /******************************************** Anonymous Namespace */
@@ -58,16 +62,118 @@ namespace { /******************************************** Anonymous Namespace */
 
 	EventManager *s_instance(0);
 
-	bool
-	SortSharedEvent(const SharedEvent& lhs, const SharedEvent& rhs) {
-		return(lhs->priority() > rhs->priority()
-		   || lhs->timeStamp() < rhs->timeStamp());
-	}
+	/* batch is set for batch listeners, same object as handler */
+	struct Listener
+	{
+		IEventListener      *handler;
+		IBatchEventListener *batch;
+
+		bool operator ==(const IEventListener *rhs) const
+		    { return(handler == rhs); }
+	};
+	typedef std::vector<Listener> EventListenerList;
+
+	/*
+	 * Listeners of one event type, indexed by Core::TypeRegistry index.
+	 * Disconnecting during a dispatch of the same type leaves a null
+	 * entry behind, the table is compacted when the outermost dispatch
+	 * returns.
+	 */
+	struct ListenerTable
+	{
+		EventListenerList listeners;
+		CoalesceFunction coalesce;
+		size_t batches;
+		int  depth;
+		bool dirty;
+
+		ListenerTable(void)
+		    : coalesce(0), batches(0), depth(0), dirty(false) {}
+
+		bool batched(void) const
+		    { return(batches > 0 || coalesce); }
+
+		void compact(void)
+		{
+			listeners.erase(std::remove(listeners.begin(), listeners.end(),
+			    static_cast<IEventListener *>(0)), listeners.end());
+			dirty = false;
+		}
+	};
+	typedef std::vector<ListenerTable> ListenerTableList;
+
+	typedef std::vector<SharedEvent> SharedEventList;
+	typedef std::vector<const IEvent *> EventBatch;
+	typedef std::vector<uint64_t> CoalesceKeyList;
+
+	/* direct mapped type index cache, skips the registry lock */
+	struct TypeCacheEntry
+	{
+		MMUID uid;
+		int   index;
+		bool  valid;
+	};
+	enum { TypeCacheSize = 32 };
+
+	/* events posted from other threads, drained by execute() */
+	typedef Core::MPSCQueue<IEvent *> PostQueue;
+	enum { PostQueueSize = 1024 };
+
+	/*
+	 * Queued events live in slots, handles carry the slot index and the
+	 * slot generation so stale handles are rejected. Cancelled events
+	 * stay in the heaps until popped.
+	 */
+	struct Slot
+	{
+		SharedEvent event;
+		uint32_t    generation;
+		bool        cancelled;
+	};
+	typedef std::vector<Slot> SlotList;
+	typedef std::vector<uint32_t> SlotIndexList;
+
+	struct Entry
+	{
+		MMTICK   timestamp;
+		uint64_t sequence;
+		uint32_t slot;
+		uint8_t  priority;
+	};
+	typedef std::vector<Entry> EntryHeap;
+
+	/* marks due entries already delivered as part of a batch */
+	const uint32_t DeliveredSlot = ~0u;
+
+	/* heap "less" puts the earliest due event on top */
+	struct TimerOrder
+	{
+		bool operator()(const Entry &lhs, const Entry &rhs) const
+		{
+			if (lhs.timestamp != rhs.timestamp)
+				return(lhs.timestamp > rhs.timestamp);
+			return(lhs.sequence > rhs.sequence);
+		}
+	};
+
+	/* highest priority, then earliest, then first queued on top */
+	struct DispatchOrder
+	{
+		bool operator()(const Entry &lhs, const Entry &rhs) const
+		{
+			if (lhs.priority != rhs.priority)
+				return(lhs.priority < rhs.priority);
+			if (lhs.timestamp != rhs.timestamp)
+				return(lhs.timestamp > rhs.timestamp);
+			return(lhs.sequence > rhs.sequence);
+		}
+	};
 
-	typedef std::list<IEventListener *> EventListenerList;
-	typedef Core::Shared<EventListenerList> SharedEventListenerList;
-	typedef std::map<MMUID, SharedEventListenerList> EventListenerMap;
-	typedef std::list<SharedEvent> EventList;
+	inline EventHandle
+	MakeHandle(uint32_t slot, uint32_t generation)
+	{
+		return((static_cast<EventHandle>(generation) << 32) | slot);
+	}
 
 } /****************************************************** Anonymous Namespace */
 
@@ -75,21 +181,246 @@ namespace Event { /****************************************** Event Namespace */
 
 struct EventManager::Private
 {
-	EventListenerMap elmap;
-	EventList queue[2];
+	Private(void)
+	    : posted(PostQueueSize) {}
+
+	PostQueue posted;
+	ListenerTableList tables;
+	TypeCacheEntry type_cache[TypeCacheSize];
+	SlotList slots;
+	SlotIndexList free_slots;
+	EntryHeap incoming;
+	EntryHeap timers;
+	EntryHeap ready;
+	SlotIndexList due;
+	SharedEventList batch_events;
+	EventBatch batch;
+	CoalesceKeyList keys;
+	IEventTap *tap;
+	uint64_t sequence;
+	size_t cancelled;
+	bool delivering;
 	Core::Identifier id;
-	uint8_t active_queue;
-	Core::Type dispatch_type;
-	bool dispatch_invalid;
+
+	inline int index(const Core::Type &type);
+	inline ListenerTable *table(const Core::Type &type);
+	ListenerTable *insert(const Core::Type &type);
+	bool connect(IEventListener *handler, IBatchEventListener *batch,
+	             const Core::Type &type);
+	void gather(size_t first, size_t table, const Core::Type &type);
+	void deliver(size_t table, const Core::Type &type);
+	inline void release(uint32_t slot);
+	inline bool pending(uint32_t slot) const
+	    { return(slots[slot].event && !slots[slot].cancelled); }
+	void cancel(uint32_t slot);
+	void compact(void);
+
+	/* releases cancelled slots as it finds them */
+	struct Cancelled
+	{
+		Private &p;
+		explicit Cancelled(Private &p_) : p(p_) {}
+		bool operator()(const Entry &entry) const
+		{
+			if (!p.slots[entry.slot].cancelled)
+				return(false);
+			p.release(entry.slot);
+			return(true);
+		}
+	};
 };
 
+int
+EventManager::Private::index(const Core::Type &type)
+{
+	TypeCacheEntry &l_entry = type_cache[type.uid() & (TypeCacheSize - 1)];
+	if (!l_entry.valid || l_entry.uid != type.uid()) {
+		l_entry.uid = type.uid();
+		l_entry.index = Core::TypeRegistry::Index(type);
+		l_entry.valid = true;
+	}
+	return(l_entry.index);
+}
+
+ListenerTable *
+EventManager::Private::table(const Core::Type &type)
+{
+	const int l_index = index(type);
+	if (l_index == Core::TypeRegistry::InvalidIndex
+	    || static_cast<size_t>(l_index) >= tables.size())
+		return(0);
+	return(&tables[static_cast<size_t>(l_index)]);
+}
+
+ListenerTable *
+EventManager::Private::insert(const Core::Type &type)
+{
+	const int l_index = Core::TypeRegistry::Register(type);
+	if (l_index == Core::TypeRegistry::InvalidIndex)
+		return(0);
+
+	/* registration may have made a cached miss stale */
+	TypeCacheEntry &l_entry = type_cache[type.uid() & (TypeCacheSize - 1)];
+	l_entry.uid = type.uid();
+	l_entry.index = l_index;
+	l_entry.valid = true;
+
+	if (static_cast<size_t>(l_index) >= tables.size())
+		tables.resize(static_cast<size_t>(l_index) + 1);
+
+	return(&tables[static_cast<size_t>(l_index)]);
+}
+
+bool
+EventManager::Private::connect(IEventListener *handler,
+                               IBatchEventListener *batch_,
+                               const Core::Type &t)
+{
+	MMINFO("Connecting `" << handler << "` handler to event type `" << t.str() << "`.");
+
+	if (!handler) {
+		MMWARNING("Failed! Invalid listener.");
+		return(false);
+	}
+
+	ListenerTable *l_table = insert(t);
+	if (!l_table)
+		return(false);
+
+	EventListenerList &l_listeners = l_table->listeners;
+	if (std::find(l_listeners.begin(), l_listeners.end(), handler)
+	    != l_listeners.end()) {
+		MMWARNING("Failed! Listener already connected to this event type.");
+		return(false);
+	}
+
+	Listener l_listener;
+	l_listener.handler = handler;
+	l_listener.batch = batch_;
+	l_listeners.push_back(l_listener);
+	if (batch_) ++l_table->batches;
+
+	MMINFO("Connected! Current listener count is: " << l_listeners.size() << ".");
+
+	return(true);
+}
+
+/*
+ * Moves due events of table's type, starting at due[first], into the
+ * batch and releases their slots. Coalescing keeps the latest event for
+ * each key, so the batch is filled back to front.
+ */
+void
+EventManager::Private::gather(size_t first, size_t table, const Core::Type &type)
+{
+	const CoalesceFunction l_coalesce = tables[table].coalesce;
+	const MMUID l_type = type.uid();
+
+	batch_events.clear();
+	keys.clear();
+
+	for (size_t l_i = due.size(); l_i-- > first;) {
+		const uint32_t l_slot = due[l_i];
+		if (l_slot == DeliveredSlot || !pending(l_slot)
+		    || slots[l_slot].event->type().uid() != l_type)
+			continue;
+
+		const SharedEvent &l_event = slots[l_slot].event;
+		if (l_coalesce) {
+			const uint64_t l_key = l_coalesce(*l_event);
+			if (std::find(keys.begin(), keys.end(), l_key) == keys.end()) {
+				keys.push_back(l_key);
+				batch_events.push_back(l_event);
+			}
+		}
+		else batch_events.push_back(l_event);
+
+		release(l_slot);
+		due[l_i] = DeliveredSlot;
+	}
+
+	batch.clear();
+	SharedEventList::const_reverse_iterator l_i;
+	for (l_i = batch_events.rbegin(); l_i != batch_events.rend(); ++l_i)
+		batch.push_back(l_i->raw());
+}
+
+/*
+ * Batch listeners get the events not yet handled in one call, plain
+ * listeners one call each, handled events drop out of the batch.
+ */
+void
+EventManager::Private::deliver(size_t table, const Core::Type &type)
+{
+	MMPROFILE_SCOPE("EventManager::deliver");
+
+	const size_t l_count = tables[table].listeners.size();
+	++tables[table].depth;
+
+	for (size_t l_i = 0; !batch.empty() && l_i < l_count; ++l_i) {
+		const Listener l_listener = tables[table].listeners[l_i];
+
+		if (l_listener.batch) {
+			if (l_listener.batch->handleEvents(type, &batch[0], batch.size()))
+				batch.clear();
+		}
+		else if (l_listener.handler) {
+			EventBatch::iterator l_out = batch.begin();
+			EventBatch::const_iterator l_e;
+			for (l_e = batch.begin(); l_e != batch.end(); ++l_e)
+				if (!l_listener.handler->handleEvent(**l_e))
+					*l_out++ = *l_e;
+			batch.erase(l_out, batch.end());
+		}
+	}
+
+	ListenerTable &l_table = tables[table];
+	if (--l_table.depth == 0 && l_table.dirty)
+		l_table.compact();
+
+	batch.clear();
+	batch_events.clear();
+}
+
+void
+EventManager::Private::release(uint32_t slot)
+{
+	Slot &l_slot = slots[slot];
+	if (l_slot.cancelled) --cancelled;
+	l_slot.event.clear();
+	l_slot.cancelled = false;
+	++l_slot.generation;
+	free_slots.push_back(slot);
+}
+
+void
+EventManager::Private::cancel(uint32_t slot)
+{
+	/* slot is recycled once its heap entry pops */
+	slots[slot].cancelled = true;
+	slots[slot].event.clear();
+	++cancelled;
+}
+
+void
+EventManager::Private::compact(void)
+{
+	EntryHeap::iterator l_end =
+	    std::remove_if(timers.begin(), timers.end(), Cancelled(*this));
+	timers.erase(l_end, timers.end());
+	std::make_heap(timers.begin(), timers.end(), TimerOrder());
+}
+
 EventManager::EventManager(const Core::Identifier &i)
     : m_p(new Private)
 {
 	m_p->id = i;
-	m_p->active_queue = 0;
-	m_p->dispatch_type = Core::Type::Null;
-	m_p->dispatch_invalid = true;
+	m_p->tap = 0;
+	m_p->sequence = 0;
+	m_p->cancelled = 0;
+	m_p->delivering = false;
+	for (int l_i = 0; l_i < TypeCacheSize; ++l_i)
+		m_p->type_cache[l_i].valid = false;
 
 	if (!s_instance) s_instance = this;
 }
@@ -97,6 +428,11 @@ EventManager::EventManager(const Core::Identifier &i)
 EventManager::~EventManager(void)
 {
 	if (s_instance == this) s_instance = 0;
+
+	IEvent *l_event;
+	while (m_p->posted.pop(l_event))
+		delete l_event;
+
 	delete m_p, m_p = 0;
 }
 
@@ -109,148 +445,264 @@ EventManager::id(void) const
 bool
 EventManager::connect(IEventListener *handler, const Core::Type &t)
 {
-	MMINFO("Connecting `" << &handler << "` handler to event type `" << t.str() << "`.");
-
-	EventListenerMap::const_iterator l_elmapi =
-	    m_p->elmap.find(t.uid());
+	return(m_p->connect(handler, 0, t));
+}
 
-	/* if this is a new type, assign a new EventListenerList */
-	if (l_elmapi == m_p->elmap.end())
-		m_p->elmap[t.uid()] = new EventListenerList;
+bool
+EventManager::connect(IBatchEventListener *handler, const Core::Type &t)
+{
+	return(m_p->connect(handler, handler, t));
+}
 
-	SharedEventListenerList l_listeners(m_p->elmap[t.uid()]);
+bool
+EventManager::disconnect(IEventListener *handler, const Core::Type &t)
+{
+	MMINFO("Disconnecting `" << handler << "` handler from event type `" << t.str() << "`");
 
-	EventListenerList::const_iterator l_listenersi =
-	    std::find(l_listeners->begin(), l_listeners->end(), handler);
+	ListenerTable *l_table = m_p->table(t);
+	if (!l_table) {
+		MMWARNING("Failed! Event type not in registry.");
+		return(false);
+	}
 
-	if (l_listenersi == l_listeners->end())
-		l_listeners->push_back(handler);
-	else {
-		MMWARNING("Failed! Listener already connected to this event type.");
+	EventListenerList::iterator l_listenersi =
+	    std::find(l_table->listeners.begin(), l_table->listeners.end(), handler);
+	if (!handler || l_listenersi == l_table->listeners.end()) {
+		MMWARNING("Failed! Listener not connected to this event type.");
 		return(false);
 	}
 
-	MMINFO("Connected! Current listener count is: " << l_listeners->size() << ".");
+	if (l_listenersi->batch) --l_table->batches;
+
+	/* keep indices stable for dispatches in progress */
+	if (l_table->depth > 0) {
+		l_listenersi->handler = 0;
+		l_listenersi->batch = 0;
+		l_table->dirty = true;
+	} else l_table->listeners.erase(l_listenersi);
 
-	/* invalidate dispatch if needed */
-	m_p->dispatch_invalid |= (m_p->dispatch_type == t);
+	MMINFO("Disconnected!");
 
 	return(true);
 }
 
 bool
-EventManager::disconnect(IEventListener *handler, const Core::Type &t)
+EventManager::dispatch(const IEvent &event)
 {
-	MMINFO("Disconnecting `" << &handler << "` handler from event type `" << t.str() << "`");
+	MMPROFILE_SCOPE("EventManager::dispatch");
 
-	EventListenerMap::const_iterator l_elmapi =
-	    m_p->elmap.find(t.uid());
+	if (m_p->tap && !m_p->delivering)
+		m_p->tap->tap(event, IEventTap::Dispatched);
 
-	/* if this is a new type, assign a new EventListenerList */
-	if (l_elmapi == m_p->elmap.end()) {
-		MMWARNING("Failed! Event type not in registry.");
+	const int l_index = m_p->index(event.type());
+	if (l_index == Core::TypeRegistry::InvalidIndex
+	    || static_cast<size_t>(l_index) >= m_p->tables.size())
 		return(false);
+
+	const size_t l_table = static_cast<size_t>(l_index);
+	const size_t l_count = m_p->tables[l_table].listeners.size();
+	++m_p->tables[l_table].depth;
+
+	/*
+	 * Listeners may connect or disconnect while we iterate, the table is
+	 * looked up again for every listener since connect() can grow the
+	 * table list.
+	 */
+	bool l_handled = false;
+	for (size_t l_i = 0; !l_handled && l_i < l_count; ++l_i) {
+		IEventListener *l_listener = m_p->tables[l_table].listeners[l_i].handler;
+		if (l_listener)
+			l_handled = l_listener->handleEvent(event);
 	}
 
-	SharedEventListenerList l_listeners(m_p->elmap[t.uid()]);
-	l_listeners->remove(handler);
-	MMINFO("Disconnected! Current listener count is: " << l_listeners->size() << ".");
+	ListenerTable &l_listeners = m_p->tables[l_table];
+	if (--l_listeners.depth == 0 && l_listeners.dirty)
+		l_listeners.compact();
 
-	/* invalidate dispatch if needed */
-	m_p->dispatch_invalid |= (m_p->dispatch_type == t);
+	return(l_handled);
+}
 
-	return(true);
+void
+EventManager::setTap(IEventTap *t)
+{
+	m_p->tap = t;
 }
 
-bool
-EventManager::dispatch(const IEvent &event)
+void
+EventManager::setCoalescing(const Core::Type &t, CoalesceFunction key)
 {
-	bool l_handled = false;
+	ListenerTable *l_table = key ? m_p->insert(t) : m_p->table(t);
+	if (l_table) l_table->coalesce = key;
+}
 
-	EventListenerMap::const_iterator l_elmapi =
-	    m_p->elmap.find(event.type().uid());
-	if (l_elmapi == m_p->elmap.end())
+bool
+EventManager::dequeue(const SharedEvent &event, bool all)
+{
+	if (!event)
 		return(false);
 
-	m_p->dispatch_invalid = false;
-	m_p->dispatch_type = event.type();
+	const MMUID l_type = event->type().uid();
+	bool l_found = false;
 
-	SharedEventListenerList l_listeners(l_elmapi->second);
-	EventListenerList::iterator l_listenersi;
+	for (uint32_t l_i = 0; l_i < m_p->slots.size(); ++l_i) {
+		if (!m_p->pending(l_i))
+			continue;
 
-	for (l_listenersi = l_listeners->begin();
-	     !l_handled && !m_p->dispatch_invalid
-	       && (l_listenersi != l_listeners->end());) {
-		if (*l_listenersi)
-			l_handled = (*l_listenersi++)->handleEvent(event);
-		else
-			l_listeners->erase(l_listenersi++);
+		const SharedEvent &l_event = m_p->slots[l_i].event;
+		if (all ? l_event->type().uid() == l_type : l_event == event) {
+			m_p->cancel(l_i);
+			l_found = true;
+			if (!all) break;
+		}
 	}
 
-	if (m_p->dispatch_invalid && !l_handled)
-		MMERROR("Dispatch listeners changed without current event being handled.");
-
-	m_p->dispatch_type = Core::Type::Null;
-
-	return(l_handled);
+	return(l_found);
 }
 
 bool
-EventManager::dequeue(const SharedEvent &event, bool all)
+EventManager::queue(const SharedEvent &event)
 {
-	EventList &l_queue = m_p->queue[m_p->active_queue == 0 ? 1 : 0];
-
-	if (all) {
-		const MMUID l_type = event->type();
-		EventList::reverse_iterator l_i = l_queue.rbegin();
+	return(queueHandle(event) != 0);
+}
 
-		while (l_i != l_queue.rend()) {
-			if (l_type == (*l_i)->type()) {
-			    EventList::iterator l_tmp = l_queue.erase(--l_i.base());
-			    l_i = EventList::reverse_iterator(l_tmp);
-			}
-			else ++l_i;
-		}
+EventHandle
+EventManager::queueHandle(const SharedEvent &event)
+{
+	if (!event)
+		return(0);
+
+	if (m_p->tap && !m_p->delivering)
+		m_p->tap->tap(*event, IEventTap::Queued);
+
+	uint32_t l_slot;
+	if (m_p->free_slots.empty()) {
+		l_slot = static_cast<uint32_t>(m_p->slots.size());
+		Slot l_new;
+		l_new.generation = 1;
+		l_new.cancelled = false;
+		m_p->slots.push_back(l_new);
 	} else {
-		l_queue.remove(event);
+		l_slot = m_p->free_slots.back();
+		m_p->free_slots.pop_back();
 	}
 
-	return(true);
+	Slot &l_entry_slot = m_p->slots[l_slot];
+	l_entry_slot.event = event;
+
+	Entry l_entry;
+	l_entry.timestamp = event->timeStamp();
+	l_entry.sequence = m_p->sequence++;
+	l_entry.slot = l_slot;
+	l_entry.priority = event->priority();
+
+	/* scheduled on the next execute() */
+	m_p->incoming.push_back(l_entry);
+
+	return(MakeHandle(l_slot, l_entry_slot.generation));
 }
 
 bool
-EventManager::queue(const SharedEvent &event)
+EventManager::post(IEvent *event)
+{
+	/* no logging, may run in a signal handler */
+	if (!event)
+		return(false);
+	return(m_p->posted.push(event));
+}
+
+bool
+EventManager::cancel(EventHandle handle)
 {
-	EventList &l_queue = m_p->queue[m_p->active_queue == 0 ? 1 : 0];
-	l_queue.push_back(event);
+	const uint32_t l_slot = static_cast<uint32_t>(handle & 0xFFFFFFFF);
+	const uint32_t l_generation = static_cast<uint32_t>(handle >> 32);
+
+	if (l_slot >= m_p->slots.size()
+	    || m_p->slots[l_slot].generation != l_generation
+	    || !m_p->pending(l_slot))
+		return(false);
+
+	m_p->cancel(l_slot);
 	return(true);
 }
 
 bool
 EventManager::execute()
 {
-	/* fetch and sort active queue */
-	EventList &l_queue = m_p->queue[m_p->active_queue];
-	l_queue.sort(SortSharedEvent);
-
-	/* dispatch events in active queue
-	 *
-	 * stop only if:
-	 *     we ran out of messages
-	 *     event timestamp is in the future
-	 */
-	SharedEvent event;
-	while (!l_queue.empty()
-	    && (event = l_queue.front())->timeStamp() <= NOW()) {
-		dispatch(*event); l_queue.pop_front();
+	MMPROFILE_SCOPE("EventManager::execute");
+
+	/* take ownership of posted events */
+	IEvent *l_posted;
+	while (m_p->posted.pop(l_posted))
+		queue(SharedEvent(l_posted));
+
+	const MMTICK l_now = NOW_TICKS();
+
+	/* schedule events queued since the last call */
+	EntryHeap::const_iterator l_i;
+	for (l_i = m_p->incoming.begin(); l_i != m_p->incoming.end(); ++l_i) {
+		if (l_i->timestamp <= l_now) {
+			m_p->ready.push_back(*l_i);
+			std::push_heap(m_p->ready.begin(), m_p->ready.end(), DispatchOrder());
+		} else {
+			m_p->timers.push_back(*l_i);
+			std::push_heap(m_p->timers.begin(), m_p->timers.end(), TimerOrder());
+		}
+	}
+	m_p->incoming.clear();
+
+	/* drop cancelled timers once they make up half the heap */
+	if (m_p->cancelled > 64 && m_p->cancelled * 2 > m_p->timers.size())
+		m_p->compact();
+
+	/* promote due timers */
+	while (!m_p->timers.empty() && m_p->timers.front().timestamp <= l_now) {
+		std::pop_heap(m_p->timers.begin(), m_p->timers.end(), TimerOrder());
+		m_p->ready.push_back(m_p->timers.back());
+		m_p->timers.pop_back();
+		std::push_heap(m_p->ready.begin(), m_p->ready.end(), DispatchOrder());
 	}
 
-	if (l_queue.empty()) {
-		/* switch active queues */
-		m_p->active_queue = (m_p->active_queue == 0 ? 1 : 0);
-		return(true);
+	/* due events in dispatch order */
+	m_p->due.clear();
+	while (!m_p->ready.empty()) {
+		std::pop_heap(m_p->ready.begin(), m_p->ready.end(), DispatchOrder());
+		m_p->due.push_back(m_p->ready.back().slot);
+		m_p->ready.pop_back();
 	}
-	return(false);
+
+	/*
+	 * Dispatch due events, the slot is released first so listeners
+	 * can't cancel an event being dispatched (later ones they can).
+	 */
+	m_p->delivering = true;
+	SharedEvent l_event;
+	for (size_t l_d = 0; l_d < m_p->due.size(); ++l_d) {
+		const uint32_t l_slot = m_p->due[l_d];
+		if (l_slot == DeliveredSlot)
+			continue;
+		if (!m_p->pending(l_slot)) {
+			m_p->release(l_slot);
+			continue;
+		}
+
+		const Core::Type l_type = m_p->slots[l_slot].event->type();
+		const int l_index = m_p->index(l_type);
+		if (l_index != Core::TypeRegistry::InvalidIndex
+		    && static_cast<size_t>(l_index) < m_p->tables.size()
+		    && m_p->tables[static_cast<size_t>(l_index)].batched()) {
+			m_p->gather(l_d, static_cast<size_t>(l_index), l_type);
+			m_p->deliver(static_cast<size_t>(l_index), l_type);
+			continue;
+		}
+
+		l_event = m_p->slots[l_slot].event;
+		m_p->release(l_slot);
+		dispatch(*l_event);
+	}
+	m_p->delivering = false;
+
+	/* cancelled timers linger in the heap until compacted */
+	return(m_p->timers.size() == m_p->cancelled);
 }
 
 EventManager *
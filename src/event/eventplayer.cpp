@@ -0,0 +1,282 @@
+/*
+ * Copyright (c) 2013, Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ * All rights reserved.
+ *
+ * This file is part of Marshmallow Game Engine.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE CONTRIBUTORS ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are
+ * those of the authors and should not be interpreted as representing official
+ * policies, either expressed or implied, of the project as a whole.
+ */
+
+#include "event/eventplayer.h"
+
+/*!
+ * @file
+ *
+ * @author Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ */
+
+#include "core/idataio.h"
+#include "core/logger.h"
+#include "core/platform.h"
+#include "core/shared.h"
+
+#include "event/eventmanager.h"
+#include "event/joystickaxisevent.h"
+#include "event/joystickbuttonevent.h"
+#include "event/keyboardevent.h"
+#include "event/quitevent.h"
+#include "event/sensorevent.h"
+#include "event/touchevent.h"
+#include "event/viewportevent.h"
+
+#include "eventlog_p.h"
+
+#include <vector>
+
+MARSHMALLOW_NAMESPACE_BEGIN
+namespace Event { /****************************************** Event Namespace */
+namespace { /*********************************** Event::<anonymous> Namespace */
+
+struct Record
+{
+	uint32_t frame;
+	uint8_t  tag;
+	bool     dispatched;
+	MMTICK   delay;
+	int64_t  integers[Log::MaxIntegerFields];
+	float    floats[Log::MaxFloatFields];
+};
+typedef std::vector<Record> RecordList;
+
+template <typename T>
+inline T
+Int(const Record &r, int field)
+{
+	return(static_cast<T>(r.integers[field]));
+}
+
+SharedEvent
+CreateEvent(const Record &r, MMTICK timestamp)
+{
+	using namespace Input;
+
+	switch (r.tag) {
+	case Log::KeyboardTag:
+		return(Core::MakeShared<KeyboardEvent>
+		    (Int<Keyboard::Key>(r, 0), Int<Keyboard::Action>(r, 1),
+		     static_cast<size_t>(r.integers[2]), timestamp)
+		    .staticCast<IEvent>());
+
+	case Log::JoystickAxisTag:
+		return(Core::MakeShared<JoystickAxisEvent>
+		    (Int<Joystick::Axis>(r, 0), Int<int>(r, 1), Int<int>(r, 2),
+		     Int<int>(r, 3), static_cast<size_t>(r.integers[4]), timestamp)
+		    .staticCast<IEvent>());
+
+	case Log::JoystickButtonTag:
+		return(Core::MakeShared<JoystickButtonEvent>
+		    (Int<Joystick::Button>(r, 0), Int<Joystick::Action>(r, 1),
+		     Int<int>(r, 2), static_cast<size_t>(r.integers[3]), timestamp)
+		    .staticCast<IEvent>());
+
+	case Log::TouchTag:
+		return(Core::MakeShared<TouchEvent>
+		    (Int<Touch::Action>(r, 0), Int<int>(r, 1), Int<int>(r, 2),
+		     static_cast<size_t>(r.integers[3]), timestamp)
+		    .staticCast<IEvent>());
+
+	case Log::SensorTag:
+		return(Core::MakeShared<SensorEvent>
+		    (Int<Sensor::Type>(r, 0), r.floats[0], r.floats[1],
+		     r.floats[2], static_cast<size_t>(r.integers[1]), timestamp)
+		    .staticCast<IEvent>());
+
+	case Log::QuitTag:
+		return(Core::MakeShared<QuitEvent>(Int<int>(r, 0), timestamp)
+		    .staticCast<IEvent>());
+
+	case Log::ViewportTag:
+		return(Core::MakeShared<ViewportEvent>
+		    (Int<ViewportEvent::Reason>(r, 0))
+		    .staticCast<IEvent>());
+	}
+
+	return(SharedEvent());
+}
+
+} /********************************************* Event::<anonymous> Namespace */
+
+struct EventPlayer::Private
+{
+	RecordList records;
+	size_t next;
+	uint32_t frames;
+	int fps;
+	bool valid;
+
+	Private(void)
+	    : next(0)
+	    , frames(0)
+	    , fps(0)
+	    , valid(false) {}
+
+	bool load(const unsigned char *data, size_t size);
+};
+
+bool
+EventPlayer::Private::load(const unsigned char *data, size_t size)
+{
+	if (size < Log::HeaderSize
+	    || 0 != memcmp(data, Log::Magic, sizeof(Log::Magic))) {
+		MMERROR("Not an event log.");
+		return(false);
+	}
+
+	if (Log::Load32(data + 4) != Log::Version) {
+		MMERROR("Unsupported event log version " << Log::Load32(data + 4));
+		return(false);
+	}
+	fps = static_cast<int>(Log::Load32(data + 8));
+
+	Log::Cursor l_cursor(data + Log::HeaderSize, size - Log::HeaderSize);
+	uint32_t l_frame = 0;
+	Record l_record;
+
+	while (!l_cursor.atEnd()) {
+		l_frame += static_cast<uint32_t>(Log::GetVarint(l_cursor));
+		l_record.frame = l_frame;
+
+		const uint8_t l_flags = Log::GetByte(l_cursor);
+		l_record.tag = static_cast<uint8_t>(l_flags & Log::TagMask);
+		l_record.dispatched = (0 != (l_flags & Log::DispatchedFlag));
+
+		Log::GetVarint(l_cursor); /* ticks since previous record */
+		l_record.delay = static_cast<MMTICK>(Log::GetVarint(l_cursor));
+
+		const int l_integers = Log::IntegerFields(l_record.tag);
+		for (int l_i = 0; l_i < l_integers; ++l_i)
+			l_record.integers[l_i] = Log::GetSigned(l_cursor);
+
+		const int l_floats = Log::FloatFields(l_record.tag);
+		for (int l_i = 0; l_i < l_floats; ++l_i)
+			l_record.floats[l_i] = Log::GetFloat(l_cursor);
+
+		if (!l_cursor.ok || l_record.tag == Log::InvalidTag
+		    || l_record.tag >= Log::Tags) {
+			MMERROR("Corrupt event log record " << records.size());
+			return(false);
+		}
+
+		frames = l_frame + 1;
+		if (l_record.tag != Log::EndTag)
+			records.push_back(l_record);
+	}
+
+	return(true);
+}
+
+EventPlayer::EventPlayer(Core::IDataIO &source)
+    : m_p(new Private)
+{
+	std::vector<unsigned char> l_data;
+	unsigned char l_chunk[4096];
+	size_t l_read;
+	while ((l_read = source.read(l_chunk, sizeof(l_chunk))) > 0)
+		l_data.insert(l_data.end(), l_chunk, l_chunk + l_read);
+
+	m_p->valid = !l_data.empty() && m_p->load(&l_data[0], l_data.size());
+	if (!m_p->valid) {
+		m_p->records.clear();
+		m_p->frames = 0;
+	}
+}
+
+EventPlayer::~EventPlayer(void)
+{
+	delete m_p, m_p = 0;
+}
+
+bool
+EventPlayer::isValid(void) const
+{
+	return(m_p->valid);
+}
+
+int
+EventPlayer::fps(void) const
+{
+	return(m_p->fps);
+}
+
+uint32_t
+EventPlayer::frames(void) const
+{
+	return(m_p->frames);
+}
+
+size_t
+EventPlayer::events(void) const
+{
+	return(m_p->records.size());
+}
+
+bool
+EventPlayer::atEnd(void) const
+{
+	return(m_p->next >= m_p->records.size());
+}
+
+size_t
+EventPlayer::play(EventManager &manager, uint32_t frame)
+{
+	const RecordList &l_records = m_p->records;
+	size_t &l_next = m_p->next;
+	const size_t l_first = l_next;
+
+	for (; l_next < l_records.size() && l_records[l_next].frame <= frame;
+	    ++l_next) {
+		const Record &l_record = l_records[l_next];
+		const MMTICK l_timestamp =
+		    l_record.delay > 0 ? NOW_TICKS() + l_record.delay : 0;
+
+		const SharedEvent l_event = CreateEvent(l_record, l_timestamp);
+		if (l_record.dispatched)
+			manager.dispatch(*l_event);
+		else
+			manager.queue(l_event);
+	}
+
+	return(l_next - l_first);
+}
+
+void
+EventPlayer::rewind(void)
+{
+	m_p->next = 0;
+}
+
+} /********************************************************** Event Namespace */
+MARSHMALLOW_NAMESPACE_END
@@ -0,0 +1,258 @@
+/*
+ * Copyright (c) 2013, Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ * All rights reserved.
+ *
+ * This file is part of Marshmallow Game Engine.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE CONTRIBUTORS ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are
+ * those of the authors and should not be interpreted as representing official
+ * policies, either expressed or implied, of the project as a whole.
+ */
+
+#include "event/eventrecorder.h"
+
+/*!
+ * @file
+ *
+ * @author Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ */
+
+#include "core/idataio.h"
+#include "core/logger.h"
+#include "core/platform.h"
+#include "core/type.h"
+
+#include "event/joystickaxisevent.h"
+#include "event/joystickbuttonevent.h"
+#include "event/keyboardevent.h"
+#include "event/quitevent.h"
+#include "event/sensorevent.h"
+#include "event/touchevent.h"
+#include "event/viewportevent.h"
+
+#include "eventlog_p.h"
+
+#include <string>
+
+MARSHMALLOW_NAMESPACE_BEGIN
+namespace Event { /****************************************** Event Namespace */
+
+struct EventRecorder::Private
+{
+	Core::IDataIO &sink;
+	std::string record;
+	MMTICK last_tick;
+	uint32_t frame;
+	uint32_t last_frame;
+	size_t recorded;
+	bool valid;
+
+	Private(Core::IDataIO &sink_)
+	    : sink(sink_)
+	    , last_tick(NOW_TICKS())
+	    , frame(0)
+	    , last_frame(0)
+	    , recorded(0)
+	    , valid(true) {}
+
+	inline int tag(const Core::Type &type) const;
+	bool write(int tag, bool dispatched, MMTICK due,
+	    const int64_t *integers, const float *floats);
+};
+
+int
+EventRecorder::Private::tag(const Core::Type &t) const
+{
+	if (t == KeyboardEvent::Type())
+		return(Log::KeyboardTag);
+	if (t == JoystickAxisEvent::Type())
+		return(Log::JoystickAxisTag);
+	if (t == JoystickButtonEvent::Type())
+		return(Log::JoystickButtonTag);
+	if (t == TouchEvent::Type())
+		return(Log::TouchTag);
+	if (t == SensorEvent::Type())
+		return(Log::SensorTag);
+	if (t == QuitEvent::Type())
+		return(Log::QuitTag);
+	if (t == ViewportEvent::Type())
+		return(Log::ViewportTag);
+	return(Log::InvalidTag);
+}
+
+bool
+EventRecorder::Private::write(int t, bool dispatched, MMTICK due,
+    const int64_t *integers, const float *floats)
+{
+	const MMTICK l_now = NOW_TICKS();
+
+	record.clear();
+	Log::PutVarint(record, frame - last_frame);
+	record += static_cast<char>(t | (dispatched ? Log::DispatchedFlag : 0));
+	Log::PutVarint(record, static_cast<uint64_t>
+	    (l_now > last_tick ? l_now - last_tick : 0));
+	Log::PutVarint(record, static_cast<uint64_t>
+	    (due > l_now ? due - l_now : 0));
+	for (int l_i = 0; l_i < Log::IntegerFields(t); ++l_i)
+		Log::PutSigned(record, integers[l_i]);
+	for (int l_i = 0; l_i < Log::FloatFields(t); ++l_i)
+		Log::PutFloat(record, floats[l_i]);
+
+	if (record.size() != sink.write(record.data(), record.size())) {
+		MMERROR("Failed to write event log record, recording stopped.");
+		valid = false;
+		return(false);
+	}
+
+	last_frame = frame;
+	last_tick = l_now;
+	return(true);
+}
+
+EventRecorder::EventRecorder(Core::IDataIO &s, int fps)
+    : m_p(new Private(s))
+{
+	unsigned char l_header[Log::HeaderSize];
+	memcpy(l_header, Log::Magic, sizeof(Log::Magic));
+	Log::Store32(l_header + 4, Log::Version);
+	Log::Store32(l_header + 8, static_cast<uint32_t>(fps));
+
+	if (Log::HeaderSize != s.write(l_header, Log::HeaderSize)) {
+		MMERROR("Failed to write event log header.");
+		m_p->valid = false;
+	}
+}
+
+EventRecorder::~EventRecorder(void)
+{
+	if (m_p->valid)
+		m_p->write(Log::EndTag, false, 0, 0, 0);
+
+	delete m_p, m_p = 0;
+}
+
+bool
+EventRecorder::isValid(void) const
+{
+	return(m_p->valid);
+}
+
+void
+EventRecorder::setFrame(uint32_t f)
+{
+	if (f < m_p->frame) {
+		MMWARNING("Event log frames can't go backwards.");
+		return;
+	}
+	m_p->frame = f;
+}
+
+uint32_t
+EventRecorder::frame(void) const
+{
+	return(m_p->frame);
+}
+
+size_t
+EventRecorder::recorded(void) const
+{
+	return(m_p->recorded);
+}
+
+void
+EventRecorder::tap(const IEvent &event, Origin origin)
+{
+	if (!m_p->valid)
+		return;
+
+	const int l_tag = m_p->tag(event.type());
+	if (l_tag == Log::InvalidTag)
+		return;
+
+	int64_t l_integers[Log::MaxIntegerFields];
+	float l_floats[Log::MaxFloatFields];
+
+	switch (l_tag) {
+	case Log::KeyboardTag: {
+		const KeyboardEvent &l_event =
+		    static_cast<const KeyboardEvent &>(event);
+		l_integers[0] = l_event.key();
+		l_integers[1] = l_event.action();
+		l_integers[2] = static_cast<int64_t>(l_event.source());
+		} break;
+
+	case Log::JoystickAxisTag: {
+		const JoystickAxisEvent &l_event =
+		    static_cast<const JoystickAxisEvent &>(event);
+		l_integers[0] = l_event.axis();
+		l_integers[1] = l_event.value();
+		l_integers[2] = l_event.minimum();
+		l_integers[3] = l_event.maximum();
+		l_integers[4] = static_cast<int64_t>(l_event.source());
+		} break;
+
+	case Log::JoystickButtonTag: {
+		const JoystickButtonEvent &l_event =
+		    static_cast<const JoystickButtonEvent &>(event);
+		l_integers[0] = l_event.button();
+		l_integers[1] = l_event.action();
+		l_integers[2] = l_event.state();
+		l_integers[3] = static_cast<int64_t>(l_event.source());
+		} break;
+
+	case Log::TouchTag: {
+		const TouchEvent &l_event =
+		    static_cast<const TouchEvent &>(event);
+		l_integers[0] = l_event.action();
+		l_integers[1] = l_event.x();
+		l_integers[2] = l_event.y();
+		l_integers[3] = static_cast<int64_t>(l_event.source());
+		} break;
+
+	case Log::SensorTag: {
+		const SensorEvent &l_event =
+		    static_cast<const SensorEvent &>(event);
+		l_integers[0] = l_event.sensor();
+		l_integers[1] = static_cast<int64_t>(l_event.source());
+		l_floats[0] = l_event.x();
+		l_floats[1] = l_event.y();
+		l_floats[2] = l_event.z();
+		} break;
+
+	case Log::QuitTag:
+		l_integers[0] = static_cast<const QuitEvent &>(event).code();
+		break;
+
+	case Log::ViewportTag:
+		l_integers[0] = static_cast<const ViewportEvent &>(event).reason();
+		break;
+	}
+
+	if (m_p->write(l_tag, origin == Dispatched, event.timeStamp(),
+	    l_integers, l_floats))
+		++m_p->recorded;
+}
+
+} /********************************************************** Event Namespace */
+MARSHMALLOW_NAMESPACE_END
@@ -39,6 +39,7 @@
  */
 
 #include "core/identifier.h"
+#include "core/objectpool.h"
 #include "core/platform.h"
 
 MARSHMALLOW_NAMESPACE_BEGIN
@@ -46,13 +47,15 @@ namespace Event { /****************************************** Event Namespace */
 
 struct InputEvent::Private
 {
+	MMPOOLED
+
 	InputType type;
 	int code;
 	int value;
 	size_t source;
 };
 
-InputEvent::InputEvent(InputType type_, int code_, int value_, size_t source_, MMTIME time_)
+InputEvent::InputEvent(InputType type_, int code_, int value_, size_t source_, MMTICK time_)
     : EventBase(time_, HighPriority)
     , m_p(new Private)
 {
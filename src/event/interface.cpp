@@ -38,8 +38,10 @@
  * @author Guillermo A. Amaral B. (gamaral) <g@maral.me>
  */
 
+#include "event/ibatcheventlistener.h"
 #include "event/ievent.h"
 #include "event/ieventlistener.h"
+#include "event/ieventtap.h"
 
 MARSHMALLOW_NAMESPACE_BEGIN
 namespace Event { /****************************************** Event Namespace */
@@ -48,6 +50,10 @@ namespace Event { /****************************************** Event Namespace */
 
 	IEventListener::~IEventListener(void) {}
 
+	IBatchEventListener::~IBatchEventListener(void) {}
+
+	IEventTap::~IEventTap(void) {}
+
 } /********************************************************** Event Namespace */
 MARSHMALLOW_NAMESPACE_END
 
@@ -39,12 +39,15 @@
  */
 
 #include "core/identifier.h"
+#include "core/objectpool.h"
 
 MARSHMALLOW_NAMESPACE_USE
 using namespace Event;
 
 struct JoystickAxisEvent::Private
 {
+	MMPOOLED
+
 	int minimum;
 	int maximum;
 };
@@ -55,7 +58,7 @@ JoystickAxisEvent::JoystickAxisEvent(
     int minimum_,
     int maximum_,
     size_t source_,
-    MMTIME timestamp_)
+    MMTICK timestamp_)
     : InputEvent(itJoystick, axis_, value_, source_, timestamp_)
     , m_p(new Private)
 {
@@ -87,3 +90,11 @@ JoystickAxisEvent::Type(void)
 	return(s_type);
 }
 
+uint64_t
+JoystickAxisEvent::CoalesceKey(const IEvent &e)
+{
+	const InputEvent &l_event = static_cast<const InputEvent &>(e);
+	return((static_cast<uint64_t>(l_event.source()) << 32)
+	    | static_cast<uint32_t>(l_event.code()));
+}
+
@@ -39,12 +39,15 @@
  */
 
 #include "core/identifier.h"
+#include "core/objectpool.h"
 
 MARSHMALLOW_NAMESPACE_USE
 using namespace Event;
 
 struct JoystickButtonEvent::Private
 {
+	MMPOOLED
+
 	int state;
 };
 
@@ -53,7 +56,7 @@ JoystickButtonEvent::JoystickButtonEvent(
     Input::Joystick::Action action_,
     int state_,
     size_t source_,
-    MMTIME timestamp_)
+    MMTICK timestamp_)
     : InputEvent(itJoystick, button_, action_, source_, timestamp_)
     , m_p(new Private)
 {
@@ -47,7 +47,7 @@ namespace Event { /****************************************** Event Namespace */
 KeyboardEvent::KeyboardEvent(Input::Keyboard::Key key_,
                              Input::Keyboard::Action action_,
                              size_t source_,
-                             MMTIME timestamp_)
+                             MMTICK timestamp_)
     : InputEvent(itKeyboard, key_, action_, source_, timestamp_)
 {
 }
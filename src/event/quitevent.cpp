@@ -39,16 +39,19 @@
  */
 
 #include "core/identifier.h"
+#include "core/objectpool.h"
 
 MARSHMALLOW_NAMESPACE_BEGIN
 namespace Event { /****************************************** Event Namespace */
 
 struct QuitEvent::Private
 {
+	MMPOOLED
+
 	int code;
 };
 
-QuitEvent::QuitEvent(int c, MMTIME t)
+QuitEvent::QuitEvent(int c, MMTICK t)
     : EventBase(t, HighPriority)
     , m_p(new Private)
 {
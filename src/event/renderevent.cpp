@@ -48,6 +48,11 @@ RenderEvent::RenderEvent(void)
 {
 }
 
+RenderEvent::RenderEvent(const FrameTransient &t)
+    : EventBase(0, HighestPriority, t)
+{
+}
+
 RenderEvent::~RenderEvent(void)
 {
 }
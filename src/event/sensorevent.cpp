@@ -39,6 +39,7 @@
  */
 
 #include "core/identifier.h"
+#include "core/objectpool.h"
 #include "core/platform.h"
 #include "core/logger.h"
 
@@ -47,6 +48,8 @@ namespace Event { /****************************************** Event Namespace */
 
 struct SensorEvent::Private
 {
+	MMPOOLED
+
 	float x;
 	float y;
 	float z;
@@ -55,7 +58,7 @@ struct SensorEvent::Private
 SensorEvent::SensorEvent(Input::Sensor::Type type_,
                        float x_, float y_, float z_,
                        size_t source_,
-                       MMTIME timestamp_)
+                       MMTICK timestamp_)
     : InputEvent(itSensor, type_, 0, source_, timestamp_)
     , m_p(new Private)
 {
@@ -94,6 +97,14 @@ SensorEvent::Type(void)
 	return(s_type);
 }
 
+uint64_t
+SensorEvent::CoalesceKey(const IEvent &e)
+{
+	const InputEvent &l_event = static_cast<const InputEvent &>(e);
+	return((static_cast<uint64_t>(l_event.source()) << 32)
+	    | static_cast<uint32_t>(l_event.code()));
+}
+
 } /********************************************************** Event Namespace */
 MARSHMALLOW_NAMESPACE_END
 
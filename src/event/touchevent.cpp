@@ -39,6 +39,7 @@
  */
 
 #include "core/identifier.h"
+#include "core/objectpool.h"
 #include "core/platform.h"
 #include "core/logger.h"
 
@@ -47,6 +48,8 @@ namespace Event { /****************************************** Event Namespace */
 
 struct TouchEvent::Private
 {
+	MMPOOLED
+
 	int x;
 	int y;
 };
@@ -55,7 +58,7 @@ TouchEvent::TouchEvent(Input::Touch::Action action_,
                        int x_,
                        int y_,
                        size_t source_,
-                       MMTIME timestamp_)
+                       MMTICK timestamp_)
     : InputEvent(itTouch, action_, 0, source_, timestamp_)
     , m_p(new Private)
 {
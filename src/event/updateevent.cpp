@@ -38,14 +38,21 @@
  * @author Guillermo A. Amaral B. (gamaral) <g@maral.me>
  */
 
+#include "core/framearena.h"
 #include "core/identifier.h"
+#include "core/objectpool.h"
+
+#include <new>
 
 MARSHMALLOW_NAMESPACE_BEGIN
 namespace Event { /****************************************** Event Namespace */
 
 struct UpdateEvent::Private
 {
+	MMPOOLED
+
 	float delta;
+	bool transient;
 };
 
 UpdateEvent::UpdateEvent(float d)
@@ -53,11 +60,23 @@ UpdateEvent::UpdateEvent(float d)
     , m_p(new Private)
 {
 	m_p->delta = d;
+	m_p->transient = false;
+}
+
+UpdateEvent::UpdateEvent(float d, const FrameTransient &t)
+    : EventBase(0, HighestPriority, t)
+    , m_p(new (Core::FrameArena::Allocate(sizeof(Private))) Private)
+{
+	m_p->delta = d;
+	m_p->transient = true;
 }
 
 UpdateEvent::~UpdateEvent(void)
 {
-	delete m_p, m_p = 0;
+	if (m_p->transient)
+		m_p->~Private();
+	else delete m_p;
+	m_p = 0;
 }
 
 float
@@ -39,12 +39,15 @@
  */
 
 #include "core/identifier.h"
+#include "core/objectpool.h"
 
 MARSHMALLOW_NAMESPACE_BEGIN
 namespace Event { /****************************************** Event Namespace */
 
 struct ViewportEvent::Private
 {
+	MMPOOLED
+
 	Reason reason;
 };
 
@@ -38,13 +38,15 @@
  * @author Guillermo A. Amaral B. (gamaral) <g@maral.me>
  */
 
-#include "core/base64.h"
-#include "core/gzip.h"
+#include "core/base64io.h"
+#include "core/bufferio.h"
 #include "core/identifier.h"
+#include "core/inflateio.h"
 #include "core/logger.h"
+#include "core/mappedfileio.h"
 #include "core/platform.h"
+#include "core/shared.h"
 #include "core/weak.h"
-#include "core/zlib.h"
 
 #include "graphics/backend.h"
 #include "graphics/factory.h"
@@ -134,7 +136,12 @@ TMXLoader::Private::load(const char *f)
 
 	is_loaded = false;
 
-	if (l_tmx.LoadFile(f) != XML_NO_ERROR)
+	/* parse from the page cache, tinyxml2 keeps its own working copy */
+	Core::MappedFileIO l_file(f);
+	const char *l_data;
+	if (!l_file.isOpen()
+	    || !(l_data = static_cast<const char *>(l_file.view(0, l_file.size())))
+	    || l_tmx.Parse(l_data, l_file.size()) != XML_NO_ERROR)
 	    return(false);
 
 	/* get parent directory */
@@ -315,26 +322,27 @@ TMXLoader::Private::processLayer(XMLElement &e)
 
 #define TMXDATA_ENCODING_BASE64 "base64"
 	if (0 == strcmp(l_data_encoding, TMXDATA_ENCODING_BASE64)) {
-		char *l_decoded_data;
-		size_t l_decoded_data_size =
-		    Core::Base64::Decode(l_data_raw, l_data_raw_len, &l_decoded_data);
+		/* decoded straight from the XML text, no intermediate buffer */
+		Core::SharedDataIO l_decoder(new Core::Base64IO(Core::SharedDataIO(
+		    new Core::BufferIO(static_cast<const void *>(l_data_raw),
+		        l_data_raw_len))));
 
 #define TMXDATA_COMPRESSION_ZLIB "zlib"
-		if (0 == strcmp(l_data_compression, TMXDATA_COMPRESSION_ZLIB)) {
-			char *l_inflated_data;
-			if (0 < Core::Zlib::Inflate(l_decoded_data, l_decoded_data_size,
-			    static_cast<size_t>(map_size.width * map_size.height * 4), &l_inflated_data))
-				l_data_array = l_inflated_data;
-		}
 #define TMXDATA_COMPRESSION_GZIP "gzip"
-		else if (0 == strcmp(l_data_compression, TMXDATA_COMPRESSION_GZIP)) {
-			char *l_inflated_data;
-			if (0 < Core::Gzip::Inflate(l_decoded_data, l_decoded_data_size,
-			    static_cast<size_t>(map_size.width * map_size.height * 4), &l_inflated_data))
-				l_data_array = l_inflated_data;
+		if (0 == strcmp(l_data_compression, TMXDATA_COMPRESSION_ZLIB)
+		    || 0 == strcmp(l_data_compression, TMXDATA_COMPRESSION_GZIP)) {
+			const size_t l_data_size =
+			    static_cast<size_t>(map_size.width * map_size.height * 4);
+
+			/* InflateIO detects zlib and gzip headers on its own */
+			Core::InflateIO l_inflate(l_decoder);
+
+			l_data_array = new char[l_data_size];
+			if (l_data_size != l_inflate.read(l_data_array, l_data_size)) {
+				MMWARNING("Layer data is smaller than map size.");
+				delete[] l_data_array, l_data_array = 0;
+			}
 		}
-
-		delete[] l_decoded_data;
 	}
 
 #define TMXDATA_ENCODING_CSV "csv"
@@ -45,6 +45,7 @@
 
 #include "core/identifier.h"
 #include "core/logger.h"
+#include "core/ref.h"
 #include "core/weak.h"
 
 #include "graphics/meshbase.h"
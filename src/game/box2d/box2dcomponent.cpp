@@ -43,6 +43,7 @@
 #include <tinyxml2.h>
 
 #include "core/logger.h"
+#include "core/ref.h"
 #include "core/type.h"
 #include "core/weak.h"
 
@@ -125,17 +126,17 @@ Box2DComponent::update(float d)
 	MMUNUSED(d);
 
 	if (!m_p->position) {
-		m_p->position = entity().getComponentType("Game::PositionComponent").
+		m_p->position = entity().getComponentType(PositionComponent::Type()).
 		    staticCast<PositionComponent>();
 	}
 
 	if (!m_p->render) {
-		m_p->render = entity().getComponentType("Game::RenderComponent").
+		m_p->render = entity().getComponentType(RenderComponent::Type()).
 		    staticCast<RenderComponent>();
 	}
 
 	if (!m_p->init && !m_p->b2layer && m_p->position) {
-		WeakSceneLayer l_layer = entity().layer().scene().getLayerType("Game::Box2DSceneLayer");
+		WeakSceneLayer l_layer = entity().layer().scene().getLayerType(Box2DSceneLayer::Type());
 		m_p->b2layer = l_layer.cast<Box2DSceneLayer>();
 
 		if (!m_p->b2layer) {
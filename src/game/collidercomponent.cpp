@@ -41,6 +41,8 @@
 #include <tinyxml2.h>
 
 #include "core/logger.h"
+#include "core/objectpool.h"
+#include "core/ref.h"
 #include "core/type.h"
 #include "core/weak.h"
 
@@ -61,6 +63,8 @@ namespace Game { /******************************************** Game Namespace */
 
 struct ColliderComponent::Private
 {
+	MMPOOLED
+
 	WeakCollisionSceneLayer layer;
 	WeakMovementComponent   movement;
 	WeakPositionComponent   position;
@@ -178,23 +182,23 @@ void
 ColliderComponent::update(float d)
 {
 	if (!m_p->movement) {
-		m_p->movement = entity().getComponentType("Game::MovementComponent").
+		m_p->movement = entity().getComponentType(MovementComponent::Type()).
 		    staticCast<MovementComponent>();
 	}
 
 	if (!m_p->position) {
-		m_p->position = entity().getComponentType("Game::PositionComponent").
+		m_p->position = entity().getComponentType(PositionComponent::Type()).
 		    staticCast<PositionComponent>();
 	}
 
 	if (!m_p->size) {
-		m_p->size = entity().getComponentType("Game::SizeComponent").
+		m_p->size = entity().getComponentType(SizeComponent::Type()).
 		    staticCast<SizeComponent>();
 	}
 
 	if (!m_p->init && !m_p->layer && m_p->position && m_p->size) {
 		m_p->layer = entity().layer().scene()
-		    .getLayerType("Game::CollisionSceneLayer").staticCast<CollisionSceneLayer>();
+		    .getLayerType(CollisionSceneLayer::Type()).staticCast<CollisionSceneLayer>();
 		if (!m_p->layer) {
 			MMWARNING("Collider component used with no collision scene layer!");
 			return;
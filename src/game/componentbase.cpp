@@ -41,12 +41,15 @@
 #include <tinyxml2.h>
 
 #include "core/identifier.h"
+#include "core/objectpool.h"
 
 MARSHMALLOW_NAMESPACE_BEGIN
 namespace Game { /******************************************** Game Namespace */
 
 struct ComponentBase::Private
 {
+	MMPOOLED
+
 	Private(const Core::Identifier &i, IEntity &e)
 	    : id(i)
 	    , entity(e) {}
@@ -40,12 +40,19 @@
 
 #include <tinyxml2.h>
 
+#include "core/fileio.h"
+#include "core/framearena.h"
 #include "core/identifier.h"
+#include "core/jobsystem.h"
 #include "core/logger.h"
+#include "core/memory.h"
 #include "core/platform.h"
+#include "core/profiler.h"
 #include "core/shared.h"
 
 #include "event/eventmanager.h"
+#include "event/eventplayer.h"
+#include "event/eventrecorder.h"
 #include "event/quitevent.h"
 #include "event/renderevent.h"
 #include "event/updateevent.h"
@@ -103,26 +110,107 @@ struct EngineBase::Private
 	Event::SharedEventManager  event_manager;
 	Game::SharedSceneManager   scene_manager;
 	Game::SharedFactory        factory;
-	MMTIME delta_time;
+	Game::SharedFramePacer     frame_pacer;
+	Game::FrameStats           frame_stats;
+	Core::FileIO              *event_log;
+	Event::EventRecorder      *recorder;
+	Event::EventPlayer        *player;
+#if MARSHMALLOW_PROFILE
+	std::string profile_trace;
+#endif
+	MMTICK delta_time;
+	uint32_t frame;
 	int    exit_code;
 	int    fps;
 	int    frame_rate;
+	int    memory_interval;
+	int    memory_elapsed;
 	int    sleep;
 	bool   running;
 	bool   suspended;
 	bool   valid;
 
 	Private(int fps_, int sleep_)
-	    : delta_time(0)
+	    : frame_stats(fps_ > 0 ? static_cast<size_t>(fps_) * 5 : 300)
+	    , event_log(0)
+	    , recorder(0)
+	    , player(0)
+	    , delta_time(0)
+	    , frame(0)
 	    , exit_code(0)
 	    , fps(fps_)
 	    , frame_rate(0)
+	    , memory_interval(0)
+	    , memory_elapsed(0)
 	    , sleep(sleep_)
 	    , running(false)
 	    , suspended(false)
 	    , valid(false) {}
+
+	bool setupEventLog(Event::EventManager &manager);
+	void releaseEventLog(Event::EventManager *manager);
 };
 
+bool
+EngineBase::Private::setupEventLog(Event::EventManager &manager)
+{
+	using namespace Core;
+
+	/* MM_REPLAY=<events.log> replays a recorded session at a fixed step */
+	const char *l_replay = getenv("MM_REPLAY");
+	if (l_replay && *l_replay) {
+		FileIO l_file(l_replay, DIOReadOnly);
+		if (!l_file.isOpen()) {
+			MMERROR("Failed to open event log: " << l_replay);
+			return(false);
+		}
+
+		player = new Event::EventPlayer(l_file);
+		if (!player->isValid()) {
+			MMERROR("Invalid event log: " << l_replay);
+			return(false);
+		}
+
+		if (player->fps() != fps)
+			MMWARNING("Event log was recorded at " << player->fps()
+			    << " fps, replaying at " << fps << " fps.");
+
+		MMINFO("Replaying " << player->events() << " events over "
+		    << player->frames() << " frames from " << l_replay);
+		return(true);
+	}
+
+	/* MM_RECORD=<events.log> records input for MM_REPLAY */
+	const char *l_record = getenv("MM_RECORD");
+	if (l_record && *l_record) {
+		event_log = new FileIO(l_record, DIOTruncate);
+		if (!event_log->isOpen()) {
+			MMERROR("Failed to create event log: " << l_record);
+			return(false);
+		}
+
+		recorder = new Event::EventRecorder(*event_log, fps);
+		manager.setTap(recorder);
+		MMINFO("Recording events to " << l_record);
+	}
+
+	return(true);
+}
+
+void
+EngineBase::Private::releaseEventLog(Event::EventManager *manager)
+{
+	if (manager)
+		manager->setTap(0);
+
+	/* last frame that ran */
+	if (recorder && frame > 0)
+		recorder->setFrame(frame - 1);
+	delete recorder, recorder = 0;
+	delete event_log, event_log = 0;
+	delete player, player = 0;
+}
+
 EngineBase::EngineBase(int fps_, int sleep)
     : m_p(new Private(fps_, sleep))
 {
@@ -154,21 +242,39 @@ EngineBase::initialize(void)
 	 */
 
 	Platform::Initialize();
+	JobSystem::Initialize();
+
+	{
+		MMMEMORY_SCOPE(EventMemory);
+		if (!m_p->event_manager)
+			m_p->event_manager = new Event::EventManager("EngineBase.EventManager");
+		eventManager()->connect(this, Event::QuitEvent::Type());
+	}
 
-	if (!m_p->event_manager)
-		m_p->event_manager = new Event::EventManager("EngineBase.EventManager");
-	eventManager()->connect(this, Event::QuitEvent::Type());
+	{
+		MMMEMORY_SCOPE(AudioMemory);
+		Audio::Backend::Initialize();
+	}
 
-	Audio::Backend::Initialize();
-	Graphics::Backend::Initialize();
-	Input::Joystick::Initialize();
-	Input::Keyboard::Initialize();
+	{
+		MMMEMORY_SCOPE(GraphicsMemory);
+		Graphics::Backend::Initialize();
+	}
+
+	{
+		MMMEMORY_SCOPE(InputMemory);
+		Input::Joystick::Initialize();
+		Input::Keyboard::Initialize();
+	}
 
-	if (!m_p->scene_manager)
-		m_p->scene_manager = new SceneManager();
+	{
+		MMMEMORY_SCOPE(GameMemory);
+		if (!m_p->scene_manager)
+			m_p->scene_manager = new SceneManager();
 
-	if (!m_p->factory)
-		m_p->factory = new Factory();
+		if (!m_p->factory)
+			m_p->factory = new Factory();
+	}
 
 	/*
 	 * Environment Overrides
@@ -177,13 +283,34 @@ EngineBase::initialize(void)
 	Graphics::Display l_display = Graphics::Backend::Display();
 	GetBackendOverrides(l_display);
 
+	/* MM_MEMORY=<seconds> dumps memory usage periodically */
+	const char *l_memory = getenv("MM_MEMORY");
+	if (l_memory && *l_memory)
+		m_p->memory_interval = atoi(l_memory);
+
 	/*
 	 * Setup
 	 */
-	if (!Graphics::Backend::Setup(l_display)) {
-		MMERROR("Failed to initialize engine!");
+	{
+		MMMEMORY_SCOPE(GraphicsMemory);
+		if (!Graphics::Backend::Setup(l_display)) {
+			MMERROR("Failed to initialize engine!");
+			return(false);
+		}
+	}
+
+	/* after setup, the backend announces its viewport again on replay */
+	if (!m_p->setupEventLog(*eventManager()))
 		return(false);
+
+#if MARSHMALLOW_PROFILE
+	/* MM_PROFILE=<trace.json> records a trace until finalize */
+	const char *l_profile = getenv("MM_PROFILE");
+	if (l_profile && *l_profile) {
+		m_p->profile_trace = l_profile;
+		Profiler::Start();
 	}
+#endif
 
 	/* validate */
 	m_p->valid = true;
@@ -201,6 +328,24 @@ EngineBase::finalize(void)
 	if (isValid())
 		eventManager()->disconnect(this, Event::QuitEvent::Type());
 
+	/* MM_FRAMESTATS=<report.txt> */
+	const char *l_stats = getenv("MM_FRAMESTATS");
+	if (l_stats && *l_stats && m_p->frame_stats.frames())
+		m_p->frame_stats.write(l_stats);
+
+	if (m_p->memory_interval > 0)
+		Memory::Dump();
+
+	m_p->releaseEventLog(m_p->event_manager.raw());
+
+#if MARSHMALLOW_PROFILE
+	if (!m_p->profile_trace.empty()) {
+		Profiler::Stop();
+		Profiler::WriteChromeTrace(m_p->profile_trace);
+		m_p->profile_trace.clear();
+	}
+#endif
+
 	m_p->factory.clear();
 	m_p->scene_manager.clear();
 
@@ -211,6 +356,8 @@ EngineBase::finalize(void)
 
 	m_p->event_manager.clear();
 
+	JobSystem::Finalize();
+	FrameArena::Release();
 	Platform::Finalize();
 
 	/* invalidate */
@@ -248,6 +395,12 @@ EngineBase::setFactory(const SharedFactory &f)
 	m_p->factory = f;
 }
 
+void
+EngineBase::setFramePacer(const SharedFramePacer &p)
+{
+	m_p->frame_pacer = p;
+}
+
 int
 EngineBase::fps(void) const
 {
@@ -256,6 +409,12 @@ EngineBase::fps(void) const
 
 MMTIME
 EngineBase::deltaTime(void) const
+{
+	return(Core::Platform::TicksToTime(m_p->delta_time));
+}
+
+MMTICK
+EngineBase::deltaTicks(void) const
 {
 	return(m_p->delta_time);
 }
@@ -266,6 +425,18 @@ EngineBase::frameRate(void)
 	return(m_p->frame_rate);
 }
 
+SharedFramePacer
+EngineBase::framePacer(void) const
+{
+	return(m_p->frame_pacer);
+}
+
+const FrameStats &
+EngineBase::frameStats(void) const
+{
+	return(m_p->frame_stats);
+}
+
 int
 EngineBase::run(void)
 {
@@ -277,96 +448,137 @@ EngineBase::run(void)
 		return(-1);
 	}
 
-#define MILLISECONDS_PER_SECOND 1000
-	const MMTIME l_tick_target = MILLISECONDS_PER_SECOND / m_p->fps;
-	const MMTIME l_tick_fast_target = (l_tick_target * 2) / 3;
-	MMTIME l_second = 0;
-	MMTIME l_tock = 0;
-	MMTIME l_tick;
+	const MMTICK l_tick_target = Platform::TicksPerSecond / m_p->fps;
+	MMTICK l_second = 0;
+	MMTICK l_tick;
+	MMTICK l_ticked;
+	MMTICK l_updated;
+	MMTICK l_rendered;
+
+	if (!m_p->frame_pacer)
+		m_p->frame_pacer = new FramePacer(m_p->sleep);
+	IFramePacer &l_pacer = *m_p->frame_pacer;
+
+	/* replay runs unpaced, every frame steps by exactly one tick target */
+	Event::EventPlayer *l_player = m_p->player;
+	MMTICK l_frame;
+	MMTICK l_work = 0;
 
 	/* start */
-	bool l_wait  = false;
 	m_p->valid   = true;
 	m_p->running = true;
 
 	tick(.0f);
 	update(.0f);
-	l_tick = NOW() - l_tick_target;
+	l_pacer.reset(l_tick_target, Graphics::Backend::Display().vsync);
+	m_p->frame_stats.reset(l_tick_target);
+	m_p->frame = 0;
+	if (l_player)
+		m_p->delta_time = l_tick_target;
+	const MMTICK l_started = NOW_TICKS();
 
 	/*
 	 * Game Loop
 	 */
 	while (m_p->running) {
-		l_tick = NOW();
+		l_tick = NOW_TICKS();
+
+		/*
+		 * Event Log
+		 */
+		if (m_p->recorder)
+			m_p->recorder->setFrame(m_p->frame);
+		else if (l_player) {
+			if (m_p->frame >= l_player->frames()) {
+				stop(0);
+				break;
+			}
+			l_player->play(*m_p->event_manager, m_p->frame);
+		}
 
 #if MARSHMALLOW_DEBUG
 		/* detect breakpoint */
-		if (m_p->delta_time > MILLISECONDS_PER_SECOND) {
+		if (m_p->delta_time > Platform::TicksPerSecond) {
 			MMWARNING("Abnormally long time between ticks, debugger breakpoint?");
 			m_p->delta_time = l_tick_target;
 		}
 #endif
 
-		/* update dt counters */
-		l_tock   += m_p->delta_time;
-		l_second += m_p->delta_time;
-
-		/* wait if no vsync or cpu/gpu too fast */
-		l_wait |= (m_p->delta_time <= l_tick_fast_target);
-
 		/*
 		 * Second
 		 */
-		if (l_second >= MILLISECONDS_PER_SECOND) {
+		l_second += m_p->delta_time;
+		if (l_second >= Platform::TicksPerSecond) {
 			second();
 
-			l_wait = (m_p->delta_time <= (l_tick_fast_target));
 			m_p->frame_rate = 0;
 
-			/* reset second */
-			l_second = 0;
+			/* reset second, keeping the overshoot */
+			l_second -= Platform::TicksPerSecond;
+			if (l_second >= Platform::TicksPerSecond)
+				l_second = 0;
 		}
 
 		/*
-		 * Tock
+		 * Tick
 		 */
-		if (l_tock >= l_tick_target || !l_wait) {
-			/*
-			 * Update
-			 */
-			update(static_cast<float>(l_tick_target) / MILLISECONDS_PER_SECOND);
-
-			/*
-			 * Render
-			 */
-			render();
-			m_p->frame_rate++;
-
-			/* reset tock */
-			l_tock= 0;
-		}
+		tick(Platform::TicksToSeconds(m_p->delta_time));
+		l_ticked = NOW_TICKS();
 
 		/*
-		 * Sleep
-		 *
-		 * Higher suspend interval values might cause minor choppiness
-		 * but it might be worth it for sub 20% CPU usage (very battery
-		 * friendly).
+		 * Update
 		 */
-		if (l_wait) Platform::Sleep(m_p->sleep);
+		update(Platform::TicksToSeconds(l_tick_target));
+		l_updated = NOW_TICKS();
 
 		/*
-		 * Tick
+		 * Render
+		 */
+		render();
+		l_rendered = NOW_TICKS();
+		l_work += l_rendered - l_tick;
+		m_p->frame_rate++;
+
+		/*
+		 * Wait
+		 *
+		 * Higher sleep presets might cause minor choppiness but it
+		 * might be worth it for sub 20% CPU usage (very battery
+		 * friendly).
 		 */
-		tick(static_cast<float>(m_p->delta_time) / MILLISECONDS_PER_SECOND);
+		if (!l_player)
+			l_pacer.wait();
 
-		m_p->delta_time = NOW() - l_tick;
+		MMPROFILE_FRAME();
+
+		l_frame = NOW_TICKS() - l_tick;
+		m_p->delta_time = l_player ? l_tick_target : l_frame;
+		++m_p->frame;
+
+		m_p->frame_stats.record(l_ticked - l_tick,
+		                        l_updated - l_ticked,
+		                        l_rendered - l_updated,
+		                        l_frame);
+
+		/* recycle frame transient allocations */
+		FrameArena::Swap();
+		MMMEMORY_FRAME();
 	}
 
 	/*
 	 * Exit
 	 */
 
+	if (l_player) {
+		const FrameStats &l_stats = m_p->frame_stats;
+		MMLOG("INFO", "Replay frames=" << m_p->frame
+		    << " time=" << (NOW_TICKS() - l_started) << "ns"
+		    << " work mean=" << (m_p->frame ? l_work / m_p->frame : 0)
+		    << "ns p50=" << l_stats.percentile(FrameStats::Work, 50.)
+		    << "ns p99=" << l_stats.percentile(FrameStats::Work, 99.)
+		    << "ns max=" << l_stats.maximum(FrameStats::Work) << "ns");
+	}
+
 	finalize();
 	return(m_p->exit_code);
 }
@@ -414,13 +626,28 @@ EngineBase::factory(void) const
 void
 EngineBase::tick(float delta)
 {
+	MMPROFILE_SCOPE("EngineBase::tick");
+
 	using namespace Input;
 
-	Audio::Backend::Tick(delta);
-	Graphics::Backend::Tick(delta);
-	Keyboard::Tick(delta);
-	Joystick::Tick(delta);
+	{
+		MMMEMORY_SCOPE(AudioMemory);
+		Audio::Backend::Tick(delta);
+	}
 
+	{
+		MMMEMORY_SCOPE(GraphicsMemory);
+		Graphics::Backend::Tick(delta);
+	}
+
+	/* replayed input comes from the event log */
+	if (!m_p->player) {
+		MMMEMORY_SCOPE(InputMemory);
+		Keyboard::Tick(delta);
+		Joystick::Tick(delta);
+	}
+
+	MMMEMORY_SCOPE(EventMemory);
 	if (m_p->event_manager) m_p->event_manager->execute();
 	else MMWARNING("No event manager!");
 }
@@ -429,31 +656,84 @@ void
 EngineBase::second(void)
 {
 	MMDEBUG("FPS=" << m_p->frame_rate);
+
+	if (m_p->frame_pacer)
+		MMDEBUG("Frame interval=" << m_p->frame_pacer->interval()
+		    << "ns jitter=" << m_p->frame_pacer->jitter() << "ns");
+
+	/* rolling frame statistics */
+	const FrameStats &l_stats = m_p->frame_stats;
+	MMDEBUG("Work p50=" << l_stats.percentile(FrameStats::Work, 50.)
+	    << "ns p95=" << l_stats.percentile(FrameStats::Work, 95.)
+	    << "ns p99=" << l_stats.percentile(FrameStats::Work, 99.)
+	    << "ns max=" << l_stats.maximum(FrameStats::Work)
+	    << "ns over budget=" << l_stats.overBudget(FrameStats::Work)
+	    << " hitches=" << l_stats.overBudget(FrameStats::Frame));
+
+#if MARSHMALLOW_DEBUG
+	/* reference operations per frame (averaged over the last second) */
+	if (m_p->frame_rate > 0)
+		MMDEBUG("Shared operations per frame="
+		    << Core::SharedData::Operations / static_cast<uint32_t>(m_p->frame_rate));
+	Core::SharedData::Operations = 0;
+#endif
+
+#if MARSHMALLOW_PROFILE
+	/* zones of the last frame, longest first */
+	const Core::Profiler::ZoneSummary *l_zones;
+	const size_t l_count = Core::Profiler::LastFrame(&l_zones);
+	if (l_count)
+		MMDEBUG("Frame time=" << Core::Profiler::LastFrameTime() << "ns");
+	for (size_t l_i = 0; l_i < l_count; ++l_i)
+		MMDEBUG("  " << l_zones[l_i].name << ": " << l_zones[l_i].total
+		    << "ns (" << l_zones[l_i].calls << " calls)");
+#endif
+
+	if (m_p->memory_interval > 0
+	    && ++m_p->memory_elapsed >= m_p->memory_interval) {
+		Core::Memory::Dump();
+		m_p->memory_elapsed = 0;
+	}
 }
 
 void
 EngineBase::render(void)
 {
+	MMPROFILE_SCOPE("EngineBase::render");
+
 	using namespace Event;
 
 	if (!Graphics::Backend::Active() || m_p->suspended)
 		return;
 
-	Graphics::Painter::Render();
+	{
+		MMMEMORY_SCOPE(GraphicsMemory);
+		Graphics::Painter::Render();
+	}
 
-	RenderEvent event;
-	eventManager()->dispatch(event);
+	{
+		MMMEMORY_SCOPE(GameMemory);
+		RenderEvent event((EventBase::FrameTransient()));
+		eventManager()->dispatch(event);
+	}
 
+	MMMEMORY_SCOPE(GraphicsMemory);
 	Graphics::Backend::Finish();
+
+	if (m_p->frame_pacer)
+		m_p->frame_pacer->presented();
 }
 
 void
 EngineBase::update(float d)
 {
+	MMPROFILE_SCOPE("EngineBase::update");
+
 	if (!Graphics::Backend::Active() || m_p->suspended)
 		return;
 
-	Event::UpdateEvent event(d);
+	MMMEMORY_SCOPE(GameMemory);
+	Event::UpdateEvent event(d, Event::EventBase::FrameTransient());
 	eventManager()->dispatch(event);
 }
 
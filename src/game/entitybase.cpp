@@ -40,8 +40,13 @@
 
 #include "core/identifier.h"
 #include "core/logger.h"
+#include "core/objectpool.h"
+#include "core/ref.h"
 #include "core/shared.h"
+#include "core/weak.h"
 
+#include "game/entityscenelayer.h"
+#include "game/entitystore.h"
 #include "game/factorybase.h"
 #include "game/icomponent.h"
 
@@ -56,12 +61,16 @@ typedef std::list<SharedComponent> ComponentList;
 
 struct EntityBase::Private
 {
+	MMPOOLED
+
 	Private(const Core::Identifier &i, EntitySceneLayer &l)
 	    : id(i)
 	    , layer(l)
 	    , killed(false) {}
 
 	ComponentList components;
+	WeakEntityStore store;
+	EntityHandle handle;
 	Core::Identifier id;
 	EntitySceneLayer &layer;
 	bool killed;
@@ -76,9 +85,23 @@ EntityBase::~EntityBase(void)
 {
 	m_p->components.clear();
 
+	/* layer (and store) may already be gone */
+	if (m_p->store)
+		m_p->store->destroy(m_p->handle);
+
 	delete m_p, m_p = 0;
 }
 
+const EntityHandle &
+EntityBase::handle(void)
+{
+	if (m_p->handle.isNull()) {
+		m_p->store = m_p->layer.store();
+		m_p->handle = m_p->store->create();
+	}
+	return(m_p->handle);
+}
+
 const Core::Identifier &
 EntityBase::id(void) const
 {
@@ -124,6 +147,18 @@ EntityBase::removeComponent(const SharedComponent &c)
 
 SharedComponent
 EntityBase::getComponent(const Core::Identifier &i) const
+{
+	return(borrowComponent(i));
+}
+
+SharedComponent
+EntityBase::getComponentType(const Core::Type &t) const
+{
+	return(borrowComponentType(t));
+}
+
+RefComponent
+EntityBase::borrowComponent(const Core::Identifier &i) const
 {
 	ComponentList::const_iterator l_i;
 	ComponentList::const_iterator l_c = m_p->components.end();
@@ -132,11 +167,11 @@ EntityBase::getComponent(const Core::Identifier &i) const
 		if ((*l_i)->id() == i)
 			return(*l_i);
 	}
-	return(SharedComponent());
+	return(RefComponent());
 }
 
-SharedComponent
-EntityBase::getComponentType(const Core::Type &t) const
+RefComponent
+EntityBase::borrowComponentType(const Core::Type &t) const
 {
 	ComponentList::const_iterator l_i;
 	ComponentList::const_iterator l_c = m_p->components.end();
@@ -145,7 +180,7 @@ EntityBase::getComponentType(const Core::Type &t) const
 		if ((*l_i)->type() == t)
 			return(*l_i);
 	}
-	return(SharedComponent());
+	return(RefComponent());
 }
 
 void
@@ -40,10 +40,13 @@
 
 #include "core/identifier.h"
 #include "core/logger.h"
+#include "core/ref.h"
 #include "core/shared.h"
+#include "core/weak.h"
 
 #include "graphics/camera.h"
 
+#include "game/entitystore.h"
 #include "game/factorybase.h"
 #include "game/ientity.h"
 #include "game/positioncomponent.h"
@@ -57,6 +60,7 @@ namespace Game { /******************************************** Game Namespace */
 struct EntitySceneLayer::Private
 {
 	EntityList entities;
+	SharedEntityStore store;
 	bool visiblility_testing;
 };
 
@@ -64,6 +68,7 @@ EntitySceneLayer::EntitySceneLayer(const Core::Identifier &i, IScene &s, int f)
     : SceneLayerBase(i, s, f)
     , m_p(new Private)
 {
+	m_p->store = new EntityStore;
 	m_p->visiblility_testing = true;
 }
 
@@ -122,6 +127,12 @@ EntitySceneLayer::getEntities(void) const
 	return(m_p->entities);
 }
 
+const SharedEntityStore &
+EntitySceneLayer::store(void) const
+{
+	return(m_p->store);
+}
+
 bool
 EntitySceneLayer::visiblityTesting(void) const
 {
@@ -144,22 +155,22 @@ EntitySceneLayer::render(void)
 		const float l_visiblility_radius2 = Graphics::Camera::VisibleMagnitude2();
 
 		for (l_i = m_p->entities.begin(); l_i != m_p->entities.end();l_i++) {
-			SharedEntity l_entity = (*l_i);
+			const SharedEntity &l_entity = (*l_i);
 			float l_size2 = 0;
 
 			if (l_entity->isZombie())
 				continue;
 
-			SharedPositionComponent l_positionComponent =
-			    l_entity->getComponentType("Game::PositionComponent")
+			RefPositionComponent l_positionComponent =
+			    l_entity->borrowComponentType(PositionComponent::Type())
 			        .staticCast<Game::PositionComponent>();
 			if (!l_positionComponent) {
 				l_entity->render();
 				continue;
 			}
 
-			SharedSizeComponent l_sizeComponent =
-			    l_entity->getComponentType("Game::SizeComponent")
+			RefSizeComponent l_sizeComponent =
+			    l_entity->borrowComponentType(SizeComponent::Type())
 			        .staticCast<Game::SizeComponent>();
 			if (l_sizeComponent) {
 				const Math::Size2f &l_size =
@@ -182,6 +193,8 @@ EntitySceneLayer::render(void)
 void
 EntitySceneLayer::update(float d)
 {
+	m_p->store->update(d);
+
 	EntityList::const_iterator l_i;
 
 	for (l_i = m_p->entities.begin(); l_i != m_p->entities.end();) {
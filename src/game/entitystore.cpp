@@ -0,0 +1,505 @@
+/*
+ * Copyright (c) 2013, Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ * All rights reserved.
+ *
+ * This file is part of Marshmallow Game Engine.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE CONTRIBUTORS ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are
+ * those of the authors and should not be interpreted as representing official
+ * policies, either expressed or implied, of the project as a whole.
+ */
+
+#include "game/entitystore.h"
+
+/*!
+ * @file
+ *
+ * @author Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ */
+
+#include <algorithm>
+#include <vector>
+
+MARSHMALLOW_NAMESPACE_BEGIN
+namespace Game { /******************************************** Game Namespace */
+namespace { /************************************ Game::<anonymous> Namespace */
+
+const uint32_t NoSlot = ~uint32_t(0);
+
+struct Record
+{
+	uint32_t generation;
+	uint32_t slot[EntityStore::Components];
+	bool alive;
+};
+typedef std::vector<Record> RecordList;
+typedef std::vector<uint32_t> IndexList;
+
+} /********************************************** Game::<anonymous> Namespace */
+
+struct EntityStore::Private
+{
+	RecordList records;
+	IndexList free_records;
+	size_t alive;
+
+	IndexList owners[Components];
+
+	std::vector<Math::Point2> positions;
+
+	std::vector<Math::Vector2> velocities;
+	std::vector<Math::Vector2> accelerations;
+	std::vector<Math::Pair> limits_x;
+	std::vector<Math::Pair> limits_y;
+
+	std::vector<Math::Size2f> sizes;
+
+	/*
+	 * Entities with both position and movement occupy the first
+	 * *paired* slots of both pools, in the same order.
+	 */
+	uint32_t paired;
+
+	Private(void)
+	    : alive(0)
+	    , paired(0) {}
+
+	inline Record * record(const EntityHandle &handle);
+	inline const Record * record(const EntityHandle &handle) const;
+	inline uint32_t slot(const EntityHandle &handle, Component component) const;
+
+	void push(uint32_t owner, Component component);
+	void remove(uint32_t index, Component component);
+	void exchange(Component component, uint32_t a, uint32_t b);
+};
+
+Record *
+EntityStore::Private::record(const EntityHandle &h)
+{
+	if (h.index >= records.size())
+		return(0);
+
+	Record &l_record = records[h.index];
+	return(l_record.alive && l_record.generation == h.generation ? &l_record : 0);
+}
+
+const Record *
+EntityStore::Private::record(const EntityHandle &h) const
+{
+	return(const_cast<Private *>(this)->record(h));
+}
+
+uint32_t
+EntityStore::Private::slot(const EntityHandle &h, Component c) const
+{
+	const Record *l_record = record(h);
+	return(l_record ? l_record->slot[c] : NoSlot);
+}
+
+void
+EntityStore::Private::exchange(Component c, uint32_t a, uint32_t b)
+{
+	if (a == b)
+		return;
+
+	std::swap(owners[c][a], owners[c][b]);
+	records[owners[c][a]].slot[c] = a;
+	records[owners[c][b]].slot[c] = b;
+
+	switch (c) {
+	case Position:
+		std::swap(positions[a], positions[b]);
+		break;
+
+	case Movement:
+		std::swap(velocities[a], velocities[b]);
+		std::swap(accelerations[a], accelerations[b]);
+		std::swap(limits_x[a], limits_x[b]);
+		std::swap(limits_y[a], limits_y[b]);
+		break;
+
+	case Size:
+		std::swap(sizes[a], sizes[b]);
+		break;
+
+	case Components: break;
+	}
+}
+
+void
+EntityStore::Private::push(uint32_t owner, Component c)
+{
+	records[owner].slot[c] = static_cast<uint32_t>(owners[c].size());
+	owners[c].push_back(owner);
+
+	switch (c) {
+	case Position:
+		positions.push_back(Math::Point2());
+		break;
+
+	case Movement:
+		velocities.push_back(Math::Vector2());
+		accelerations.push_back(Math::Vector2());
+		limits_x.push_back(Math::Pair(-1.f, -1.f));
+		limits_y.push_back(Math::Pair(-1.f, -1.f));
+		break;
+
+	case Size:
+		sizes.push_back(Math::Size2f());
+		break;
+
+	case Components: break;
+	}
+
+	if (c == Size)
+		return;
+
+	/* completes a pair, move both to the end of the paired range */
+	const Component l_other = (c == Position ? Movement : Position);
+	Record &l_record = records[owner];
+	if (l_record.slot[l_other] != NoSlot) {
+		exchange(c, l_record.slot[c], paired);
+		exchange(l_other, l_record.slot[l_other], paired);
+		++paired;
+	}
+}
+
+void
+EntityStore::Private::remove(uint32_t index, Component c)
+{
+	/* breaks a pair, move both to the end of the paired range first */
+	if (c != Size && records[index].slot[c] < paired) {
+		const uint32_t l_last = --paired;
+		exchange(Position, records[index].slot[Position], l_last);
+		exchange(Movement, records[index].slot[Movement], l_last);
+	}
+
+	const uint32_t l_slot = records[index].slot[c];
+	const uint32_t l_last = static_cast<uint32_t>(owners[c].size() - 1);
+	records[index].slot[c] = NoSlot;
+
+	/* swap last element in */
+	if (l_slot != l_last) {
+		const uint32_t l_owner = owners[c][l_last];
+		owners[c][l_slot] = l_owner;
+		records[l_owner].slot[c] = l_slot;
+
+		switch (c) {
+		case Position:
+			positions[l_slot] = positions[l_last];
+			break;
+
+		case Movement:
+			velocities[l_slot] = velocities[l_last];
+			accelerations[l_slot] = accelerations[l_last];
+			limits_x[l_slot] = limits_x[l_last];
+			limits_y[l_slot] = limits_y[l_last];
+			break;
+
+		case Size:
+			sizes[l_slot] = sizes[l_last];
+			break;
+
+		case Components: break;
+		}
+	}
+	owners[c].pop_back();
+
+	switch (c) {
+	case Position:
+		positions.pop_back();
+		break;
+
+	case Movement:
+		velocities.pop_back();
+		accelerations.pop_back();
+		limits_x.pop_back();
+		limits_y.pop_back();
+		break;
+
+	case Size:
+		sizes.pop_back();
+		break;
+
+	case Components: break;
+	}
+}
+
+EntityStore::EntityStore(void)
+    : m_p(new Private)
+{
+}
+
+EntityStore::~EntityStore(void)
+{
+	delete m_p, m_p = 0;
+}
+
+void
+EntityStore::reserve(size_t c)
+{
+	m_p->records.reserve(c);
+	for (int l_c = 0; l_c < Components; ++l_c)
+		m_p->owners[l_c].reserve(c);
+
+	m_p->positions.reserve(c);
+	m_p->velocities.reserve(c);
+	m_p->accelerations.reserve(c);
+	m_p->limits_x.reserve(c);
+	m_p->limits_y.reserve(c);
+	m_p->sizes.reserve(c);
+}
+
+EntityHandle
+EntityStore::create(int c)
+{
+	uint32_t l_index;
+	if (m_p->free_records.empty()) {
+		l_index = static_cast<uint32_t>(m_p->records.size());
+
+		Record l_record;
+		l_record.generation = 1;
+		m_p->records.push_back(l_record);
+	} else {
+		l_index = m_p->free_records.back();
+		m_p->free_records.pop_back();
+	}
+
+	Record &l_record = m_p->records[l_index];
+	l_record.alive = true;
+	for (int l_c = 0; l_c < Components; ++l_c)
+		l_record.slot[l_c] = NoSlot;
+	++m_p->alive;
+
+	const EntityHandle l_handle(l_index, l_record.generation);
+	for (int l_c = 0; l_c < Components; ++l_c)
+		if (c & (1 << l_c))
+			m_p->push(l_index, static_cast<Component>(l_c));
+
+	return(l_handle);
+}
+
+void
+EntityStore::destroy(const EntityHandle &h)
+{
+	Record *l_record = m_p->record(h);
+	if (!l_record)
+		return;
+
+	for (int l_c = 0; l_c < Components; ++l_c)
+		if (l_record->slot[l_c] != NoSlot)
+			m_p->remove(h.index, static_cast<Component>(l_c));
+
+	/* stale outstanding handles, zero is reserved for null */
+	l_record->alive = false;
+	if (++l_record->generation == 0)
+		l_record->generation = 1;
+
+	m_p->free_records.push_back(h.index);
+	--m_p->alive;
+}
+
+bool
+EntityStore::isAlive(const EntityHandle &h) const
+{
+	return(m_p->record(h) != 0);
+}
+
+size_t
+EntityStore::size(void) const
+{
+	return(m_p->alive);
+}
+
+bool
+EntityStore::attach(const EntityHandle &h, Component c)
+{
+	Record *l_record = m_p->record(h);
+	if (!l_record)
+		return(false);
+
+	if (l_record->slot[c] == NoSlot)
+		m_p->push(h.index, c);
+	return(true);
+}
+
+void
+EntityStore::detach(const EntityHandle &h, Component c)
+{
+	Record *l_record = m_p->record(h);
+	if (l_record && l_record->slot[c] != NoSlot)
+		m_p->remove(h.index, c);
+}
+
+int
+EntityStore::components(const EntityHandle &h) const
+{
+	const Record *l_record = m_p->record(h);
+	if (!l_record)
+		return(0);
+
+	int l_mask = 0;
+	for (int l_c = 0; l_c < Components; ++l_c)
+		if (l_record->slot[l_c] != NoSlot)
+			l_mask |= (1 << l_c);
+	return(l_mask);
+}
+
+Math::Point2 *
+EntityStore::position(const EntityHandle &h)
+{
+	const uint32_t l_slot = m_p->slot(h, Position);
+	return(l_slot != NoSlot ? &m_p->positions[l_slot] : 0);
+}
+
+Math::Vector2 *
+EntityStore::velocity(const EntityHandle &h)
+{
+	const uint32_t l_slot = m_p->slot(h, Movement);
+	return(l_slot != NoSlot ? &m_p->velocities[l_slot] : 0);
+}
+
+Math::Vector2 *
+EntityStore::acceleration(const EntityHandle &h)
+{
+	const uint32_t l_slot = m_p->slot(h, Movement);
+	return(l_slot != NoSlot ? &m_p->accelerations[l_slot] : 0);
+}
+
+Math::Pair *
+EntityStore::limitX(const EntityHandle &h)
+{
+	const uint32_t l_slot = m_p->slot(h, Movement);
+	return(l_slot != NoSlot ? &m_p->limits_x[l_slot] : 0);
+}
+
+Math::Pair *
+EntityStore::limitY(const EntityHandle &h)
+{
+	const uint32_t l_slot = m_p->slot(h, Movement);
+	return(l_slot != NoSlot ? &m_p->limits_y[l_slot] : 0);
+}
+
+Math::Size2f *
+EntityStore::size(const EntityHandle &h)
+{
+	const uint32_t l_slot = m_p->slot(h, Size);
+	return(l_slot != NoSlot ? &m_p->sizes[l_slot] : 0);
+}
+
+size_t
+EntityStore::count(Component c) const
+{
+	return(m_p->owners[c].size());
+}
+
+size_t
+EntityStore::paired(void) const
+{
+	return(m_p->paired);
+}
+
+EntityHandle
+EntityStore::owner(Component c, size_t i) const
+{
+	const uint32_t l_index = m_p->owners[c][i];
+	return(EntityHandle(l_index, m_p->records[l_index].generation));
+}
+
+Math::Point2 *
+EntityStore::positions(void)
+{
+	return(m_p->positions.empty() ? 0 : &m_p->positions[0]);
+}
+
+Math::Vector2 *
+EntityStore::velocities(void)
+{
+	return(m_p->velocities.empty() ? 0 : &m_p->velocities[0]);
+}
+
+Math::Vector2 *
+EntityStore::accelerations(void)
+{
+	return(m_p->accelerations.empty() ? 0 : &m_p->accelerations[0]);
+}
+
+Math::Pair *
+EntityStore::limitsX(void)
+{
+	return(m_p->limits_x.empty() ? 0 : &m_p->limits_x[0]);
+}
+
+Math::Pair *
+EntityStore::limitsY(void)
+{
+	return(m_p->limits_y.empty() ? 0 : &m_p->limits_y[0]);
+}
+
+Math::Size2f *
+EntityStore::sizes(void)
+{
+	return(m_p->sizes.empty() ? 0 : &m_p->sizes[0]);
+}
+
+void
+EntityStore::update(float d)
+{
+	const size_t l_count = m_p->owners[Movement].size();
+	if (!l_count)
+		return;
+
+	const size_t l_paired = m_p->paired;
+	const Math::Vector2 *l_accelerations = &m_p->accelerations[0];
+	const Math::Pair *l_limits_x = &m_p->limits_x[0];
+	const Math::Pair *l_limits_y = &m_p->limits_y[0];
+	Math::Vector2 *l_velocities = &m_p->velocities[0];
+	Math::Point2 *l_positions = m_p->positions.empty() ? 0 : &m_p->positions[0];
+
+	/* same integration as MovementComponent::update() */
+	for (size_t l_i = 0; l_i < l_count; ++l_i) {
+		const Math::Pair &l_limit_x = l_limits_x[l_i];
+		const Math::Pair &l_limit_y = l_limits_y[l_i];
+		Math::Vector2 &l_velocity = l_velocities[l_i];
+
+		l_velocity += l_accelerations[l_i] * d;
+
+		if (l_limit_x.first()  > -1 && l_velocity.x < -l_limit_x.first())
+			l_velocity.x = -l_limit_x.first();
+		if (l_limit_x.second() > -1 && l_velocity.x >  l_limit_x.second())
+			l_velocity.x =  l_limit_x.second();
+
+		if (l_limit_y.first()  > -1 && l_velocity.y < -l_limit_y.first())
+			l_velocity.y = -l_limit_y.first();
+		if (l_limit_y.second() > -1 && l_velocity.y >  l_limit_y.second())
+			l_velocity.y =  l_limit_y.second();
+
+		/* paired slots share their index */
+		if (l_i < l_paired)
+			l_positions[l_i] += l_velocity * d;
+	}
+}
+
+} /*********************************************************** Game Namespace */
+MARSHMALLOW_NAMESPACE_END
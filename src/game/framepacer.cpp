@@ -0,0 +1,203 @@
+/*
+ * Copyright (c) 2012-2013, Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ * All rights reserved.
+ *
+ * This file is part of Marshmallow Game Engine.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE CONTRIBUTORS ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are
+ * those of the authors and should not be interpreted as representing official
+ * policies, either expressed or implied, of the project as a whole.
+ */
+
+#include "game/framepacer.h"
+
+/*!
+ * @file
+ *
+ * @author Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ */
+
+#include "core/platform.h"
+
+MARSHMALLOW_NAMESPACE_BEGIN
+namespace Game { /******************************************** Game Namespace */
+namespace { /************************************ Game::<anonymous> Namespace */
+
+	/* exponential moving average weight, 1/16 */
+	const MMTICK Smoothing = 16;
+
+	/* spin at least this long while still measuring */
+	const MMTICK MinimumSpin = Core::Platform::TicksPerMillisecond / 4;
+
+	inline void
+	Smooth(MMTICK &average, MMTICK sample)
+	{
+		average += (sample - average) / Smoothing;
+	}
+
+} /********************************************** Game::<anonymous> Namespace */
+
+struct FramePacer::Private
+{
+	Private(int sleep_)
+	    : interval(0)
+	    , deadline(0)
+	    , last_present(0)
+	    , measured(0)
+	    , jitter(0)
+	    , oversleep(0)
+	    , spin_cap(0)
+	    , vsync(0)
+	    , presented(false)
+	{
+		if (sleep_ < MMSLEEP_DISABLED)
+			sleep_ = MMSLEEP_DISABLED;
+		else if (sleep_ > MMSLEEP_DEEPSLEEP)
+			sleep_ = MMSLEEP_DEEPSLEEP;
+
+		/* 2ms when disabled down to none for deep sleep */
+		spin_cap = ((MMSLEEP_DEEPSLEEP - sleep_)
+		    * Core::Platform::TicksPerMillisecond) / 3;
+	}
+
+	MMTICK spin(void) const
+	{
+		if (!spin_cap)
+			return(0);
+
+		MMTICK l_spin = (oversleep * 2) + MinimumSpin;
+		return(l_spin < spin_cap ? l_spin : spin_cap);
+	}
+
+	MMTICK interval;
+	MMTICK deadline;
+	MMTICK last_present;
+	MMTICK measured;
+	MMTICK jitter;
+	MMTICK oversleep;
+	MMTICK spin_cap;
+	int    vsync;
+	bool   presented;
+};
+
+FramePacer::FramePacer(int s)
+    : m_p(new Private(s))
+{
+}
+
+FramePacer::~FramePacer(void)
+{
+	delete m_p, m_p = 0;
+}
+
+MMTICK
+FramePacer::spin(void) const
+{
+	return(m_p->spin());
+}
+
+void
+FramePacer::reset(MMTICK i, int v)
+{
+	m_p->interval = i;
+	m_p->vsync = v;
+	m_p->deadline = Core::Platform::Ticks() + i;
+	m_p->last_present = 0;
+	m_p->measured = i;
+	m_p->jitter = 0;
+	m_p->presented = false;
+}
+
+void
+FramePacer::wait(void)
+{
+	using namespace Core;
+
+	MMTICK l_now = Platform::Ticks();
+
+	/*
+	 * Let the swap block for us, only trusted while frames are actually
+	 * being presented (not while suspended).
+	 */
+	const bool l_presented = m_p->presented;
+	m_p->presented = false;
+	if (m_p->vsync && l_presented
+	    && m_p->interval <= m_p->measured + (m_p->measured >> 3)) {
+		m_p->deadline = l_now + m_p->interval;
+		return;
+	}
+
+	/* fell a frame or more behind, don't try to catch up */
+	if (l_now - m_p->deadline >= m_p->interval)
+		m_p->deadline = l_now;
+
+	const MMTICK l_spin = m_p->spin();
+	const MMTICK l_wake = m_p->deadline - l_spin;
+
+	if (l_wake > l_now) {
+		Platform::SleepTicks(l_wake - l_now);
+		l_now = Platform::Ticks();
+
+		/* learn how late we get woken up */
+		Smooth(m_p->oversleep, l_now > l_wake ? l_now - l_wake : 0);
+	}
+
+	while (l_now < m_p->deadline)
+		l_now = Platform::Ticks();
+
+	m_p->deadline += m_p->interval;
+}
+
+void
+FramePacer::presented(void)
+{
+	const MMTICK l_now = Core::Platform::Ticks();
+
+	if (m_p->last_present) {
+		const MMTICK l_delta = l_now - m_p->last_present;
+		Smooth(m_p->measured, l_delta);
+
+		const MMTICK l_deviation = l_delta > m_p->measured ?
+		    l_delta - m_p->measured : m_p->measured - l_delta;
+		Smooth(m_p->jitter, l_deviation);
+	}
+
+	m_p->last_present = l_now;
+	m_p->presented = true;
+}
+
+MMTICK
+FramePacer::interval(void) const
+{
+	return(m_p->measured);
+}
+
+MMTICK
+FramePacer::jitter(void) const
+{
+	return(m_p->jitter);
+}
+
+} /*********************************************************** Game Namespace */
+MARSHMALLOW_NAMESPACE_END
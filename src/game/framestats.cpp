@@ -0,0 +1,305 @@
+/*
+ * Copyright (c) 2012-2013, Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ * All rights reserved.
+ *
+ * This file is part of Marshmallow Game Engine.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE CONTRIBUTORS ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are
+ * those of the authors and should not be interpreted as representing official
+ * policies, either expressed or implied, of the project as a whole.
+ */
+
+#include "game/framestats.h"
+
+/*!
+ * @file
+ *
+ * @author Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ */
+
+#include "core/fileio.h"
+#include "core/histogram.h"
+#include "core/identifier.h"
+#include "core/logger.h"
+#include "core/platform.h"
+
+#include <cstdio>
+#include <vector>
+
+MARSHMALLOW_NAMESPACE_BEGIN
+namespace Game { /******************************************** Game Namespace */
+namespace { /************************************ Game::<anonymous> Namespace */
+
+/* longest trackable duration, longer ones are clamped */
+const MMTICK HighestDuration = 10 * Core::Platform::TicksPerSecond;
+
+const char *const PhaseNames[FrameStats::Phases] =
+    { "tick", "update", "render", "work", "frame" };
+
+inline double
+TicksToMilliseconds(double t)
+{
+	return(t / static_cast<double>(Core::Platform::TicksPerMillisecond));
+}
+
+inline double
+TicksToMilliseconds(MMTICK t)
+{
+	return(TicksToMilliseconds(static_cast<double>(t)));
+}
+
+} /********************************************** Game::<anonymous> Namespace */
+
+struct FrameStats::Private
+{
+	Core::Histogram *rolling[Phases];
+	Core::Histogram *lifetime[Phases];
+
+	/* ring of the last window frames, Phases durations per frame */
+	std::vector<MMTICK> samples;
+	size_t window;
+	size_t head;
+	size_t filled;
+
+	size_t   over[Phases];
+	uint64_t total_over[Phases];
+	uint64_t frames;
+	MMTICK   budget;
+
+	explicit Private(size_t window_);
+	~Private(void);
+
+	inline bool
+	isOver(int phase, MMTICK value) const
+	{
+		if (budget <= 0)
+			return(false);
+		if (phase == Frame)
+			return(value > budget + budget / 2);
+		return(value > budget);
+	}
+
+	void reset(MMTICK budget_);
+};
+
+FrameStats::Private::Private(size_t w)
+    : samples((w > 0 ? w : 1) * Phases)
+    , window(w > 0 ? w : 1)
+{
+	for (int l_i = 0; l_i < Phases; ++l_i) {
+		rolling[l_i]  = new Core::Histogram(HighestDuration);
+		lifetime[l_i] = new Core::Histogram(HighestDuration);
+	}
+	reset(0);
+}
+
+FrameStats::Private::~Private(void)
+{
+	for (int l_i = 0; l_i < Phases; ++l_i) {
+		delete rolling[l_i];
+		delete lifetime[l_i];
+	}
+}
+
+void
+FrameStats::Private::reset(MMTICK b)
+{
+	for (int l_i = 0; l_i < Phases; ++l_i) {
+		rolling[l_i]->reset();
+		lifetime[l_i]->reset();
+		over[l_i] = 0;
+		total_over[l_i] = 0;
+	}
+
+	head = filled = 0;
+	frames = 0;
+	budget = b;
+}
+
+FrameStats::FrameStats(size_t w)
+    : m_p(new Private(w))
+{
+}
+
+FrameStats::~FrameStats(void)
+{
+	delete m_p, m_p = 0;
+}
+
+void
+FrameStats::reset(MMTICK b)
+{
+	m_p->reset(b);
+}
+
+void
+FrameStats::record(MMTICK t, MMTICK u, MMTICK r, MMTICK f)
+{
+	const MMTICK l_sample[Phases] = { t, u, r, t + u + r, f };
+	MMTICK *l_slot = &m_p->samples[m_p->head * Phases];
+
+	/* evict oldest frame once the window is full */
+	if (m_p->filled == m_p->window) {
+		for (int l_i = 0; l_i < Phases; ++l_i) {
+			m_p->rolling[l_i]->remove(l_slot[l_i]);
+			if (m_p->isOver(l_i, l_slot[l_i]))
+				--m_p->over[l_i];
+		}
+	}
+	else ++m_p->filled;
+
+	for (int l_i = 0; l_i < Phases; ++l_i) {
+		l_slot[l_i] = l_sample[l_i];
+		m_p->rolling[l_i]->record(l_sample[l_i]);
+		m_p->lifetime[l_i]->record(l_sample[l_i]);
+		if (m_p->isOver(l_i, l_sample[l_i])) {
+			++m_p->over[l_i];
+			++m_p->total_over[l_i];
+		}
+	}
+
+	if (++m_p->head == m_p->window)
+		m_p->head = 0;
+	++m_p->frames;
+}
+
+MMTICK
+FrameStats::budget(void) const
+{
+	return(m_p->budget);
+}
+
+size_t
+FrameStats::window(void) const
+{
+	return(m_p->window);
+}
+
+uint64_t
+FrameStats::frames(void) const
+{
+	return(m_p->frames);
+}
+
+MMTICK
+FrameStats::percentile(Phase p, double percent) const
+{
+	/* bound by the exact maximum, evicted frames may have raised it */
+	const MMTICK l_value = m_p->rolling[p]->percentile(percent);
+	const MMTICK l_max = maximum(p);
+	return(l_value < l_max ? l_value : l_max);
+}
+
+MMTICK
+FrameStats::maximum(Phase p) const
+{
+	MMTICK l_max = 0;
+	for (size_t l_i = 0; l_i < m_p->filled; ++l_i) {
+		const MMTICK l_value = m_p->samples[l_i * Phases + p];
+		if (l_value > l_max)
+			l_max = l_value;
+	}
+	return(l_max);
+}
+
+MMTICK
+FrameStats::mean(Phase p) const
+{
+	return(static_cast<MMTICK>(m_p->rolling[p]->mean()));
+}
+
+size_t
+FrameStats::overBudget(Phase p) const
+{
+	return(m_p->over[p]);
+}
+
+uint64_t
+FrameStats::totalOverBudget(Phase p) const
+{
+	return(m_p->total_over[p]);
+}
+
+const Core::Histogram &
+FrameStats::histogram(Phase p) const
+{
+	return(*m_p->lifetime[p]);
+}
+
+bool
+FrameStats::write(Core::IDataIO &o) const
+{
+	char l_line[256];
+	int l_length;
+
+	l_length = snprintf(l_line, sizeof(l_line),
+	    "# frames %llu, budget %.3fms\n"
+	    "# phase       mean      p50      p90      p95      p99    p99.9"
+	    "      max  over budget\n",
+	    static_cast<unsigned long long>(m_p->frames),
+	    TicksToMilliseconds(m_p->budget));
+	if (o.write(l_line, static_cast<size_t>(l_length)) != static_cast<size_t>(l_length))
+		return(false);
+
+	for (int l_i = 0; l_i < Phases; ++l_i) {
+		const Core::Histogram &l_histogram = *m_p->lifetime[l_i];
+
+		l_length = snprintf(l_line, sizeof(l_line),
+		    "%-8s %8.3f %8.3f %8.3f %8.3f %8.3f %8.3f %8.3f %12llu\n",
+		    PhaseNames[l_i],
+		    TicksToMilliseconds(l_histogram.mean()),
+		    TicksToMilliseconds(l_histogram.percentile(50.)),
+		    TicksToMilliseconds(l_histogram.percentile(90.)),
+		    TicksToMilliseconds(l_histogram.percentile(95.)),
+		    TicksToMilliseconds(l_histogram.percentile(99.)),
+		    TicksToMilliseconds(l_histogram.percentile(99.9)),
+		    TicksToMilliseconds(l_histogram.maximum()),
+		    static_cast<unsigned long long>(m_p->total_over[l_i]));
+		if (o.write(l_line, static_cast<size_t>(l_length)) != static_cast<size_t>(l_length))
+			return(false);
+	}
+
+	return(true);
+}
+
+bool
+FrameStats::write(const std::string &p) const
+{
+	Core::FileIO l_file(p, Core::DIOWriteOnly);
+	if (!l_file.isOpen()) {
+		MMERROR("Failed to create frame statistics: " << p);
+		return(false);
+	}
+
+	return(write(l_file));
+}
+
+const char *
+FrameStats::PhaseName(Phase p)
+{
+	return(p >= 0 && p < Phases ? PhaseNames[p] : "unknown");
+}
+
+} /*********************************************************** Game Namespace */
+MARSHMALLOW_NAMESPACE_END
@@ -42,6 +42,7 @@
 #include "game/iengine.h"
 #include "game/ientity.h"
 #include "game/ifactory.h"
+#include "game/iframepacer.h"
 #include "game/iscene.h"
 #include "game/iscenelayer.h"
 
@@ -56,6 +57,8 @@ namespace Game { /******************************************** Game Namespace */
 
 	IFactory::~IFactory(void) {}
 
+	IFramePacer::~IFramePacer(void) {}
+
 	IScene::~IScene(void) {}
 
 	ISceneLayer::~ISceneLayer(void) {}
@@ -40,8 +40,11 @@
 
 #include "core/identifier.h"
 #include "core/logger.h"
+#include "core/objectpool.h"
+#include "core/ref.h"
 #include "core/weak.h"
 
+#include "game/entitystore.h"
 #include "game/ientity.h"
 #include "game/positioncomponent.h"
 
@@ -52,10 +55,16 @@ namespace Game { /******************************************** Game Namespace */
 
 struct MovementComponent::Private
 {
-	Private(void)
-	    : limit_x(-1.f, -1.f)
+	MMPOOLED
+
+	Private(const WeakEntityStore &store_, const EntityHandle &handle_)
+	    : store(store_)
+	    , handle(handle_)
+	    , limit_x(-1.f, -1.f)
 	    , limit_y(-1.f, -1.f) {}
 
+	WeakEntityStore store;
+	EntityHandle handle;
 	WeakPositionComponent position;
 	Math::Vector2 acceleration;
 	Math::Pair limit_x;
@@ -65,44 +74,74 @@ struct MovementComponent::Private
 
 MovementComponent::MovementComponent(const Core::Identifier &i, IEntity &e)
     : ComponentBase(i, e)
-    , m_p(new Private)
+    , m_p(new Private(WeakEntityStore(), EntityHandle()))
+{
+}
+
+MovementComponent::MovementComponent(const Core::Identifier &i, IEntity &e,
+    const WeakEntityStore &s, const EntityHandle &h)
+    : ComponentBase(i, e)
+    , m_p(new Private(s, h))
 {
+	if (m_p->store)
+		m_p->store->attach(h, EntityStore::Movement);
 }
 
 MovementComponent::~MovementComponent(void)
 {
+	if (m_p->store)
+		m_p->store->detach(m_p->handle, EntityStore::Movement);
+
 	delete m_p, m_p = 0;
 }
 
 Math::Vector2 &
 MovementComponent::acceleration(void)
 {
+	Math::Vector2 *l_acceleration;
+	if (m_p->store && (l_acceleration = m_p->store->acceleration(m_p->handle)))
+		return(*l_acceleration);
 	return(m_p->acceleration);
 }
 
 Math::Pair &
 MovementComponent::limitX(void)
 {
+	Math::Pair *l_limit;
+	if (m_p->store && (l_limit = m_p->store->limitX(m_p->handle)))
+		return(*l_limit);
 	return(m_p->limit_x);
 }
 
 Math::Pair &
 MovementComponent::limitY(void)
 {
+	Math::Pair *l_limit;
+	if (m_p->store && (l_limit = m_p->store->limitY(m_p->handle)))
+		return(*l_limit);
 	return(m_p->limit_y);
 }
 
 Math::Vector2 &
 MovementComponent::velocity(void)
 {
+	Math::Vector2 *l_velocity;
+	if (m_p->store && (l_velocity = m_p->store->velocity(m_p->handle)))
+		return(*l_velocity);
 	return(m_p->velocity);
 }
 
 Math::Point2
 MovementComponent::simulate(float d) const
 {
+	MovementComponent *l_this = const_cast<MovementComponent *>(this);
+
+	Math::Point2 *l_position;
+	if (m_p->store && (l_position = m_p->store->position(m_p->handle)))
+		return(*l_position + (l_this->velocity() * d));
+
 	if (m_p->position)
-		return(m_p->position->position() + (m_p->velocity * d));
+		return(m_p->position->position() + (l_this->velocity() * d));
 	else MMWARNING("MovementComponent::simulate didn't find a position component.");
 	return(Math::Point2::Zero());
 }
@@ -110,30 +149,40 @@ MovementComponent::simulate(float d) const
 void
 MovementComponent::update(float d)
 {
+	/*
+	 * Pooled velocity is integrated by EntityStore::update(), which also
+	 * moves pooled positions.
+	 */
+	const bool l_pooled = m_p->store && m_p->store->velocity(m_p->handle);
+	if (l_pooled && m_p->store->position(m_p->handle))
+		return;
+
 	if (!m_p->position) {
-		m_p->position = entity().getComponentType("Game::PositionComponent").
+		m_p->position = entity().getComponentType(PositionComponent::Type()).
 		    staticCast<PositionComponent>();
 	}
 
-	const Math::Pair &l_limit_x = m_p->limit_x;
-	const Math::Pair &l_limit_y = m_p->limit_y;
-	Math::Vector2 &l_velocity = m_p->velocity;
+	const Math::Pair &l_limit_x = limitX();
+	const Math::Pair &l_limit_y = limitY();
+	Math::Vector2 &l_velocity = velocity();
 
-	/* update velocity */
+	if (!l_pooled) {
+		/* update velocity */
 
-	l_velocity += m_p->acceleration * d;
+		l_velocity += acceleration() * d;
 
-	/* check limit */
+		/* check limit */
 
-	if (l_limit_x.first()  > -1 && l_velocity.x < -l_limit_x.first())
-		l_velocity.x = -l_limit_x.first();
-	if (l_limit_x.second() > -1 && l_velocity.x >  l_limit_x.second())
-		l_velocity.x =  l_limit_x.second();
+		if (l_limit_x.first()  > -1 && l_velocity.x < -l_limit_x.first())
+			l_velocity.x = -l_limit_x.first();
+		if (l_limit_x.second() > -1 && l_velocity.x >  l_limit_x.second())
+			l_velocity.x =  l_limit_x.second();
 
-	if (l_limit_y.first()  > -1 && l_velocity.y < -l_limit_y.first())
-		l_velocity.y = -l_limit_y.first();
-	if (l_limit_y.second() > -1 && l_velocity.y >  l_limit_y.second())
-		l_velocity.y =  l_limit_y.second();
+		if (l_limit_y.first()  > -1 && l_velocity.y < -l_limit_y.first())
+			l_velocity.y = -l_limit_y.first();
+		if (l_limit_y.second() > -1 && l_velocity.y >  l_limit_y.second())
+			l_velocity.y =  l_limit_y.second();
+	}
 
 	/* update position */
 
@@ -146,21 +195,23 @@ MovementComponent::serialize(XMLElement &n) const
 	if (!ComponentBase::serialize(n))
 	    return(false);
 
+	MovementComponent *l_this = const_cast<MovementComponent *>(this);
+
 	XMLElement *l_acceleration = n.GetDocument()->NewElement("acceleration");
-	l_acceleration->SetAttribute("x", m_p->acceleration.x);
-	l_acceleration->SetAttribute("y", m_p->acceleration.y);
+	l_acceleration->SetAttribute("x", l_this->acceleration().x);
+	l_acceleration->SetAttribute("y", l_this->acceleration().y);
 	n.InsertEndChild(l_acceleration);
 
 	XMLElement *l_limit = n.GetDocument()->NewElement("limit");
-	l_limit->SetAttribute("x1", m_p->limit_x.first());
-	l_limit->SetAttribute("x2", m_p->limit_x.second());
-	l_limit->SetAttribute("y1", m_p->limit_y.first());
-	l_limit->SetAttribute("y2", m_p->limit_y.second());
+	l_limit->SetAttribute("x1", l_this->limitX().first());
+	l_limit->SetAttribute("x2", l_this->limitX().second());
+	l_limit->SetAttribute("y1", l_this->limitY().first());
+	l_limit->SetAttribute("y2", l_this->limitY().second());
 	n.InsertEndChild(l_limit);
 
 	XMLElement *l_velocity = n.GetDocument()->NewElement("velocity");
-	l_velocity->SetAttribute("x", m_p->velocity.x);
-	l_velocity->SetAttribute("y", m_p->velocity.y);
+	l_velocity->SetAttribute("x", l_this->velocity().x);
+	l_velocity->SetAttribute("y", l_this->velocity().y);
 	n.InsertEndChild(l_velocity);
 
 	return(true);
@@ -174,22 +225,22 @@ MovementComponent::deserialize(XMLElement &n)
 
 	XMLElement *l_acceleration = n.FirstChildElement( "acceleration" );
 	if (l_acceleration) {
-		l_acceleration->QueryFloatAttribute("x", &m_p->acceleration.x);
-		l_acceleration->QueryFloatAttribute("y", &m_p->acceleration.y);
+		l_acceleration->QueryFloatAttribute("x", &acceleration().x);
+		l_acceleration->QueryFloatAttribute("y", &acceleration().y);
 	}
 
 	XMLElement *l_limit = n.FirstChildElement( "limit" );
 	if (l_limit) {
-		l_limit->QueryFloatAttribute("x1", &m_p->limit_x[0]);
-		l_limit->QueryFloatAttribute("x2", &m_p->limit_x[1]);
-		l_limit->QueryFloatAttribute("y1", &m_p->limit_y[0]);
-		l_limit->QueryFloatAttribute("y2", &m_p->limit_y[1]);
+		l_limit->QueryFloatAttribute("x1", &limitX()[0]);
+		l_limit->QueryFloatAttribute("x2", &limitX()[1]);
+		l_limit->QueryFloatAttribute("y1", &limitY()[0]);
+		l_limit->QueryFloatAttribute("y2", &limitY()[1]);
 	}
 
 	XMLElement *l_velocity = n.FirstChildElement( "velocity" );
 	if (l_velocity) {
-		l_velocity->QueryFloatAttribute("x", &m_p->velocity.x);
-		l_velocity->QueryFloatAttribute("y", &m_p->velocity.y);
+		l_velocity->QueryFloatAttribute("x", &velocity().x);
+		l_velocity->QueryFloatAttribute("y", &velocity().y);
 	}
 
 	return(true);
@@ -39,6 +39,10 @@
  */
 
 #include "core/identifier.h"
+#include "core/objectpool.h"
+#include "core/weak.h"
+
+#include "game/entitystore.h"
 
 #include <tinyxml2.h>
 
@@ -47,23 +51,46 @@ namespace Game { /******************************************** Game Namespace */
 
 struct PositionComponent::Private
 {
+	MMPOOLED
+
+	Private(const WeakEntityStore &store_, const EntityHandle &handle_)
+	    : store(store_)
+	    , handle(handle_) {}
+
+	WeakEntityStore store;
+	EntityHandle handle;
 	Math::Point2 position;
 };
 
 PositionComponent::PositionComponent(const Core::Identifier &i, IEntity &e)
     : ComponentBase(i, e)
-    , m_p(new Private)
+    , m_p(new Private(WeakEntityStore(), EntityHandle()))
+{
+}
+
+PositionComponent::PositionComponent(const Core::Identifier &i, IEntity &e,
+    const WeakEntityStore &s, const EntityHandle &h)
+    : ComponentBase(i, e)
+    , m_p(new Private(s, h))
 {
+	if (m_p->store)
+		m_p->store->attach(h, EntityStore::Position);
 }
 
 PositionComponent::~PositionComponent(void)
 {
+	if (m_p->store)
+		m_p->store->detach(m_p->handle, EntityStore::Position);
+
 	delete m_p, m_p = 0;
 }
 
 Math::Point2 &
 PositionComponent::position(void)
 {
+	Math::Point2 *l_position;
+	if (m_p->store && (l_position = m_p->store->position(m_p->handle)))
+		return(*l_position);
 	return(m_p->position);
 }
 
@@ -73,8 +100,10 @@ PositionComponent::serialize(XMLElement &n) const
 	if (!ComponentBase::serialize(n))
 	    return(false);
 
-	n.SetAttribute("x", m_p->position.x);
-	n.SetAttribute("y", m_p->position.y);
+	const Math::Point2 &l_position =
+	    const_cast<PositionComponent *>(this)->position();
+	n.SetAttribute("x", l_position.x);
+	n.SetAttribute("y", l_position.y);
 	return(true);
 }
 
@@ -84,8 +113,9 @@ PositionComponent::deserialize(XMLElement &n)
 	if (!ComponentBase::deserialize(n))
 	    return(false);
 
-	n.QueryFloatAttribute("x", &m_p->position.x);
-	n.QueryFloatAttribute("y", &m_p->position.y);
+	Math::Point2 &l_position = position();
+	n.QueryFloatAttribute("x", &l_position.x);
+	n.QueryFloatAttribute("y", &l_position.y);
 	return(true);
 }
 
@@ -39,6 +39,8 @@
  */
 
 #include "core/logger.h"
+#include "core/objectpool.h"
+#include "core/ref.h"
 #include "core/type.h"
 #include "core/weak.h"
 
@@ -56,6 +58,8 @@ namespace Game { /******************************************** Game Namespace */
 
 struct RenderComponent::Private
 {
+	MMPOOLED
+
 	WeakPositionComponent position;
 	Graphics::SharedMesh  mesh;
 };
@@ -81,7 +85,7 @@ void
 RenderComponent::update(float)
 {
 	if (!m_p->position)
-		m_p->position = entity().getComponentType("Game::PositionComponent").
+		m_p->position = entity().getComponentType(PositionComponent::Type()).
 		    staticCast<PositionComponent>();
 }
 
@@ -40,6 +40,8 @@
 
 #include "core/identifier.h"
 #include "core/logger.h"
+#include "core/profiler.h"
+#include "core/ref.h"
 #include "core/shared.h"
 
 #include "graphics/color.h"
@@ -117,6 +119,18 @@ SceneBase::removeLayer(const Core::Identifier &i)
 
 SharedSceneLayer
 SceneBase::getLayer(const Core::Identifier &i) const
+{
+	return(borrowLayer(i));
+}
+
+SharedSceneLayer
+SceneBase::getLayerType(const Core::Type &t) const
+{
+	return(borrowLayerType(t));
+}
+
+RefSceneLayer
+SceneBase::borrowLayer(const Core::Identifier &i) const
 {
 	SceneLayerList::const_iterator l_i;
 	SceneLayerList::const_iterator l_c = m_p->layers.end();
@@ -127,11 +141,11 @@ SceneBase::getLayer(const Core::Identifier &i) const
 			return(*l_i);
 	}
 
-	return(SharedSceneLayer());
+	return(RefSceneLayer());
 }
 
-SharedSceneLayer
-SceneBase::getLayerType(const Core::Type &t) const
+RefSceneLayer
+SceneBase::borrowLayerType(const Core::Type &t) const
 {
 	SceneLayerList::const_iterator l_i;
 	SceneLayerList::const_iterator l_c = m_p->layers.end();
@@ -142,7 +156,7 @@ SceneBase::getLayerType(const Core::Type &t) const
 			return(*l_i);
 	}
 
-	return(SharedSceneLayer());
+	return(RefSceneLayer());
 }
 
 const SceneLayerList &
@@ -187,6 +201,8 @@ SceneBase::deactivate(void)
 void
 SceneBase::render(void)
 {
+	MMPROFILE_SCOPE("SceneBase::render");
+
 	if (m_p->layers.empty()) return;
 
 	SceneLayerList::const_iterator l_i;
@@ -209,6 +225,8 @@ SceneBase::render(void)
 void
 SceneBase::update(float d)
 {
+	MMPROFILE_SCOPE("SceneBase::update");
+
 	if (m_p->layers.empty()) return;
 
 	SceneLayerList::const_iterator l_i;
@@ -40,32 +40,59 @@
 
 #include <tinyxml2.h>
 
+#include "core/objectpool.h"
 #include "core/type.h"
+#include "core/weak.h"
 
 #include "math/size2.h"
 
+#include "game/entitystore.h"
+
 MARSHMALLOW_NAMESPACE_BEGIN
 namespace Game { /******************************************** Game Namespace */
 
 struct SizeComponent::Private
 {
+	MMPOOLED
+
+	Private(const WeakEntityStore &store_, const EntityHandle &handle_)
+	    : store(store_)
+	    , handle(handle_) {}
+
+	WeakEntityStore store;
+	EntityHandle handle;
 	Math::Size2f size;
 };
 
 SizeComponent::SizeComponent(const Core::Identifier &i, IEntity &e)
     : ComponentBase(i, e)
-    , m_p(new Private)
+    , m_p(new Private(WeakEntityStore(), EntityHandle()))
+{
+}
+
+SizeComponent::SizeComponent(const Core::Identifier &i, IEntity &e,
+    const WeakEntityStore &s, const EntityHandle &h)
+    : ComponentBase(i, e)
+    , m_p(new Private(s, h))
 {
+	if (m_p->store)
+		m_p->store->attach(h, EntityStore::Size);
 }
 
 SizeComponent::~SizeComponent(void)
 {
+	if (m_p->store)
+		m_p->store->detach(m_p->handle, EntityStore::Size);
+
 	delete m_p, m_p = 0;
 }
 
 Math::Size2f &
 SizeComponent::size(void)
 {
+	Math::Size2f *l_size;
+	if (m_p->store && (l_size = m_p->store->size(m_p->handle)))
+		return(*l_size);
 	return(m_p->size);
 }
 
@@ -75,8 +102,9 @@ SizeComponent::serialize(XMLElement &n) const
 	if (!ComponentBase::serialize(n))
 	    return(false);
 
-	n.SetAttribute("width", m_p->size.width);
-	n.SetAttribute("height", m_p->size.height);
+	const Math::Size2f &l_size = const_cast<SizeComponent *>(this)->size();
+	n.SetAttribute("width", l_size.width);
+	n.SetAttribute("height", l_size.height);
 	return(true);
 }
 
@@ -86,8 +114,9 @@ SizeComponent::deserialize(XMLElement &n)
 	if (!ComponentBase::deserialize(n))
 	    return(false);
 
-	n.QueryFloatAttribute("width",  &m_p->size.width);
-	n.QueryFloatAttribute("height", &m_p->size.height);
+	Math::Size2f &l_size = size();
+	n.QueryFloatAttribute("width",  &l_size.width);
+	n.QueryFloatAttribute("height", &l_size.height);
 	return(true);
 }
 
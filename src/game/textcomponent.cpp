@@ -40,6 +40,7 @@
 
 #include "core/identifier.h"
 #include "core/logger.h"
+#include "core/ref.h"
 #include "core/weak.h"
 
 #include "math/point2.h"
@@ -277,7 +278,7 @@ TextComponent::update(float delta)
 	ComponentBase::update(delta);
 
 	if (!m_p->position)
-	    m_p->position = entity().getComponentType("Game::PositionComponent").
+	    m_p->position = entity().getComponentType(PositionComponent::Type()).
 	        staticCast<PositionComponent>();
 
 	if (m_p->invalidated)
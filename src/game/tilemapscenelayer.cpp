@@ -38,8 +38,12 @@
  * @author Guillermo A. Amaral B. (gamaral) <g@maral.me>
  */
 
+#include <algorithm>
 #include <map>
+#include <new>
 
+#include "core/framearena.h"
+#include "core/ref.h"
 #include "core/shared.h"
 #include "core/type.h"
 
@@ -54,7 +58,21 @@ namespace Game { /******************************************** Game Namespace */
 namespace { /************************************ Game::<anonymous> Namespace */
 	typedef std::map<uint32_t, Graphics::SharedTileset> TilesetCollection;
 	typedef std::map<uint32_t, Graphics::SharedVertexData> VertexDataCache;
+	typedef std::map<uint32_t, Graphics::SharedQuadMesh> MeshCache;
 	typedef std::map<std::string, std::string> PropertyMap;
+
+	struct TileOrigin
+	{
+		uint32_t index;
+		float    x;
+		float    y;
+	};
+
+	inline bool
+	TileOriginLess(const TileOrigin &lhs, const TileOrigin &rhs)
+	{
+		return(lhs.index < rhs.index);
+	}
 } /********************************************** Game::<anonymous> Namespace */
 
 /******************************************************************************/
@@ -73,7 +91,8 @@ struct TilemapSceneLayer::Private
 		data = 0;
 	}
 
-	Graphics::SharedTileset tileset(uint32_t i, uint32_t *o);
+	Graphics::RefTileset tileset(uint32_t i, uint32_t *o);
+	Graphics::SharedQuadMesh mesh(uint32_t i);
 	void render(void);
 
 	void recalculateAllVertexData();
@@ -82,6 +101,7 @@ struct TilemapSceneLayer::Private
 
 	TilesetCollection tilesets;
 	VertexDataCache vertexes;
+	MeshCache meshes;
 	PropertyMap properties;
 
 	Math::Size2f hrsize;
@@ -102,14 +122,14 @@ struct TilemapSceneLayer::Private
 	bool  visible;
 };
 
-Graphics::SharedTileset
+Graphics::RefTileset
 TilemapSceneLayer::Private::tileset(uint32_t i, uint32_t *o)
 {
 	TilesetCollection::iterator l_i;
 	TilesetCollection::const_iterator l_end = tilesets.end();
 
 	uint32_t l_offset = 0;
-	Graphics::SharedTileset l_ts;
+	Graphics::RefTileset l_ts;
 
 	for (l_i = tilesets.begin(); l_i != l_end; ++l_i)
 		if (l_i->first <= i && l_offset < l_i->first) {
@@ -120,7 +140,32 @@ TilemapSceneLayer::Private::tileset(uint32_t i, uint32_t *o)
 	if (l_offset > 0) {
 		if (o) *o = l_offset;
 		return(l_ts);
-	} else return(Graphics::SharedTileset());
+	} else return(Graphics::RefTileset());
+}
+
+Graphics::SharedQuadMesh
+TilemapSceneLayer::Private::mesh(uint32_t i)
+{
+	MeshCache::const_iterator l_cached = meshes.find(i);
+	if (l_cached != meshes.end())
+		return(l_cached->second);
+
+	uint32_t l_tioffset;
+	Graphics::RefTileset l_ts = tileset(i, &l_tioffset);
+	if (!l_ts)
+		return(Graphics::SharedQuadMesh());
+
+	/* texture coordinates are only available once the texture loads */
+	Graphics::SharedTextureCoordinateData l_tcdata =
+	    l_ts->getTextureCoordinateData(static_cast<uint16_t>(i - l_tioffset));
+	if (!l_tcdata)
+		return(Graphics::SharedQuadMesh());
+
+	Graphics::SharedQuadMesh l_mesh =
+	    new Graphics::QuadMesh(l_tcdata, l_ts->textureData(), vertexes[l_tioffset]);
+	meshes[i] = l_mesh;
+
+	return(l_mesh);
 }
 
 void
@@ -128,15 +173,6 @@ TilemapSceneLayer::Private::render(void)
 {
 	if (!data || !visible) return;
 
-	typedef std::map<uint32_t, uint32_t> TileIndexCount;
-	typedef std::pair<float, float> Origin;
-	typedef std::multimap<uint32_t, Origin> TileIndexOrigins;
-	typedef std::pair<uint32_t, Origin> TileIndexOrigin;
-	typedef std::pair<TileIndexOrigins::iterator, TileIndexOrigins::iterator> TileIndexOriginsRange;
-	TileIndexCount   l_tile_count;
-	TileIndexOrigins l_tile_origins;
-	uint32_t         l_tile_count_max = 0;
-
 	/* calculate visible row and column range */
 
 	const Graphics::Transform &l_camera = Graphics::Camera::Transform();
@@ -174,7 +210,15 @@ TilemapSceneLayer::Private::render(void)
 	int row_stop  = static_cast<int>(ceilf(((row_stop_cam - hrsize.height) / rsize.height)
 	    * static_cast<float>(-size.height)));
 
-	/* calculate tile origins */
+	if (row_stop <= row_start || col_stop <= col_start)
+		return;
+
+	/* calculate tile origins (frame transient) */
+
+	const size_t l_tile_max = static_cast<size_t>(row_stop - row_start)
+	                        * static_cast<size_t>(col_stop - col_start);
+	TileOrigin *l_tiles = Core::FrameArena::Allocate<TileOrigin>(l_tile_max);
+	size_t l_tile_count = 0;
 
 	for (int l_r = row_start; l_r < row_stop; ++l_r) {
 		const int l_rindex = l_r % size.height;
@@ -201,46 +245,33 @@ TilemapSceneLayer::Private::render(void)
 			/* offset to bottom of tile (we draw up) */
 			l_y -= rtile_size.height;
 
-			/* add to cache */
-
-			uint32_t l_current_count = (l_tile_count[l_tindex] += 1);
-			if (l_tile_count_max < l_current_count)
-				l_tile_count_max = l_current_count;
-
-			l_tile_origins.insert(TileIndexOrigin(l_tindex, Origin(l_x, l_y)));
+			TileOrigin &l_tile = l_tiles[l_tile_count++];
+			l_tile.index = l_tindex;
+			l_tile.x = l_x;
+			l_tile.y = l_y;
 		}
 	}
 
-	/* draw tiles */
+	/* group tiles by index, one draw per index */
 
-	Math::Point2   *l_origins = new Math::Point2[l_tile_count_max];
-	Graphics::Color l_color(1.f, 1.f, 1.f, opacity);
+	std::sort(l_tiles, l_tiles + l_tile_count, TileOriginLess);
 
-	TileIndexCount::iterator ti;
-	TileIndexCount::iterator te = l_tile_count.end();
-	for (ti = l_tile_count.begin(); ti != te; ++ti) {
-		TileIndexOriginsRange l_range = l_tile_origins.equal_range(ti->first);
-		TileIndexOrigins::iterator oi;
-		uint32_t oic = 0;
-		for (oi = l_range.first; oi != l_range.second; ++oi)
-			l_origins[oic++].set(oi->second.first, oi->second.second);
-
-		assert(oic == ti->second && "Tile origin count mismatch!");
+	Math::Point2   *l_origins = Core::FrameArena::Allocate<Math::Point2>(l_tile_count);
+	Graphics::Color l_color(1.f, 1.f, 1.f, opacity);
 
-		uint32_t l_tioffset;
-		Graphics::SharedTileset l_ts = tileset(ti->first, &l_tioffset);
-		Graphics::SharedTextureCoordinateData l_tcd;
-		if (l_ts) {
-			Graphics::SharedVertexData &l_svdata = vertexes[l_tioffset];
+	size_t l_end;
+	for (size_t l_begin = 0; l_begin < l_tile_count; l_begin = l_end) {
+		const uint32_t l_tindex = l_tiles[l_begin].index;
 
-			Graphics::QuadMesh l_mesh(l_ts->getTextureCoordinateData(static_cast<uint16_t>(ti->first - l_tioffset)),
-			    l_ts->textureData(), l_svdata);
-			l_mesh.setColor(l_color);
+		for (l_end = l_begin; l_end < l_tile_count && l_tiles[l_end].index == l_tindex; ++l_end)
+			new (&l_origins[l_end - l_begin]) Math::Point2(l_tiles[l_end].x, l_tiles[l_end].y);
 
-			Graphics::Painter::Draw(l_mesh, l_origins, oic);
+		Graphics::SharedQuadMesh l_mesh = mesh(l_tindex);
+		if (l_mesh) {
+			l_mesh->setColor(l_color);
+			Graphics::Painter::Draw(*l_mesh, l_origins, l_end - l_begin);
 		}
 	}
-	delete [] l_origins;
 }
 
 void
@@ -315,6 +346,7 @@ TilemapSceneLayer::attachTileset(uint32_t o, Graphics::SharedTileset ts)
 {
 	m_p->tilesets[o] = ts;
 	m_p->vertexes[o] = Graphics::Factory::CreateVertexData(MARSHMALLOW_QUAD_VERTEXES);
+	m_p->meshes.clear();
 	m_p->recalculateVertexData(o);
 }
 
@@ -323,6 +355,7 @@ TilemapSceneLayer::dettachTileset(uint32_t o)
 {
 	m_p->tilesets.erase(o);
 	m_p->vertexes.erase(o);
+	m_p->meshes.clear();
 }
 
 const uint32_t *
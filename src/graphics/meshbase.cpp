@@ -41,6 +41,7 @@
 #include <tinyxml2.h>
 
 #include "core/logger.h"
+#include "core/objectpool.h"
 #include "core/shared.h"
 #include "core/type.h"
 
@@ -79,6 +80,8 @@ ScaleModeToString(Graphics::ITextureData::ScaleMode mode)
 
 struct MeshBase::Private
 {
+	MMPOOLED
+
 	SharedTextureCoordinateData tcdata;
 	SharedTextureData tdata;
 	SharedVertexData vdata;
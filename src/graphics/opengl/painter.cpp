@@ -42,6 +42,8 @@
 #include <stack>
 
 #include "core/logger.h"
+#include "core/profiler.h"
+#include "core/ref.h"
 #include "core/shared.h"
 #include "core/type.h"
 
@@ -409,7 +411,9 @@ GLPainter::LoadViewProjection(void)
 void
 GLPainter::Draw(const Graphics::IMesh &m, const Math::Point2 *o, size_t c)
 {
-	using OpenGL::SharedTextureData;
+	MMPROFILE_SCOPE("Painter::Draw");
+
+	using OpenGL::RefTextureData;
 	using OpenGL::TextureData;
 
 	if (0 == (flags & sfInitialized))
@@ -431,8 +435,8 @@ GLPainter::Draw(const Graphics::IMesh &m, const Math::Point2 *o, size_t c)
 	/* set texture */
 	glActiveTexture(GL_TEXTURE0);
 
-	SharedTextureData l_texture_data =
-	    m.textureData().staticCast<TextureData>();
+	RefTextureData l_texture_data =
+	    Graphics::RefTextureData(m.textureData()).staticCast<TextureData>();
 	if (last_texture_id != l_texture_data->id()) {
 		last_texture_id = l_texture_data->id();
 		if (l_texture_data->isLoaded()) {
@@ -443,9 +447,7 @@ GLPainter::Draw(const Graphics::IMesh &m, const Math::Point2 *o, size_t c)
 			if (l_texture_data->sessionId() != session_id)
 				l_texture_data->reload();
 
-			SharedTextureData l_data =
-			    l_texture_data.staticCast<TextureData>();
-			glBindTexture(GL_TEXTURE_2D, l_data->textureId());
+			glBindTexture(GL_TEXTURE_2D, l_texture_data->textureId());
 			glUniform1i(location_usecolor, 0);
 		}
 		else glUniform1i(location_usecolor, 1);
@@ -486,18 +488,19 @@ inline void
 GLPainter::BeginDrawQuadMesh(const Graphics::QuadMesh &g, bool tcoords)
 {
 	using OpenGL::Extensions::glBindBuffer;
-	using OpenGL::SharedTextureCoordinateData;
-	using OpenGL::SharedVertexData;
+	using OpenGL::RefTextureCoordinateData;
+	using OpenGL::RefVertexData;
 	using OpenGL::TextureCoordinateData;
 	using OpenGL::VertexData;
 
-	SharedVertexData l_vdata =
-	    g.vertexData().staticCast<VertexData>();
+	RefVertexData l_vdata =
+	    Graphics::RefVertexData(g.vertexData()).staticCast<VertexData>();
 
 	if (!l_vdata) return;
 
-	SharedTextureCoordinateData l_tcdata =
-	    g.textureCoordinateData() .staticCast<TextureCoordinateData>();
+	RefTextureCoordinateData l_tcdata =
+	    Graphics::RefTextureCoordinateData(g.textureCoordinateData())
+	        .staticCast<TextureCoordinateData>();
 
 	/* ** vertex ** */
 
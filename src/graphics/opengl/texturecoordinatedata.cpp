@@ -39,6 +39,7 @@
  */
 
 #include "core/logger.h"
+#include "core/memory.h"
 
 #include <cstring>
 
@@ -76,8 +77,10 @@ TextureCoordinateData::buffer(void)
 	using Graphics::OpenGL::Extensions::glBufferData;
 	using Graphics::OpenGL::Extensions::glGenBuffers;
 
-	if (!isBuffered())
+	if (!isBuffered()) {
 		glGenBuffers(1, &m_buffer_id);
+		MMMEMORY_TRACK(TextureCoordinateMemory, m_count * AXES * sizeof(GLfloat));
+	}
 
 	glBindBuffer(GL_ARRAY_BUFFER, m_buffer_id);
 	glBufferData(GL_ARRAY_BUFFER, m_count * AXES * sizeof(GLfloat), m_data, GL_STATIC_DRAW);
@@ -100,6 +103,8 @@ TextureCoordinateData::unbuffer(void)
 
 	glDeleteBuffers(1, &m_buffer_id);
 	m_buffer_id = 0;
+
+	MMMEMORY_UNTRACK(TextureCoordinateMemory, m_count * AXES * sizeof(GLfloat));
 }
 
 void
@@ -108,6 +113,9 @@ TextureCoordinateData::rebuffer(void)
 	if (!isBuffered())
 		return;
 
+	/* the old buffer died with its context */
+	MMMEMORY_UNTRACK(TextureCoordinateMemory, m_count * AXES * sizeof(GLfloat));
+
 	m_buffer_id = 0;
 	m_session_id = 0;
 	buffer();
@@ -105,6 +105,7 @@ namespace OpenGL { /****************************** Graphics::OpenGL Namespace */
 	};
 	typedef Core::Shared<TextureCoordinateData> SharedTextureCoordinateData;
 	typedef Core::Weak<TextureCoordinateData> WeakTextureCoordinateData;
+	typedef Core::Ref<TextureCoordinateData> RefTextureCoordinateData;
 
 } /*********************************************** Graphics::OpenGL Namespace */
 } /******************************************************* Graphics Namespace */
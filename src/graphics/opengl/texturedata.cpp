@@ -40,6 +40,8 @@
 
 #include "core/identifier.h"
 #include "core/logger.h"
+#include "core/mappedfileio.h"
+#include "core/memory.h"
 
 #include <cassert>
 #include <cstring>
@@ -64,40 +66,61 @@ struct Texture
 	uint8_t *pixels;
 };
 
+struct PNGSource
+{
+	const png_byte *data;
+	size_t size;
+	size_t cursor;
+};
+
+void
+ReadPNGData(png_structp png_ptr, png_bytep buffer, png_size_t bsize)
+{
+	PNGSource *l_source = static_cast<PNGSource *>(png_get_io_ptr(png_ptr));
+
+	if (bsize > l_source->size - l_source->cursor)
+		png_error(png_ptr, "Unexpected end of PNG data.");
+
+	memcpy(buffer, l_source->data + l_source->cursor, bsize);
+	l_source->cursor += bsize;
+}
+
 bool
 LoadTexturePNG(const std::string &filename, Texture &data)
 {
-	FILE *png_file;
-	if (0 == (png_file = fopen(filename.c_str(), "rb")))
+	Core::MappedFileIO l_file(filename);
+	if (!l_file.isOpen())
 		return(false);
 
-	unsigned char header[8];
-	if (8 != fread(header, 1, 8, png_file)
-	    || png_sig_cmp(header, 0, 8) != 0) {
-		fclose(png_file);
+	/* decoded in one pass */
+	l_file.advise(Core::DIOAdviceSequential);
+
+	PNGSource l_source;
+	l_source.size = l_file.size();
+	l_source.cursor = 8;
+
+	if (l_source.size < 8
+	    || !(l_source.data = static_cast<const png_byte *>
+	        (l_file.view(0, l_source.size)))
+	    || png_sig_cmp(const_cast<png_bytep>(l_source.data), 0, 8) != 0)
 		return(false);
-	}
 
 	png_structp png_ptr;
-	if (0 == (png_ptr = png_create_read_struct(PNG_LIBPNG_VER_STRING, 0, 0, 0))) {
-		fclose(png_file);
+	if (0 == (png_ptr = png_create_read_struct(PNG_LIBPNG_VER_STRING, 0, 0, 0)))
 		return(false);
-	}
 
 	png_infop info_ptr;
 	if (0 == (info_ptr = png_create_info_struct(png_ptr))) {
-		fclose(png_file);
 		png_destroy_read_struct(&png_ptr, 0, 0);
 		return(false);
 	}
 
 	if (setjmp(png_jmpbuf(png_ptr))) {
-		fclose(png_file);
 		png_destroy_read_struct(&png_ptr, &info_ptr, 0);
 		return(false);
 	}
 
-	png_init_io(png_ptr, png_file);
+	png_set_read_fn(png_ptr, &l_source, ReadPNGData);
 	png_set_sig_bytes(png_ptr, 8);
 
 	png_read_png(png_ptr, info_ptr, PNG_TRANSFORM_STRIP_16 | PNG_TRANSFORM_PACKING | PNG_TRANSFORM_EXPAND, 0);
@@ -113,7 +136,6 @@ LoadTexturePNG(const std::string &filename, Texture &data)
 	else if((color_type & PNG_COLOR_TYPE_RGB) == PNG_COLOR_TYPE_RGB)
 		data.components = 3;
 	else {
-		fclose(png_file);
 		png_destroy_read_struct(&png_ptr, &info_ptr, 0);
 		return(false);
 	}
@@ -127,7 +149,6 @@ LoadTexturePNG(const std::string &filename, Texture &data)
 		memcpy(data.pixels + (row_bytes * i), row_pointers[i], row_bytes);
 
 	png_destroy_read_struct(&png_ptr, &info_ptr, 0);
-	fclose(png_file);
 
 	return(true);
 }
@@ -147,6 +168,7 @@ UnloadTexture(Texture &data)
 TextureData::TextureData(void)
     : m_id()
     , m_size()
+    , m_bytes(0)
     , m_session_id(0)
     , m_texture_id(0)
 {
@@ -163,6 +185,10 @@ TextureData::reload(void)
 	if (!isLoaded())
 		return(false);
 
+	/* the old texture died with its context */
+	MMMEMORY_UNTRACK(TextureMemory, m_bytes);
+	m_bytes = 0;
+
 	m_texture_id = 0;
 	m_session_id = 0;
 	return(load(m_id, m_min, m_mag));
@@ -253,6 +279,11 @@ TextureData::load(const Core::Identifier &_id, ScaleMode min, ScaleMode mag)
 	             tdata.pixels);
 	if (l_mipmaps) glGenerateMipmap(GL_TEXTURE_2D);
 
+	/* GPU side estimate, a full mipmap chain adds a third */
+	m_bytes = static_cast<size_t>(tdata.width) * tdata.height * tdata.components;
+	if (l_mipmaps) m_bytes += m_bytes / 3;
+	MMMEMORY_TRACK(TextureMemory, m_bytes);
+
 	/* unload local-copy */
 	UnloadTexture(tdata);
 
@@ -266,9 +297,12 @@ TextureData::load(const Core::Identifier &_id, ScaleMode min, ScaleMode mag)
 void
 TextureData::unload(void)
 {
-	if (m_texture_id)
+	if (m_texture_id) {
 		glDeleteTextures(1, &m_texture_id);
+		MMMEMORY_UNTRACK(TextureMemory, m_bytes);
+	}
 
+	m_bytes = 0;
 	m_size = Math::Size2i();
 	m_session_id = 0;
 	m_texture_id = 0;
@@ -56,6 +56,7 @@ namespace OpenGL { /****************************** Graphics::OpenGL Namespace */
 	{
 		Core::Identifier m_id;
 		Math::Size2i m_size;
+		size_t m_bytes;
 		unsigned int m_session_id;
 		unsigned int m_texture_id;
 		ScaleMode m_min;
@@ -104,6 +105,7 @@ namespace OpenGL { /****************************** Graphics::OpenGL Namespace */
 	};
 	typedef Core::Shared<TextureData> SharedTextureData;
 	typedef Core::Weak<TextureData> WeakTextureData;
+	typedef Core::Ref<TextureData> RefTextureData;
 
 } /*********************************************** Graphics::OpenGL Namespace */
 } /******************************************************* Graphics Namespace */
@@ -39,6 +39,7 @@
  */
 
 #include "core/logger.h"
+#include "core/memory.h"
 
 #include <cstring>
 
@@ -77,8 +78,10 @@ VertexData::buffer(void)
 	using Graphics::OpenGL::Extensions::glBufferData;
 	using Graphics::OpenGL::Extensions::glGenBuffers;
 
-	if (!isBuffered())
+	if (!isBuffered()) {
 		glGenBuffers(1, &m_buffer_id);
+		MMMEMORY_TRACK(VertexMemory, m_count * AXES * sizeof(GLfloat));
+	}
 
 	glBindBuffer(GL_ARRAY_BUFFER, m_buffer_id);
 	glBufferData(GL_ARRAY_BUFFER, m_count * AXES * sizeof(GLfloat), m_data, GL_STATIC_DRAW);
@@ -101,6 +104,8 @@ VertexData::unbuffer(void)
 
 	glDeleteBuffers(1, &m_buffer_id);
 	m_buffer_id = 0;
+
+	MMMEMORY_UNTRACK(VertexMemory, m_count * AXES * sizeof(GLfloat));
 }
 
 void
@@ -109,6 +114,9 @@ VertexData::rebuffer(void)
 	if (!isBuffered())
 		return;
 
+	/* the old buffer died with its context */
+	MMMEMORY_UNTRACK(VertexMemory, m_count * AXES * sizeof(GLfloat));
+
 	m_buffer_id = 0;
 	m_session_id = 0;
 	buffer();
@@ -105,6 +105,7 @@ namespace OpenGL { /****************************** Graphics::OpenGL Namespace */
 	};
 	typedef Core::Shared<VertexData> SharedVertexData;
 	typedef Core::Weak<VertexData> WeakVertexData;
+	typedef Core::Ref<VertexData> RefVertexData;
 
 } /*********************************************** Graphics::OpenGL Namespace */
 } /******************************************************* Graphics Namespace */
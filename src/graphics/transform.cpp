@@ -38,6 +38,8 @@
  * @author Guillermo A. Amaral B. (gamaral) <g@maral.me>
  */
 
+#include "core/objectpool.h"
+
 #include "math/matrix4.h"
 #include "math/point2.h"
 #include "math/size2.h"
@@ -49,6 +51,8 @@ namespace Graphics { /************************************ Graphics Namespace */
 
 struct Transform::Private
 {
+	MMPOOLED
+
 	bool invalidated;
 
 	float rotation;
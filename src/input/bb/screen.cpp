@@ -167,7 +167,7 @@ HandleScreenKeyEvent(screen_event_t &e)
 	if (l_prev_action != l_action) {
 		Keyboard::SetKeyState(l_key, l_action);
 		Event::EventManager::Instance()->
-		    queue(new Event::KeyboardEvent(l_key, l_action, 0));
+		    queue<Event::KeyboardEvent>(l_key, l_action, 0);
 	}
 
 	return(true);
@@ -189,7 +189,7 @@ HandleScreenTouchEvent(int type, screen_event_t &e)
         screen_get_event_property_iv(e, SCREEN_PROPERTY_SOURCE_POSITION, l_pos);
 
 	Event::EventManager::Instance()->
-	    queue(new Event::TouchEvent(l_action, l_pos[0], l_pos[1], 0));
+	    queue<Event::TouchEvent>(l_action, l_pos[0], l_pos[1], 0);
 
 	return(true);
 }
@@ -93,7 +93,7 @@ HandleBasicSensorEvent(int type, bps_event_t *e)
 	 */
 	sensor_event_get_xyz(e, &l_value[0], &l_value[1], &l_value[2]);
 	Event::EventManager::Instance()->
-	    queue(new Event::SensorEvent(l_sensor, l_value[0], l_value[1], l_value[2], 0));
+	    queue<Event::SensorEvent>(l_sensor, l_value[0], l_value[1], l_value[2], 0);
 
 	MMDEBUG("Sensor event received: " << l_sensor << ": "
 	    << l_value[0] << " " << l_value[1] << " " << l_value[2]);
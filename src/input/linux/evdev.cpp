@@ -39,6 +39,7 @@
  */
 
 #include "core/logger.h"
+#include "core/profiler.h"
 
 #include <sys/inotify.h>
 
@@ -199,6 +200,8 @@ Finalize(int mask)
 void
 Tick(int mask)
 {
+	MMPROFILE_SCOPE("EVDEV::Tick");
+
 	ProcessNotificationEvents();
 
 	for (unsigned int i = 0; i < EVDEV_MAX; ++i) {
@@ -144,19 +144,17 @@ JoystickDevice::handleEvent(struct input_event &event)
 			default: break;
 			}
 
-			SharedEvent l_event(new JoystickAxisEvent(
+			EventManager::Instance()->queue<JoystickAxisEvent>(
 			    l_axis,
 			    l_value, -1, 1,
-			    id()));
-			EventManager::Instance()->queue(l_event);
+			    id());
 		}
 
-		SharedEvent l_event(new JoystickButtonEvent(
+		EventManager::Instance()->queue<JoystickButtonEvent>(
 		    l_btn,
 		    l_action,
 		    m_btn_state,
-		    id()));
-		EventManager::Instance()->queue(l_event);
+		    id());
 	}
 	else if (event.type == EV_ABS) {
 		Map::EventABSInfo::const_iterator l_entry =
@@ -166,13 +164,12 @@ JoystickDevice::handleEvent(struct input_event &event)
 
 		struct input_absinfo *l_absinfo = l_entry->second;
 
-		SharedEvent l_event(new JoystickAxisEvent(
+		EventManager::Instance()->queue<JoystickAxisEvent>(
 		    static_cast<Joystick::Axis>(l_absinfo->value),
 		    event.value,
 		    l_absinfo->minimum,
 		    l_absinfo->maximum,
-		    id()));
-		EventManager::Instance()->queue(l_event);
+		    id());
 	}
 	else return(false);
 	
@@ -229,8 +229,7 @@ KeyboardDevice::handleEvent(struct input_event &event)
 	if (l_prev_action != l_action) {
 		Keyboard::SetKeyState(l_key, l_action);
 
-		SharedEvent l_event(new KeyboardEvent(l_key, l_action, id()));
-		EventManager::Instance()->queue(l_event);
+		EventManager::Instance()->queue<KeyboardEvent>(l_key, l_action, id());
 	}
 
 	return(true);
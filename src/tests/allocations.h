@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2011-2013, Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ * All rights reserved.
+ *
+ * This file is part of Marshmallow Game Engine.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE CONTRIBUTORS ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are
+ * those of the authors and should not be interpreted as representing official
+ * policies, either expressed or implied, of the project as a whole.
+ */
+
+#include <core/global.h>
+#include <core/memory.h>
+
+#include <cstdlib>
+#include <new>
+
+/*!
+ * @file
+ *
+ * Heap allocation counter shared by tests and benchmarks, include from a
+ * single translation unit.
+ *
+ * Replaces global new/delete, unless memory tracking already does, in
+ * which case Core::Memory statistics are summed instead.
+ *
+ * @author Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ */
+
+#if MARSHMALLOW_MEMORY_TRACKING
+
+static inline unsigned long
+TestAllocations(void)
+{
+	namespace Memory = MARSHMALLOW_NAMESPACE::Core::Memory;
+
+	unsigned long l_allocations = 0;
+	for (int l_i = 0; l_i < Memory::Tags; ++l_i)
+		l_allocations += Memory::Stats(static_cast<Memory::Tag>(l_i)).allocations;
+	return(l_allocations);
+}
+
+#define TEST_ALLOCATIONS TestAllocations()
+
+#else
+
+static unsigned long s_allocations = 0;
+
+#define TEST_ALLOCATIONS s_allocations
+
+/*********************************************************** allocation count */
+
+#if MARSHMALLOW_CXX11
+#   define TEST_THROW_BAD_ALLOC
+#else
+#   define TEST_THROW_BAD_ALLOC throw (std::bad_alloc)
+#endif
+
+void *
+operator new(size_t size) TEST_THROW_BAD_ALLOC
+{
+	++s_allocations;
+	return(malloc(size ? size : 1));
+}
+
+void *
+operator new[](size_t size) TEST_THROW_BAD_ALLOC
+{
+	++s_allocations;
+	return(malloc(size ? size : 1));
+}
+
+void
+operator delete(void *ptr) throw ()
+{
+	free(ptr);
+}
+
+void
+operator delete[](void *ptr) throw ()
+{
+	free(ptr);
+}
+
+void
+operator delete(void *ptr, size_t) throw ()
+{
+	operator delete(ptr);
+}
+
+void
+operator delete[](void *ptr, size_t) throw ()
+{
+	operator delete[](ptr);
+}
+
+#endif
@@ -33,7 +33,10 @@
 #include <cstring>
 
 #include "core/base64.h"
+#include "core/base64io.h"
+#include "core/bufferio.h"
 #include "core/global.h"
+#include "core/shared.h"
 
 #include "tests/common.h"
 
@@ -44,6 +47,19 @@ static const char ubase64b[] = "12345";
 static const char  base64c[] = "MTIzNA==";
 static const char ubase64c[] = "1234";
 
+static const char *s_malformed[] = {
+    "MTIzNDU",     /* bad length */
+    "MTIz NDU2",   /* whitespace */
+    "MTI*NDU2",    /* outside alphabet */
+    "MT=zNDU2",    /* padding in the middle */
+    "MTIz=DU2",    /* padding in the middle */
+    "MTIzN===",    /* too much padding */
+    "MTIzNDV=",    /* non-zero leftover bits */
+    "MTIzNB==",    /* non-zero leftover bits */
+    "MTIzNDU2\xC3\xA9" "AA", /* high bytes */
+    0
+};
+
 /*!
  * @file
  *
@@ -70,6 +86,118 @@ base64_decode_test(void)
 	delete[] out;
 }
 
+void
+base64_malformed_test(void)
+{
+	for (const char **l_in = s_malformed; *l_in; ++l_in) {
+		char *out = reinterpret_cast<char *>(1);
+		const size_t l_size = Core::Base64::Decode(*l_in, strlen(*l_in), &out);
+		ASSERT_ZERO(*l_in, l_size);
+		ASSERT_ZERO(*l_in, out);
+	}
+
+	/* an error deep inside a long buffer has to be caught by every kernel */
+	char l_encoded[1024];
+	char l_decoded[768];
+	memset(l_encoded, 'A', sizeof(l_encoded));
+	for (size_t l_i = 0; l_i < sizeof(l_encoded); ++l_i) {
+		const char l_saved = l_encoded[l_i];
+		l_encoded[l_i] = (l_i % 2 ? '-' : '\x80');
+		const bool l_valid =
+		    Core::Base64::DecodeTo(l_encoded, sizeof(l_encoded), l_decoded);
+		l_encoded[l_i] = l_saved;
+		if (l_valid) {
+			ASSERT_FALSE("Core::Base64::DecodeTo() invalid character", l_valid);
+			break;
+		}
+	}
+}
+
+void
+base64_roundtrip_test(void)
+{
+	unsigned char l_data[300];
+	for (size_t l_i = 0; l_i < sizeof(l_data); ++l_i)
+		l_data[l_i] = static_cast<unsigned char>(255 - (l_i * 7) % 256);
+
+	const char *l_in = reinterpret_cast<const char *>(l_data);
+	bool l_passed = true;
+
+	for (size_t l_size = 0; l_size <= sizeof(l_data) && l_passed; ++l_size) {
+		char *l_encoded;
+		const size_t l_encoded_size =
+		    Core::Base64::Encode(l_in, l_size, &l_encoded);
+		l_passed = (l_encoded_size == Core::Base64::EncodedSize(l_size))
+		        && (strlen(l_encoded) == l_encoded_size);
+
+		char *l_decoded;
+		const size_t l_decoded_size =
+		    Core::Base64::Decode(l_encoded, l_encoded_size, &l_decoded);
+		l_passed = l_passed && l_decoded
+		        && (l_decoded_size == l_size + 1)
+		        && (0 == memcmp(l_decoded, l_data, l_size));
+
+		delete[] l_decoded;
+		delete[] l_encoded;
+	}
+
+	ASSERT_TRUE("Core::Base64 binary round-trip", l_passed);
+
+	char l_encoded[400];
+	char l_decoded[300];
+	Core::Base64::EncodeTo(l_in, sizeof(l_data), l_encoded);
+	ASSERT_EQUAL("Core::Base64::DecodedSize()",
+	    Core::Base64::DecodedSize(l_encoded, 400), sizeof(l_data));
+	const bool l_valid = Core::Base64::DecodeTo(l_encoded, 400, l_decoded);
+	ASSERT_TRUE("Core::Base64::DecodeTo()", l_valid);
+	ASSERT_ZERO("Core::Base64::EncodeTo()",
+	    memcmp(l_decoded, l_data, sizeof(l_data)));
+}
+
+void
+base64_stream_test(void)
+{
+	unsigned char l_data[1000];
+	for (size_t l_i = 0; l_i < sizeof(l_data); ++l_i)
+		l_data[l_i] = static_cast<unsigned char>((l_i * 13) % 256);
+
+	char *l_encoded;
+	const size_t l_encoded_size = Core::Base64::Encode
+	    (reinterpret_cast<const char *>(l_data), sizeof(l_data), &l_encoded);
+
+	/* odd window and chunk sizes to split quads across reads */
+	Core::Base64IO l_stream(Core::SharedDataIO(new Core::BufferIO
+	    (static_cast<const void *>(l_encoded), l_encoded_size)), 22);
+
+	unsigned char l_decoded[sizeof(l_data)];
+	size_t l_total = 0;
+	size_t l_read;
+	while ((l_read = l_stream.read(l_decoded + l_total, 7)) > 0)
+		l_total += l_read;
+
+	ASSERT_EQUAL("Core::Base64IO::read() chunked size", l_total, sizeof(l_data));
+	ASSERT_ZERO("Core::Base64IO::read() chunked",
+	    memcmp(l_decoded, l_data, sizeof(l_data)));
+	ASSERT_TRUE("Core::Base64IO::atEOF()", l_stream.atEOF());
+	ASSERT_FALSE("Core::Base64IO::failed()", l_stream.failed());
+
+	const bool l_seek = l_stream.seek(500, Core::DIOSet);
+	ASSERT_TRUE("Core::Base64IO::seek() backward", l_seek);
+	unsigned char l_byte = 0;
+	l_read = l_stream.read(&l_byte, 1);
+	ASSERT_EQUAL("Core::Base64IO::seek() position", l_byte, l_data[500]);
+
+	/* corrupt the middle of the stream */
+	l_encoded[l_encoded_size / 2] = '!';
+	Core::Base64IO l_corrupt(Core::SharedDataIO(new Core::BufferIO
+	    (static_cast<const void *>(l_encoded), l_encoded_size)));
+	l_read = l_corrupt.read(l_decoded, sizeof(l_decoded));
+	ASSERT_TRUE("Core::Base64IO::read() malformed", l_read < sizeof(l_data));
+	ASSERT_TRUE("Core::Base64IO::failed() malformed", l_corrupt.failed());
+
+	delete[] l_encoded;
+}
+
 void
 base64_encode_test(void)
 {
@@ -95,6 +223,9 @@ main(int, char *[])
 
 	RUN_TEST(base64_decode_test);
 	RUN_TEST(base64_encode_test);
+	RUN_TEST(base64_malformed_test);
+	RUN_TEST(base64_roundtrip_test);
+	RUN_TEST(base64_stream_test);
 
 	return(TEST_EXITCODE);
 }
@@ -89,6 +89,11 @@ buffer_readonly_test(void)
 	l_buffer.read(l_scratch, 1);
 	ASSERT_TRUE("Core::BufferIO::atEOF() == TRUE", l_buffer.atEOF());
 
+	ASSERT_EQUAL("Core::BufferIO::view() ZERO-COPY",
+	    l_buffer.view(4, 6), &s_content[4]);
+	ASSERT_ZERO("Core::BufferIO::view() OUT OF BOUNDS",
+	    l_buffer.view(4, s_content_size));
+
 	l_buffer.close();
 	ASSERT_FALSE("Core::BufferIO::close()", l_buffer.isOpen());
 }
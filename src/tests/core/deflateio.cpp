@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2013, Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ * All rights reserved.
+ *
+ * This file is part of Marshmallow Game Engine.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE CONTRIBUTORS ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are
+ * those of the authors and should not be interpreted as representing official
+ * policies, either expressed or implied, of the project as a whole.
+ */
+
+#include <cstring>
+
+#include "core/bufferio.h"
+#include "core/deflateio.h"
+#include "core/fileio.h"
+#include "core/gzip.h"
+#include "core/identifier.h"
+#include "core/shared.h"
+#include "core/zlib.h"
+
+#include "tests/common.h"
+
+/*!
+ * @file
+ *
+ * @author Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ */
+
+MARSHMALLOW_NAMESPACE_USE
+
+static const Core::Identifier s_data_file("core/data/fileio.dat");
+static const Core::Identifier s_deflate_file("core/data/deflateio.dat");
+
+void
+deflateio_file_test(void)
+{
+	char l_content[64];
+	Core::FileIO l_file(s_data_file, Core::DIOReadOnly);
+	const size_t l_content_size = l_file.read(l_content, sizeof(l_content));
+	ASSERT_NOT_ZERO("Core::FileIO::read() TEST DATA", l_content_size);
+
+	Core::SharedFileIO l_sink =
+	    Core::MakeShared<Core::FileIO>(s_deflate_file, Core::DIOTruncate);
+	{
+		Core::DeflateIO l_deflate(l_sink.staticCast<Core::IDataIO>(),
+		    Core::DeflateIO::ZlibFormat,
+		    Core::Zlib::BestCompression, 8);
+		ASSERT_TRUE("Core::DeflateIO::isOpen()", l_deflate.isOpen());
+
+		size_t l_written = l_deflate.write(l_content, 4);
+		l_written += l_deflate.write(l_content + 4, l_content_size - 4);
+		ASSERT_EQUAL("Core::DeflateIO::write()", l_written, l_content_size);
+		ASSERT_EQUAL("Core::DeflateIO::tell()",
+		    size_t(l_deflate.tell()), l_content_size);
+	}
+	const size_t l_compressed_size = l_sink->size();
+	l_sink->close();
+
+	char l_compressed[256];
+	Core::FileIO l_compressed_file(s_deflate_file, Core::DIOReadOnly);
+	const size_t l_read = l_compressed_file.read(l_compressed, sizeof(l_compressed));
+	ASSERT_EQUAL("Core::DeflateIO::close() FINISHED STREAM",
+	    l_read, l_compressed_size);
+
+	char *l_inflated;
+	const size_t l_inflated_size = Core::Zlib::Inflate(l_compressed,
+	    l_compressed_size, l_content_size, &l_inflated);
+	ASSERT_EQUAL("Core::Zlib::Inflate() SIZE", l_inflated_size, l_content_size);
+	ASSERT_ZERO("Core::Zlib::Inflate() CONFIRM DATA OK",
+	    memcmp(l_inflated, l_content, l_content_size));
+	delete[] l_inflated;
+}
+
+void
+deflateio_gzip_test(void)
+{
+	static const size_t s_size = 64 * 1024;
+	char *l_content = new char[s_size];
+	for (size_t l_i = 0; l_i < s_size; ++l_i)
+		l_content[l_i] = static_cast<char>('a' + (l_i * 7) % 13);
+
+	char *l_compressed = new char[s_size];
+	Core::SharedBufferIO l_sink = Core::MakeShared<Core::BufferIO>
+	    (static_cast<void *>(l_compressed), s_size);
+
+	Core::DeflateIO l_deflate(l_sink.staticCast<Core::IDataIO>(),
+	    Core::DeflateIO::GzipFormat);
+	for (size_t l_i = 0; l_i < s_size; l_i += 1000)
+		l_deflate.write(l_content + l_i, l_i + 1000 < s_size ? 1000 : s_size - l_i);
+
+	ASSERT_TRUE("Core::DeflateIO::flush()", l_deflate.flush());
+	l_deflate.close();
+	ASSERT_FALSE("Core::DeflateIO::close()", l_deflate.isOpen());
+
+	char *l_inflated;
+	const size_t l_inflated_size = Core::Gzip::Inflate(l_compressed,
+	    size_t(l_sink->tell()), s_size, &l_inflated);
+	ASSERT_EQUAL("Core::Gzip::Inflate() SIZE", l_inflated_size, s_size);
+	ASSERT_ZERO("Core::Gzip::Inflate() CONFIRM DATA OK",
+	    memcmp(l_inflated, l_content, s_size));
+
+	delete[] l_inflated;
+	delete[] l_compressed;
+	delete[] l_content;
+}
+
+int
+main(int, char *[])
+{
+	MMCHDIR(MARSHMALLOW_TESTS_DIRECTORY);
+
+	RUN_TEST(deflateio_file_test);
+	RUN_TEST(deflateio_gzip_test);
+
+	return(TEST_EXITCODE);
+}
@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2013, Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ * All rights reserved.
+ *
+ * This file is part of Marshmallow Game Engine.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE CONTRIBUTORS ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are
+ * those of the authors and should not be interpreted as representing official
+ * policies, either expressed or implied, of the project as a whole.
+ */
+
+#include <vector>
+
+#include "core/framearena.h"
+
+#include "tests/common.h"
+
+/*!
+ * @file
+ *
+ * @author Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ */
+
+MARSHMALLOW_NAMESPACE_USE
+
+static bool
+Aligned(void *p)
+{
+	return(0 == (reinterpret_cast<size_t>(p) % Core::FrameArena::Alignment));
+}
+
+void
+framearena_allocate_test(void)
+{
+	char *l_a = static_cast<char *>(Core::FrameArena::Allocate(3));
+	char *l_b = static_cast<char *>(Core::FrameArena::Allocate(1));
+	ASSERT_TRUE("Core::FrameArena::Allocate() alignment", Aligned(l_a) && Aligned(l_b));
+	ASSERT_TRUE("Core::FrameArena::Allocate() distinct", l_a != l_b);
+	ASSERT_EQUAL("Core::FrameArena::Used()", Core::FrameArena::Used(),
+	    2 * static_cast<size_t>(Core::FrameArena::Alignment));
+
+	/* survives exactly one swap */
+	*l_a = 'a';
+	Core::FrameArena::Swap();
+	ASSERT_ZERO("Core::FrameArena::Swap() resets", Core::FrameArena::Used());
+	char *l_c = Core::FrameArena::Allocate<char>(1);
+	ASSERT_TRUE("Core::FrameArena::Swap() double buffered", l_c != l_a && *l_a == 'a');
+
+	Core::FrameArena::Swap();
+	char *l_d = Core::FrameArena::Allocate<char>(1);
+	ASSERT_EQUAL("Core::FrameArena::Swap() recycles", l_d, l_a);
+}
+
+void
+framearena_spill_test(void)
+{
+	const size_t l_capacity = Core::FrameArena::Capacity();
+	const unsigned long l_spilled = Core::FrameArena::Spilled();
+
+	/* overflow the current frame */
+	void *l_big = Core::FrameArena::Allocate(l_capacity + 1);
+	ASSERT_TRUE("Core::FrameArena::Allocate() spill", l_big && Aligned(l_big));
+	ASSERT_EQUAL("Core::FrameArena::Spilled()", Core::FrameArena::Spilled(), l_spilled + 1);
+
+	/* buffer grows when it comes around again */
+	Core::FrameArena::Swap();
+	Core::FrameArena::Swap();
+	ASSERT_TRUE("Core::FrameArena::Capacity() grown", Core::FrameArena::Capacity() > l_capacity);
+
+	Core::FrameArena::Allocate(l_capacity + 1);
+	ASSERT_EQUAL("Core::FrameArena no spill after growth", Core::FrameArena::Spilled(), l_spilled + 1);
+}
+
+void
+framearena_allocator_test(void)
+{
+	typedef std::vector<int, Core::FrameAllocator<int> > FrameVector;
+
+	Core::FrameArena::Swap();
+
+	FrameVector l_vector;
+	for (int l_i = 0; l_i < 1000; ++l_i)
+		l_vector.push_back(l_i);
+
+	bool l_valid = true;
+	for (int l_i = 0; l_i < 1000; ++l_i)
+		l_valid &= (l_vector[static_cast<size_t>(l_i)] == l_i);
+	ASSERT_TRUE("Core::FrameAllocator std::vector", l_valid);
+	ASSERT_NOT_ZERO("Core::FrameAllocator uses arena", Core::FrameArena::Used());
+}
+
+int
+main(int, char *[])
+{
+	RUN_TEST(framearena_allocate_test);
+	RUN_TEST(framearena_spill_test);
+	RUN_TEST(framearena_allocator_test);
+
+	Core::FrameArena::Release();
+
+	return(TEST_EXITCODE);
+}
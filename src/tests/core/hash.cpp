@@ -34,6 +34,9 @@
 #include "core/hash.h"
 #include "core/strhash.h"
 
+#include <cstring>
+#include <string>
+
 #include "tests/common.h"
 
 /*!
@@ -61,6 +64,67 @@ strhash_compare_test(void)
 	    Core::StrHash("tset"), Core::StrHash("test"));
 }
 
+void
+hash_algorithm_test(void)
+{
+#if MARSHMALLOW_LEGACY_HASH
+	const MMUID l_check = 0xC66B58C5;
+#else
+	const MMUID l_check = 0xAC7081CC; /* mixed crc32c check value */
+#endif
+	ASSERT_EQUAL("Core::Hash::Algorithm() '123456789'",
+	    Core::Hash::Algorithm("123456789", 9, ~static_cast<MMUID>(0)), l_check);
+	ASSERT_EQUAL("Core::Hash::LegacyAlgorithm() '123456789'",
+	    Core::Hash::LegacyAlgorithm("123456789", 9, ~static_cast<MMUID>(0)),
+	    static_cast<MMUID>(0xC66B58C5));
+	ASSERT_ZERO("Core::Hash::Algorithm() EMPTY",
+	    Core::Hash::Algorithm("", 0, ~static_cast<MMUID>(0)));
+
+	/* word-at-a-time paths must not depend on alignment or tail length */
+	char l_buffer[80];
+	char l_shifted[88];
+	for (size_t l_i = 0; l_i < sizeof(l_buffer); ++l_i)
+		l_buffer[l_i] = static_cast<char>(l_i * 37 + 11);
+
+	bool l_aligned = true;
+	for (size_t l_o = 1; l_o < 8; ++l_o) {
+		memcpy(l_shifted + l_o, l_buffer, sizeof(l_buffer));
+		for (size_t l_n = 0; l_n <= sizeof(l_buffer); ++l_n)
+			if (Core::Hash::Algorithm(l_buffer, l_n, ~static_cast<MMUID>(0))
+			    != Core::Hash::Algorithm(l_shifted + l_o, l_n, ~static_cast<MMUID>(0)))
+				l_aligned = false;
+	}
+	ASSERT_TRUE("Core::Hash::Algorithm() UNALIGNED", l_aligned);
+}
+
+void
+hash_literal_test(void)
+{
+	ASSERT_EQUAL("MMHASH() EQUAL TO Core::Hash::Algorithm()",
+	    MMHASH("Game::PositionComponent"),
+	    Core::Hash::Algorithm("Game::PositionComponent", 23,
+	        ~static_cast<MMUID>(0)));
+	ASSERT_EQUAL("MMHASH() 'test' EQUAL TO Core::StrHash() 'test'",
+	    MMHASH("test"), Core::StrHash("test").uid());
+}
+
+void
+strhash_intern_test(void)
+{
+	Core::StrHash l_a("intern");
+	Core::StrHash l_b(std::string("intern"));
+	Core::StrHash l_c("intern", MMHASH("intern"));
+	ASSERT_EQUAL("Core::StrHash() interned", &l_a.str(), &l_b.str());
+	ASSERT_EQUAL("Core::StrHash() precomputed interned", &l_a.str(), &l_c.str());
+	ASSERT_EQUAL("Core::StrHash() precomputed", l_a, l_c);
+
+	Core::StrHash l_copy;
+	ASSERT_TRUE("Core::StrHash() empty", l_copy.str().empty());
+	l_copy = l_a;
+	ASSERT_EQUAL("Core::StrHash::operator=()", &l_copy.str(), &l_a.str());
+	ASSERT_EQUAL("Core::StrHash::operator=() 'intern'", l_copy.str(), "intern");
+}
+
 
 int
 main(int, char *[])
@@ -69,6 +133,9 @@ main(int, char *[])
 
 	RUN_TEST(hash_compare_test);
 	RUN_TEST(strhash_compare_test);
+	RUN_TEST(hash_algorithm_test);
+	RUN_TEST(hash_literal_test);
+	RUN_TEST(strhash_intern_test);
 
 	return(TEST_EXITCODE);
 }
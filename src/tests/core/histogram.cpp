@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2013, Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ * All rights reserved.
+ *
+ * This file is part of Marshmallow Game Engine.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE CONTRIBUTORS ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are
+ * those of the authors and should not be interpreted as representing official
+ * policies, either expressed or implied, of the project as a whole.
+ */
+#include <cstdio>
+
+#include "core/histogram.h"
+
+#include "tests/common.h"
+
+/*!
+ * @file
+ *
+ * @author Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ */
+
+MARSHMALLOW_NAMESPACE_USE
+
+void
+histogram_bucket_test(void)
+{
+	/* small values are exact */
+	bool l_exact = true;
+	for (int64_t l_i = 0; l_i < 2 * Core::Histogram::SubBuckets; ++l_i)
+		l_exact &= (Core::Histogram::BucketLowest(Core::Histogram::BucketOf(l_i)) == l_i)
+		        && (Core::Histogram::BucketHighest(Core::Histogram::BucketOf(l_i)) == l_i);
+	ASSERT_TRUE("Core::Histogram exact range", l_exact);
+
+	/* buckets are contiguous and keep relative precision */
+	bool l_contiguous = true;
+	bool l_precise = true;
+	for (size_t l_b = 1; l_b < 10000; ++l_b) {
+		const int64_t l_low = Core::Histogram::BucketLowest(l_b);
+		const int64_t l_high = Core::Histogram::BucketHighest(l_b);
+		l_contiguous &= (l_low == Core::Histogram::BucketHighest(l_b - 1) + 1);
+		l_contiguous &= (Core::Histogram::BucketOf(l_low) == l_b)
+		             && (Core::Histogram::BucketOf(l_high) == l_b);
+		l_precise &= (l_high - l_low) * Core::Histogram::SubBuckets <= l_low;
+	}
+	ASSERT_TRUE("Core::Histogram contiguous buckets", l_contiguous);
+	ASSERT_TRUE("Core::Histogram bucket precision", l_precise);
+
+	ASSERT_EQUAL("Core::Histogram top bucket",
+	    Core::Histogram::BucketHighest(Core::Histogram::BucketOf(MMTICK_MAX)), MMTICK_MAX);
+}
+
+void
+histogram_percentile_test(void)
+{
+	Core::Histogram l_histogram(1000000);
+
+	ASSERT_ZERO("Core::Histogram::percentile() empty", l_histogram.percentile(50.));
+
+	/* 1..10000 uniformly */
+	for (int64_t l_i = 1; l_i <= 10000; ++l_i)
+		l_histogram.record(l_i);
+
+	ASSERT_EQUAL("Core::Histogram::count()", l_histogram.count(), 10000u);
+	ASSERT_TRUE("Core::Histogram::mean()",
+	    l_histogram.mean() > 5000.4 && l_histogram.mean() < 5000.6);
+	ASSERT_EQUAL("Core::Histogram::minimum()", l_histogram.minimum(), 1);
+
+	const int64_t l_p50 = l_histogram.percentile(50.);
+	const int64_t l_p99 = l_histogram.percentile(99.);
+	const int64_t l_max = l_histogram.maximum();
+	ASSERT_TRUE("Core::Histogram::percentile(50)", l_p50 >= 5000 && l_p50 <= 5000 + 5000 / Core::Histogram::SubBuckets);
+	ASSERT_TRUE("Core::Histogram::percentile(99)", l_p99 >= 9900 && l_p99 <= 9900 + 9900 / Core::Histogram::SubBuckets);
+	ASSERT_EQUAL("Core::Histogram::maximum()", l_max, 10000);
+	ASSERT_EQUAL("Core::Histogram::percentile(100)", l_histogram.percentile(100.), l_max);
+
+	/* clamping */
+	l_histogram.record(5000000);
+	ASSERT_EQUAL("Core::Histogram clamped maximum", l_histogram.maximum(), 1000000);
+	l_histogram.remove(5000000);
+
+	/* removing restores the previous distribution */
+	for (int64_t l_i = 5001; l_i <= 10000; ++l_i)
+		l_histogram.remove(l_i);
+	ASSERT_EQUAL("Core::Histogram::remove()", l_histogram.count(), 5000u);
+	const int64_t l_p100 = l_histogram.percentile(100.);
+	ASSERT_TRUE("Core::Histogram::remove() maximum", l_p100 >= 5000 && l_p100 <= 5000 + 5000 / Core::Histogram::SubBuckets);
+	ASSERT_EQUAL("Core::Histogram::countAbove()", l_histogram.countAbove(2 * Core::Histogram::SubBuckets - 1),
+	    5000u - 2 * Core::Histogram::SubBuckets + 1);
+
+	l_histogram.reset();
+	ASSERT_ZERO("Core::Histogram::reset()", l_histogram.count());
+	ASSERT_ZERO("Core::Histogram::reset() maximum", l_histogram.maximum());
+}
+
+void
+histogram_merge_test(void)
+{
+	Core::Histogram l_a(1000);
+	Core::Histogram l_b(1000);
+
+	l_a.record(10, 3);
+	l_b.record(900, 1);
+	l_a.merge(l_b);
+
+	ASSERT_EQUAL("Core::Histogram::merge() count", l_a.count(), 4u);
+	ASSERT_EQUAL("Core::Histogram::merge() p75", l_a.percentile(75.), 10);
+	ASSERT_TRUE("Core::Histogram::merge() maximum", l_a.maximum() >= 900);
+}
+
+int
+main(void)
+{
+	RUN_TEST(histogram_bucket_test);
+	RUN_TEST(histogram_percentile_test);
+	RUN_TEST(histogram_merge_test);
+
+	return(TEST_EXITCODE);
+}
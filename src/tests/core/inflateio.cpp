@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2013, Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ * All rights reserved.
+ *
+ * This file is part of Marshmallow Game Engine.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE CONTRIBUTORS ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are
+ * those of the authors and should not be interpreted as representing official
+ * policies, either expressed or implied, of the project as a whole.
+ */
+
+#include <cstring>
+
+#include "core/bufferio.h"
+#include "core/fileio.h"
+#include "core/gzip.h"
+#include "core/identifier.h"
+#include "core/inflateio.h"
+#include "core/shared.h"
+#include "core/zlib.h"
+
+#include "tests/common.h"
+
+/*!
+ * @file
+ *
+ * @author Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ */
+
+MARSHMALLOW_NAMESPACE_USE
+
+static const Core::Identifier s_data_file("core/data/fileio.dat");
+static const size_t s_large_size = 256 * 1024;
+
+static void
+FillPattern(char *buffer, size_t size)
+{
+	uint32_t l_seed = 0x1234;
+	for (size_t l_i = 0; l_i < size; ++l_i) {
+		l_seed = l_seed * 1103515245 + 12345;
+		buffer[l_i] = static_cast<char>('a' + (l_seed >> 16) % 8);
+	}
+}
+
+void
+inflateio_zlib_test(void)
+{
+	char l_content[64];
+	Core::FileIO l_file(s_data_file, Core::DIOReadOnly);
+	const size_t l_content_size = l_file.read(l_content, sizeof(l_content));
+	ASSERT_NOT_ZERO("Core::FileIO::read() TEST DATA", l_content_size);
+
+	char *l_compressed;
+	const size_t l_compressed_size =
+	    Core::Zlib::Deflate(l_content, l_content_size, &l_compressed);
+
+	Core::InflateIO l_inflate(Core::SharedDataIO(new Core::BufferIO
+	    (static_cast<const void *>(l_compressed), l_compressed_size)), 4);
+	ASSERT_TRUE("Core::InflateIO::isOpen()", l_inflate.isOpen());
+
+	char l_scratch[64];
+	size_t l_read = l_inflate.read(l_scratch, sizeof(l_scratch));
+	ASSERT_EQUAL("Core::InflateIO::read() ALL BYTES", l_read, l_content_size);
+	ASSERT_ZERO("Core::InflateIO::read() CONFIRM DATA OK",
+	    memcmp(l_scratch, l_content, l_content_size));
+	ASSERT_TRUE("Core::InflateIO::atEOF() == TRUE", l_inflate.atEOF());
+	ASSERT_EQUAL("Core::InflateIO::size()", l_inflate.size(), l_content_size);
+
+	bool l_seeked = l_inflate.seek(5, Core::DIOSet);
+	ASSERT_TRUE("Core::InflateIO::seek() BACKWARD", l_seeked);
+	ASSERT_EQUAL("Core::InflateIO::tell() CONFIRM NEW POSITION", 5, l_inflate.tell());
+	l_read = l_inflate.read(l_scratch, 4);
+	ASSERT_EQUAL("Core::InflateIO::read() 4 BYTES", l_read, 4);
+	ASSERT_ZERO("Core::InflateIO::read() CONFIRM DATA OK",
+	    memcmp(l_scratch, &l_content[5], 4));
+	ASSERT_FALSE("Core::InflateIO::atEOF() == FALSE", l_inflate.atEOF());
+
+	l_seeked = l_inflate.seek(-3, Core::DIOEnd);
+	ASSERT_TRUE("Core::InflateIO::seek() -3 BYTES FROM END", l_seeked);
+	l_read = l_inflate.read(l_scratch, 3);
+	ASSERT_ZERO("Core::InflateIO::read() CONFIRM DATA OK",
+	    memcmp(l_scratch, &l_content[l_content_size - 3], 3));
+
+	l_seeked = l_inflate.seek(1, Core::DIOEnd);
+	ASSERT_FALSE("Core::InflateIO::seek() PAST END", l_seeked);
+
+	l_inflate.close();
+	ASSERT_FALSE("Core::InflateIO::close()", l_inflate.isOpen());
+
+	delete[] l_compressed;
+}
+
+void
+inflateio_gzip_test(void)
+{
+	char *l_content = new char[s_large_size];
+	FillPattern(l_content, s_large_size);
+
+	char *l_compressed;
+	const size_t l_compressed_size =
+	    Core::Gzip::Deflate(l_content, s_large_size, &l_compressed);
+
+	/* compressed data doesn't have to start at the beginning */
+	char *l_framed = new char[l_compressed_size + 3];
+	memcpy(l_framed, "abc", 3);
+	memcpy(l_framed + 3, l_compressed, l_compressed_size);
+	Core::SharedDataIO l_source(new Core::BufferIO
+	    (static_cast<const void *>(l_framed), l_compressed_size + 3));
+	l_source->seek(3, Core::DIOSet);
+
+	Core::InflateIO l_inflate(l_source, 512);
+	ASSERT_TRUE("Core::InflateIO::isOpen() GZIP", l_inflate.isOpen());
+
+	char *l_scratch = new char[s_large_size];
+	size_t l_total = 0;
+	size_t l_read;
+	while ((l_read = l_inflate.read(l_scratch + l_total, 1000)) > 0)
+		l_total += l_read;
+	ASSERT_EQUAL("Core::InflateIO::read() CHUNKED", l_total, s_large_size);
+	ASSERT_ZERO("Core::InflateIO::read() CONFIRM DATA OK",
+	    memcmp(l_scratch, l_content, s_large_size));
+
+	const bool l_seeked = l_inflate.seek(100000, Core::DIOSet);
+	ASSERT_TRUE("Core::InflateIO::seek() REWIND", l_seeked);
+	l_read = l_inflate.read(l_scratch, 16);
+	ASSERT_ZERO("Core::InflateIO::read() CONFIRM DATA OK",
+	    memcmp(l_scratch, l_content + 100000, 16));
+
+	delete[] l_scratch;
+	delete[] l_framed;
+	delete[] l_compressed;
+	delete[] l_content;
+}
+
+void
+inflateio_corrupt_test(void)
+{
+	static const char s_garbage[] = "this is not a zlib stream";
+	Core::InflateIO l_inflate(Core::SharedDataIO(new Core::BufferIO
+	    (static_cast<const void *>(s_garbage), sizeof(s_garbage))));
+
+	char l_scratch[64];
+	const size_t l_read = l_inflate.read(l_scratch, sizeof(l_scratch));
+	ASSERT_ZERO("Core::InflateIO::read() CORRUPT", l_read);
+	ASSERT_TRUE("Core::InflateIO::atEOF() CORRUPT", l_inflate.atEOF());
+}
+
+int
+main(int, char *[])
+{
+	MMCHDIR(MARSHMALLOW_TESTS_DIRECTORY);
+
+	RUN_TEST(inflateio_zlib_test);
+	RUN_TEST(inflateio_gzip_test);
+	RUN_TEST(inflateio_corrupt_test);
+
+	return(TEST_EXITCODE);
+}
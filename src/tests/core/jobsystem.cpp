@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2013, Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ * All rights reserved.
+ *
+ * This file is part of Marshmallow Game Engine.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE CONTRIBUTORS ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are
+ * those of the authors and should not be interpreted as representing official
+ * policies, either expressed or implied, of the project as a whole.
+ */
+#include <cstdio>
+#include <vector>
+
+#include "core/jobsystem.h"
+
+#include "tests/common.h"
+
+/*!
+ * @file
+ *
+ * @author Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ */
+
+MARSHMALLOW_NAMESPACE_USE
+
+static const size_t s_elements = 100000;
+static volatile long s_counter = 0;
+
+static void
+Visit(void *c, size_t b, size_t e)
+{
+	int *l_visits = static_cast<int *>(c);
+	for (size_t l_i = b; l_i < e; ++l_i)
+		++l_visits[l_i];
+}
+
+static void
+Count(void *)
+{
+	MMATOMIC_INCREMENT(s_counter);
+}
+
+/*
+ * Spawns children down to depth zero, every node counts itself
+ */
+struct Node
+{
+	Core::JobSystem::Job *self;
+	int depth;
+};
+
+static void
+Spawn(void *c)
+{
+	Node *l_node = static_cast<Node *>(c);
+	MMATOMIC_INCREMENT(s_counter);
+
+	if (l_node->depth <= 0) {
+		delete l_node;
+		return;
+	}
+
+	for (int l_i = 0; l_i < 2; ++l_i) {
+		Node *l_child = new Node;
+		l_child->depth = l_node->depth - 1;
+		l_child->self = Core::JobSystem::Create(Spawn, l_child, l_node->self);
+		Core::JobSystem::Run(l_child->self);
+	}
+
+	delete l_node;
+}
+
+static bool
+ParallelForVisitsOnce(void)
+{
+	std::vector<int> l_visits(s_elements, 0);
+	Core::JobSystem::ParallelFor(s_elements, Visit, &l_visits[0]);
+
+	for (size_t l_i = 0; l_i < s_elements; ++l_i)
+		if (l_visits[l_i] != 1)
+			return(false);
+	return(true);
+}
+
+void
+jobsystem_inactive_test(void)
+{
+	ASSERT_FALSE("Core::JobSystem::Active()", Core::JobSystem::Active());
+	ASSERT_EQUAL("Core::JobSystem::Threads()", Core::JobSystem::Threads(), 1);
+
+	/* runs inline */
+	s_counter = 0;
+	Core::JobSystem::Job *l_job = Core::JobSystem::Create(Count, 0);
+	Core::JobSystem::Run(l_job);
+	ASSERT_EQUAL("Core::JobSystem::Run() inline", s_counter, 1);
+	ASSERT_TRUE("Core::JobSystem::Finished()", Core::JobSystem::Finished(l_job));
+
+	ASSERT_TRUE("Core::JobSystem::ParallelFor() inline", ParallelForVisitsOnce());
+}
+
+void
+jobsystem_parallelfor_test(void)
+{
+	ASSERT_TRUE("Core::JobSystem::ParallelFor()", ParallelForVisitsOnce());
+
+	/* uneven ranges and tiny counts */
+	std::vector<int> l_visits(7, 0);
+	Core::JobSystem::ParallelFor(7, Visit, &l_visits[0], 2);
+	bool l_once = true;
+	for (size_t l_i = 0; l_i < l_visits.size(); ++l_i)
+		l_once &= (l_visits[l_i] == 1);
+	ASSERT_TRUE("Core::JobSystem::ParallelFor() grain", l_once);
+}
+
+void
+jobsystem_forkjoin_test(void)
+{
+	/* flat, enough rounds to recycle the job ring */
+	s_counter = 0;
+	for (int l_round = 0; l_round < 20; ++l_round) {
+		Core::JobSystem::Job *l_root = Core::JobSystem::Create(0, 0);
+		for (int l_i = 0; l_i < 1000; ++l_i)
+			Core::JobSystem::Run(Core::JobSystem::Create(Count, 0, l_root));
+		Core::JobSystem::Run(l_root);
+		Core::JobSystem::Wait(l_root);
+	}
+	ASSERT_EQUAL("Core::JobSystem fork-join", s_counter, 20000);
+
+	/* nested, children created from inside jobs */
+	s_counter = 0;
+	Node *l_node = new Node;
+	l_node->depth = 10;
+	l_node->self = Core::JobSystem::Create(Spawn, l_node);
+	Core::JobSystem::Job *l_root = l_node->self;
+	Core::JobSystem::Run(l_root);
+	Core::JobSystem::Wait(l_root);
+	ASSERT_EQUAL("Core::JobSystem nested fork-join", s_counter, (1 << 11) - 1);
+}
+
+int
+main(int, char *[])
+{
+	RUN_TEST(jobsystem_inactive_test);
+
+	ASSERT_TRUE("Core::JobSystem::Initialize()", Core::JobSystem::Initialize(3));
+	ASSERT_EQUAL("Core::JobSystem::Threads() initialized", Core::JobSystem::Threads(), 4);
+
+	RUN_TEST(jobsystem_parallelfor_test);
+	RUN_TEST(jobsystem_forkjoin_test);
+
+	Core::JobSystem::Finalize();
+	ASSERT_FALSE("Core::JobSystem::Finalize()", Core::JobSystem::Active());
+
+	return(TEST_EXITCODE);
+}
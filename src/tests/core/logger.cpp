@@ -0,0 +1,214 @@
+/*
+ * Copyright (c) 2013, Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ * All rights reserved.
+ *
+ * This file is part of Marshmallow Game Engine.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE CONTRIBUTORS ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are
+ * those of the authors and should not be interpreted as representing official
+ * policies, either expressed or implied, of the project as a whole.
+ */
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "core/logger.h"
+
+#include "core/thread_p.h"
+
+#include "tests/common.h"
+
+#include <string>
+
+/*!
+ * @file
+ *
+ * @author Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ */
+
+MARSHMALLOW_NAMESPACE_USE
+
+static const int s_threads = 4;
+static const int s_messages = 200;
+
+static std::string s_captured;
+static volatile int s_block = 0;
+static volatile int s_blocked = 0;
+
+static void
+CaptureSink(const char *text, size_t length)
+{
+	s_blocked = s_block;
+	while (s_block)
+		Core::Thread::Sleep(1);
+
+	s_captured.append(text, length);
+}
+
+static bool
+Captured(const char *text)
+{
+	return(s_captured.find(text) != std::string::npos);
+}
+
+static void
+ThreadMain(void *context)
+{
+	const int l_thread = *static_cast<int *>(context);
+	for (int l_i = 0; l_i < s_messages; ++l_i)
+		MMERROR("thread " << l_thread << " message " << l_i << ';');
+}
+
+void
+logger_format_test(void)
+{
+	s_captured.clear();
+
+	MMERROR("value " << 42 << ' ' << 1.5 << ' ' << std::string("text"));
+	ASSERT_TRUE("Core::Logger level tag", Captured("[ERROR]"));
+	ASSERT_TRUE("Core::Logger message", Captured("value 42 1.5 text"));
+	ASSERT_TRUE("Core::Logger source location", Captured("logger.cpp:"));
+
+	s_captured.clear();
+
+	MMERROR(std::string(Core::Logger::Record::Capacity * 2, 'x'));
+	const std::string l_full(Core::Logger::Record::Capacity, 'x');
+	ASSERT_TRUE("Core::Logger truncation", Captured((l_full + "...").c_str()));
+	ASSERT_FALSE("Core::Logger truncation bound", Captured((l_full + "x").c_str()));
+}
+
+void
+logger_filter_test(void)
+{
+	s_captured.clear();
+
+	Core::Logger::SetThreshold(Core::Logger::ErrorLevel);
+	MMLOG("WARN", "below threshold");
+	MMERROR("above threshold");
+	Core::Logger::SetThreshold(Core::Logger::VerboseLevel);
+
+	ASSERT_FALSE("Core::Logger::SetThreshold() filters", Captured("below threshold"));
+	ASSERT_TRUE("Core::Logger::SetThreshold() passes", Captured("above threshold"));
+
+	s_captured.clear();
+
+	Core::Logger::SetSubsystem("tests", false);
+	MMERROR("disabled subsystem");
+	const bool l_other =
+	    Core::Logger::Enabled(Core::Logger::ErrorLevel, "/x/src/graphics/y.cpp");
+	const bool l_self =
+	    Core::Logger::Enabled(Core::Logger::ErrorLevel, __FILE__);
+	Core::Logger::SetSubsystem("tests", true);
+	MMERROR("enabled subsystem");
+
+	ASSERT_FALSE("Core::Logger::SetSubsystem() filters", Captured("disabled subsystem"));
+	ASSERT_TRUE("Core::Logger::SetSubsystem() other subsystem", l_other);
+	ASSERT_FALSE("Core::Logger::SetSubsystem() own subsystem", l_self);
+	ASSERT_TRUE("Core::Logger::SetSubsystem() re-enabled", Captured("enabled subsystem"));
+}
+
+void
+logger_threads_test(void)
+{
+	s_captured.clear();
+	Core::Logger::SetAsynchronous(true);
+
+	const unsigned long l_dropped = Core::Logger::Dropped();
+
+	int l_ids[s_threads];
+	Core::Thread::Handle *l_handles[s_threads];
+	for (int l_t = 0; l_t < s_threads; ++l_t) {
+		l_ids[l_t] = l_t;
+		l_handles[l_t] = Core::Thread::Start(ThreadMain, &l_ids[l_t]);
+	}
+
+	for (int l_t = 0; l_t < s_threads; ++l_t)
+		Core::Thread::Join(l_handles[l_t]);
+
+	Core::Logger::Flush();
+
+	/* every message arrives, in order per thread */
+	int l_received = 0;
+	bool l_ordered = true;
+	for (int l_t = 0; l_t < s_threads; ++l_t) {
+		size_t l_pos = 0;
+		for (int l_i = 0; l_i < s_messages; ++l_i) {
+			char l_text[64];
+			sprintf(l_text, "thread %d message %d;", l_t, l_i);
+			const size_t l_found = s_captured.find(l_text);
+			if (l_found == std::string::npos)
+				continue;
+			l_ordered &= (l_found >= l_pos);
+			l_pos = l_found;
+			++l_received;
+		}
+	}
+
+	const unsigned long l_lost = Core::Logger::Dropped() - l_dropped;
+	ASSERT_EQUAL("Core::Logger threads received",
+	    static_cast<unsigned long>(l_received) + l_lost,
+	    static_cast<unsigned long>(s_threads * s_messages));
+	ASSERT_TRUE("Core::Logger threads ordered", l_ordered);
+}
+
+void
+logger_drop_test(void)
+{
+	s_captured.clear();
+	Core::Logger::SetAsynchronous(true);
+
+	const unsigned long l_dropped = Core::Logger::Dropped();
+
+	/* stall the writer inside the sink */
+	s_block = 1;
+	MMERROR("stall");
+	while (!s_blocked)
+		Core::Thread::Sleep(1);
+
+	const std::string l_long(Core::Logger::Record::Capacity, 'd');
+	for (int l_i = 0; l_i < 1000; ++l_i)
+		MMERROR(l_long);
+
+	s_block = 0;
+	Core::Logger::Flush();
+
+	const bool l_reported = Captured("log messages dropped");
+	ASSERT_TRUE("Core::Logger::Dropped() counts", Core::Logger::Dropped() > l_dropped);
+	ASSERT_TRUE("Core::Logger drop report", l_reported);
+}
+
+int
+main(void)
+{
+	Core::Logger::SetSink(CaptureSink);
+	Core::Logger::SetAsynchronous(false);
+
+	RUN_TEST(logger_format_test);
+	RUN_TEST(logger_filter_test);
+	RUN_TEST(logger_threads_test);
+	RUN_TEST(logger_drop_test);
+
+	Core::Logger::SetSink(0);
+	return(TEST_EXITCODE);
+}
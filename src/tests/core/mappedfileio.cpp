@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2013, Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ * All rights reserved.
+ *
+ * This file is part of Marshmallow Game Engine.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE CONTRIBUTORS ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are
+ * those of the authors and should not be interpreted as representing official
+ * policies, either expressed or implied, of the project as a whole.
+ */
+
+#include <cstring>
+
+#include "core/fileio.h"
+#include "core/identifier.h"
+#include "core/mappedfileio.h"
+
+#include "tests/common.h"
+
+/*!
+ * @file
+ *
+ * @author Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ */
+
+MARSHMALLOW_NAMESPACE_USE
+
+static const char s_content[] = "this is a test!";
+static const size_t s_content_size = sizeof(s_content);
+static const Core::Identifier s_data_file("core/data/mappedfileio.dat");
+
+void
+mappedfileio_readonly_test(void)
+{
+	char l_scratch[s_content_size];
+
+	{
+		Core::FileIO l_file(s_data_file, Core::DIOTruncate);
+		const size_t l_written = l_file.write(s_content, s_content_size);
+		ASSERT_EQUAL("Core::FileIO::write() WRITE TEST DATA",
+		    l_written, s_content_size);
+	}
+
+	Core::MappedFileIO l_file(s_data_file, Core::DIOReadOnly);
+	ASSERT_TRUE("Core::MappedFileIO::open()", l_file.isOpen());
+	if (!l_file.isOpen()) return;
+
+	ASSERT_EQUAL("Core::MappedFileIO::size() CONFIRM", s_content_size, l_file.size());
+	ASSERT_TRUE("Core::MappedFileIO::advise() SEQUENTIAL",
+	    l_file.advise(Core::DIOAdviceSequential));
+	ASSERT_TRUE("Core::MappedFileIO::advise() WILLNEED RANGE",
+	    l_file.advise(Core::DIOAdviceWillNeed, 5, 4));
+
+	size_t l_read = l_file.read(l_scratch, s_content_size);
+	ASSERT_EQUAL("Core::MappedFileIO::read() ALL BYTES", s_content_size, l_read);
+	ASSERT_ZERO("Core::MappedFileIO::read() CONFIRM DATA OK",
+	    strncmp(l_scratch, s_content, s_content_size));
+	ASSERT_FALSE("Core::MappedFileIO::isEOF() == FALSE", l_file.atEOF());
+
+	l_read = l_file.read(l_scratch, 1);
+	ASSERT_ZERO("Core::MappedFileIO::read() FAIL/EOF", l_read);
+	ASSERT_TRUE("Core::MappedFileIO::isEOF() == TRUE", l_file.atEOF());
+
+	bool l_seeked = l_file.seek(-6, Core::DIOCurrent);
+	ASSERT_TRUE("Core::MappedFileIO::seek() -6 BYTES FROM CURRENT", l_seeked);
+	ASSERT_EQUAL("Core::MappedFileIO::tell() CONFIRM NEW POSITION",
+	    s_content_size -6, l_file.tell());
+	l_read = l_file.read(l_scratch, 6);
+	ASSERT_EQUAL("Core::MappedFileIO::read() 6 BYTES", l_read, 6);
+	ASSERT_ZERO("Core::MappedFileIO::read() CONFIRM DATA OK",
+	    strcmp(l_scratch, &s_content[s_content_size -6]));
+
+	l_seeked = l_file.seek(1, Core::DIOEnd);
+	ASSERT_FALSE("Core::MappedFileIO::seek() PAST END", l_seeked);
+
+	const size_t l_written = l_file.write(s_content, s_content_size);
+	ASSERT_ZERO("Core::MappedFileIO::write() READ-ONLY", l_written);
+
+	l_file.close();
+	ASSERT_FALSE("Core::MappedFileIO::close()", l_file.isOpen());
+
+	Core::MappedFileIO l_writable(s_data_file, Core::DIOReadWrite);
+	ASSERT_FALSE("Core::MappedFileIO::open() WRITE", l_writable.isOpen());
+}
+
+void
+mappedfileio_view_test(void)
+{
+	Core::MappedFileIO l_file(s_data_file);
+	ASSERT_TRUE("Core::MappedFileIO::open()", l_file.isOpen());
+	if (!l_file.isOpen()) return;
+
+	const char *l_view =
+	    static_cast<const char *>(l_file.view(0, s_content_size));
+	ASSERT_NOT_ZERO("Core::MappedFileIO::view() ALL BYTES", l_view);
+	if (l_view) ASSERT_ZERO("Core::MappedFileIO::view() CONFIRM DATA OK",
+	    memcmp(l_view, s_content, s_content_size));
+
+	l_view = static_cast<const char *>(l_file.view(10, 6));
+	ASSERT_NOT_ZERO("Core::MappedFileIO::view() OFFSET", l_view);
+	if (l_view) ASSERT_ZERO("Core::MappedFileIO::view() CONFIRM DATA OK",
+	    memcmp(l_view, &s_content[10], 6));
+
+	ASSERT_ZERO("Core::MappedFileIO::view() OUT OF BOUNDS",
+	    l_file.view(10, s_content_size));
+	ASSERT_ZERO("Core::MappedFileIO::tell() UNCHANGED", l_file.tell());
+
+	/* same mapping through the interface */
+	Core::IDataIO &l_dio = l_file;
+	ASSERT_EQUAL("Core::IDataIO::view()",
+	    l_dio.view(1, 1), l_file.view(1, 1));
+}
+
+int
+main(int, char *[])
+{
+	MMCHDIR(MARSHMALLOW_TESTS_DIRECTORY);
+
+	RUN_TEST(mappedfileio_readonly_test);
+	RUN_TEST(mappedfileio_view_test);
+
+	return(TEST_EXITCODE);
+}
@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2013, Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ * All rights reserved.
+ *
+ * This file is part of Marshmallow Game Engine.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE CONTRIBUTORS ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are
+ * those of the authors and should not be interpreted as representing official
+ * policies, either expressed or implied, of the project as a whole.
+ */
+
+#include "core/memory.h"
+
+#include "tests/common.h"
+
+/*!
+ * @file
+ *
+ * @author Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ */
+
+MARSHMALLOW_NAMESPACE_USE
+
+void
+memory_scope_test(void)
+{
+	ASSERT_EQUAL("Core::Memory::Current() default",
+	    Core::Memory::Current(), Core::Memory::UntaggedMemory);
+	{
+		Core::Memory::Scope l_graphics(Core::Memory::GraphicsMemory);
+		ASSERT_EQUAL("Core::Memory::Scope", Core::Memory::Current(), Core::Memory::GraphicsMemory);
+		{
+			Core::Memory::Scope l_audio(Core::Memory::AudioMemory);
+			ASSERT_EQUAL("Core::Memory::Scope nested", Core::Memory::Current(), Core::Memory::AudioMemory);
+		}
+		ASSERT_EQUAL("Core::Memory::Scope restore", Core::Memory::Current(), Core::Memory::GraphicsMemory);
+	}
+	ASSERT_EQUAL("Core::Memory::Scope restore default",
+	    Core::Memory::Current(), Core::Memory::UntaggedMemory);
+}
+
+void
+memory_resource_test(void)
+{
+	Core::Memory::Track(Core::Memory::TextureMemory, 4096);
+	Core::Memory::Track(Core::Memory::TextureMemory, 1024);
+	Core::Memory::Untrack(Core::Memory::TextureMemory, 4096);
+
+	Core::Memory::Statistics l_stats = Core::Memory::Stats(Core::Memory::TextureMemory);
+	ASSERT_EQUAL("Core::Memory::Stats() live", l_stats.live, 1024);
+	ASSERT_EQUAL("Core::Memory::Stats() peak", l_stats.peak, 5120);
+	ASSERT_EQUAL("Core::Memory::Stats() allocations", l_stats.allocations, 2ul);
+
+	Core::Memory::Frame();
+	ASSERT_EQUAL("Core::Memory::Frame() latches", Core::Memory::Stats(Core::Memory::TextureMemory).frame, 2ul);
+	Core::Memory::Frame();
+	ASSERT_ZERO("Core::Memory::Frame() quiet frame", Core::Memory::Stats(Core::Memory::TextureMemory).frame);
+
+	Core::Memory::Untrack(Core::Memory::TextureMemory, 1024);
+	ASSERT_ZERO("Core::Memory::Untrack()", Core::Memory::Stats(Core::Memory::TextureMemory).live);
+}
+
+void
+memory_tracking_test(void)
+{
+	if (!Core::Memory::Enabled()) {
+		ASSERT_ZERO("Core::Memory disabled",
+		    Core::Memory::Stats(Core::Memory::GameMemory).allocations);
+		return;
+	}
+
+	const long l_live = Core::Memory::Stats(Core::Memory::GameMemory).live;
+	char *l_block;
+	{
+		Core::Memory::Scope l_scope(Core::Memory::GameMemory);
+		l_block = new char[1000];
+	}
+	ASSERT_EQUAL("Core::Memory charges scope tag",
+	    Core::Memory::Stats(Core::Memory::GameMemory).live - l_live, 1000);
+
+	/* credited to the allocating tag regardless of the current one */
+	delete[] l_block;
+	ASSERT_EQUAL("Core::Memory credits allocating tag",
+	    Core::Memory::Stats(Core::Memory::GameMemory).live, l_live);
+}
+
+int
+main(int, char *[])
+{
+	RUN_TEST(memory_scope_test);
+	RUN_TEST(memory_resource_test);
+	RUN_TEST(memory_tracking_test);
+
+	return(TEST_EXITCODE);
+}
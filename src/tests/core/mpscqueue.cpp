@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2013, Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ * All rights reserved.
+ *
+ * This file is part of Marshmallow Game Engine.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE CONTRIBUTORS ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are
+ * those of the authors and should not be interpreted as representing official
+ * policies, either expressed or implied, of the project as a whole.
+ */
+
+#include <vector>
+
+#include "core/mpscqueue.h"
+#include "core/thread_p.h"
+
+#include "tests/common.h"
+
+/*!
+ * @file
+ *
+ * @author Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ */
+
+MARSHMALLOW_NAMESPACE_USE
+
+static const uint32_t s_producers = 4;
+static const uint32_t s_values = 200000;
+
+typedef Core::MPSCQueue<uint32_t> Queue;
+
+struct Producer
+{
+	Queue *queue;
+	uint32_t id;
+	uint32_t retries;
+};
+
+/* values carry the producer id in the top byte */
+static void
+Produce(void *c)
+{
+	Producer *l_producer = static_cast<Producer *>(c);
+
+	for (uint32_t l_i = 0; l_i < s_values; ++l_i) {
+		const uint32_t l_value = (l_producer->id << 24) | l_i;
+		while (!l_producer->queue->push(l_value)) {
+			++l_producer->retries;
+			Core::Thread::YieldSlice();
+		}
+	}
+}
+
+void
+mpscqueue_basic_test(void)
+{
+	Queue l_queue(3);
+	ASSERT_EQUAL("MPSCQueue::capacity() rounded up", l_queue.capacity(), 4u);
+
+	uint32_t l_value = 0;
+	bool l_result = l_queue.pop(l_value);
+	ASSERT_FALSE("MPSCQueue::pop() empty", l_result);
+
+	for (uint32_t l_i = 0; l_i < 4; ++l_i)
+		l_queue.push(l_i + 10);
+	l_result = l_queue.push(14);
+	ASSERT_FALSE("MPSCQueue::push() full", l_result);
+
+	l_queue.pop(l_value);
+	ASSERT_EQUAL("MPSCQueue::pop() oldest", l_value, 10u);
+	l_result = l_queue.push(14);
+	ASSERT_TRUE("MPSCQueue::push() after pop", l_result);
+
+	/* wraps around */
+	uint32_t l_expected = 11;
+	bool l_ordered = true;
+	while (l_queue.pop(l_value))
+		l_ordered &= (l_value == l_expected++);
+	ASSERT_TRUE("MPSCQueue::pop() order", l_ordered && l_expected == 15);
+}
+
+void
+mpscqueue_stress_test(void)
+{
+	/* small ring, producers hit the full path */
+	Queue l_queue(256);
+
+	Producer l_producers[s_producers];
+	Core::Thread::Handle *l_threads[s_producers];
+
+	for (uint32_t l_i = 0; l_i < s_producers; ++l_i) {
+		l_producers[l_i].queue = &l_queue;
+		l_producers[l_i].id = l_i;
+		l_producers[l_i].retries = 0;
+		l_threads[l_i] = Core::Thread::Start(Produce, &l_producers[l_i]);
+	}
+
+	std::vector<uint32_t> l_next(s_producers, 0);
+	bool l_ordered = true;
+	uint32_t l_received = 0;
+	uint32_t l_value;
+
+	while (l_received < s_producers * s_values) {
+		if (!l_queue.pop(l_value)) {
+			Core::Thread::YieldSlice();
+			continue;
+		}
+
+		/* per producer order must hold */
+		const uint32_t l_id = l_value >> 24;
+		if (l_id >= s_producers || (l_value & 0xFFFFFF) != l_next[l_id]++)
+			l_ordered = false;
+		++l_received;
+	}
+
+	for (uint32_t l_i = 0; l_i < s_producers; ++l_i)
+		Core::Thread::Join(l_threads[l_i]);
+
+	ASSERT_TRUE("MPSCQueue stress, per producer order", l_ordered);
+
+	bool l_complete = true;
+	for (uint32_t l_i = 0; l_i < s_producers; ++l_i)
+		l_complete &= (l_next[l_i] == s_values);
+	ASSERT_TRUE("MPSCQueue stress, all values received", l_complete);
+
+	const bool l_empty = !l_queue.pop(l_value);
+	ASSERT_TRUE("MPSCQueue stress, drained", l_empty);
+}
+
+int
+main(int, char *[])
+{
+	RUN_TEST(mpscqueue_basic_test);
+	RUN_TEST(mpscqueue_stress_test);
+
+	return(TEST_EXITCODE);
+}
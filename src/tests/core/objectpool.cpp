@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) 2013, Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ * All rights reserved.
+ *
+ * This file is part of Marshmallow Game Engine.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE CONTRIBUTORS ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are
+ * those of the authors and should not be interpreted as representing official
+ * policies, either expressed or implied, of the project as a whole.
+ */
+
+#include <vector>
+
+#include "core/jobsystem.h"
+#include "core/objectpool.h"
+#include "core/shared.h"
+
+#include "tests/common.h"
+
+/*!
+ * @file
+ *
+ * @author Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ */
+
+MARSHMALLOW_NAMESPACE_USE
+
+struct Pooled
+{
+	MMPOOLED
+
+	char payload[40];
+};
+
+static const size_t s_objects = 10000;
+
+static void
+Churn(void *, size_t b, size_t e)
+{
+	std::vector<void *> l_objects;
+	for (size_t l_i = b; l_i < e; ++l_i)
+		l_objects.push_back(Core::ObjectPool::Allocate(24 + l_i % 100));
+	for (size_t l_i = b; l_i < e; ++l_i)
+		Core::ObjectPool::Release(l_objects[l_i - b], 24 + l_i % 100);
+}
+
+void
+objectpool_class_test(void)
+{
+	ASSERT_EQUAL("Core::ObjectPool::SizeClass(1)", Core::ObjectPool::SizeClass(1), 0);
+	ASSERT_EQUAL("Core::ObjectPool::SizeClass(16)", Core::ObjectPool::SizeClass(16), 0);
+	ASSERT_EQUAL("Core::ObjectPool::SizeClass(17)", Core::ObjectPool::SizeClass(17), 1);
+	ASSERT_EQUAL("Core::ObjectPool::SizeClass(MaxSize)",
+	    Core::ObjectPool::SizeClass(Core::ObjectPool::MaxSize), Core::ObjectPool::Classes - 1);
+	ASSERT_EQUAL("Core::ObjectPool::SizeClass(MaxSize + 1)",
+	    Core::ObjectPool::SizeClass(Core::ObjectPool::MaxSize + 1), Core::ObjectPool::Classes);
+}
+
+void
+objectpool_reuse_test(void)
+{
+	const int l_class = Core::ObjectPool::SizeClass(sizeof(Pooled));
+	const Core::ObjectPool::Statistics l_before = Core::ObjectPool::Stats(l_class);
+
+	Pooled *l_a = new Pooled;
+	ASSERT_TRUE("Core::ObjectPool alignment",
+	    0 == reinterpret_cast<size_t>(l_a) % Core::ObjectPool::Granularity);
+	delete l_a;
+
+	Pooled *l_b = new Pooled;
+	ASSERT_EQUAL("Core::ObjectPool recycles", l_b, l_a);
+	delete l_b;
+
+	const Core::ObjectPool::Statistics l_after = Core::ObjectPool::Stats(l_class);
+	ASSERT_EQUAL("Core::ObjectPool::Stats() size", l_after.size, 48u);
+	ASSERT_EQUAL("Core::ObjectPool::Stats() allocations", l_after.allocations - l_before.allocations, 2ul);
+	ASSERT_EQUAL("Core::ObjectPool::Stats() releases", l_after.releases - l_before.releases, 2ul);
+	ASSERT_NOT_ZERO("Core::ObjectPool::Stats() slabs", l_after.slabs);
+
+	/* large requests bypass the pool */
+	void *l_large = Core::ObjectPool::Allocate(Core::ObjectPool::MaxSize + 1);
+	ASSERT_TRUE("Core::ObjectPool::Allocate() large", l_large != 0);
+	Core::ObjectPool::Release(l_large, Core::ObjectPool::MaxSize + 1);
+
+	/* shared control blocks */
+	const int l_shared_class = Core::ObjectPool::SizeClass(sizeof(Core::SharedData));
+	const unsigned long l_shared = Core::ObjectPool::Stats(l_shared_class).allocations;
+	{
+		Core::Shared<int> l_int(new int(1));
+	}
+	ASSERT_EQUAL("Core::Shared pooled control block",
+	    Core::ObjectPool::Stats(l_shared_class).allocations - l_shared, 1ul);
+}
+
+static unsigned long
+Live(int size_class)
+{
+	const Core::ObjectPool::Statistics l_stats = Core::ObjectPool::Stats(size_class);
+	return(l_stats.capacity - l_stats.available);
+}
+
+void
+objectpool_flush_test(void)
+{
+	const int l_class = Core::ObjectPool::SizeClass(sizeof(Pooled));
+	Core::ObjectPool::Flush();
+	const unsigned long l_live = Live(l_class);
+
+	std::vector<Pooled *> l_objects;
+	for (size_t l_i = 0; l_i < s_objects; ++l_i)
+		l_objects.push_back(new Pooled);
+	ASSERT_TRUE("Core::ObjectPool live objects", Live(l_class) >= l_live + s_objects);
+
+	for (size_t l_i = 0; l_i < s_objects; ++l_i)
+		delete l_objects[l_i];
+
+	/* released objects stay cached until flushed */
+	Core::ObjectPool::Flush();
+	ASSERT_EQUAL("Core::ObjectPool::Flush()", Live(l_class), l_live);
+}
+
+void
+objectpool_threads_test(void)
+{
+	unsigned long l_live[Core::ObjectPool::Classes];
+	unsigned long l_allocations[Core::ObjectPool::Classes];
+
+	Core::ObjectPool::Flush();
+	for (int l_class = 0; l_class < Core::ObjectPool::Classes; ++l_class) {
+		l_live[l_class] = Live(l_class);
+		l_allocations[l_class] = Core::ObjectPool::Stats(l_class).allocations;
+	}
+
+	Core::JobSystem::Initialize(3);
+	Core::JobSystem::ParallelFor(s_objects * 10, Churn, 0, 1000);
+	Core::JobSystem::Finalize();
+
+	Core::ObjectPool::Flush();
+
+	bool l_balanced = true;
+	unsigned long l_churned = 0;
+	for (int l_class = 0; l_class < Core::ObjectPool::Classes; ++l_class) {
+		l_balanced &= (Live(l_class) == l_live[l_class]);
+		l_churned += Core::ObjectPool::Stats(l_class).allocations - l_allocations[l_class];
+	}
+	ASSERT_TRUE("Core::ObjectPool balanced across threads", l_balanced);
+	ASSERT_TRUE("Core::ObjectPool counts worker allocations", l_churned >= s_objects * 10);
+}
+
+int
+main(int, char *[])
+{
+	RUN_TEST(objectpool_class_test);
+	RUN_TEST(objectpool_reuse_test);
+	RUN_TEST(objectpool_flush_test);
+	RUN_TEST(objectpool_threads_test);
+
+	return(TEST_EXITCODE);
+}
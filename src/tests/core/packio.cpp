@@ -0,0 +1,236 @@
+/*
+ * Copyright (c) 2013, Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ * All rights reserved.
+ *
+ * This file is part of Marshmallow Game Engine.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE CONTRIBUTORS ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are
+ * those of the authors and should not be interpreted as representing official
+ * policies, either expressed or implied, of the project as a whole.
+ */
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "core/fileio.h"
+#include "core/identifier.h"
+#include "core/mappedfileio.h"
+#include "core/packio.h"
+#include "core/packwriter.h"
+
+#include "tests/common.h"
+
+/*!
+ * @file
+ *
+ * @author Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ */
+
+MARSHMALLOW_NAMESPACE_USE
+
+static const char s_content[] = "this is a test!";
+static const size_t s_content_size = sizeof(s_content);
+static const size_t s_entries = 200;
+static const char s_pack_file[] = "core/data/packio.pack";
+static const char s_patch_file[] = "core/data/packio-patch.pack";
+static const char s_corrupt_file[] = "core/data/packio-corrupt.pack";
+
+static std::string
+EntryName(size_t index)
+{
+	char l_name[32];
+	sprintf(l_name, "sprites/%03lu.dat", static_cast<unsigned long>(index));
+	return(l_name);
+}
+
+void
+packio_build_test(void)
+{
+	Core::PackWriter l_pack(64);
+	bool l_added = true;
+
+	for (size_t l_i = 0; l_i < s_entries; ++l_i) {
+		const std::string l_name = EntryName(l_i);
+		l_added &= l_pack.add(l_name, l_name.data(), l_name.size());
+	}
+
+	/* compressible, stored compressed */
+	std::vector<char> l_zeros(4096, 0);
+	l_added &= l_pack.add("maps/zeros.dat", &l_zeros[0], l_zeros.size(), true);
+	l_added &= l_pack.add("pack://maps/./test.dat", s_content, s_content_size, true);
+	l_added &= l_pack.add("empty.dat", 0, 0);
+	ASSERT_TRUE("Core::PackWriter::add()", l_added);
+
+	const bool l_duplicate = l_pack.add("maps/test.dat", s_content, 1);
+	ASSERT_FALSE("Core::PackWriter::add() DUPLICATE", l_duplicate);
+	const bool l_escape = l_pack.add("../escape.dat", s_content, 1);
+	ASSERT_FALSE("Core::PackWriter::add() OUTSIDE ROOT", l_escape);
+
+	ASSERT_EQUAL("Core::PackWriter::count()", l_pack.count(), s_entries + 3);
+	const bool l_written = l_pack.write(s_pack_file);
+	ASSERT_TRUE("Core::PackWriter::write()", l_written);
+
+	Core::PackWriter l_patch(4096);
+	l_patch.add("maps/test.dat", "patched", 8);
+	const bool l_patch_written = l_patch.write(s_patch_file);
+	ASSERT_TRUE("Core::PackWriter::write() PATCH", l_patch_written);
+}
+
+void
+packio_read_test(void)
+{
+	const bool l_mounted = Core::PackIO::Mount(s_pack_file);
+	ASSERT_TRUE("Core::PackIO::Mount()", l_mounted);
+	if (!l_mounted) return;
+
+	const bool l_remount = Core::PackIO::Mount(s_pack_file);
+	ASSERT_FALSE("Core::PackIO::Mount() TWICE", l_remount);
+
+	ASSERT_TRUE("Core::PackIO::IsPackPath()",
+	    Core::PackIO::IsPackPath("pack://maps/test.dat"));
+	ASSERT_FALSE("Core::PackIO::IsPackPath() PLAIN",
+	    Core::PackIO::IsPackPath("maps/test.dat"));
+
+	bool l_found = true;
+	for (size_t l_i = 0; l_i < s_entries && l_found; ++l_i) {
+		const std::string l_name = EntryName(l_i);
+		Core::PackIO l_entry(l_name);
+		l_found = l_entry.isOpen() && l_entry.size() == l_name.size()
+		    && 0 == memcmp(l_entry.view(0, l_name.size()),
+		                   l_name.data(), l_name.size());
+	}
+	ASSERT_TRUE("Core::PackIO::open() ALL ENTRIES", l_found);
+
+	ASSERT_TRUE("Core::PackIO::Exists()",
+	    Core::PackIO::Exists("pack://sprites/007.dat"));
+	ASSERT_TRUE("Core::PackIO::Exists() NORMALIZED",
+	    Core::PackIO::Exists("pack://maps/../sprites//007.dat"));
+	ASSERT_FALSE("Core::PackIO::Exists() MISSING",
+	    Core::PackIO::Exists("pack://sprites/999.dat"));
+
+	char l_scratch[s_content_size];
+	Core::PackIO l_entry("pack://maps/test.dat");
+	ASSERT_TRUE("Core::PackIO::open() COMPRESSED", l_entry.isOpen());
+	const size_t l_read = l_entry.read(l_scratch, sizeof(l_scratch));
+	ASSERT_EQUAL("Core::PackIO::read() ALL BYTES", l_read, s_content_size);
+	ASSERT_ZERO("Core::PackIO::read() CONFIRM DATA OK",
+	    memcmp(l_scratch, s_content, s_content_size));
+	const bool l_seeked = l_entry.seek(-6, Core::DIOEnd);
+	ASSERT_TRUE("Core::PackIO::seek()", l_seeked);
+	ASSERT_EQUAL("Core::PackIO::tell()", l_entry.tell(), long(s_content_size - 6));
+	const size_t l_written = l_entry.write(s_content, 1);
+	ASSERT_ZERO("Core::PackIO::write() READ-ONLY", l_written);
+
+	Core::PackIO l_zeros("pack://maps/zeros.dat");
+	ASSERT_EQUAL("Core::PackIO::size() INFLATED", l_zeros.size(), 4096);
+
+	Core::PackIO l_empty("pack://empty.dat");
+	ASSERT_TRUE("Core::PackIO::open() EMPTY", l_empty.isOpen());
+	ASSERT_ZERO("Core::PackIO::size() EMPTY", l_empty.size());
+
+	Core::PackIO l_missing("pack://missing.dat");
+	ASSERT_FALSE("Core::PackIO::open() MISSING", l_missing.isOpen());
+}
+
+void
+packio_transparent_test(void)
+{
+	char l_scratch[s_content_size];
+
+	Core::FileIO l_file("pack://maps/test.dat");
+	ASSERT_TRUE("Core::FileIO::open() PACK", l_file.isOpen());
+	if (l_file.isOpen()) {
+		ASSERT_EQUAL("Core::FileIO::size() PACK", l_file.size(), s_content_size);
+		const size_t l_read = l_file.read(l_scratch, sizeof(l_scratch));
+		ASSERT_EQUAL("Core::FileIO::read() PACK", l_read, s_content_size);
+		ASSERT_ZERO("Core::FileIO::read() PACK DATA OK",
+		    memcmp(l_scratch, s_content, s_content_size));
+	}
+
+	Core::FileIO l_writable("pack://maps/test.dat", Core::DIOWriteOnly);
+	ASSERT_FALSE("Core::FileIO::open() PACK WRITE", l_writable.isOpen());
+
+	Core::MappedFileIO l_mapped("pack://sprites/042.dat");
+	ASSERT_TRUE("Core::MappedFileIO::open() PACK", l_mapped.isOpen());
+	const std::string l_name = EntryName(42);
+	if (l_mapped.isOpen()) ASSERT_ZERO("Core::MappedFileIO::view() PACK",
+	    memcmp(l_mapped.view(0, l_name.size()), l_name.data(), l_name.size()));
+
+	/* later mounts take precedence */
+	const bool l_patched = Core::PackIO::Mount(s_patch_file);
+	ASSERT_TRUE("Core::PackIO::Mount() PATCH", l_patched);
+	{
+		Core::PackIO l_entry("pack://maps/test.dat");
+		ASSERT_EQUAL("Core::PackIO::size() PATCHED", l_entry.size(), 8);
+		Core::PackIO l_sprite("pack://sprites/042.dat");
+		ASSERT_TRUE("Core::PackIO::open() FALLTHROUGH", l_sprite.isOpen());
+	}
+
+	const bool l_unmounted = Core::PackIO::Unmount(s_patch_file)
+	                      && Core::PackIO::Unmount(s_pack_file);
+	ASSERT_TRUE("Core::PackIO::Unmount()", l_unmounted);
+
+	/* still mapped while open */
+	if (l_mapped.isOpen()) ASSERT_ZERO("Core::MappedFileIO::view() UNMOUNTED",
+	    memcmp(l_mapped.view(0, l_name.size()), l_name.data(), l_name.size()));
+	ASSERT_FALSE("Core::PackIO::Exists() UNMOUNTED",
+	    Core::PackIO::Exists("pack://maps/test.dat"));
+}
+
+void
+packio_corrupt_test(void)
+{
+	std::vector<char> l_data;
+	{
+		Core::FileIO l_file(s_pack_file);
+		l_data.resize(l_file.size());
+		l_file.read(&l_data[0], l_data.size());
+	}
+
+	/* bucket count past the end of the file */
+	memset(&l_data[16], 0x7F, 4);
+	{
+		Core::FileIO l_file(s_corrupt_file, Core::DIOTruncate);
+		l_file.write(&l_data[0], l_data.size());
+	}
+
+	const bool l_mounted = Core::PackIO::Mount(s_corrupt_file);
+	ASSERT_FALSE("Core::PackIO::Mount() CORRUPT", l_mounted);
+
+	const bool l_plain = Core::PackIO::Mount("core/data/fileio.dat");
+	ASSERT_FALSE("Core::PackIO::Mount() NOT A PACK", l_plain);
+}
+
+int
+main(int, char *[])
+{
+	MMCHDIR(MARSHMALLOW_TESTS_DIRECTORY);
+
+	RUN_TEST(packio_build_test);
+	RUN_TEST(packio_read_test);
+	RUN_TEST(packio_transparent_test);
+	RUN_TEST(packio_corrupt_test);
+
+	return(TEST_EXITCODE);
+}
@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2013, Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ * All rights reserved.
+ *
+ * This file is part of Marshmallow Game Engine.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE CONTRIBUTORS ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are
+ * those of the authors and should not be interpreted as representing official
+ * policies, either expressed or implied, of the project as a whole.
+ */
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "core/platform.h"
+
+#include "tests/common.h"
+
+/*!
+ * @file
+ *
+ * @author Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ */
+
+MARSHMALLOW_NAMESPACE_USE
+
+void
+platform_ticks_test(void)
+{
+	bool l_monotonic = true;
+	MMTICK l_last = Core::Platform::Ticks();
+	for (int l_i = 0; l_i < 100000; ++l_i) {
+		const MMTICK l_now = Core::Platform::Ticks();
+		l_monotonic &= (l_now >= l_last);
+		l_last = l_now;
+	}
+	ASSERT_TRUE("Core::Platform::Ticks() monotonic", l_monotonic);
+
+	const MMTICK l_before = NOW_TICKS();
+	const MMTIME l_time = NOW();
+	const MMTICK l_after = NOW_TICKS();
+	ASSERT_TRUE("Core::Platform::TimeStamp() lower bound",
+	    l_time >= Core::Platform::TicksToTime(l_before));
+	ASSERT_TRUE("Core::Platform::TimeStamp() upper bound",
+	    l_time <= Core::Platform::TicksToTime(l_after));
+}
+
+void
+platform_sleep_test(void)
+{
+	const MMTICK l_timeout = 2 * Core::Platform::TicksPerMillisecond;
+
+	const MMTICK l_start = Core::Platform::Ticks();
+	Core::Platform::SleepTicks(l_timeout);
+	const MMTICK l_elapsed = Core::Platform::Ticks() - l_start;
+	ASSERT_TRUE("Core::Platform::SleepTicks()", l_elapsed >= l_timeout);
+}
+
+void
+platform_conversion_test(void)
+{
+	ASSERT_EQUAL("Core::Platform::TimeToTicks()",
+	    Core::Platform::TimeToTicks(16), MMTICK(16000000));
+	ASSERT_EQUAL("Core::Platform::TicksToTime()",
+	    Core::Platform::TicksToTime(16666666), 16);
+	ASSERT_EQUAL("Core::Platform::TicksToSeconds()",
+	    Core::Platform::TicksToSeconds(Core::Platform::TicksPerSecond / 4), .25f);
+
+	/* past what a 32-bit millisecond counter holds */
+	const MMTICK l_month = 30 * 24 * 3600 * Core::Platform::TicksPerSecond;
+	ASSERT_TRUE("MMTICK range", l_month > 0 && l_month < MMTICK_MAX);
+}
+
+int
+main(void)
+{
+	RUN_TEST(platform_ticks_test);
+	RUN_TEST(platform_sleep_test);
+	RUN_TEST(platform_conversion_test);
+
+	return(TEST_EXITCODE);
+}
@@ -0,0 +1,186 @@
+/*
+ * Copyright (c) 2013, Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ * All rights reserved.
+ *
+ * This file is part of Marshmallow Game Engine.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE CONTRIBUTORS ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are
+ * those of the authors and should not be interpreted as representing official
+ * policies, either expressed or implied, of the project as a whole.
+ */
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "core/fileio.h"
+#include "core/identifier.h"
+#include "core/platform.h"
+#include "core/profiler.h"
+
+#include "core/thread_p.h"
+
+#include "tests/common.h"
+
+#include <string>
+#include <vector>
+
+/*!
+ * @file
+ *
+ * @author Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ */
+
+MARSHMALLOW_NAMESPACE_USE
+
+static const char s_trace_file[] = "core/data/profiler.json";
+static const int s_threads = 4;
+static const int s_zones = 1000;
+
+static void
+Busy(MMTICK ticks)
+{
+	const MMTICK l_end = Core::Platform::Ticks() + ticks;
+	while (Core::Platform::Ticks() < l_end);
+}
+
+static const Core::Profiler::ZoneSummary *
+FindZone(const char *name)
+{
+	const Core::Profiler::ZoneSummary *l_zones;
+	const size_t l_count = Core::Profiler::LastFrame(&l_zones);
+	for (size_t l_i = 0; l_i < l_count; ++l_i)
+		if (0 == strcmp(l_zones[l_i].name, name))
+			return(&l_zones[l_i]);
+	return(0);
+}
+
+static void
+Worker(void *)
+{
+	for (int l_i = 0; l_i < s_zones; ++l_i)
+		Core::Profiler::Zone l_zone("worker");
+}
+
+void
+profiler_zone_test(void)
+{
+	Core::Profiler::Start();
+
+	{
+		Core::Profiler::Zone l_outer("outer");
+		for (int l_i = 0; l_i < 3; ++l_i) {
+			Core::Profiler::Zone l_inner("inner");
+			Busy(Core::Platform::TicksPerMillisecond / 2);
+		}
+	}
+	Core::Profiler::Frame();
+
+	const Core::Profiler::ZoneSummary *l_zones;
+	const size_t l_count = Core::Profiler::LastFrame(&l_zones);
+	ASSERT_EQUAL("Core::Profiler::LastFrame() zones", l_count, 2u);
+
+	const Core::Profiler::ZoneSummary *l_outer = FindZone("outer");
+	const Core::Profiler::ZoneSummary *l_inner = FindZone("inner");
+	ASSERT_TRUE("Core::Profiler outer zone", l_outer && l_outer->calls == 1);
+	ASSERT_TRUE("Core::Profiler inner zone", l_inner && l_inner->calls == 3);
+	ASSERT_TRUE("Core::Profiler nesting",
+	    l_outer && l_inner && l_outer->total >= l_inner->total
+	    && l_inner->total >= 3 * Core::Platform::TicksPerMillisecond / 2);
+	ASSERT_TRUE("Core::Profiler::LastFrameTime()",
+	    Core::Profiler::LastFrameTime() >= l_outer->total);
+
+	/* nothing recorded while stopped */
+	Core::Profiler::Stop();
+	{
+		Core::Profiler::Zone l_zone("stopped");
+	}
+	Core::Profiler::Start();
+	Core::Profiler::Frame();
+	ASSERT_ZERO("Core::Profiler::Stop()", FindZone("stopped"));
+}
+
+void
+profiler_threads_test(void)
+{
+	Core::Profiler::Start();
+	const unsigned long l_dropped = Core::Profiler::Dropped();
+
+	Core::Thread::Handle *l_handles[s_threads];
+	for (int l_t = 0; l_t < s_threads; ++l_t)
+		l_handles[l_t] = Core::Thread::Start(Worker, 0);
+	for (int l_t = 0; l_t < s_threads; ++l_t)
+		Core::Thread::Join(l_handles[l_t]);
+
+	Core::Profiler::Frame();
+
+	const Core::Profiler::ZoneSummary *l_worker = FindZone("worker");
+	const unsigned long l_lost = Core::Profiler::Dropped() - l_dropped;
+	ASSERT_TRUE("Core::Profiler threads",
+	    l_worker && l_worker->calls + l_lost == unsigned(s_threads * s_zones));
+}
+
+void
+profiler_trace_test(void)
+{
+	Core::Profiler::Start();
+	{
+		Core::Profiler::Zone l_zone("trace \"quoted\"");
+	}
+	Core::Profiler::Frame();
+	Core::Profiler::Stop();
+
+	const bool l_written = Core::Profiler::WriteChromeTrace(s_trace_file);
+	ASSERT_TRUE("Core::Profiler::WriteChromeTrace()", l_written);
+
+	Core::FileIO l_file(s_trace_file);
+	std::vector<char> l_data(l_file.size());
+	const size_t l_read = l_data.empty() ? 0 : l_file.read(&l_data[0], l_data.size());
+	const std::string l_json(l_data.begin(), l_data.begin() + long(l_read));
+
+	ASSERT_TRUE("Chrome trace header",
+	    0 == l_json.find("{\"displayTimeUnit\":\"ms\",\"traceEvents\":["));
+	ASSERT_TRUE("Chrome trace escaping",
+	    std::string::npos != l_json.find("\"name\":\"trace \\\"quoted\\\"\",\"cat\""));
+	ASSERT_TRUE("Chrome trace frame",
+	    std::string::npos != l_json.find("\"name\":\"Frame\""));
+	ASSERT_TRUE("Chrome trace complete event",
+	    std::string::npos != l_json.find("\"ph\":\"X\""));
+	ASSERT_TRUE("Chrome trace footer",
+	    l_json.size() > 3 && 0 == l_json.compare(l_json.size() - 3, 3, "]}\n"));
+
+	l_file.close();
+	remove(s_trace_file);
+}
+
+int
+main(int, char *[])
+{
+	MMCHDIR(MARSHMALLOW_TESTS_DIRECTORY);
+
+	RUN_TEST(profiler_zone_test);
+	RUN_TEST(profiler_threads_test);
+	RUN_TEST(profiler_trace_test);
+
+	return(TEST_EXITCODE);
+}
@@ -30,6 +30,7 @@
  * policies, either expressed or implied, of the project as a whole.
  */
 
+#include "core/ref.h"
 #include "core/shared.h"
 #include "core/weak.h"
 
@@ -70,6 +71,79 @@ weak_basic_test(void)
 	ASSERT_INVALID("Core::Weak::clear()", valid);
 }
 
+struct SharedTestObject
+{
+	static int s_alive;
+	int value;
+
+	SharedTestObject(int v = 0)
+	    : value(v) { ++s_alive; }
+	~SharedTestObject(void)
+	    { --s_alive; }
+};
+int SharedTestObject::s_alive = 0;
+
+void
+shared_make_test(void)
+{
+	Core::Shared<SharedTestObject> valid =
+	    Core::MakeShared<SharedTestObject>(42);
+	ASSERT_VALID("Core::MakeShared()", valid);
+	ASSERT_EQUAL("Core::MakeShared() constructed", valid->value, 42);
+	ASSERT_EQUAL("Core::MakeShared() alive", SharedTestObject::s_alive, 1);
+
+	Core::Shared<SharedTestObject> copy(valid);
+	ASSERT_TRUE("Core::Shared::Shared(const Shared &)", copy == valid);
+
+	/* weak reference outlives object */
+	Core::Weak<SharedTestObject> weak(valid);
+	valid.clear();
+	ASSERT_VALID("Core::Weak::Weak() still valid", weak);
+	copy.clear();
+	ASSERT_EQUAL("Core::MakeShared() destroyed", SharedTestObject::s_alive, 0);
+	ASSERT_INVALID("Core::Weak::Weak() expired", weak);
+
+	Core::Shared<SharedTestObject> expired(weak);
+	ASSERT_INVALID("Core::Weak::operator Shared() expired", expired);
+}
+
+void
+shared_refs_test(void)
+{
+	/* more references than the old 16-bit counters could hold */
+	static const int s_count = 40000;
+	Core::Shared<SharedTestObject> valid(new SharedTestObject);
+	Core::Shared<SharedTestObject> *l_copies =
+	    new Core::Shared<SharedTestObject>[s_count];
+	for (int i = 0; i < s_count; ++i)
+		l_copies[i] = valid;
+	valid.clear();
+	ASSERT_EQUAL("Core::Shared 32-bit references", SharedTestObject::s_alive, 1);
+	delete[] l_copies;
+	ASSERT_EQUAL("Core::Shared released", SharedTestObject::s_alive, 0);
+}
+
+void
+ref_basic_test(void)
+{
+	ASSERT_INVALID("Core::Ref::Ref() INVALID", Core::Ref<int>());
+
+	Core::Shared<int> svalid(new int);
+	Core::Ref<int> valid(svalid);
+	ASSERT_VALID("Core::Ref::Ref()", valid);
+	ASSERT_EQUAL("Core::Ref::raw()", valid.raw(), svalid.raw());
+
+	/* promote borrow */
+	Core::Shared<int> spromoted(valid);
+	Core::Weak<int> wpromoted(valid);
+	svalid.clear();
+	ASSERT_VALID("Core::Ref::operator Shared()", spromoted);
+	ASSERT_VALID("Core::Ref::operator Weak()", wpromoted);
+
+	spromoted.clear();
+	ASSERT_INVALID("Core::Ref::operator Weak() expired", wpromoted);
+}
+
 int
 main(int, char *[])
 {
@@ -77,6 +151,9 @@ main(int, char *[])
 
 	RUN_TEST(shared_basic_test);
 	RUN_TEST(weak_basic_test);
+	RUN_TEST(shared_make_test);
+	RUN_TEST(shared_refs_test);
+	RUN_TEST(ref_basic_test);
 
 	return(TEST_EXITCODE);
 }
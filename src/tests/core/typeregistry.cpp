@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2013, Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ * All rights reserved.
+ *
+ * This file is part of Marshmallow Game Engine.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE CONTRIBUTORS ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are
+ * those of the authors and should not be interpreted as representing official
+ * policies, either expressed or implied, of the project as a whole.
+ */
+
+#include "core/type.h"
+#include "core/typeregistry.h"
+
+#include "tests/common.h"
+
+/*!
+ * @file
+ *
+ * @author Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ */
+
+MARSHMALLOW_NAMESPACE_USE
+
+struct TypeA
+{
+	static const Core::Type & Type(void)
+	    { static const Core::Type s_type("Tests::TypeA");
+	      return(s_type); }
+};
+
+struct TypeB
+{
+	static const Core::Type & Type(void)
+	    { static const Core::Type s_type("Tests::TypeB");
+	      return(s_type); }
+};
+
+void
+typeregistry_index_test(void)
+{
+	const int l_a = Core::TypeIndex<TypeA>();
+	const int l_b = Core::TypeIndex<TypeB>();
+
+	ASSERT_NOT_EQUAL("Core::TypeIndex() VALID",
+	    l_a, Core::TypeRegistry::InvalidIndex);
+	ASSERT_NOT_EQUAL("Core::TypeIndex() UNIQUE", l_a, l_b);
+	ASSERT_EQUAL("Core::TypeIndex() STABLE", l_a, Core::TypeIndex<TypeA>());
+	ASSERT_TRUE("Core::TypeIndex() DENSE",
+	    l_a < Core::TypeRegistry::Count() && l_b < Core::TypeRegistry::Count());
+
+	ASSERT_EQUAL("Core::TypeRegistry::Index()",
+	    Core::TypeRegistry::Index(TypeA::Type()), l_a);
+	ASSERT_EQUAL("Core::TypeRegistry::Register() twice",
+	    Core::TypeRegistry::Register(Core::Type("Tests::TypeB")), l_b);
+	ASSERT_EQUAL("Core::TypeRegistry::TypeAt()",
+	    Core::TypeRegistry::TypeAt(l_b), TypeB::Type());
+
+	ASSERT_EQUAL("Core::TypeRegistry::Index() UNREGISTERED",
+	    Core::TypeRegistry::Index(Core::Type("Tests::Unregistered")),
+	    Core::TypeRegistry::InvalidIndex);
+}
+
+void
+typeregistry_collision_test(void)
+{
+#if MARSHMALLOW_LEGACY_HASH
+	/* both strings hash to 0x804c7612 */
+	const Core::Type l_a("Test::Type107386");
+	const Core::Type l_b("Test::Type151800");
+#else
+	/* both strings hash to 0x71f031c8 */
+	const Core::Type l_a("Test::Typexsnhjwbd");
+	const Core::Type l_b("Test::Typetcvtsbjf");
+#endif
+	ASSERT_EQUAL("Core::Type COLLISION", l_a.uid(), l_b.uid());
+
+	ASSERT_NOT_EQUAL("Core::TypeRegistry::Register()",
+	    Core::TypeRegistry::Register(l_a), Core::TypeRegistry::InvalidIndex);
+	ASSERT_EQUAL("Core::TypeRegistry::Register() COLLISION",
+	    Core::TypeRegistry::Register(l_b), Core::TypeRegistry::InvalidIndex);
+}
+
+int
+main(int, char *[])
+{
+	MMCHDIR(MARSHMALLOW_TESTS_DIRECTORY);
+
+	RUN_TEST(typeregistry_index_test);
+	RUN_TEST(typeregistry_collision_test);
+
+	return(TEST_EXITCODE);
+}
+
@@ -0,0 +1,293 @@
+/*
+ * Copyright (c) 2013, Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ * All rights reserved.
+ *
+ * This file is part of Marshmallow Game Engine.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE CONTRIBUTORS ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are
+ * those of the authors and should not be interpreted as representing official
+ * policies, either expressed or implied, of the project as a whole.
+ */
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#include "core/bufferio.h"
+#include "core/type.h"
+
+#include "event/eventmanager.h"
+#include "event/eventplayer.h"
+#include "event/eventrecorder.h"
+#include "event/ieventlistener.h"
+#include "event/joystickaxisevent.h"
+#include "event/joystickbuttonevent.h"
+#include "event/keyboardevent.h"
+#include "event/quitevent.h"
+#include "event/renderevent.h"
+#include "event/sensorevent.h"
+#include "event/touchevent.h"
+#include "event/viewportevent.h"
+
+#include "tests/common.h"
+
+/*!
+ * @file
+ *
+ * @author Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ */
+
+MARSHMALLOW_NAMESPACE_USE
+
+static const int s_fps = 60;
+
+/*
+ * Describes every event it sees, a key press also queues a quit event
+ * (derived, not recorded, regenerated on replay).
+ */
+class CaptureListener : public Event::IEventListener
+{
+	NO_ASSIGN_COPY(CaptureListener);
+public:
+
+	CaptureListener(Event::EventManager &manager)
+	    : m_manager(manager)
+	{
+		m_manager.connect(this, Event::KeyboardEvent::Type());
+		m_manager.connect(this, Event::JoystickAxisEvent::Type());
+		m_manager.connect(this, Event::JoystickButtonEvent::Type());
+		m_manager.connect(this, Event::TouchEvent::Type());
+		m_manager.connect(this, Event::SensorEvent::Type());
+		m_manager.connect(this, Event::QuitEvent::Type());
+		m_manager.connect(this, Event::ViewportEvent::Type());
+	}
+
+	std::string log;
+
+	void frame(void)
+	    { log += "|"; }
+
+	VIRTUAL bool handleEvent(const Event::IEvent &event)
+	{
+		using namespace Event;
+
+		char l_line[128];
+		const Core::Type &l_type = event.type();
+
+		if (l_type == KeyboardEvent::Type()) {
+			const KeyboardEvent &l_event =
+			    static_cast<const KeyboardEvent &>(event);
+			snprintf(l_line, sizeof(l_line), "K%d,%d,%d;", l_event.key(),
+			    l_event.action(), int(l_event.source()));
+			m_manager.queue(new QuitEvent(9));
+		}
+		else if (l_type == JoystickAxisEvent::Type()) {
+			const JoystickAxisEvent &l_event =
+			    static_cast<const JoystickAxisEvent &>(event);
+			snprintf(l_line, sizeof(l_line), "A%d,%d,%d,%d,%d;",
+			    l_event.axis(), l_event.value(), l_event.minimum(),
+			    l_event.maximum(), int(l_event.source()));
+		}
+		else if (l_type == JoystickButtonEvent::Type()) {
+			const JoystickButtonEvent &l_event =
+			    static_cast<const JoystickButtonEvent &>(event);
+			snprintf(l_line, sizeof(l_line), "B%d,%d,%d,%d;",
+			    l_event.button(), l_event.action(), l_event.state(),
+			    int(l_event.source()));
+		}
+		else if (l_type == TouchEvent::Type()) {
+			const TouchEvent &l_event =
+			    static_cast<const TouchEvent &>(event);
+			snprintf(l_line, sizeof(l_line), "T%d,%d,%d,%d;",
+			    l_event.action(), l_event.x(), l_event.y(),
+			    int(l_event.source()));
+		}
+		else if (l_type == SensorEvent::Type()) {
+			const SensorEvent &l_event =
+			    static_cast<const SensorEvent &>(event);
+			snprintf(l_line, sizeof(l_line), "S%d,%.9g,%.9g,%.9g,%d;",
+			    l_event.sensor(), double(l_event.x()), double(l_event.y()),
+			    double(l_event.z()), int(l_event.source()));
+		}
+		else if (l_type == QuitEvent::Type())
+			snprintf(l_line, sizeof(l_line), "Q%d;",
+			    static_cast<const QuitEvent &>(event).code());
+		else if (l_type == ViewportEvent::Type())
+			snprintf(l_line, sizeof(l_line), "V%d;",
+			    static_cast<const ViewportEvent &>(event).reason());
+		else
+			snprintf(l_line, sizeof(l_line), "?;");
+
+		log += l_line;
+		return(false);
+	}
+
+private:
+
+	Event::EventManager &m_manager;
+};
+
+/* records the reference session into buffer, returns the log size */
+static size_t
+Record(char *buffer, size_t size, std::string &log, size_t &recorded)
+{
+	using namespace Event;
+	using namespace Input;
+
+	Core::BufferIO l_sink(buffer, size);
+	EventManager l_manager("eventlog.record");
+	CaptureListener l_capture(l_manager);
+
+	EventRecorder *l_recorder = new EventRecorder(l_sink, s_fps);
+	l_manager.setTap(l_recorder);
+
+	for (uint32_t l_frame = 0; l_frame < 8; ++l_frame) {
+		l_recorder->setFrame(l_frame);
+
+		switch (l_frame) {
+		case 0: {
+			l_manager.queue(new KeyboardEvent(Keyboard::KBK_A,
+			    Keyboard::KeyPressed, 1));
+
+			TouchEvent l_touch(Touch::Press, 10, -20, 2);
+			l_manager.dispatch(l_touch);
+
+			RenderEvent l_render;
+			l_manager.dispatch(l_render);
+			} break;
+
+		case 2: {
+			l_manager.queue(new JoystickAxisEvent(Joystick::JSA_X,
+			    -300, -32768, 32767, 3));
+			l_manager.queue(new JoystickButtonEvent(Joystick::JSB_A,
+			    Joystick::ButtonPressed, Joystick::JSB_A, 3));
+			l_manager.queue(new SensorEvent(Sensor::Gyroscope,
+			    .5f, -1.25f, 3.1415926f, 4));
+
+			ViewportEvent l_viewport(ViewportEvent::Created);
+			l_manager.dispatch(l_viewport);
+			} break;
+
+		case 5:
+			l_manager.queue(new QuitEvent(3));
+			break;
+		}
+
+		l_manager.execute();
+		l_capture.frame();
+	}
+
+	recorded = l_recorder->recorded();
+	l_manager.setTap(0);
+	delete l_recorder;
+
+	log = l_capture.log;
+	return(static_cast<size_t>(l_sink.tell()));
+}
+
+void
+eventlog_replay_test(void)
+{
+	char l_buffer[1024];
+	std::string l_recorded_log;
+	size_t l_recorded;
+	const size_t l_size =
+	    Record(l_buffer, sizeof(l_buffer), l_recorded_log, l_recorded);
+
+	ASSERT_EQUAL("Event::EventRecorder::recorded() SKIPS DERIVED AND UNKNOWN",
+	    7, l_recorded);
+
+	Core::BufferIO l_source(static_cast<const void *>(l_buffer), l_size);
+	Event::EventPlayer l_player(l_source);
+	ASSERT_TRUE("Event::EventPlayer::isValid()", l_player.isValid());
+	ASSERT_EQUAL("Event::EventPlayer::fps()", s_fps, l_player.fps());
+	ASSERT_EQUAL("Event::EventPlayer::frames()", 8, l_player.frames());
+	ASSERT_EQUAL("Event::EventPlayer::events()", 7, l_player.events());
+
+	Event::EventManager l_manager("eventlog.replay");
+	CaptureListener l_capture(l_manager);
+
+	size_t l_played = 0;
+	for (uint32_t l_frame = 0; l_frame < l_player.frames(); ++l_frame) {
+		const size_t l_count = l_player.play(l_manager, l_frame);
+		if (l_frame == 0)
+			ASSERT_EQUAL("Event::EventPlayer::play() FRAME 0", 2, l_count);
+		l_played += l_count;
+
+		l_manager.execute();
+		l_capture.frame();
+	}
+	ASSERT_EQUAL("Event::EventPlayer::play() ALL", 7, l_played);
+	ASSERT_TRUE("Event::EventPlayer::atEnd()", l_player.atEnd());
+
+	ASSERT_TRUE("Event::EventPlayer REPLAY MATCHES RECORDING",
+	    l_recorded_log == l_capture.log);
+
+	l_player.rewind();
+	ASSERT_FALSE("Event::EventPlayer::rewind()", l_player.atEnd());
+}
+
+void
+eventlog_invalid_test(void)
+{
+	char l_buffer[1024];
+	std::string l_log;
+	size_t l_recorded;
+	const size_t l_size = Record(l_buffer, sizeof(l_buffer), l_log, l_recorded);
+
+	{
+		Core::BufferIO l_source(static_cast<const void *>(l_buffer),
+		    l_size - 1);
+		Event::EventPlayer l_player(l_source);
+		ASSERT_FALSE("Event::EventPlayer::isValid() TRUNCATED",
+		    l_player.isValid());
+		ASSERT_ZERO("Event::EventPlayer::frames() TRUNCATED",
+		    l_player.frames());
+	}
+
+	{
+		l_buffer[4] = 2;
+		Core::BufferIO l_source(static_cast<const void *>(l_buffer), l_size);
+		Event::EventPlayer l_player(l_source);
+		ASSERT_FALSE("Event::EventPlayer::isValid() VERSION",
+		    l_player.isValid());
+	}
+
+	{
+		const char l_garbage[] = "not an event log";
+		Core::BufferIO l_source(static_cast<const void *>(l_garbage),
+		    sizeof(l_garbage));
+		Event::EventPlayer l_player(l_source);
+		ASSERT_FALSE("Event::EventPlayer::isValid() GARBAGE",
+		    l_player.isValid());
+	}
+}
+
+int
+main(int, char *[])
+{
+	RUN_TEST(eventlog_replay_test);
+	RUN_TEST(eventlog_invalid_test);
+
+	return(TEST_EXITCODE);
+}
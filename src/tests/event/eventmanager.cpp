@@ -0,0 +1,478 @@
+/*
+ * Copyright (c) 2013, Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ * All rights reserved.
+ *
+ * This file is part of Marshmallow Game Engine.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE CONTRIBUTORS ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are
+ * those of the authors and should not be interpreted as representing official
+ * policies, either expressed or implied, of the project as a whole.
+ */
+
+#include <vector>
+
+#include "core/identifier.h"
+#include "core/platform.h"
+#include "core/shared.h"
+#include "core/thread_p.h"
+#include "core/type.h"
+
+#include "event/eventbase.h"
+#include "event/eventmanager.h"
+#include "event/ibatcheventlistener.h"
+#include "event/ieventlistener.h"
+
+#include "tests/common.h"
+
+/*!
+ * @file
+ *
+ * @author Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ */
+
+MARSHMALLOW_NAMESPACE_USE
+
+class TestEvent : public Event::EventBase
+{
+	NO_ASSIGN_COPY(TestEvent);
+public:
+
+	TestEvent(int id_, MMTICK timestamp = 0, uint8_t priority = 0)
+	    : EventBase(timestamp, priority)
+	    , id(id_) {}
+
+	const int id;
+
+	VIRTUAL const Core::Type & type(void) const
+	    { return(Type()); }
+
+	static const Core::Type & Type(void)
+	{
+		static const Core::Type s_type("TestEvent");
+		return(s_type);
+	}
+};
+
+class TestListener : public Event::IEventListener
+{
+	NO_ASSIGN_COPY(TestListener);
+public:
+
+	TestListener(Event::EventManager &manager)
+	    : m_manager(manager) {}
+
+	std::vector<int> order;
+
+	VIRTUAL bool handleEvent(const Event::IEvent &event)
+	{
+		const TestEvent &l_event = static_cast<const TestEvent &>(event);
+		order.push_back(l_event.id);
+
+		/* queued during execute, must wait for the next one */
+		if (l_event.id == 100)
+			m_manager.queue(new TestEvent(101));
+
+		return(false);
+	}
+
+private:
+
+	Event::EventManager &m_manager;
+};
+
+class MutatingListener : public Event::IEventListener
+{
+	NO_ASSIGN_COPY(MutatingListener);
+public:
+
+	MutatingListener(Event::EventManager &manager)
+	    : calls(0)
+	    , connect(0)
+	    , disconnect(0)
+	    , redispatch(false)
+	    , m_manager(manager) {}
+
+	int calls;
+	Event::IEventListener *connect;
+	Event::IEventListener *disconnect;
+	bool redispatch;
+
+	VIRTUAL bool handleEvent(const Event::IEvent &event)
+	{
+		++calls;
+
+		if (redispatch) {
+			redispatch = false;
+			m_manager.dispatch(event);
+		}
+		if (disconnect) {
+			m_manager.disconnect(disconnect, TestEvent::Type());
+			disconnect = 0;
+		}
+		if (connect) {
+			m_manager.connect(connect, TestEvent::Type());
+			connect = 0;
+		}
+		return(false);
+	}
+
+private:
+
+	Event::EventManager &m_manager;
+};
+
+class BatchListener : public Event::IBatchEventListener
+{
+	NO_ASSIGN_COPY(BatchListener);
+public:
+
+	BatchListener(bool handle_)
+	    : batches(0)
+	    , handle(handle_) {}
+
+	std::vector<int> order;
+	int batches;
+	bool handle;
+
+	VIRTUAL bool handleEvent(const Event::IEvent &event)
+	{
+		order.push_back(static_cast<const TestEvent &>(event).id);
+		return(handle);
+	}
+
+	VIRTUAL bool handleEvents(const Core::Type &, const Event::IEvent *const *events,
+	                          size_t count)
+	{
+		++batches;
+		for (size_t l_i = 0; l_i < count; ++l_i)
+			order.push_back(static_cast<const TestEvent *>(events[l_i])->id);
+		return(handle);
+	}
+};
+
+/* events in the same tens coalesce */
+static uint64_t
+Tens(const Event::IEvent &event)
+{
+	return(static_cast<uint64_t>(static_cast<const TestEvent &>(event).id / 10));
+}
+
+static bool
+Order(const std::vector<int> &order, const int *expected, size_t count)
+{
+	if (order.size() != count)
+		return(false);
+	for (size_t l_i = 0; l_i < count; ++l_i)
+		if (order[l_i] != expected[l_i])
+			return(false);
+	return(true);
+}
+
+void
+eventmanager_order_test(void)
+{
+	Event::EventManager l_manager("order");
+	TestListener l_listener(l_manager);
+	l_manager.connect(&l_listener, TestEvent::Type());
+
+	const MMTICK l_now = NOW_TICKS();
+
+	/* priority first, then timestamp, then queue order */
+	l_manager.queue(new TestEvent(1, l_now - 10, Event::LowPriority));
+	l_manager.queue(new TestEvent(2, l_now - 20, Event::LowPriority));
+	l_manager.queue(new TestEvent(3, l_now - 5, Event::HighPriority));
+	l_manager.queue(new TestEvent(4, l_now - 20, Event::LowPriority));
+	l_manager.queue(new TestEvent(5, l_now + Core::Platform::TicksPerSecond * 60));
+
+	const bool l_drained = l_manager.execute();
+	ASSERT_FALSE("EventManager::execute() pending timer", l_drained);
+
+	const int l_expected[] = { 3, 2, 4, 1 };
+	ASSERT_TRUE("EventManager::execute() order",
+	    Order(l_listener.order, l_expected, 4));
+
+	/* future event must not hold back new ones */
+	l_listener.order.clear();
+	l_manager.queue(new TestEvent(100, l_now));
+	l_manager.execute();
+	ASSERT_TRUE("EventManager::execute() not blocked by timers",
+	    l_listener.order.size() == 1 && l_listener.order[0] == 100);
+
+	l_listener.order.clear();
+	l_manager.execute();
+	ASSERT_TRUE("EventManager::execute() deferred queue",
+	    l_listener.order.size() == 1 && l_listener.order[0] == 101);
+
+	l_manager.disconnect(&l_listener, TestEvent::Type());
+}
+
+void
+eventmanager_cancel_test(void)
+{
+	Event::EventManager l_manager("cancel");
+	TestListener l_listener(l_manager);
+	l_manager.connect(&l_listener, TestEvent::Type());
+
+	const Event::EventHandle l_a = l_manager.queueHandle(new TestEvent(1));
+	const Event::EventHandle l_b = l_manager.queueHandle(new TestEvent(2));
+	ASSERT_NOT_ZERO("EventManager::queueHandle() handle", l_a);
+	ASSERT_NOT_EQUAL("EventManager::queueHandle() unique handles", l_a, l_b);
+
+	bool l_cancelled = l_manager.cancel(l_a);
+	ASSERT_TRUE("EventManager::cancel()", l_cancelled);
+	l_cancelled = l_manager.cancel(l_a);
+	ASSERT_FALSE("EventManager::cancel() twice", l_cancelled);
+
+	l_manager.execute();
+	ASSERT_TRUE("EventManager::cancel() skipped",
+	    l_listener.order.size() == 1 && l_listener.order[0] == 2);
+	l_cancelled = l_manager.cancel(l_b);
+	ASSERT_FALSE("EventManager::cancel() dispatched", l_cancelled);
+
+	/* recycled slot rejects the stale handle */
+	const Event::EventHandle l_c = l_manager.queueHandle(new TestEvent(3));
+	l_cancelled = l_manager.cancel(l_a);
+	ASSERT_FALSE("EventManager::cancel() stale handle", l_cancelled);
+	l_cancelled = l_manager.cancel(l_c);
+	ASSERT_TRUE("EventManager::cancel() recycled slot", l_cancelled);
+
+	/* dequeue by type */
+	l_listener.order.clear();
+	Event::SharedEvent l_event(new TestEvent(4));
+	l_manager.queue(l_event);
+	l_manager.queue(new TestEvent(5));
+	const bool l_dequeued = l_manager.dequeue(l_event, true);
+	ASSERT_TRUE("EventManager::dequeue(all)", l_dequeued);
+	l_manager.execute();
+	ASSERT_TRUE("EventManager::dequeue(all) removed", l_listener.order.empty());
+
+	/* cancelled timers don't count as pending */
+	const Event::EventHandle l_d = l_manager.queueHandle(new TestEvent(6,
+	    NOW_TICKS() + Core::Platform::TicksPerSecond * 60));
+	bool l_idle = l_manager.execute();
+	ASSERT_FALSE("EventManager::execute() pending timer", l_idle);
+	l_manager.cancel(l_d);
+	l_idle = l_manager.execute();
+	ASSERT_TRUE("EventManager::execute() cancelled timer", l_idle);
+
+	l_manager.disconnect(&l_listener, TestEvent::Type());
+}
+
+void
+eventmanager_construct_test(void)
+{
+	Event::EventManager l_manager("construct");
+	TestListener l_listener(l_manager);
+	l_manager.connect(&l_listener, TestEvent::Type());
+
+	const Event::EventHandle l_a = l_manager.queue<TestEvent>(7);
+	const Event::EventHandle l_b =
+	    l_manager.queue<TestEvent>(8, NOW_TICKS() - 1, Event::HighPriority);
+	ASSERT_TRUE("EventManager::queue<T>() handles", l_a && l_b);
+
+	l_manager.execute();
+	const int l_expected[] = { 8, 7 };
+	ASSERT_TRUE("EventManager::queue<T>() dispatched",
+	    Order(l_listener.order, l_expected, 2));
+
+	l_manager.disconnect(&l_listener, TestEvent::Type());
+}
+
+void
+eventmanager_listener_test(void)
+{
+	Event::EventManager l_manager("listener");
+	MutatingListener l_a(l_manager);
+	MutatingListener l_b(l_manager);
+	MutatingListener l_c(l_manager);
+	MutatingListener l_d(l_manager);
+	TestEvent l_event(0);
+
+	bool l_result = l_manager.dispatch(l_event);
+	ASSERT_FALSE("EventManager::dispatch() without listeners", l_result);
+
+	l_manager.connect(&l_a, TestEvent::Type());
+	l_manager.connect(&l_b, TestEvent::Type());
+	l_manager.connect(&l_c, TestEvent::Type());
+	l_result = l_manager.connect(&l_a, TestEvent::Type());
+	ASSERT_FALSE("EventManager::connect() twice", l_result);
+
+	/* b is skipped, d waits for the next dispatch */
+	l_a.disconnect = &l_b;
+	l_a.connect = &l_d;
+	l_manager.dispatch(l_event);
+	ASSERT_TRUE("EventManager::dispatch() mutated during dispatch",
+	    l_a.calls == 1 && l_b.calls == 0 && l_c.calls == 1 && l_d.calls == 0);
+
+	l_manager.dispatch(l_event);
+	ASSERT_TRUE("EventManager::dispatch() after mutation",
+	    l_a.calls == 2 && l_b.calls == 0 && l_c.calls == 2 && l_d.calls == 1);
+
+	l_result = l_manager.disconnect(&l_b, TestEvent::Type());
+	ASSERT_FALSE("EventManager::disconnect() not connected", l_result);
+
+	/* nested dispatch, c is removed from inside the inner one */
+	l_a.redispatch = true;
+	l_a.disconnect = &l_c;
+	l_manager.dispatch(l_event);
+	ASSERT_TRUE("EventManager::dispatch() nested",
+	    l_a.calls == 4 && l_c.calls == 2 && l_d.calls == 3);
+
+	l_manager.dispatch(l_event);
+	ASSERT_TRUE("EventManager::dispatch() after nested",
+	    l_a.calls == 5 && l_c.calls == 2 && l_d.calls == 4);
+
+	l_manager.disconnect(&l_a, TestEvent::Type());
+	l_manager.disconnect(&l_d, TestEvent::Type());
+	l_result = l_manager.dispatch(l_event);
+	ASSERT_FALSE("EventManager::dispatch() all disconnected", l_result);
+}
+
+static const int s_posters = 4;
+static const int s_posts = 1000;
+
+static void
+Post(void *c)
+{
+	Event::EventManager *l_manager = static_cast<Event::EventManager *>(c);
+
+	for (int l_i = 0; l_i < s_posts; ++l_i) {
+		Event::IEvent *l_event = new TestEvent(l_i);
+		while (!l_manager->post(l_event))
+			Core::Thread::YieldSlice();
+	}
+}
+
+void
+eventmanager_post_test(void)
+{
+	Event::EventManager l_manager("post");
+	MutatingListener l_listener(l_manager);
+	l_manager.connect(&l_listener, TestEvent::Type());
+
+	bool l_result = l_manager.post(0);
+	ASSERT_FALSE("EventManager::post() null", l_result);
+
+	Core::Thread::Handle *l_threads[s_posters];
+	for (int l_i = 0; l_i < s_posters; ++l_i)
+		l_threads[l_i] = Core::Thread::Start(Post, &l_manager);
+
+	/* bounded, in case posts get lost */
+	for (int l_i = 0; l_i < 100000 && l_listener.calls < s_posters * s_posts; ++l_i) {
+		l_manager.execute();
+		Core::Thread::YieldSlice();
+	}
+
+	for (int l_i = 0; l_i < s_posters; ++l_i)
+		Core::Thread::Join(l_threads[l_i]);
+	l_manager.execute();
+
+	ASSERT_EQUAL("EventManager::post() from threads",
+	    l_listener.calls, s_posters * s_posts);
+
+	/* still queued on destruction, must not leak */
+	l_manager.post(new TestEvent(0));
+	l_manager.disconnect(&l_listener, TestEvent::Type());
+}
+
+void
+eventmanager_batch_test(void)
+{
+	Event::EventManager l_manager("batch");
+	BatchListener l_batch(false);
+	TestListener l_plain(l_manager);
+	l_manager.connect(&l_batch, TestEvent::Type());
+	l_manager.connect(&l_plain, TestEvent::Type());
+
+	for (int l_i = 1; l_i <= 4; ++l_i)
+		l_manager.queue<TestEvent>(l_i);
+	l_manager.execute();
+
+	const int l_expected[] = { 1, 2, 3, 4 };
+	ASSERT_EQUAL("EventManager::execute() single batch", l_batch.batches, 1);
+	ASSERT_TRUE("EventManager::execute() batch order",
+	    Order(l_batch.order, l_expected, 4));
+	ASSERT_TRUE("EventManager::execute() plain listener after batch",
+	    Order(l_plain.order, l_expected, 4));
+
+	/* direct dispatch goes through handleEvent() */
+	l_batch.order.clear();
+	TestEvent l_event(9);
+	l_manager.dispatch(l_event);
+	ASSERT_TRUE("EventManager::dispatch() batch listener",
+	    l_batch.order.size() == 1 && l_batch.order[0] == 9);
+
+	/* handled batches stop there */
+	l_batch.handle = true;
+	l_plain.order.clear();
+	l_manager.queue<TestEvent>(5);
+	l_manager.execute();
+	ASSERT_TRUE("EventManager::execute() handled batch", l_plain.order.empty());
+
+	l_manager.disconnect(&l_batch, TestEvent::Type());
+	l_manager.disconnect(&l_plain, TestEvent::Type());
+}
+
+void
+eventmanager_coalesce_test(void)
+{
+	Event::EventManager l_manager("coalesce");
+	TestListener l_listener(l_manager);
+	l_manager.connect(&l_listener, TestEvent::Type());
+	l_manager.setCoalescing(TestEvent::Type(), Tens);
+
+	const int l_ids[] = { 10, 20, 11, 21, 12, 30 };
+	for (int l_i = 0; l_i < 6; ++l_i)
+		l_manager.queue<TestEvent>(l_ids[l_i]);
+	l_manager.execute();
+
+	/* latest per key, in the order they were queued */
+	const int l_expected[] = { 21, 12, 30 };
+	ASSERT_TRUE("EventManager::setCoalescing() latest per key",
+	    Order(l_listener.order, l_expected, 3));
+
+	l_listener.order.clear();
+	l_manager.setCoalescing(TestEvent::Type(), 0);
+	l_manager.queue<TestEvent>(10);
+	l_manager.queue<TestEvent>(11);
+	l_manager.execute();
+	ASSERT_EQUAL("EventManager::setCoalescing() disabled",
+	    l_listener.order.size(), 2u);
+
+	l_manager.disconnect(&l_listener, TestEvent::Type());
+}
+
+int
+main(int, char *[])
+{
+	RUN_TEST(eventmanager_order_test);
+	RUN_TEST(eventmanager_cancel_test);
+	RUN_TEST(eventmanager_construct_test);
+	RUN_TEST(eventmanager_listener_test);
+	RUN_TEST(eventmanager_batch_test);
+	RUN_TEST(eventmanager_coalesce_test);
+	RUN_TEST(eventmanager_post_test);
+
+	return(TEST_EXITCODE);
+}
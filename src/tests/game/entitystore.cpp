@@ -0,0 +1,389 @@
+/*
+ * Copyright (c) 2013, Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ * All rights reserved.
+ *
+ * This file is part of Marshmallow Game Engine.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE CONTRIBUTORS ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are
+ * those of the authors and should not be interpreted as representing official
+ * policies, either expressed or implied, of the project as a whole.
+ */
+
+#include "core/identifier.h"
+#include "core/shared.h"
+#include "core/weak.h"
+
+#include "game/entity.h"
+#include "game/entityscenelayer.h"
+#include "game/entitystore.h"
+#include "game/movementcomponent.h"
+#include "game/positioncomponent.h"
+#include "game/scene.h"
+#include "game/sizecomponent.h"
+
+#include "tests/common.h"
+
+/*!
+ * @file
+ *
+ * @author Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ */
+
+MARSHMALLOW_NAMESPACE_USE
+
+void
+entitystore_handle_test(void)
+{
+	Game::EntityStore l_store;
+
+	const Game::EntityHandle l_a = l_store.create();
+	const Game::EntityHandle l_b = l_store.create();
+
+	ASSERT_FALSE("Created handle isn't null", l_a.isNull());
+	ASSERT_TRUE("Default handle is null", Game::EntityHandle().isNull());
+	ASSERT_NOT_EQUAL("Handles are distinct", l_a, l_b);
+
+	const size_t l_size = l_store.size();
+	ASSERT_EQUAL("Two live entities", l_size, 2u);
+
+	l_store.destroy(l_a);
+
+	const bool l_alive = l_store.isAlive(l_a);
+	ASSERT_FALSE("Destroyed handle is stale", l_alive);
+
+	/* slot is recycled with a new generation */
+	const Game::EntityHandle l_c = l_store.create();
+	ASSERT_EQUAL("Slot recycled", l_c.index, l_a.index);
+	ASSERT_NOT_EQUAL("Generation bumped", l_c.generation, l_a.generation);
+
+	const bool l_attached = l_store.attach(l_a, Game::EntityStore::Position);
+	ASSERT_FALSE("Attach to stale handle fails", l_attached);
+
+	const int l_components = l_store.components(l_c);
+	ASSERT_ZERO("Recycled slot starts empty", l_components);
+
+	Math::Point2 *l_position = l_store.position(l_a);
+	ASSERT_ZERO("Stale handle has no position", l_position);
+}
+
+void
+entitystore_pool_test(void)
+{
+	Game::EntityStore l_store;
+
+	Game::EntityHandle l_handles[4];
+	for (int l_i = 0; l_i < 4; ++l_i) {
+		l_handles[l_i] = l_store.create
+		    (Game::EntityStore::PositionFlag | Game::EntityStore::SizeFlag);
+		l_store.position(l_handles[l_i])->x = static_cast<float>(l_i);
+	}
+
+	size_t l_count = l_store.count(Game::EntityStore::Position);
+	ASSERT_EQUAL("Four positions pooled", l_count, 4u);
+
+	/* last position is swapped into the hole */
+	l_store.destroy(l_handles[1]);
+
+	l_count = l_store.count(Game::EntityStore::Position);
+	ASSERT_EQUAL("Three positions pooled", l_count, 3u);
+
+	const Game::EntityHandle l_owner = l_store.owner(Game::EntityStore::Position, 1);
+	ASSERT_EQUAL("Swapped owner", l_owner, l_handles[3]);
+
+	const float l_x = l_store.positions()[1].x;
+	ASSERT_EQUAL("Swapped position", l_x, 3.f);
+
+	const float l_last = l_store.position(l_handles[3])->x;
+	ASSERT_EQUAL("Moved entity keeps its data", l_last, 3.f);
+
+	l_count = l_store.count(Game::EntityStore::Size);
+	ASSERT_EQUAL("Sizes follow", l_count, 3u);
+
+	/* detach leaves other components alone */
+	l_store.detach(l_handles[0], Game::EntityStore::Size);
+
+	const int l_components = l_store.components(l_handles[0]);
+	ASSERT_EQUAL("Position remains", l_components,
+	    static_cast<int>(Game::EntityStore::PositionFlag));
+}
+
+void
+entitystore_movement_test(void)
+{
+	Game::EntityStore l_store;
+
+	const Game::EntityHandle l_moving = l_store.create
+	    (Game::EntityStore::PositionFlag | Game::EntityStore::MovementFlag);
+	const Game::EntityHandle l_still = l_store.create
+	    (Game::EntityStore::MovementFlag);
+
+	*l_store.velocity(l_moving) = Math::Vector2(10.f, 0.f);
+	*l_store.acceleration(l_moving) = Math::Vector2(0.f, 100.f);
+	*l_store.limitY(l_moving) = Math::Pair(-1.f, 20.f);
+	*l_store.velocity(l_still) = Math::Vector2(10.f, 10.f);
+
+	l_store.update(.5f);
+
+	const Math::Point2 l_position = *l_store.position(l_moving);
+	ASSERT_EQUAL("Moved along x", l_position.x, 5.f);
+	ASSERT_EQUAL("Moved along clamped y", l_position.y, 10.f);
+
+	const Math::Vector2 l_velocity = *l_store.velocity(l_moving);
+	ASSERT_EQUAL("Velocity clamped to limit", l_velocity.y, 20.f);
+
+	const Math::Vector2 l_still_velocity = *l_store.velocity(l_still);
+	ASSERT_EQUAL("Entity without position keeps velocity",
+	    l_still_velocity.x, 10.f);
+}
+
+void
+entitystore_paired_test(void)
+{
+	Game::EntityStore l_store;
+
+	const int l_count = 32;
+	Game::EntityHandle l_handles[l_count];
+	for (int l_i = 0; l_i < l_count; ++l_i) {
+		/* mix of position only, movement only and both, either order */
+		l_handles[l_i] = l_store.create();
+		if (l_i % 3 != 1)
+			l_store.attach(l_handles[l_i], Game::EntityStore::Movement);
+		if (l_i % 3 != 2)
+			l_store.attach(l_handles[l_i], Game::EntityStore::Position);
+		if (l_i % 4 == 0)
+			l_store.attach(l_handles[l_i], Game::EntityStore::Movement);
+	}
+
+	/* break some pairs up */
+	for (int l_i = 0; l_i < l_count; l_i += 5)
+		l_store.detach(l_handles[l_i], Game::EntityStore::Movement);
+	for (int l_i = 3; l_i < l_count; l_i += 7)
+		l_store.destroy(l_handles[l_i]);
+
+	const int l_both =
+	    Game::EntityStore::PositionFlag | Game::EntityStore::MovementFlag;
+
+	size_t l_expected = 0;
+	for (int l_i = 0; l_i < l_count; ++l_i)
+		if ((l_store.components(l_handles[l_i]) & l_both) == l_both)
+			++l_expected;
+
+	const size_t l_paired = l_store.paired();
+	ASSERT_EQUAL("Paired count", l_paired, l_expected);
+
+	bool l_aligned = true;
+	for (size_t l_i = 0; l_i < l_paired; ++l_i)
+		l_aligned &= (l_store.owner(Game::EntityStore::Position, l_i)
+		    == l_store.owner(Game::EntityStore::Movement, l_i));
+	ASSERT_TRUE("Paired slots share owners", l_aligned);
+
+	/* every entity moves by its own velocity */
+	for (int l_i = 0; l_i < l_count; ++l_i) {
+		Math::Vector2 *l_velocity = l_store.velocity(l_handles[l_i]);
+		if (l_velocity)
+			*l_velocity = Math::Vector2(static_cast<float>(l_i), 0.f);
+	}
+	l_store.update(1.f);
+
+	bool l_moved = true;
+	for (int l_i = 0; l_i < l_count; ++l_i) {
+		const Math::Point2 *l_position = l_store.position(l_handles[l_i]);
+		if (!l_position)
+			continue;
+		const float l_x = l_store.velocity(l_handles[l_i]) ?
+		    static_cast<float>(l_i) : 0.f;
+		l_moved &= (l_position->x == l_x);
+	}
+	ASSERT_TRUE("Entities moved by their own velocity", l_moved);
+}
+
+void
+entitystore_adapter_test(void)
+{
+	Game::Scene l_scene("test");
+	Game::SharedSceneLayer l_slayer(new Game::EntitySceneLayer("entities", l_scene));
+	l_scene.pushLayer(l_slayer);
+
+	Game::SharedEntitySceneLayer l_layer =
+	    l_slayer.staticCast<Game::EntitySceneLayer>();
+	const Game::SharedEntityStore &l_shared_store = l_layer->store();
+	Game::EntityStore &l_store = *l_shared_store;
+
+	Game::Entity *l_entity = new Game::Entity("entity", *l_layer);
+	Game::SharedEntity l_shared(l_entity);
+	const Game::EntityHandle l_handle = l_entity->handle();
+
+	Game::PositionComponent *l_position =
+	    new Game::PositionComponent("position", *l_entity, l_shared_store, l_handle);
+	Game::MovementComponent *l_movement =
+	    new Game::MovementComponent("movement", *l_entity, l_shared_store, l_handle);
+	Game::SizeComponent *l_size =
+	    new Game::SizeComponent("size", *l_entity, l_shared_store, l_handle);
+	l_entity->pushComponent(l_position);
+	l_entity->pushComponent(l_movement);
+	l_entity->pushComponent(l_size);
+	l_layer->addEntity(l_shared);
+
+	const int l_components = l_store.components(l_handle);
+	ASSERT_EQUAL("Components attached", l_components,
+	    Game::EntityStore::PositionFlag | Game::EntityStore::MovementFlag
+	    | Game::EntityStore::SizeFlag);
+
+	l_position->position() = Math::Point2(1.f, 2.f);
+	l_size->size() = Math::Size2f(4.f, 8.f);
+	l_movement->velocity() = Math::Vector2(2.f, 0.f);
+
+	const float l_store_y = l_store.position(l_handle)->y;
+	ASSERT_EQUAL("Position lives in store", l_store_y, 2.f);
+
+	const float l_store_height = l_store.size(l_handle)->height;
+	ASSERT_EQUAL("Size lives in store", l_store_height, 8.f);
+
+	/* moved once by the store, not again by the component */
+	l_layer->update(.5f);
+
+	const float l_x = l_position->position().x;
+	ASSERT_EQUAL("Layer update moves pooled entity", l_x, 2.f);
+
+	const Math::Point2 l_simulated = l_movement->simulate(.5f);
+	ASSERT_EQUAL("Simulate reads store", l_simulated.x, 3.f);
+
+	/* unbound components keep working alongside */
+	Game::Entity *l_legacy = new Game::Entity("legacy", *l_layer);
+	Game::SharedEntity l_legacy_shared(l_legacy);
+	Game::PositionComponent *l_legacy_position =
+	    new Game::PositionComponent("position", *l_legacy);
+	Game::MovementComponent *l_legacy_movement =
+	    new Game::MovementComponent("movement", *l_legacy);
+	l_legacy->pushComponent(l_legacy_position);
+	l_legacy->pushComponent(l_legacy_movement);
+	l_legacy_movement->velocity() = Math::Vector2(2.f, 0.f);
+	l_layer->addEntity(l_legacy_shared);
+
+	l_layer->update(.5f);
+
+	const float l_legacy_x = l_legacy_position->position().x;
+	ASSERT_EQUAL("Legacy entity still moves", l_legacy_x, 1.f);
+
+	/* destruction releases the store slot */
+	l_layer->removeEntity(l_shared);
+	l_shared.clear();
+
+	const bool l_alive = l_store.isAlive(l_handle);
+	ASSERT_FALSE("Entity handle released", l_alive);
+
+	const size_t l_count = l_store.count(Game::EntityStore::Position);
+	ASSERT_ZERO("Position pool empty", l_count);
+}
+
+void
+entitystore_mixed_test(void)
+{
+	Game::Scene l_scene("test");
+	Game::SharedEntitySceneLayer l_layer
+	    (new Game::EntitySceneLayer("entities", l_scene));
+
+	Game::Entity *l_entity = new Game::Entity("entity", *l_layer);
+	Game::SharedEntity l_shared(l_entity);
+	const Game::EntityHandle l_handle = l_entity->handle();
+
+	/* bound movement, unbound position */
+	Game::PositionComponent *l_position =
+	    new Game::PositionComponent("position", *l_entity);
+	Game::MovementComponent *l_movement = new Game::MovementComponent
+	    ("movement", *l_entity, l_layer->store(), l_handle);
+	l_entity->pushComponent(l_position);
+	l_entity->pushComponent(l_movement);
+	l_layer->addEntity(l_shared);
+
+	l_movement->acceleration() = Math::Vector2(0.f, 4.f);
+
+	l_layer->update(.5f);
+	l_layer->update(.5f);
+
+	/* integrated once per update: v = 2, 4 and y = 1, 3 */
+	const Math::Vector2 l_velocity = l_movement->velocity();
+	ASSERT_EQUAL("Velocity integrated once per update", l_velocity.y, 4.f);
+
+	const float l_y = l_position->position().y;
+	ASSERT_EQUAL("Unbound position moved", l_y, 3.f);
+
+	l_layer->removeEntity(l_shared);
+}
+
+void
+entitystore_lifetime_test(void)
+{
+	Game::SharedEntity l_shared;
+	Game::PositionComponent *l_position = 0;
+	Game::WeakEntityStore l_store;
+
+	{
+		Game::Scene l_scene("test");
+		Game::SharedEntitySceneLayer l_layer
+		    (new Game::EntitySceneLayer("entities", l_scene));
+		l_store = l_layer->store();
+
+		Game::Entity *l_entity = new Game::Entity("entity", *l_layer);
+		l_shared = l_entity;
+		const Game::EntityHandle l_handle = l_entity->handle();
+
+		l_position = new Game::PositionComponent
+		    ("position", *l_entity, l_layer->store(), l_handle);
+		l_entity->pushComponent(l_position);
+		l_entity->pushComponent(new Game::MovementComponent
+		    ("movement", *l_entity, l_layer->store(), l_handle));
+		l_entity->pushComponent(new Game::SizeComponent
+		    ("size", *l_entity, l_layer->store(), l_handle));
+		l_layer->addEntity(l_shared);
+
+		l_position->position() = Math::Point2(1.f, 2.f);
+	}
+
+	const bool l_released = !l_store;
+	ASSERT_TRUE("Store released with its layer", l_released);
+
+	/* unbound, falls back to component data */
+	l_position->position() = Math::Point2(3.f, 4.f);
+	const float l_x = l_position->position().x;
+	ASSERT_EQUAL("Orphaned component keeps working", l_x, 3.f);
+
+	/* must not touch the released store */
+	l_shared.clear();
+	ASSERT_FALSE("Entity outlived its layer", l_shared);
+}
+
+int
+main(int, char *[])
+{
+	RUN_TEST(entitystore_handle_test);
+	RUN_TEST(entitystore_pool_test);
+	RUN_TEST(entitystore_movement_test);
+	RUN_TEST(entitystore_paired_test);
+	RUN_TEST(entitystore_adapter_test);
+	RUN_TEST(entitystore_mixed_test);
+	RUN_TEST(entitystore_lifetime_test);
+
+	return(TEST_EXITCODE);
+}
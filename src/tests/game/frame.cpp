@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2013, Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ * All rights reserved.
+ *
+ * This file is part of Marshmallow Game Engine.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE CONTRIBUTORS ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are
+ * those of the authors and should not be interpreted as representing official
+ * policies, either expressed or implied, of the project as a whole.
+ */
+
+#include <sstream>
+
+#include "core/framearena.h"
+#include "core/identifier.h"
+#include "core/shared.h"
+
+#include "event/eventmanager.h"
+#include "event/renderevent.h"
+#include "event/updateevent.h"
+
+#include "graphics/dummy/texturedata.h"
+#include "graphics/painter_p.h"
+#include "graphics/quadmesh.h"
+#include "graphics/tileset.h"
+
+#include "game/collidercomponent.h"
+#include "game/collisionscenelayer.h"
+#include "game/entity.h"
+#include "game/entityscenelayer.h"
+#include "game/movementcomponent.h"
+#include "game/positioncomponent.h"
+#include "game/rendercomponent.h"
+#include "game/scene.h"
+#include "game/scenemanager.h"
+#include "game/sizecomponent.h"
+#include "game/tilemapscenelayer.h"
+
+#include "tests/allocations.h"
+#include "tests/common.h"
+
+/*!
+ * @file
+ *
+ * @author Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ */
+
+MARSHMALLOW_NAMESPACE_USE
+
+static const int s_map_size = 64;
+static const int s_entities = 20;
+
+static Game::SharedScene
+SampleScene(void)
+{
+	Game::SharedScene l_scene(new Game::Scene("sample"));
+
+	/* tilemap */
+
+	Graphics::Dummy::SharedTextureData l_texture_data = new Graphics::Dummy::TextureData;
+	l_texture_data->load("128x128");
+	l_texture_data->setSize(Math::Size2i(128, 128));
+
+	Graphics::Tileset *l_tileset = new Graphics::Tileset;
+	l_tileset->setTileSize(Math::Size2i(16, 16));
+	l_tileset->setTextureData(l_texture_data.staticCast<Graphics::ITextureData>());
+
+	Game::TilemapSceneLayer *l_tilemap = new Game::TilemapSceneLayer("tilemap", *l_scene);
+	Game::SharedSceneLayer l_tilemap_layer(l_tilemap);
+	l_tilemap->setTileSize(Math::Size2i(16, 16));
+	l_tilemap->setSize(Math::Size2i(s_map_size, s_map_size));
+	l_tilemap->attachTileset(1, Graphics::SharedTileset(l_tileset));
+
+	uint32_t *l_data = new uint32_t[s_map_size * s_map_size];
+	for (int l_i = 0; l_i < s_map_size * s_map_size; ++l_i)
+		l_data[l_i] = static_cast<uint32_t>(1 + l_i % 7);
+	l_tilemap->setData(l_data);
+	l_scene->pushLayer(l_tilemap_layer);
+
+	/* collision */
+
+	Game::SharedSceneLayer l_collision(new Game::CollisionSceneLayer("collision", *l_scene));
+	l_scene->pushLayer(l_collision);
+
+	/* entities */
+
+	Game::SharedSceneLayer l_layer(new Game::EntitySceneLayer("entities", *l_scene));
+	Game::SharedEntitySceneLayer l_entity_layer =
+	    l_layer.staticCast<Game::EntitySceneLayer>();
+	l_scene->pushLayer(l_layer);
+
+	for (int l_i = 0; l_i < s_entities; ++l_i) {
+		std::stringstream l_id;
+		l_id << "entity" << l_i;
+
+		Game::SharedEntity l_entity(new Game::Entity(l_id.str(), *l_entity_layer));
+		l_entity->pushComponent(new Game::PositionComponent("position", *l_entity));
+		l_entity->pushComponent(new Game::SizeComponent("size", *l_entity));
+		l_entity->pushComponent(new Game::MovementComponent("movement", *l_entity));
+		l_entity->pushComponent(new Game::ColliderComponent("collider", *l_entity));
+
+		Game::RenderComponent *l_render = new Game::RenderComponent("render", *l_entity);
+		l_render->mesh() = new Graphics::QuadMesh(8.f, 8.f);
+		l_entity->pushComponent(l_render);
+
+		l_entity_layer->addEntity(l_entity);
+	}
+
+	return(l_scene);
+}
+
+static void
+Frame(Event::EventManager &em)
+{
+	em.execute();
+
+	{
+		Event::UpdateEvent l_event(1.f / 60.f,
+		    Event::EventBase::FrameTransient());
+		em.dispatch(l_event);
+	}
+
+	Graphics::Painter::Render();
+
+	{
+		Event::RenderEvent l_event((Event::EventBase::FrameTransient()));
+		em.dispatch(l_event);
+	}
+
+	Core::FrameArena::Swap();
+}
+
+void
+frame_steady_state_test(void)
+{
+	Event::EventManager l_event_manager("frame");
+	Game::SharedSceneManager l_scene_manager(new Game::SceneManager);
+	l_scene_manager->pushScene(SampleScene());
+
+	/* warm up caches */
+	for (int l_i = 0; l_i < 10; ++l_i)
+		Frame(l_event_manager);
+
+	const unsigned long l_allocations = TEST_ALLOCATIONS;
+	for (int l_i = 0; l_i < 100; ++l_i)
+		Frame(l_event_manager);
+
+	ASSERT_EQUAL("Steady-state frame heap allocations",
+	    TEST_ALLOCATIONS - l_allocations, 0ul);
+
+	l_scene_manager->popScene();
+	Core::FrameArena::Release();
+}
+
+int
+main(int, char *[])
+{
+	RUN_TEST(frame_steady_state_test);
+
+	return(TEST_EXITCODE);
+}
@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2013, Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ * All rights reserved.
+ *
+ * This file is part of Marshmallow Game Engine.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE CONTRIBUTORS ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are
+ * those of the authors and should not be interpreted as representing official
+ * policies, either expressed or implied, of the project as a whole.
+ */
+
+#include "game/framestats.h"
+
+#include "tests/common.h"
+
+/*!
+ * @file
+ *
+ * @author Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ */
+
+MARSHMALLOW_NAMESPACE_USE
+
+static const MMTICK s_budget = 100;
+
+void
+framestats_window_test(void)
+{
+	Game::FrameStats l_stats(4);
+	l_stats.reset(s_budget);
+
+	/* tick, update, render, frame */
+	l_stats.record(10,  20, 30, 100);
+	l_stats.record(10, 120, 30, 200); /* update over budget, hitch */
+	l_stats.record(10,  20, 30, 100);
+	l_stats.record(10,  20, 30, 160); /* hitch */
+
+	size_t l_over = l_stats.overBudget(Game::FrameStats::Update);
+	ASSERT_EQUAL("Game::FrameStats::overBudget(Update)", l_over, 1u);
+	l_over = l_stats.overBudget(Game::FrameStats::Work);
+	ASSERT_EQUAL("Game::FrameStats::overBudget(Work)", l_over, 1u);
+	l_over = l_stats.overBudget(Game::FrameStats::Frame);
+	ASSERT_EQUAL("Game::FrameStats::overBudget(Frame) hitches", l_over, 2u);
+	l_over = l_stats.overBudget(Game::FrameStats::Tick);
+	ASSERT_ZERO("Game::FrameStats::overBudget(Tick)", l_over);
+
+	MMTICK l_max = l_stats.maximum(Game::FrameStats::Update);
+	ASSERT_EQUAL("Game::FrameStats::maximum(Update)", l_max, 120);
+	l_max = l_stats.maximum(Game::FrameStats::Frame);
+	ASSERT_EQUAL("Game::FrameStats::maximum(Frame)", l_max, 200);
+
+	/* evicts the first frame, nothing changes */
+	l_stats.record(10, 20, 30, 100);
+	l_over = l_stats.overBudget(Game::FrameStats::Frame);
+	ASSERT_EQUAL("Game::FrameStats::overBudget(Frame) KEPT", l_over, 2u);
+
+	/* evicts the frame holding both maxima */
+	l_stats.record(10, 20, 30, 100);
+	l_over = l_stats.overBudget(Game::FrameStats::Update);
+	ASSERT_ZERO("Game::FrameStats::overBudget(Update) EVICTED", l_over);
+	l_over = l_stats.overBudget(Game::FrameStats::Frame);
+	ASSERT_EQUAL("Game::FrameStats::overBudget(Frame) EVICTED", l_over, 1u);
+	l_max = l_stats.maximum(Game::FrameStats::Update);
+	ASSERT_EQUAL("Game::FrameStats::maximum(Update) EVICTED", l_max, 20);
+	l_max = l_stats.maximum(Game::FrameStats::Frame);
+	ASSERT_EQUAL("Game::FrameStats::maximum(Frame) EVICTED", l_max, 160);
+	l_max = l_stats.percentile(Game::FrameStats::Frame, 100.);
+	ASSERT_EQUAL("Game::FrameStats::percentile(Frame, 100) EVICTED", l_max, 160);
+
+	uint64_t l_total = l_stats.totalOverBudget(Game::FrameStats::Frame);
+	ASSERT_EQUAL("Game::FrameStats::totalOverBudget(Frame)", l_total, 2u);
+	l_total = l_stats.totalOverBudget(Game::FrameStats::Update);
+	ASSERT_EQUAL("Game::FrameStats::totalOverBudget(Update)", l_total, 1u);
+
+	/* late but not a hitch */
+	l_stats.record(10, 20, 30, 140);
+	l_stats.record(10, 20, 30, 100);
+	l_over = l_stats.overBudget(Game::FrameStats::Frame);
+	ASSERT_ZERO("Game::FrameStats::overBudget(Frame) NO HITCH", l_over);
+	l_max = l_stats.maximum(Game::FrameStats::Frame);
+	ASSERT_EQUAL("Game::FrameStats::maximum(Frame) WRAPPED", l_max, 140);
+
+	const uint64_t l_frames = l_stats.frames();
+	ASSERT_EQUAL("Game::FrameStats::frames()", l_frames, 8u);
+	const MMTICK l_mean = l_stats.mean(Game::FrameStats::Update);
+	ASSERT_EQUAL("Game::FrameStats::mean(Update)", l_mean, 20);
+}
+
+void
+framestats_reset_test(void)
+{
+	Game::FrameStats l_stats(4);
+	l_stats.reset(s_budget);
+	l_stats.record(10, 120, 30, 200);
+	l_stats.reset(s_budget);
+
+	const uint64_t l_frames = l_stats.frames();
+	ASSERT_ZERO("Game::FrameStats::reset() frames", l_frames);
+	const size_t l_over = l_stats.overBudget(Game::FrameStats::Update);
+	ASSERT_ZERO("Game::FrameStats::reset() overBudget", l_over);
+	const MMTICK l_max = l_stats.maximum(Game::FrameStats::Frame);
+	ASSERT_ZERO("Game::FrameStats::reset() maximum", l_max);
+}
+
+int
+main(int, char *[])
+{
+	RUN_TEST(framestats_window_test);
+	RUN_TEST(framestats_reset_test);
+
+	return(TEST_EXITCODE);
+}
@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2013, Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ * All rights reserved.
+ *
+ * This file is part of Marshmallow Game Engine.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE CONTRIBUTORS ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are
+ * those of the authors and should not be interpreted as representing official
+ * policies, either expressed or implied, of the project as a whole.
+ */
+#include <cstdio>
+#include <cstdlib>
+
+#include "core/fileio.h"
+#include "core/identifier.h"
+#include "core/platform.h"
+
+#include "event/eventrecorder.h"
+#include "event/keyboardevent.h"
+#include "event/quitevent.h"
+
+#include "game/enginebase.h"
+
+#include "tests/common.h"
+
+/*!
+ * @file
+ *
+ * @author Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ */
+
+MARSHMALLOW_NAMESPACE_USE
+
+static const int s_fps = 60;
+static const uint32_t s_quit_frame = 30;
+static const char s_log[] = MARSHMALLOW_TESTS_DIRECTORY "/replay.log";
+
+class TestEngine : public Game::EngineBase
+{
+	NO_ASSIGN_COPY(TestEngine);
+public:
+
+	TestEngine(void)
+	    : EngineBase(s_fps)
+	    , ticks(0)
+	    , fixed(true) {}
+
+	int ticks;
+	bool fixed;
+
+	VIRTUAL void tick(float delta)
+	{
+		/* the first tick happens before the game loop starts */
+		if (ticks++ > 0)
+			fixed &= (deltaTicks() == Core::Platform::TicksPerSecond / s_fps);
+
+		EngineBase::tick(delta);
+	}
+};
+
+static bool
+WriteLog(void)
+{
+	using namespace Event;
+
+	Core::FileIO l_file(s_log, Core::DIOTruncate);
+	if (!l_file.isOpen())
+		return(false);
+
+	EventRecorder l_recorder(l_file, s_fps);
+
+	l_recorder.setFrame(2);
+	KeyboardEvent l_key(Input::Keyboard::KBK_A, Input::Keyboard::KeyPressed, 0);
+	l_recorder.tap(l_key, IEventTap::Queued);
+
+	l_recorder.setFrame(s_quit_frame);
+	QuitEvent l_quit(7);
+	l_recorder.tap(l_quit, IEventTap::Queued);
+
+	return(l_recorder.isValid());
+}
+
+void
+replay_engine_test(void)
+{
+	const bool l_written = WriteLog();
+	ASSERT_TRUE("Event::EventRecorder WRITE LOG", l_written);
+	if (!l_written) return;
+
+	setenv("MM_REPLAY", s_log, 1);
+
+	TestEngine l_engine;
+	const int l_exit_code = l_engine.run();
+	ASSERT_EQUAL("Game::EngineBase::run() RECORDED QUIT CODE", 7, l_exit_code);
+	ASSERT_EQUAL("Game::EngineBase::run() STOPS ON RECORDED FRAME",
+	    s_quit_frame + 2, l_engine.ticks);
+	ASSERT_TRUE("Game::EngineBase::deltaTicks() FIXED STEP", l_engine.fixed);
+
+	unsetenv("MM_REPLAY");
+	remove(s_log);
+}
+
+void
+replay_missing_test(void)
+{
+	setenv("MM_REPLAY", MARSHMALLOW_TESTS_DIRECTORY "/missing.log", 1);
+
+	TestEngine l_engine;
+	const int l_exit_code = l_engine.run();
+	ASSERT_EQUAL("Game::EngineBase::run() MISSING LOG", -1, l_exit_code);
+
+	unsetenv("MM_REPLAY");
+}
+
+int
+main(int, char *[])
+{
+	RUN_TEST(replay_engine_test);
+	RUN_TEST(replay_missing_test);
+
+	return(TEST_EXITCODE);
+}
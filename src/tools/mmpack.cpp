@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2013, Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ * All rights reserved.
+ *
+ * This file is part of Marshmallow Game Engine.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1. Redistributions of source code must retain the above copyright notice,
+ *      this list of conditions and the following disclaimer.
+ *
+ *   2. Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer in the
+ *      documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE CONTRIBUTORS ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation are
+ * those of the authors and should not be interpreted as representing official
+ * policies, either expressed or implied, of the project as a whole.
+ */
+
+#include "core/packwriter.h"
+
+/*!
+ * @file
+ *
+ * Builds asset packs for Core::PackIO.
+ *
+ * @author Guillermo A. Amaral B. (gamaral) <g@maral.me>
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+MARSHMALLOW_NAMESPACE_USE
+
+static void
+Usage(const char *argv0)
+{
+	fprintf(stderr,
+	    "Usage: %s [-z] [-a alignment] [-C directory] output file...\n"
+	    "\n"
+	    "  -z            zlib compress entries that shrink by an eighth\n"
+	    "  -a alignment  entry data alignment, a power of two (16)\n"
+	    "  -C directory  files are relative to directory\n"
+	    "\n"
+	    "Files are named after their path, without the directory.\n"
+	    "File names are read from standard input when none are given.\n",
+	    argv0);
+}
+
+static bool
+AddFile(Core::PackWriter &pack, const std::string &directory,
+    const std::string &name, bool compress)
+{
+	const std::string l_path =
+	    directory.empty() ? name : directory + "/" + name;
+
+	if (!pack.addFile(name, l_path, compress)) {
+		fprintf(stderr, "Failed to add %s\n", l_path.c_str());
+		return(false);
+	}
+
+	return(true);
+}
+
+int
+main(int argc, char *argv[])
+{
+	std::string l_directory;
+	unsigned long l_alignment = 16;
+	bool l_compress = false;
+	int l_arg = 1;
+
+	for (; l_arg < argc && argv[l_arg][0] == '-' && argv[l_arg][1]; ++l_arg) {
+		if (0 == strcmp(argv[l_arg], "-z"))
+			l_compress = true;
+		else if (0 == strcmp(argv[l_arg], "-a") && l_arg + 1 < argc)
+			l_alignment = strtoul(argv[++l_arg], 0, 10);
+		else if (0 == strcmp(argv[l_arg], "-C") && l_arg + 1 < argc)
+			l_directory = argv[++l_arg];
+		else {
+			Usage(argv[0]);
+			return(EXIT_FAILURE);
+		}
+	}
+
+	if (l_arg >= argc || l_alignment == 0 || l_alignment > 65536
+	    || (l_alignment & (l_alignment - 1))) {
+		Usage(argv[0]);
+		return(EXIT_FAILURE);
+	}
+
+	const char *l_output = argv[l_arg++];
+	Core::PackWriter l_pack(l_alignment);
+	bool l_success = true;
+
+	if (l_arg < argc) {
+		for (; l_arg < argc; ++l_arg)
+			l_success &= AddFile(l_pack, l_directory, argv[l_arg], l_compress);
+	}
+	else {
+		char l_line[4096];
+		while (fgets(l_line, sizeof(l_line), stdin)) {
+			size_t l_length = strlen(l_line);
+			while (l_length > 0 && (l_line[l_length - 1] == '\n'
+			    || l_line[l_length - 1] == '\r'))
+				l_line[--l_length] = '\0';
+			if (l_length > 0)
+				l_success &= AddFile(l_pack, l_directory, l_line, l_compress);
+		}
+	}
+
+	if (!l_success || !l_pack.write(l_output)) {
+		fprintf(stderr, "Failed to build %s\n", l_output);
+		return(EXIT_FAILURE);
+	}
+
+	fprintf(stdout, "%s: %lu entries\n", l_output,
+	    static_cast<unsigned long>(l_pack.count()));
+	return(EXIT_SUCCESS);
+}